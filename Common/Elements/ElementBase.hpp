@@ -139,6 +139,10 @@ class ElementBase : public LinkedObject
 		virtual void GetShapeFunctionsForTractions(double *,int *,Vector *) const;
 		virtual void GetXiPos(const Vector *,Vector *) const;
 		virtual int GetCPDIFunctions(int *,double *,double *,double *,double *,MPMBase *) const;
+#ifdef FLOAT_CPDI
+		void GetShapeFunctionsForTractions(double *,int *,CPDIVector *) const;
+		void GetXiPos(const Vector *,CPDIVector *) const;
+#endif
 		
 #else
 		virtual bool HasNode(int);
@@ -66,7 +66,7 @@ class Elastic : public MaterialBase
 								  double,double,double,double &,double *,double &,bool &) const;
 		virtual void PostFailureUpdate(double &,double &,double &,Tensor *,Tensor *,Tensor *,Matrix3,
 									   double,double,double,double,bool) const;
-		virtual void UpdateCrackingStrainStress(int,Tensor *,Tensor *,double,double,double,Tensor *,Tensor *,Matrix3) const;
+		virtual void UpdateCrackingStrainStress(int,Tensor *,StressTensor *,double,double,double,Tensor *,Tensor *,Matrix3) const;
 #else
         virtual double GetStressStrainZZ(double,double,double,double,double,int);
 #endif
@@ -133,6 +133,7 @@ class MaterialBase : public LinkedObject
 		virtual double GetCpMinusCv(MPMBase *) const;
 		virtual double GetDiffusionCT(void) const;
         virtual void IncrementHeatEnergy(MPMBase *,double,double) const;
+		virtual void PrepareStrainUpdates(double);
 		virtual void MPMConstitutiveLaw(MPMBase *,Matrix3,double,int,void *,ResidualStrains *,int,Tensor *) const;
         virtual void MPMConstitutiveLaw(MPMBase *,Matrix3,double,int,void *,ResidualStrains *,int) const;
 		virtual double GetIncrementalResJ(MPMBase *,ResidualStrains *) const;
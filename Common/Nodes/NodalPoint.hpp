@@ -45,7 +45,7 @@ class NodalPoint : public LinkedObject
 #endif
 	
 		// constants (not changed in MPM time step)
-        double x,y,z;
+        NodeReal x,y,z;
         int	num;
 
 #ifdef FEA_CODE
@@ -115,6 +115,7 @@ class NodalPoint : public LinkedObject
 		bool NodeHasNonrigidParticles(void) const;
 		bool NodeHasParticles(void) const;
 		double GetNodalMass(bool) const;
+		size_t FieldMemoryBytes(void) const;
 		void Describe(bool) const;
 		void AddContactTerms(short,int,ContactTerms *);
         void AddUGradient(short,double,double,double,double,double,int,double);
@@ -180,6 +180,7 @@ short CommonReadHandler::BMPFileCommonInput(char *xName,const Attributes& attrs,
 		{	if(numAngles==2)
 				throw SAXException(XYFileError("Too many <Intensity> commands to set angle mappings.",bmpFileName));
 			angleScale[numAngles]=(maxAngle-thisMinAngle)/((double)imax-(double)imin);
+			minAngle[numAngles]=thisMinAngle;
 			minIntensity[numAngles]=(double)imin;
 			numAngles++;
 		}
@@ -208,7 +209,7 @@ short CommonReadHandler::BMPFileCommonInput(char *xName,const Attributes& attrs,
     else if(strcmp(xName,"Temperature")==0)
 	{
 #ifdef FEA_CODE
-		if(block==THERMAL) return false;
+		if(block==THERMAL || block==GRIDBCHEADER) return false;
 #endif
 		ValidateCommand(xName,INTENSITYBLOCK,ANY_DIM);
     	input=DOUBLE_NUM;
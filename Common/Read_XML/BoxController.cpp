@@ -98,6 +98,16 @@ bool BoxController::ContainsPoint(Vector& v)
     }
 }
 
+// box, cylinder, or cone (|coneRadius|<=1 keeps it within the box)
+void BoxController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	bmin->x = xmin;
+	bmax->x = xmax;
+	bmin->y = ymin;
+	bmax->y = ymax;
+	bmin->z = zmin;
+	bmax->z = zmax;
+}
+
 #pragma mark BoxController: accessors
 
 // override for 3D objects
@@ -34,6 +34,7 @@ class BoxController : public ShapeController
     
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
     
         // accessors
         virtual bool Is2DShape(void);
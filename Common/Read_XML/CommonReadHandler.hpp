@@ -88,7 +88,7 @@ class CommonReadHandler : public DefaultHandler
         //  Constructors and Destructor
         CommonReadHandler();
         ~CommonReadHandler();
-		void FinishUp(void);
+		virtual void FinishUp(void);
     
         //  Handlers for the SAX ContentHandler interface
         void startElement(const XMLCh* const,const XMLCh* const,const XMLCh* const,const Attributes&);
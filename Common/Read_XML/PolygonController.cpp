@@ -93,6 +93,20 @@ bool PolygonController::ContainsPoint(Vector &pt)
 	return (crossings & 0x01);
 }
 
+// 2D shape bounded in x and y by its vertices
+void PolygonController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	ShapeController::GetBoundingBox(bmin,bmax);
+	if(xpt.size()==0) return;
+	bmin->x = bmax->x = xpt[0];
+	bmin->y = bmax->y = ypt[0];
+	for(unsigned i=1;i<xpt.size();i++)
+	{	if(xpt[i]<bmin->x) bmin->x = xpt[i];
+		if(xpt[i]>bmax->x) bmax->x = xpt[i];
+		if(ypt[i]<bmin->y) bmin->y = ypt[i];
+		if(ypt[i]>bmax->y) bmax->y = ypt[i];
+	}
+}
+
 #pragma mark PolygonController: accessors
 
 // type of object
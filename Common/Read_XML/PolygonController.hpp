@@ -32,6 +32,7 @@ class PolygonController : public ShapeController
     
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
     
         // accessors
 		virtual const char *GetShapeName(void);
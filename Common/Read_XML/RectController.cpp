@@ -67,6 +67,15 @@ bool RectController::CheckAngle(double x,double y)
 	return true;
 }
 
+// 2D shape bounded in x and y only
+void RectController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	ShapeController::GetBoundingBox(bmin,bmax);
+	bmin->x = xmin;
+	bmax->x = xmax;
+	bmin->y = ymin;
+	bmax->y = ymax;
+}
+
 #pragma mark RectController: accessors
 
 // type of object
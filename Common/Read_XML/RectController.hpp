@@ -27,6 +27,7 @@ class RectController : public ShapeController
 		// methods
 		virtual bool ContainsPoint(Vector &);
 		virtual bool CheckAngle(double,double);
+		virtual void GetBoundingBox(Vector *,Vector *);
 	
         // accessors
         virtual const char *GetShapeName();
@@ -203,6 +203,13 @@ bool ShapeController::HasAllParameters(void) { return true; }
 // Determine if on the shape (depending of the type of shape)
 bool ShapeController::ContainsPoint(Vector& v) { return false; }
 
+// Box that contains all points in this shape (cutouts can only remove points)
+// Base class is unbounded; subclasses override when their extents are known
+void ShapeController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	bmin->x = bmin->y = bmin->z = -1.e300;
+	bmax->x = bmax->y = bmax->z = 1.e300;
+}
+
 // Determine if on the shape (depending of the type of shape)
 bool ShapeController::ShapeContainsPoint(Vector& v)
 {	// check shape
@@ -46,6 +46,7 @@ class ShapeController
 	
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
 		virtual const char *startNodeEnumerator(int,int);
 		virtual int nextNode(void);
         void resetElementEnumerator(void);
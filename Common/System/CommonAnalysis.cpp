@@ -31,6 +31,7 @@ CommonAnalysis::CommonAnalysis()
 	
 	np=-1;						// analysis method to be set
 	nfree=2;					// 2D analysis
+	numPatches=0;				// 0 to have one patch per processor
 	
 	// If non-zero, this flags can change the calculation
 	int i;
@@ -316,7 +317,13 @@ const char *CommonAnalysis::MPMAugmentation(void) { return ""; }
 // set number of processes (0 for serial code)
 void CommonAnalysis::SetNumberOfProcessors(int npr) { numProcs = npr; }
 int CommonAnalysis::GetNumberOfProcessors(void) { return numProcs; }
-int CommonAnalysis::GetTotalNumberOfPatches(void) { return numProcs>1 ? numProcs : 1 ; }
+
+// number of patches is number of processors unless set to a fixed number
+void CommonAnalysis::SetNumberOfPatches(int npatch) { numPatches = npatch; }
+int CommonAnalysis::GetTotalNumberOfPatches(void)
+{	if(numPatches>0) return numPatches;
+	return numProcs>1 ? numProcs : 1 ;
+}
 
 #pragma mark Methods to keep Xerces contact in fewer files
 
@@ -67,11 +67,12 @@ class CommonAnalysis
 		virtual const char *MPMAugmentation(void);
 		void SetNumberOfProcessors(int);
 		int GetNumberOfProcessors(void);
+		void SetNumberOfPatches(int);
 		int GetTotalNumberOfPatches(void);
 	
 	protected:
 		bool validate,reverseBytes;
-		int version,subversion,buildnumber,numProcs;
+		int version,subversion,buildnumber,numProcs,numPatches;
 		char *description;
 	
 #ifdef _OPENMP
@@ -26,6 +26,13 @@ typedef struct {
 // index to the sig components
 enum { XX=0,YY,ZZ,YZ,XZ,XY,ZY,ZX,YX};
 
+// Storage for nodal coordinates. Compiling with FLOAT_NODAL stores them in single precision
+#ifdef FLOAT_NODAL
+typedef float NodeReal;
+#else
+typedef double NodeReal;
+#endif
+
 #ifdef MPM_CODE
 	// symmetric tensor in contracted notation (3D)
 	typedef struct {
@@ -76,15 +83,86 @@ enum { XX=0,YY,ZZ,YZ,XZ,XY,ZY,ZX,YX};
 		char *nextFriction;
 	} ContactPair;
 
+	// Single precision storage for particle data. Values convert to and from double
+	// precision when read or stored, so calculations and nodal accumulations
+	// remain in double precision
+	struct FloatVector {
+		float x;
+		float y;
+		float z;
+		FloatVector() {}
+		FloatVector(const Vector &v) : x((float)v.x),y((float)v.y),z((float)v.z) {}
+		operator Vector() const { Vector v = {x,y,z}; return v; }
+	};
+	
+	struct FloatTensor {
+		float xx;
+		float yy;
+		float zz;
+		float yz;
+		float xz;
+		float xy;
+		FloatTensor() {}
+		FloatTensor(const Tensor &t) : xx((float)t.xx),yy((float)t.yy),zz((float)t.zz),
+						yz((float)t.yz),xz((float)t.xz),xy((float)t.xy) {}
+		operator Tensor() const { Tensor t = {xx,yy,zz,yz,xz,xy}; return t; }
+	};
+	
+	struct FloatTensorAntisym {
+		float yz;
+		float xz;
+		float xy;
+		FloatTensorAntisym() {}
+		FloatTensorAntisym(const TensorAntisym &t) : yz((float)t.yz),xz((float)t.xz),xy((float)t.xy) {}
+		operator TensorAntisym() const { TensorAntisym t = {yz,xz,xy}; return t; }
+	};
+	
+	// Storage for particle fields. Each can be stored in single precision
+	// by compiling with its flag:
+	//    FLOAT_POSITION - position and original position
+	//    FLOAT_VELOCITY - velocity
+	//    FLOAT_STRESS - stress tensor
+	//    FLOAT_DEFGRAD - strain and rotation tensors (i.e., deformation gradient)
+	//    FLOAT_CPDI - CPDI domain data
+#ifdef FLOAT_POSITION
+	typedef FloatVector PositionVector;
+#else
+	typedef Vector PositionVector;
+#endif
+#ifdef FLOAT_VELOCITY
+	typedef FloatVector VelocityVector;
+#else
+	typedef Vector VelocityVector;
+#endif
+#ifdef FLOAT_STRESS
+	typedef FloatTensor StressTensor;
+#else
+	typedef Tensor StressTensor;
+#endif
+#ifdef FLOAT_DEFGRAD
+	typedef FloatTensor StrainTensor;
+	typedef FloatTensorAntisym RotationTensor;
+#else
+	typedef Tensor StrainTensor;
+	typedef TensorAntisym RotationTensor;
+#endif
+#ifdef FLOAT_CPDI
+	typedef float CPDIReal;
+	typedef FloatVector CPDIVector;
+#else
+	typedef double CPDIReal;
+	typedef Vector CPDIVector;
+#endif
+
 	// for each node in CPDI domain give its element,
 	// its naturual coordinates, weighting factor
 	// for finding the gradient, and weighting factor
 	// for shape function
 	typedef struct {
 		int inElem;
-		Vector ncpos;
-		Vector wg;
-		double ws;
+		CPDIVector ncpos;
+		CPDIVector wg;
+		CPDIReal ws;
 	} CPDIDomain;
 
 	// Transport Properties
@@ -0,0 +1,147 @@
+/********************************************************************************
+    LoadCase.cpp
+    NairnFEA
+    
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Boundary_Conditions/LoadCase.hpp"
+#include "Boundary_Conditions/NodalLoad.hpp"
+#include "Boundary_Conditions/EdgeBC.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "System/UnitsController.hpp"
+#include "Read_XML/Expression.hpp"
+#include "Exceptions/CommonException.hpp"
+
+// Load case globals
+LoadCase *firstLoadCase=NULL;
+int numLoadCases=0;
+
+#pragma mark LoadCase: Constructors and Destructors
+
+// throws std::bad_alloc
+LoadCase::LoadCase(int caseNum,char *caseName)
+{
+	number=caseNum;
+	if(caseName!=NULL)
+	{	name=new char[strlen(caseName)+1];
+		strcpy(name,caseName);
+	}
+	else
+	{	name=new char[20];
+		sprintf(name,"Case %d",caseNum);
+	}
+	temperatureExpr=NULL;
+	firstLoad=NULL;
+	firstEdge=NULL;
+}
+
+LoadCase::~LoadCase()
+{	delete [] name;
+	if(temperatureExpr!=NULL) delete [] temperatureExpr;
+}
+
+#pragma mark LoadCase: Methods
+
+// print loads and temperature for this case
+LoadCase *LoadCase::PrintLoadCase(void)
+{
+	char hline[200];
+	
+	sprintf(hline,"LOAD CASE %d: %s",number,name);
+	PrintSection(hline);
+	
+	if(temperatureExpr!=NULL)
+		cout << "T: " << temperatureExpr << " C" << endl;
+	else
+		cout << "T: same as thermal load" << endl;
+	cout << endl;
+	
+	if(firstLoad!=NULL)
+	{	cout << " Node  DOF       Load (" << UnitsController::Label(FEAFORCE_UNITS) << ")\n"
+			<< "------------------------------\n";
+		NodalLoad *nextLoad=firstLoad;
+		while(nextLoad!=NULL)
+			nextLoad=nextLoad->PrintLoad();
+		cout << endl;
+	}
+	
+	if(firstEdge!=NULL)
+	{	cout << " Elem  Fc   Type      Nodal Stress     Nodal Stress     Nodal Stress (" << UnitsController::Label(PRESSURE_UNITS) << ")\n"
+			<< "----------------------------------------------------------------------\n";
+		EdgeBC *nextEdge=firstEdge;
+		while(nextEdge!=NULL)
+			nextEdge=nextEdge->PrintEdgeLoad();
+		cout << endl;
+	}
+	
+	return (LoadCase *)nextObject;
+}
+
+// remap loads if resequenced
+LoadCase *LoadCase::MapNodes(int *revMap)
+{
+	NodalLoad *nextLoad=firstLoad;
+	while(nextLoad!=NULL)
+		nextLoad=nextLoad->MapNodes(revMap);
+	return (LoadCase *)nextObject;
+}
+
+// remove loads on a removed node and decrement higher node numbers
+LoadCase *LoadCase::DecrementNodeNum(int removedNode)
+{
+	NodalLoad *nextLoad=firstLoad;
+	NodalLoad *prevLoad=NULL;
+	NodalLoad *tempLoad;
+	bool deleted;
+	while(nextLoad!=NULL)
+	{	tempLoad=(NodalLoad *)nextLoad->DecrementNodeNum(removedNode,prevLoad,&deleted);
+		if(deleted)
+		{	if(prevLoad==NULL) firstLoad=tempLoad;
+		}
+		else
+			prevLoad=nextLoad;
+		nextLoad=tempLoad;
+	}
+	return (LoadCase *)nextObject;
+}
+
+/********************************************************************************
+	Set nodal temperatures (relative to stress free temperature T0) for this case
+	Cases without their own temperature get baseTemp[] (1 based)
+	Return TRUE if this case has its own temperature
+	throws CommonException()
+********************************************************************************/
+
+bool LoadCase::SetNodalTemperatures(double T0,double *baseTemp)
+{
+	int i;
+	
+	if(temperatureExpr==NULL)
+	{	for(i=1;i<=nnodes;i++) nd[i]->gTemperature=baseTemp[i];
+		return FALSE;
+	}
+	
+	if(!Expression::CreateFunction(temperatureExpr,1))
+		throw CommonException("A load case temperature expression is not a valid function","LoadCase::SetNodalTemperatures");
+	for(i=1;i<=nnodes;i++)
+		nd[i]->gTemperature = Expression::FunctionValue(1,nd[i]->x,nd[i]->y,0.,0.,0.,0.)-T0;
+	Expression::DeleteFunction(1);
+	return TRUE;
+}
+
+#pragma mark LoadCase: Accessors
+
+// set temperature expression
+// throws std::bad_alloc
+void LoadCase::SetTemperatureExpr(char *expr)
+{	if(temperatureExpr!=NULL) delete [] temperatureExpr;
+	temperatureExpr=new char[strlen(expr)+1];
+	strcpy(temperatureExpr,expr);
+}
+
+bool LoadCase::HasTemperature(void) { return temperatureExpr!=NULL; }
+const char *LoadCase::GetName(void) { return name; }
+int LoadCase::GetNumber(void) { return number; }
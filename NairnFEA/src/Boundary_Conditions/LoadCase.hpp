@@ -0,0 +1,55 @@
+/********************************************************************************
+    LoadCase.hpp
+    NairnFEA
+    
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+	
+	A load case has its own nodal loads, edge stresses, and optional
+	temperature field. All load cases share the mesh and displacement BCs
+	and are solved with a single factorization of the stiffness matrix.
+	Loads defined outside any load case are applied in every case.
+	
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _LOADCASE_
+
+#define _LOADCASE_
+
+class NodalLoad;
+class EdgeBC;
+
+class LoadCase : public LinkedObject
+{
+    public:
+		NodalLoad *firstLoad;
+		EdgeBC *firstEdge;
+	
+        // constructors and destructors
+        LoadCase(int,char *);
+		~LoadCase();
+        
+        // methods
+		LoadCase *PrintLoadCase(void);
+		LoadCase *MapNodes(int *);
+		LoadCase *DecrementNodeNum(int);
+		bool SetNodalTemperatures(double,double *);
+	
+		// accessors
+		void SetTemperatureExpr(char *);
+		bool HasTemperature(void);
+		const char *GetName(void);
+		int GetNumber(void);
+	
+	private:
+		int number;
+		char *name;
+		char *temperatureExpr;
+};
+
+extern LoadCase *firstLoadCase;
+extern int numLoadCases;
+
+#endif
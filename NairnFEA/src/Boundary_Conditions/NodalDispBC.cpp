@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "Boundary_Conditions/NodalDispBC.hpp"
 #include "Nodes/NodalPoint.hpp"
+#include "Numerical/SparseMatrix.hpp"
 
 // Nodal BC global
 NodalDispBC *firstDispBC=NULL;
@@ -66,9 +67,11 @@ NodalDispBC *NodalDispBC::MapNodes(int *revMap)
 }
 
 // fix nodal displacement or rotate coordinates and return nextBC
-NodalDispBC *NodalDispBC::FixOrRotate(double **st,double *rm,int nsize,int nband,int nfree)
+// rm has nrhs right sides (one per load case), each nsize+1 long
+NodalDispBC *NodalDispBC::FixOrRotate(double **st,double *rm,int nsize,int nband,int nfree,int nrhs)
 {
-    int jend,j,i,ii,jj,rowj;
+    int jend,j,i,ii,jj,rowj,k;
+	double *r;
     double skew,cs,c2,s2,sn,cssn;
     double siii,sjjj,siiii,siijj,sjjjj,sijj,siij,rii,rjj;
     
@@ -77,13 +80,16 @@ NodalDispBC *NodalDispBC::FixOrRotate(double **st,double *rm,int nsize,int nband
     {   // Subtract bcValue*col(j) from right side of system
         //     and set fixed displacement
         i=nfree*(nodeNum-1)+direction;		// fixed DOF
-        if(bcValue!=0.)
-        {   jend=fmin(nsize,i+nband-1);
-            for(j=i+1;j<=jend;j++) rm[j]-=bcValue*st[i][j-i+1];
-            jend=fmax(1,i-nband+1);
-            for(j=i-1;j>=jend;j--) rm[j]-=bcValue*st[j][i-j+1];
+        for(k=0;k<nrhs;k++)
+        {   r=&rm[k*(nsize+1)];
+            if(bcValue!=0.)
+            {   jend=fmin(nsize,i+nband-1);
+                for(j=i+1;j<=jend;j++) r[j]-=bcValue*st[i][j-i+1];
+                jend=fmax(1,i-nband+1);
+                for(j=i-1;j>=jend;j--) r[j]-=bcValue*st[j][i-j+1];
+            }
+            r[i]=bcValue;
         }
-        rm[i]=bcValue;
 
         // Zero row and column i and put 1 on diagonal
         for(j=2;j<=nband;j++)
@@ -135,16 +141,32 @@ NodalDispBC *NodalDispBC::FixOrRotate(double **st,double *rm,int nsize,int nband
         st[jj][1]=siiii*s2+sjjjj*c2+2*siijj*cssn;
         st[ii][2]=(siiii-sjjjj)*cssn+siijj*(c2-s2);
 
-        // Transform right side vector
-        rii=rm[ii];
-        rjj=rm[jj];
-        rm[ii]=rii*cs-rjj*sn;
-        rm[jj]=rii*sn+rjj*cs;
+        // Transform right side vectors
+        for(k=0;k<nrhs;k++)
+        {   r=&rm[k*(nsize+1)];
+            rii=r[ii];
+            rjj=r[jj];
+            r[ii]=rii*cs-rjj*sn;
+            r[jj]=rii*sn+rjj*cs;
+        }
     }
 	
 	return (NodalDispBC *)nextObject;
 }
 
+// fix nodal displacement or rotate coordinates in sparse stiffness matrix and return nextBC
+NodalDispBC *NodalDispBC::FixOrRotate(SparseMatrix *kmat,double *rm,int nfree,int nrhs)
+{
+    if(direction>0)
+        kmat->FixDof(nfree*(nodeNum-1)+direction,bcValue,rm,nrhs);
+    else
+	{	int ii=nfree*(nodeNum-1)+1;
+        kmat->RotateDofs(ii,ii+1,PI_CONSTANT*angle/180.,rm,nrhs);
+	}
+	
+	return (NodalDispBC *)nextObject;
+}
+
 // unrotate any skewed nodes and return nextBC
 NodalDispBC *NodalDispBC::Unrotate(double *rm,int nfree)
 {
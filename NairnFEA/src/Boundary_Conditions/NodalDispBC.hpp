@@ -15,6 +15,8 @@
 
 #include "Boundary_Conditions/FEABoundaryCondition.hpp"
 
+class SparseMatrix;
+
 class NodalDispBC : public FEABoundaryCondition
 {
     public:
@@ -27,7 +29,8 @@ class NodalDispBC : public FEABoundaryCondition
 		
         // methods
         virtual NodalDispBC *PrintBC(ostream &);
-        NodalDispBC *FixOrRotate(double **,double *,int,int,int);
+        NodalDispBC *FixOrRotate(double **,double *,int,int,int,int);
+        NodalDispBC *FixOrRotate(SparseMatrix *,double *,int,int);
 		NodalDispBC *Unrotate(double *,int);
         void PrintReaction(void);
 		NodalDispBC *MapNodes(int *);
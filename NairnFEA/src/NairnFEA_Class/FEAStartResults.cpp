@@ -15,6 +15,7 @@
 #include "Boundary_Conditions/NodalLoad.hpp"
 #include "Nodes/NodalPoint.hpp"
 #include "Boundary_Conditions/EdgeBC.hpp"
+#include "Boundary_Conditions/LoadCase.hpp"
 #include "System/UnitsController.hpp"
 #include "Read_XML/Expression.hpp"
 #include "Read_FEA/FEAReadHandler.hpp"
@@ -98,6 +99,12 @@ void NairnFEA::CMStartResultsOutput(void)
 			nextEdge=nextEdge->PrintEdgeLoad();
 		cout << endl;
 	}
+
+    //---------------------------------------------------
+    // Load cases (each with loads added to those above)
+	LoadCase *nextCase=firstLoadCase;
+	while(nextCase!=NULL)
+		nextCase=nextCase->PrintLoadCase();
 	
     //---------------------------------------------------
     // Periodic directions
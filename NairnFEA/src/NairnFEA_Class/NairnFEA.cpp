@@ -16,7 +16,9 @@
 #include "Boundary_Conditions/NodalDispBC.hpp"
 #include "Boundary_Conditions/EdgeBC.hpp"
 #include "Boundary_Conditions/Constraint.hpp"
+#include "Boundary_Conditions/LoadCase.hpp"
 #include "Exceptions/CommonException.hpp"
+#include "Numerical/SparseMatrix.hpp"
 #include <time.h>
 
 // global analysis object
@@ -24,6 +26,7 @@ NairnFEA *fmobj=NULL;
 
 // prototypes to solve banded, symmetric matrix problem
 int gelbnd(double **,int,int,double *,double *,int);
+void gelbndMultiple(double **,int,int,double *,int);
 
 #pragma mark NairnFEA: Constructors and Destructor
 
@@ -39,6 +42,12 @@ NairnFEA::NairnFEA()
 	temperatureExpr=NULL;		// temperature expression
 	stressFreeTemperature=0.;	// streess free temperature
 	periodic.dof=0;				// periodic analysis
+	kmat=NULL;					// sparse stiffness matrix
+	rmCases=NULL;				// reaction vectors
+	numRHS=1;					// one unless there are load cases
+	solverType=BAND_SOLVER;		// linear solver
+	solverTolerance=1.e-10;		// PCG relative residual
+	solverMaxIterations=0;		// PCG iterations (0 for default)
     
 	// Default output flags
 	int i;
@@ -61,9 +70,11 @@ void NairnFEA::CMAnalysis(bool abort)
 
 	char nline[200];
     int result;
-    int i;
+    int i,icase;
     NodalDispBC *nextBC;
+	LoadCase *nextCase;
     double times[5];
+	double *baseTemp=NULL;
 
 #pragma mark --- TASK 0: INITIALIZE
     // start timer
@@ -85,38 +96,62 @@ void NairnFEA::CMAnalysis(bool abort)
     cout << nline << endl << endl;
 
 #pragma mark --- TASK 1: ALLOCATE R VECTOR
-    // Allocate reaction vector and load with nodal loads and edge loads
-    rm=(double *)malloc(sizeof(double)*(nsize+1));
-    if(rm==NULL) throw CommonException("Memory error allocating reaction vector (rm)","NairnFEA::FEAAnalysis");
-    for(i=1;i<=nsize;i++) rm[i]=0.;
-    
-    // add nodal loads to rm[] vector
-    NodalLoad *nextLoad=firstLoadBC;
-    while(nextLoad!=NULL)
-    	nextLoad=nextLoad->Reaction(rm,np,nfree);
-	
-	// add stresses on element edges to rm[] vector
-	ForcesOnEdges();
+    // Allocate reaction vector for each load case and load with nodal loads and edge loads
+	//   (loads outside load cases are in all cases and case loads replace them on the same DOF)
+	numRHS = numLoadCases>0 ? numLoadCases : 1;
+    rmCases=(double *)malloc(sizeof(double)*numRHS*(nsize+1));
+    if(rmCases==NULL) throw CommonException("Memory error allocating reaction vector (rm)","NairnFEA::FEAAnalysis");
+	nextCase=firstLoadCase;
+	for(icase=0;icase<numRHS;icase++)
+	{	rm=&rmCases[icase*(nsize+1)];
+		for(i=1;i<=nsize;i++) rm[i]=0.;
+		
+		// add nodal loads to rm[] vector
+		NodalLoad *nextLoad=firstLoadBC;
+		while(nextLoad!=NULL)
+			nextLoad=nextLoad->Reaction(rm,np,nfree);
+		if(nextCase!=NULL)
+		{	nextLoad=nextCase->firstLoad;
+			while(nextLoad!=NULL)
+				nextLoad=nextLoad->Reaction(rm,np,nfree);
+		}
+		
+		// add stresses on element edges to rm[] vector
+		ForcesOnEdges(firstEdgeBC);
+		if(nextCase!=NULL)
+		{	ForcesOnEdges(nextCase->firstEdge);
+			nextCase=(LoadCase *)nextCase->GetNextObject();
+		}
+	}
+	rm=rmCases;
 
 #pragma mark --- TASK 2: GET STIFFNESS MATRIX
     // allocate and fill global stiffness matrix, st[][], and reaction vector, rm[]
     times[1]=CPUTime();
     BuildStiffnessMatrix();
+	
+	// thermal loads for load cases with their own temperatures
+	if(firstLoadCase!=NULL)
+	{	baseTemp=new double[nnodes+1];
+		for(i=1;i<=nnodes;i++) baseTemp[i]=nd[i]->gTemperature;
+		CaseThermalLoads(baseTemp);
+	}
 
 #pragma mark --- TASK 3: DISPLACEMENT BCs
     // Impose displacement boundary conditions and rotate
 	//     nodes for skew boundary conditions
     nextBC=firstDispBC;
     while(nextBC!=NULL)
-    	nextBC=nextBC->FixOrRotate(st,rm,nsize,nband,nfree);
+	{	if(kmat!=NULL)
+			nextBC=nextBC->FixOrRotate(kmat,rm,nfree,numRHS);
+		else
+			nextBC=nextBC->FixOrRotate(st,rm,nsize,nband,nfree,numRHS);
+	}
     
 #pragma mark --- TASK 4: INVERT STIFFNESS MATRIX
     // Solve linear system for nodal displacements
     times[2]=CPUTime();
-    double *work=(double *)malloc(sizeof(double)*(nsize+1));
-	if(work==NULL) throw CommonException("Memory error allocating work vector for linear solver",
-                                        "NairnFEA::FEAAnalysis");
-    result=gelbnd(st,nsize,nband,rm,work,0);
+    result=SolveLinearSystem();
     if(result==1)
     {	throw CommonException("Linear solver error: matrix is singular. Check boundary conditions.\n  (Hint: turn on resequencing to check for mesh connectivity problem)",
                                 "NairnFEA::FEAAnalysis");
@@ -124,15 +159,14 @@ void NairnFEA::CMAnalysis(bool abort)
     else if(result==-1)
 	{	cout << "Linear solver warning: solution process was close to singular. Results might be invalid." << endl;
     }
-    free(work);
-    free(st);
-	free(stiffnessMemory);
     
 #pragma mark --- TASK 5a: UNSKEW ROTATED NODES
 
-    nextBC=firstDispBC;
-    while(nextBC!=NULL)
-    	nextBC=nextBC->Unrotate(rm,nfree);
+	for(icase=0;icase<numRHS;icase++)
+	{	nextBC=firstDispBC;
+		while(nextBC!=NULL)
+			nextBC=nextBC->Unrotate(&rmCases[icase*(nsize+1)],nfree);
+	}
     
 #pragma mark --- TASK 6: OUTPUT RESULTS
 
@@ -140,21 +174,35 @@ void NairnFEA::CMAnalysis(bool abort)
     double execTime=ElapsedTime();						// elpased time in secs
     times[3]=CPUTime();
     
-    // Print Displacements
-    DisplacementResults();
-    
-    // Calculate forces, stresses, and energy
-    //	print element forces and stresses
-    ForceStressEnergyResults();
-    
-    // Average nodal stresses
-    AvgNodalStresses();
-    
-    // reactivities at fixed nodes
-    ReactionResults();
-    
-    // strain energies
-    EnergyResults();
+	// results for each load case in its own section
+	nextCase=firstLoadCase;
+	for(icase=0;icase<numRHS;icase++)
+	{	rm=&rmCases[icase*(nsize+1)];
+		if(nextCase!=NULL)
+		{	sprintf(nline,"RESULTS FOR LOAD CASE %d: %s",nextCase->GetNumber(),nextCase->GetName());
+			PrintSection(nline);
+			cout << endl;
+			nextCase->SetNodalTemperatures(stressFreeTemperature,baseTemp);
+			nextCase=(LoadCase *)nextCase->GetNextObject();
+		}
+		
+		// Print Displacements
+		DisplacementResults();
+		
+		// Calculate forces, stresses, and energy
+		//	print element forces and stresses
+		ForceStressEnergyResults();
+		
+		// Average nodal stresses
+		AvgNodalStresses();
+		
+		// reactivities at fixed nodes
+		ReactionResults();
+		
+		// strain energies
+		EnergyResults();
+	}
+	if(baseTemp!=NULL) delete [] baseTemp;
     
     // execution times
     times[4]=CPUTime();
@@ -173,14 +221,14 @@ void NairnFEA::CMAnalysis(bool abort)
 }
 
 /***********************************************************
-    Calculate forces on edges
+    Calculate forces on edges in list starting at nextEdge
+	and add to rm[]
 ***********************************************************/
 
-void NairnFEA::ForcesOnEdges(void)
+void NairnFEA::ForcesOnEdges(EdgeBC *nextEdge)
 {
 	int i,mi0,ni0,ii,mi,ni,iel;
 	int numnds;
-	EdgeBC *nextEdge=firstEdgeBC;
 	double re[2*MaxElNd+1];		// max free * max nodes in element + 1
 	
 	// loop of edge boundary conditions
@@ -210,6 +258,9 @@ void NairnFEA::ForcesOnEdges(void)
 /***********************************************************************************
     Calculate stiffness matrix
 	
+	When using a sparse solver, the terms are added to kmat instead (see
+		SparseMatrix.cpp) and the rest of this comment does not apply
+	
 	The stiffness matrix is symmetric, band diagonal with bandwidth nband
 	If Kij is the (i,j) element of the stiffness matrix. It is stored in compact form
 		that has only upper half of the matrix and only possible nonzero element
@@ -241,26 +292,34 @@ void NairnFEA::BuildStiffnessMatrix(void)
     int i,j,iel,mi0,ni0,mi,ni,mj0,nj0,ind,mj,nj;
     int numnds,ii,jj;
     
-    // allocate memory for stiffness matrix and zero it
+	// sparse solvers assemble into sparse matrix with pattern from the mesh
+	if(solverType!=BAND_SOLVER)
+	{	kmat=new SparseMatrix(nsize);
+		kmat->BuildPattern(nfree,numConstraints);
+	}
 	
-	// st[] are pointers to rows of the stiffness matrix
-    st = (double **)malloc(sizeof(double *)*(nsize+1));
-    if(st==NULL) throw CommonException("Memory error creating stiffness matrix pointers (st)",
-											"NairnFEA::BuildStiffnessMatrix");
-											
-	// allocate all in one contiguous block for better speed in algorithms
-    stiffnessMemory = (double *)malloc(sizeof(double)*(nsize*nband));
-    if(stiffnessMemory==NULL) throw CommonException("Memory error creating stiffness matrix memory block",
-											"NairnFEA::BuildStiffnessMatrix");
-											
-	// allocate each row
-	int baseAddr=0;
-    for(i=1;i<=nsize;i++)
-	{	st[i]=&stiffnessMemory[baseAddr];
-		st[i]--;					// to make it 1 based
-		baseAddr+=nband;
-        for(j=1;j<=nband;j++) st[i][j]=0.;
-    }
+	else
+	{	// allocate memory for stiffness matrix and zero it
+		
+		// st[] are pointers to rows of the stiffness matrix
+		st = (double **)malloc(sizeof(double *)*(nsize+1));
+		if(st==NULL) throw CommonException("Memory error creating stiffness matrix pointers (st)",
+												"NairnFEA::BuildStiffnessMatrix");
+												
+		// allocate all in one contiguous block for better speed in algorithms
+		stiffnessMemory = (double *)malloc(sizeof(double)*(nsize*nband));
+		if(stiffnessMemory==NULL) throw CommonException("Memory error creating stiffness matrix memory block",
+												"NairnFEA::BuildStiffnessMatrix");
+												
+		// allocate each row
+		int baseAddr=0;
+		for(i=1;i<=nsize;i++)
+		{	st[i]=&stiffnessMemory[baseAddr];
+			st[i]--;					// to make it 1 based
+			baseAddr+=nband;
+			for(j=1;j<=nband;j++) st[i][j]=0.;
+		}
+	}
     
     // Loop over all elements
     for(iel=0;iel<nelems;iel++)
@@ -287,7 +346,10 @@ void NairnFEA::BuildStiffnessMatrix(void)
                             ind=mj-mi+1;
                             if(ind>0)
                             {	nj=nj0+jj;
-                                st[mi][ind]+=se[ni][nj];
+                                if(kmat!=NULL)
+                                    kmat->AddValue(mi,mj,se[ni][nj]);
+                                else
+                                    st[mi][ind]+=se[ni][nj];
                             }
                         }
                     }
@@ -295,17 +357,9 @@ void NairnFEA::BuildStiffnessMatrix(void)
             }
         }
 		
-        /* Transfer element load vector into global load vector
-                m,n are adresses in global and element vectors */
-        for(i=1;i<=numnds;i++)
-        {   mi0=nfree*(theElements[iel]->NodeIndex(i));
-            ni0=nfree*(i-1);
-            for(ii=1;ii<=nfree;ii++)
-            {	mi=mi0+ii;
-                ni=ni0+ii;
-                rm[mi]+=re[ni];
-            }
-        }
+        // Transfer element load vector into global load vector of each load case
+		for(i=0;i<numRHS;i++)
+			AddElementLoads(iel,&rmCases[i*(nsize+1)]);
     }
 	
 	// terms for contraints with Lagrange multiplier DOFs
@@ -317,14 +371,67 @@ void NairnFEA::BuildStiffnessMatrix(void)
 			mj=nbase+nextConstraint->GetLambdaNum();		// mj > mi always
 			for(i=1;i<=numnds;i++)
 			{   mi=nextConstraint->NodalDof(i,nfree);
-				st[mi][mj-mi+1]+=nextConstraint->GetCoeff(i);
+				if(kmat!=NULL)
+					kmat->AddValue(mi,mj,nextConstraint->GetCoeff(i));
+				else
+					st[mi][mj-mi+1]+=nextConstraint->GetCoeff(i);
 			}
-			rm[mj]+=nextConstraint->GetQ();
+			for(i=0;i<numRHS;i++)
+				rmCases[i*(nsize+1)+mj]+=nextConstraint->GetQ();
 			nextConstraint=(Constraint *)nextConstraint->GetNextObject();
 		}
 	}
 }
 
+/***********************************************************
+	Transfer element load vector re[] (from Stiffness())
+		into global load vector r[]
+***********************************************************/
+
+void NairnFEA::AddElementLoads(int iel,double *r)
+{
+	int i,ii,mi0,ni0;
+	int numnds=theElements[iel]->NumberNodes();
+	
+	// m,n are adresses in global and element vectors
+	for(i=1;i<=numnds;i++)
+	{   mi0=nfree*(theElements[iel]->NodeIndex(i));
+		ni0=nfree*(i-1);
+		for(ii=1;ii<=nfree;ii++)
+			r[mi0+ii]+=re[ni0+ii];
+	}
+}
+
+/***********************************************************
+	Add thermal loads for load cases with their own
+	temperatures. Thermal loads are linear in temperature
+	so add loads for the difference between the case and
+	the base temperatures (in baseTemp[], already in rm[]).
+	Leaves base temperatures in the nodes.
+	throws CommonException()
+***********************************************************/
+
+void NairnFEA::CaseThermalLoads(double *baseTemp)
+{
+	int i,iel,icase=0;
+	LoadCase *nextCase=firstLoadCase;
+	
+	while(nextCase!=NULL)
+	{	if(nextCase->SetNodalTemperatures(stressFreeTemperature,baseTemp))
+		{	for(i=1;i<=nnodes;i++) nd[i]->gTemperature-=baseTemp[i];
+			for(iel=0;iel<nelems;iel++)
+			{	theElements[iel]->Stiffness(np);
+				AddElementLoads(iel,&rmCases[icase*(nsize+1)]);
+			}
+		}
+		nextCase=(LoadCase *)nextCase->GetNextObject();
+		icase++;
+	}
+	
+	// restore base temperatures
+	for(i=1;i<=nnodes;i++) nd[i]->gTemperature=baseTemp[i];
+}
+
 /***********************************************************
 	Calculate bandwidth
 ***********************************************************/
@@ -353,6 +460,129 @@ int NairnFEA::GetBandWidth(void)
     return nband;
 }
 
+/***********************************************************
+	Solve the linear system with the selected solver and
+	print solver statistics in the stiffness matrix section.
+	Solution for each load case is returned in rmCases[]. The
+	matrix is factored once and the factor is reused for all
+	right hand sides. Return value matches
+	gelbnd(): 0 if OK, -1 for warning, or 1 if singular
+	throws CommonException()
+***********************************************************/
+
+int NairnFEA::SolveLinearSystem(void)
+{
+	int result;
+	char nline[200];
+	double startTime=ElapsedTime(),factorTime=startTime;
+	
+	// Lagrange multipliers make the matrix indefinite, which PCG cannot solve
+	if(solverType==PCG_SOLVER && numConstraints>0)
+	{	cout << "PCG solver cannot be used with constraints or periodic boundary conditions. Using skyline solver instead." << endl;
+		solverType=SKYLINE_SOLVER;
+	}
+	
+	switch(solverType)
+	{	case SKYLINE_SOLVER:
+		{	cout << "Linear solver: sparse LDL^T in skyline storage with reverse Cuthill-McKee ordering" << endl;
+			int nonzeros=kmat->GetNumberNonzeros();
+			double kmemory=kmat->MatrixMemory();
+			result=kmat->FactorSkyline(nsize-numConstraints);
+			factorTime=ElapsedTime();
+			if(result!=1) kmat->SolveSkyline(rmCases,numRHS);
+			sprintf(nline,"Nonzeros in K:%12d     Terms in factor:%14.0lf     Fill ratio:%9.3lf",
+						nonzeros,kmat->FactorNonzeros(),kmat->FactorNonzeros()/(double)nonzeros);
+			cout << nline << endl;
+			sprintf(nline,"Memory for K:%10.3lf MB     Memory for factor:%10.3lf MB",kmemory,kmat->FactorMemory());
+			cout << nline << endl;
+			break;
+		}
+		
+		case PCG_SOLVER:
+		{	cout << "Linear solver: conjugate gradients with incomplete Cholesky (IC(0)) preconditioner" << endl;
+			result=kmat->FactorIncompleteCholesky();
+			factorTime=ElapsedTime();
+			if(result==0)
+			{	int maxIter = solverMaxIterations>0 ? solverMaxIterations : max(1000,nsize);
+				if(kmat->GetShift()>0.)
+					cout << "Preconditioner diagonal shift: " << kmat->GetShift() << endl;
+				
+				// each load case solved with the same preconditioner
+				int icase;
+				for(icase=0;icase<numRHS;icase++)
+				{	result=kmat->SolvePCG(&rmCases[icase*(nsize+1)],solverTolerance,maxIter);
+					if(numRHS>1)
+						sprintf(nline,"Case %d iterations:%8d     Relative residual:%12.4e     Tolerance:%12.4e",
+								icase+1,kmat->GetIterations(),kmat->GetResidual(),solverTolerance);
+					else
+						sprintf(nline,"Iterations:%8d     Relative residual:%12.4e     Tolerance:%12.4e",
+								kmat->GetIterations(),kmat->GetResidual(),solverTolerance);
+					cout << nline << endl;
+					if(result==-1)
+					{	cout << "Linear solver warning: PCG did not converge. Results might be invalid." << endl;
+						result=0;
+					}
+					else if(result==1)
+						break;
+				}
+			}
+			sprintf(nline,"Nonzeros in K:%12d     Terms in factor:%14.0lf     Fill ratio:%9.3lf",
+						kmat->GetNumberNonzeros(),kmat->FactorNonzeros(),
+						kmat->FactorNonzeros()/(double)kmat->GetNumberNonzeros());
+			cout << nline << endl;
+			sprintf(nline,"Memory for K:%10.3lf MB     Memory for factor:%10.3lf MB",kmat->MatrixMemory(),kmat->FactorMemory());
+			cout << nline << endl;
+			break;
+		}
+		
+		default:
+		{	cout << "Linear solver: banded Gaussian elimination" << endl;
+			int i,j,nonzeros=0;
+			for(i=1;i<=nsize;i++)
+			{	for(j=1;j<=nband;j++)
+				{	if(st[i][j]!=0.) nonzeros++;
+				}
+			}
+			double *work=(double *)malloc(sizeof(double)*(nsize+1));
+			if(work==NULL) throw CommonException("Memory error allocating work vector for linear solver",
+												"NairnFEA::SolveLinearSystem");
+			result=gelbnd(st,nsize,nband,rmCases,work,0);
+			free(work);
+			
+			// other load cases with the reduced matrix
+			if(result!=1 && numRHS>1)
+				gelbndMultiple(st,nsize,nband,&rmCases[nsize+1],numRHS-1);
+			free(st);
+			free(stiffnessMemory);
+			double bandTerms=(double)nsize*(double)nband;
+			sprintf(nline,"Nonzeros in K:%12d     Terms in factor:%14.0lf     Fill ratio:%9.3lf",
+						nonzeros,bandTerms,bandTerms/(double)nonzeros);
+			cout << nline << endl;
+			sprintf(nline,"Memory for K and factor (in place):%10.3lf MB",
+						(bandTerms*sizeof(double)+(double)(nsize+1)*sizeof(double *))/1048576.);
+			cout << nline << endl;
+			break;
+		}
+	}
+	
+	// times and done with sparse matrix
+	double endTime=ElapsedTime();
+	if(solverType==BAND_SOLVER)
+		sprintf(nline,"Factor and solve time:%10.3lf secs",endTime-startTime);
+	else
+		sprintf(nline,"Factor time:%10.3lf secs     Solve time:%10.3lf secs",factorTime-startTime,endTime-factorTime);
+	cout << nline << endl;
+	if(numRHS>1)
+		cout << "Load cases solved with one factorization: " << numRHS << endl;
+	cout << endl;
+	if(kmat!=NULL)
+	{	delete kmat;
+		kmat=NULL;
+	}
+	
+	return result;
+}
+
 #pragma mark NairnFEA: Output Results
 
 // Print Displacement Results
@@ -16,11 +16,16 @@
 #define _NAIRNFEA_
 
 class CommonReadHandler;
+class SparseMatrix;
+class EdgeBC;
 
 // FEA output flags
 enum { DISPLACEMENT_OUT=0,FORCE_OUT,ELEMSTRESS_OUT,AVGSTRESS_OUT,
         REACT_OUT,ENERGY_OUT,NUMBER_OUT };
 
+// linear solvers
+enum { BAND_SOLVER=0,SKYLINE_SOLVER,PCG_SOLVER };
+
 class NairnFEA : public CommonAnalysis
 {
     public:
@@ -28,7 +33,13 @@ class NairnFEA : public CommonAnalysis
 		int nband;						// bandwidth of the problem
 		double **st;					// stiffness matrix st[i][j] - i,j 1 based
 		double *stiffnessMemory;		// actually location of stiffness matrix in contiguous memory for speed
-		double *rm;						// reaction vector
+		double *rm;						// reaction vector (for current load case)
+		double *rmCases;				// reaction vectors for all load cases, each nsize+1 long
+		int numRHS;						// number of right hand sides (1 or number of load cases)
+		SparseMatrix *kmat;				// stiffness matrix when using a sparse solver
+		int solverType;					// linear solver (BAND_SOLVER, SKYLINE_SOLVER, or PCG_SOLVER)
+		double solverTolerance;			// relative residual for PCG solver
+		int solverMaxIterations;		// maximum iterations for PCG solver (0 for default)
 		char *temperatureExpr;			// temperature expression
 		double stressFreeTemperature;	// stress free temperature
 		char xax,yax,zax;				// axis names
@@ -47,9 +58,12 @@ class NairnFEA : public CommonAnalysis
 		// FEA methods
 		void BeginResults(void);
 		void Usage();
-		void ForcesOnEdges(void);
+		void ForcesOnEdges(EdgeBC *);
 		void BuildStiffnessMatrix(void);
+		void AddElementLoads(int,double *);
+		void CaseThermalLoads(double *);
 		int GetBandWidth(void);
+		int SolveLinearSystem(void);
 		void DisplacementResults(void);
 		void ForceStressEnergyResults(void);
 		void AvgNodalStresses(void);
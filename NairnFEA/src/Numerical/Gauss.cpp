@@ -10,6 +10,11 @@
 
 // prototype
 int gelbnd(double **,int,int,double *,double *,int);
+void gelbndMultiple(double **,int,int,double *,int);
+static void gelbndBlock(double **,int,int,double *,int);
+
+// maximum right sides solved together in one pass through the matrix
+#define RHS_BLOCK 8
 
 /*  Subroutine to solve a linear system defined by
             ax=r
@@ -178,5 +183,82 @@ int gelbnd(double **a,int n,int nband,double *r,double *work,int iflag)
     return ierr;
 }
 
+/*  Solve a linear system for multiple right hand sides using a matrix that
+	was already reduced by gelbnd() (with iflag=0)
+
+    Input parameters
+        a: reduced matrix from gelbnd()
+        n: order of linear system
+        nband: bandwidth (<=n)
+        r: nrhs right hand sides, each n+1 long with r[k*(n+1)+i] for
+			element i of right side k (element 0 of each one is not used)
+        nrhs: number of right hand sides
+
+    Output parameters
+        r: solutions to linear system
+ 
+	Method
+		Right sides are handled in blocks of up to RHS_BLOCK stored interleaved
+		so each row of the reduced matrix is read once for all right sides in
+		the block. Blocks are solved in parallel.
+*/
 
+void gelbndMultiple(double **a,int n,int nband,double *r,int nrhs)
+{
+	int nblocks=(nrhs+RHS_BLOCK-1)/RHS_BLOCK;
+	
+#pragma omp parallel for
+	for(int b=0;b<nblocks;b++)
+	{	int c0=b*RHS_BLOCK;
+		int nc = nrhs-c0<RHS_BLOCK ? nrhs-c0 : RHS_BLOCK;
+		gelbndBlock(a,n,nband,&r[c0*(n+1)],nc);
+	}
+}
 
+// Forward reduction and back substitution for nc right sides (see gelbndMultiple())
+static void gelbndBlock(double **a,int n,int nband,double *r,int nc)
+{
+	int i,j,c,imin1,jend;
+	double sum[RHS_BLOCK];
+	
+	// x[i*nc+c] is element i of right side c
+	double *x=new double[(n+1)*nc];
+	for(i=1;i<=n;i++)
+	{	for(c=0;c<nc;c++) x[i*nc+c]=r[c*(n+1)+i];
+	}
+	
+	// Forward reduction of the right sides, solve Ly = r and scale by diagonal
+	for(i=1;i<=n;i++)
+	{	imin1 = i-1;
+		jend = fmin(nband,n-imin1);
+		double *yi=&x[i*nc];
+		for(j=2;j<=jend;j++)
+		{	double Lki = a[i][j];
+			if(Lki!=0.)
+			{	double *rk=&x[(imin1+j)*nc];
+				for(c=0;c<nc;c++) rk[c] -= Lki*yi[c];
+			}
+		}
+		for(c=0;c<nc;c++) yi[c] /= a[i][1];
+	}
+	
+	// Back substitution, solve Ux = y
+	for(i=n-1;i>=1;i--)
+	{	imin1 = i-1;
+		jend = fmin(nband,n-imin1);
+		for(c=0;c<nc;c++) sum[c]=0.;
+		for(j=2;j<=jend;j++)
+		{	double Lki = a[i][j];
+			if(Lki!=0.)
+			{	double *xk=&x[(imin1+j)*nc];
+				for(c=0;c<nc;c++) sum[c] += Lki*xk[c];
+			}
+		}
+		for(c=0;c<nc;c++) x[i*nc+c] -= sum[c];
+	}
+	
+	for(i=1;i<=n;i++)
+	{	for(c=0;c<nc;c++) r[c*(n+1)+i]=x[i*nc+c];
+	}
+	delete [] x;
+}
@@ -0,0 +1,954 @@
+/********************************************************************************
+    SparseMatrix.cpp
+    NairnFEA
+
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Sparse stiffness matrix and two alternatives to gelbnd():
+
+	1. FactorSkyline() and SolveSkyline() - LDL^T factorization in skyline
+		(profile) storage after reverse Cuthill-McKee ordering of the
+		displacement DOFs. Lagrange multiplier DOFs are kept last so their
+		zero diagonals are not used as pivots (as in gelbnd()). Only the
+		profile fills, so memory is far below band storage when a few
+		rows (interface elements, constraints) have long reach. Columns
+		are reduced in blocks with the rows above each block done in
+		parallel over the columns of the block.
+	2. SolvePCG() - conjugate gradients preconditioned by incomplete
+		Cholesky with no fill, IC(0). It needs a positive-definite matrix
+		and therefore cannot be used when there are constraints. Rows of
+		the factor are sorted into levels of independent rows so the
+		factorization and the triangular solves are parallel within
+		each level.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Numerical/SparseMatrix.hpp"
+#include "Elements/ElementBase.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "Boundary_Conditions/Constraint.hpp"
+#include "Exceptions/CommonException.hpp"
+#include <algorithm>
+
+// columns reduced together in the skyline factorization
+#define COLUMN_BLOCK 32
+
+// minimum average rows per level to do IC(0) levels in parallel
+#define PARALLEL_LEVEL 64
+
+// maximum right sides solved together in one pass through the factor
+#define RHS_BLOCK 8
+
+// local prototypes
+static double DotProduct(double *,double *,int);
+static int BuildLevels(int,int,int *,int *,int *,int *,int);
+static void SortLevels(int *,int,int *,int *,int);
+
+#pragma mark SparseMatrix: Constructors and Destructor
+
+// Create matrix for n equations, call BuildPattern() before adding values
+SparseMatrix::SparseMatrix(int neqs)
+{
+	n=neqs;
+	nnz=0;
+	rowStart=NULL;
+	cols=NULL;
+	vals=NULL;
+	perm=NULL;
+	top=NULL;
+	colPtr=NULL;
+	sky=NULL;
+	lowerStart=NULL;
+	lvals=NULL;
+	numLevels=0;
+	levelStart=NULL;
+	levelRows=NULL;
+	numUpperLevels=0;
+	upperLevelStart=NULL;
+	upperLevelRows=NULL;
+	uvals=NULL;
+	parallelLevels=false;
+	shift=0.;
+	iterations=0;
+	residual=0.;
+}
+
+SparseMatrix::~SparseMatrix()
+{
+	if(rowStart!=NULL) delete [] rowStart;
+	if(cols!=NULL) delete [] cols;
+	if(vals!=NULL) delete [] vals;
+	if(perm!=NULL) delete [] perm;
+	if(top!=NULL) delete [] top;
+	if(colPtr!=NULL) delete [] colPtr;
+	if(sky!=NULL) free(sky);
+	if(lowerStart!=NULL) delete [] lowerStart;
+	if(lvals!=NULL) delete [] lvals;
+	if(levelStart!=NULL) delete [] levelStart;
+	if(levelRows!=NULL) delete [] levelRows;
+	if(upperLevelStart!=NULL) delete [] upperLevelStart;
+	if(upperLevelRows!=NULL) delete [] upperLevelRows;
+	if(uvals!=NULL) delete [] uvals;
+}
+
+#pragma mark SparseMatrix: Assembly
+
+/********************************************************************************
+	Find nonzero pattern from element connectivity and constraints
+	Each node couples all its DOFs to all DOFs of nodes sharing an element, and
+	each constraint couples its Lagrange multiplier DOF (after the nodal DOFs)
+	to all DOFs of its nodes. Because rows of one node have identical columns,
+	skew rotations in RotateDofs() never need new entries.
+	throws std::bad_alloc
+********************************************************************************/
+
+void SparseMatrix::BuildPattern(int nfree,int numLambdas)
+{
+	int i,j,iel,numnds,node1;
+	int nbase=n-numLambdas;
+
+	// node connectivity (0 based nodes) including self
+	vector< vector<int> > nodeCons(nnodes);
+	for(i=0;i<nnodes;i++) nodeCons[i].push_back(i);
+	for(iel=0;iel<nelems;iel++)
+	{	numnds=theElements[iel]->NumberNodes();
+		for(i=1;i<=numnds;i++)
+		{	node1=theElements[iel]->NodeIndex(i);
+			for(j=1;j<=numnds;j++)
+				nodeCons[node1].push_back(theElements[iel]->NodeIndex(j));
+		}
+	}
+	for(i=0;i<nnodes;i++)
+	{	std::sort(nodeCons[i].begin(),nodeCons[i].end());
+		nodeCons[i].erase(std::unique(nodeCons[i].begin(),nodeCons[i].end()),nodeCons[i].end());
+	}
+
+	// Lagrange multipliers by node and nodes by Lagrange multiplier
+	vector< vector<int> > nodeLambdas(nnodes);
+	vector< vector<int> > lambdaNodes(numLambdas);
+	Constraint *nextConstraint=firstConstraint;
+	while(nextConstraint!=NULL)
+	{	int lambda=nextConstraint->GetLambdaNum();
+		numnds=nextConstraint->NumberNodes();
+		for(i=1;i<=numnds;i++)
+		{	node1=(nextConstraint->NodalDof(i,nfree)-1)/nfree;
+			nodeLambdas[node1].push_back(nbase+lambda);
+			lambdaNodes[lambda-1].push_back(node1);
+		}
+		nextConstraint=(Constraint *)nextConstraint->GetNextObject();
+	}
+	for(i=0;i<nnodes;i++)
+	{	std::sort(nodeLambdas[i].begin(),nodeLambdas[i].end());
+		nodeLambdas[i].erase(std::unique(nodeLambdas[i].begin(),nodeLambdas[i].end()),nodeLambdas[i].end());
+	}
+	for(i=0;i<numLambdas;i++)
+	{	std::sort(lambdaNodes[i].begin(),lambdaNodes[i].end());
+		lambdaNodes[i].erase(std::unique(lambdaNodes[i].begin(),lambdaNodes[i].end()),lambdaNodes[i].end());
+	}
+
+	// row lengths
+	rowStart=new int[n+2];
+	rowStart[1]=0;
+	int row=1;
+	for(i=0;i<nnodes;i++)
+	{	int rowLength=nfree*(int)nodeCons[i].size()+(int)nodeLambdas[i].size();
+		for(j=0;j<nfree;j++)
+		{	rowStart[row+1]=rowStart[row]+rowLength;
+			row++;
+		}
+	}
+	for(i=0;i<numLambdas;i++)
+	{	rowStart[row+1]=rowStart[row]+nfree*(int)lambdaNodes[i].size()+1;
+		row++;
+	}
+	nnz=rowStart[n+1];
+
+	// fill sorted columns and zero the values
+	cols=new int[nnz];
+	vals=new double[nnz];
+	for(i=0;i<nnz;i++) vals[i]=0.;
+	row=1;
+	for(i=0;i<nnodes;i++)
+	{	for(j=0;j<nfree;j++)
+		{	int k=rowStart[row];
+			unsigned m;
+			for(m=0;m<nodeCons[i].size();m++)
+			{	int jj;
+				for(jj=1;jj<=nfree;jj++) cols[k++]=nfree*nodeCons[i][m]+jj;
+			}
+			for(m=0;m<nodeLambdas[i].size();m++) cols[k++]=nodeLambdas[i][m];
+			row++;
+		}
+	}
+	for(i=0;i<numLambdas;i++)
+	{	int k=rowStart[row];
+		unsigned m;
+		for(m=0;m<lambdaNodes[i].size();m++)
+		{	int jj;
+			for(jj=1;jj<=nfree;jj++) cols[k++]=nfree*lambdaNodes[i][m]+jj;
+		}
+		cols[k]=row;
+		row++;
+	}
+}
+
+// Add to Kij and Kji (once if i==j)
+// throws CommonException()
+void SparseMatrix::AddValue(int i,int j,double value)
+{
+	double *kij=Entry(i,j);
+	if(kij==NULL)
+		throw CommonException("Stiffness matrix term is outside the sparse matrix pattern","SparseMatrix::AddValue");
+	*kij+=value;
+	if(i!=j) *Entry(j,i)+=value;
+}
+
+// pointer to Kij or NULL if not in the pattern
+double *SparseMatrix::Entry(int i,int j)
+{
+	int *first=&cols[rowStart[i]];
+	int *last=&cols[rowStart[i+1]];
+	int *found=std::lower_bound(first,last,j);
+	if(found==last || *found!=j) return NULL;
+	return &vals[found-cols];
+}
+
+// Fix DOF i to value (same steps as NodalDispBC::FixOrRotate() for band matrix)
+// rm has nrhs right sides, each n+1 long
+void SparseMatrix::FixDof(int i,double value,double *rm,int nrhs)
+{
+	int k,j,c;
+	for(k=rowStart[i];k<rowStart[i+1];k++)
+	{	j=cols[k];
+		if(j==i)
+		{	vals[k]=1.;
+			continue;
+		}
+
+		// subtract value*col(i) from right sides and zero row and column i
+		if(value!=0.)
+		{	for(c=0;c<nrhs;c++) rm[c*(n+1)+j]-=value*vals[k];
+		}
+		vals[k]=0.;
+		*Entry(j,i)=0.;
+	}
+	for(c=0;c<nrhs;c++) rm[c*(n+1)+i]=value;
+}
+
+// Rotate DOFs ii and jj of one node by angle (in radians)
+// (same steps as NodalDispBC::FixOrRotate() for band matrix)
+// rm has nrhs right sides, each n+1 long
+void SparseMatrix::RotateDofs(int ii,int jj,double skew,double *rm,int nrhs)
+{
+	double cs=cos(skew);
+	double c2=cs*cs;
+	double sn=sin(skew);
+	double s2=sn*sn;
+	double cssn=cs*sn;
+
+	// Form TKTt in rows and columns ii and jj (except diagonal terms)
+	// Rows ii and jj have the same columns in the pattern
+	int k,kj=rowStart[jj],j;
+	for(k=rowStart[ii];k<rowStart[ii+1];k++)
+	{	j=cols[k];
+		if(j!=ii && j!=jj)
+		{	double siij=vals[k];
+			double sjjj=vals[kj];
+			vals[k]=cs*siij-sn*sjjj;
+			vals[kj]=sn*siij+cs*sjjj;
+			*Entry(j,ii)=vals[k];
+			*Entry(j,jj)=vals[kj];
+		}
+		kj++;
+	}
+
+	// Do diagonal terms
+	double *kiiii=Entry(ii,ii);
+	double *kiijj=Entry(ii,jj);
+	double *kjjjj=Entry(jj,jj);
+	double siiii=*kiiii;
+	double siijj=*kiijj;
+	double sjjjj=*kjjjj;
+	*kiiii=siiii*c2+sjjjj*s2-2*siijj*cssn;
+	*kjjjj=siiii*s2+sjjjj*c2+2*siijj*cssn;
+	*kiijj=(siiii-sjjjj)*cssn+siijj*(c2-s2);
+	*Entry(jj,ii)=*kiijj;
+
+	// Transform right side vectors
+	for(k=0;k<nrhs;k++)
+	{	double *r=&rm[k*(n+1)];
+		double rii=r[ii];
+		double rjj=r[jj];
+		r[ii]=rii*cs-rjj*sn;
+		r[jj]=rii*sn+rjj*cs;
+	}
+}
+
+#pragma mark SparseMatrix: Skyline Solver
+
+/********************************************************************************
+	Reorder and factor into LDL^T in skyline storage
+	Input parameters
+		nbase: number of DOFs to reorder (the rest are Lagrange multipliers)
+	Output parameters
+		return value: 0 if no errors
+				-1 if reduction is getting too severe
+				 1 if diagonal is 0
+	The sparse matrix values are released once copied into the skyline.
+	throws CommonException()
+********************************************************************************/
+
+int SparseMatrix::FactorSkyline(int nbase)
+{
+	int i,j,k,ierr=0;
+
+	// new equation order
+	perm=new int[n];
+	ReverseCuthillMcKee(nbase);
+	for(i=nbase;i<n;i++) perm[i]=i;
+	int *iperm=new int[n];
+	for(i=0;i<n;i++) iperm[perm[i]]=i;
+
+	// first row in each column of the reordered matrix (exact zeros left by BCs are skipped)
+	top=new int[n];
+	for(j=0;j<n;j++)
+	{	int row=perm[j]+1;
+		top[j]=j;
+		for(k=rowStart[row];k<rowStart[row+1];k++)
+		{	if(vals[k]==0.) continue;
+			i=iperm[cols[k]-1];
+			if(i<top[j]) top[j]=i;
+		}
+	}
+	colPtr=new long[n+1];
+	colPtr[0]=0;
+	for(j=0;j<n;j++) colPtr[j+1]=colPtr[j]+(long)(j-top[j]+1);
+
+	// copy upper half into the skyline
+	sky=(double *)malloc(sizeof(double)*colPtr[n]);
+	if(sky==NULL)
+	{	delete [] iperm;
+		throw CommonException("Memory error allocating skyline matrix","SparseMatrix::FactorSkyline");
+	}
+	for(long m=0;m<colPtr[n];m++) sky[m]=0.;
+	double *work=new double[n];
+	for(j=0;j<n;j++)
+	{	int row=perm[j]+1;
+		for(k=rowStart[row];k<rowStart[row+1];k++)
+		{	i=iperm[cols[k]-1];
+			if(i<=j && vals[k]!=0.) sky[colPtr[j]+i-top[j]]=vals[k];
+		}
+		work[j]=sky[colPtr[j+1]-1];
+	}
+	delete [] iperm;
+	delete [] cols;
+	cols=NULL;
+	delete [] vals;
+	vals=NULL;
+
+	// Crout reduction by columns. Column j holds U(i,j) for top[j] <= i < j and D(j) in row j
+	// Rows above a block of columns only need finished columns, so the columns in the block
+	// are reduced in parallel for those rows. The rest of each column is then done in order.
+	for(int j0=0;j0<n && ierr<=0;j0+=COLUMN_BLOCK)
+	{	int j1 = j0+COLUMN_BLOCK<n ? j0+COLUMN_BLOCK : n;
+		
+#pragma omp parallel for schedule(dynamic)
+		for(int jb=j0;jb<j1;jb++)
+			ReduceSkylineRows(jb,top[jb]+1,j0);
+		
+		for(j=j0;j<j1;j++)
+		{	double *colj=&sky[colPtr[j]]-top[j];
+			
+			// rows in this block
+			ReduceSkylineRows(j,top[j]+1>j0 ? top[j]+1 : j0,j);
+
+			// U(i,j) = g(i,j)/D(i) and D(j) = K(j,j) - sum U(i,j) g(i,j)
+			double dj=colj[j];
+			for(i=top[j];i<j;i++)
+			{	double gij=colj[i];
+				colj[i]=gij/sky[colPtr[i+1]-1];
+				dj-=gij*colj[i];
+			}
+
+			// check for singular or over reduced matrix
+			if(dj==0.)
+			{	ierr=1;
+				break;
+			}
+			else if(work[j]!=0.)
+			{	if(fabs(dj/work[j])<1.e-12) ierr=-1;
+			}
+			colj[j]=dj;
+		}
+	}
+
+	delete [] work;
+	return ierr;
+}
+
+// g(i,j) = K(i,j) - sum(k<i) U(k,i) g(k,j) in column j for rows first to last-1
+// (columns of those rows must be finished)
+void SparseMatrix::ReduceSkylineRows(int j,int first,int last)
+{
+	double *colj=&sky[colPtr[j]]-top[j];
+	for(int i=first;i<last;i++)
+	{	double *coli=&sky[colPtr[i]]-top[i];
+		int kmin = top[i]>top[j] ? top[i] : top[j];
+		double sum=0.;
+		for(int k=kmin;k<i;k++) sum+=coli[k]*colj[k];
+		colj[i]-=sum;
+	}
+}
+
+/********************************************************************************
+	Solve using the factored skyline matrix for nrhs right sides in r, each
+	n+1 long (1 based). Right sides are on input and solutions on output.
+	Right sides are solved in blocks of up to RHS_BLOCK interleaved vectors
+	so each factor column is read once per block, and blocks are solved in
+	parallel.
+********************************************************************************/
+
+void SparseMatrix::SolveSkyline(double *r,int nrhs)
+{
+	int nblocks=(nrhs+RHS_BLOCK-1)/RHS_BLOCK;
+	
+#pragma omp parallel for if(nblocks>1)
+	for(int b=0;b<nblocks;b++)
+	{	int c0=b*RHS_BLOCK;
+		int nc=nrhs-c0<RHS_BLOCK ? nrhs-c0 : RHS_BLOCK;
+		if(nc==1)
+			SolveSkylineOne(&r[c0*(n+1)]);
+		else
+			SolveSkylineBlock(&r[c0*(n+1)],nc);
+	}
+}
+
+// Solve one right side r (1 based)
+void SparseMatrix::SolveSkylineOne(double *r)
+{
+	int i,j;
+	double *x=new double[n];
+	for(j=0;j<n;j++) x[j]=r[perm[j]+1];
+
+	// forward reduction for L y = r
+	for(j=0;j<n;j++)
+	{	double *colj=&sky[colPtr[j]]-top[j];
+		double sum=0.;
+		for(int k=top[j];k<j;k++) sum+=colj[k]*x[k];
+		x[j]-=sum;
+	}
+
+	// diagonal
+	for(j=0;j<n;j++) x[j]/=sky[colPtr[j+1]-1];
+
+	// back substitution for L^T x = y/D
+	for(j=n-1;j>0;j--)
+	{	double *colj=&sky[colPtr[j]]-top[j];
+		double xj=x[j];
+		if(xj==0.) continue;
+		for(i=top[j];i<j;i++) x[i]-=colj[i]*xj;
+	}
+
+	for(j=0;j<n;j++) r[perm[j]+1]=x[j];
+	delete [] x;
+}
+
+// Solve nc right sides in r (each n+1 long) with one pass through the factor
+void SparseMatrix::SolveSkylineBlock(double *r,int nc)
+{
+	int i,j,k,c;
+	double sum[RHS_BLOCK];
+	
+	// x[j*nc+c] is permuted equation j of right side c
+	double *x=new double[n*nc];
+	for(j=0;j<n;j++)
+	{	for(c=0;c<nc;c++) x[j*nc+c]=r[c*(n+1)+perm[j]+1];
+	}
+
+	// forward reduction for L y = r
+	for(j=0;j<n;j++)
+	{	double *colj=&sky[colPtr[j]]-top[j];
+		for(c=0;c<nc;c++) sum[c]=0.;
+		for(k=top[j];k<j;k++)
+		{	double ljk=colj[k];
+			if(ljk==0.) continue;
+			for(c=0;c<nc;c++) sum[c]+=ljk*x[k*nc+c];
+		}
+		for(c=0;c<nc;c++) x[j*nc+c]-=sum[c];
+	}
+
+	// diagonal
+	for(j=0;j<n;j++)
+	{	double dj=sky[colPtr[j+1]-1];
+		for(c=0;c<nc;c++) x[j*nc+c]/=dj;
+	}
+
+	// back substitution for L^T x = y/D
+	for(j=n-1;j>0;j--)
+	{	double *colj=&sky[colPtr[j]]-top[j];
+		double *xj=&x[j*nc];
+		for(i=top[j];i<j;i++)
+		{	double lij=colj[i];
+			if(lij==0.) continue;
+			for(c=0;c<nc;c++) x[i*nc+c]-=lij*xj[c];
+		}
+	}
+
+	for(j=0;j<n;j++)
+	{	for(c=0;c<nc;c++) r[c*(n+1)+perm[j]+1]=x[j*nc+c];
+	}
+	delete [] x;
+}
+
+/********************************************************************************
+	Reverse Cuthill-McKee order of the first nbase DOFs into perm[] (0 based)
+	Each connected component starts from a pseudo-peripheral DOF found by
+	repeated level structures (George and Liu) and neighbors are numbered
+	in order of increasing degree
+********************************************************************************/
+
+void SparseMatrix::ReverseCuthillMcKee(int nbase)
+{
+	int i,k,numbered=0;
+
+	// degree within the reordered DOFs
+	int *degree=new int[nbase];
+	for(i=0;i<nbase;i++)
+	{	degree[i]=0;
+		for(k=rowStart[i+1];k<rowStart[i+2];k++)
+		{	if(cols[k]<=nbase && cols[k]!=i+1) degree[i]++;
+		}
+	}
+
+	int *mask=new int[nbase];		// 0 if numbered, otherwise stamp of last visit
+	for(i=0;i<nbase;i++) mask[i]=1;
+	int *levelList=new int[nbase+2];
+	int stamp=1;
+
+	while(numbered<nbase)
+	{	// start from lowest degree remaining DOF
+		int root=-1;
+		for(i=0;i<nbase;i++)
+		{	if(mask[i]==0) continue;
+			if(root<0 || degree[i]<degree[root]) root=i;
+		}
+
+		// move to pseudo-peripheral DOF
+		int numLevels=BuildLevels(root,nbase,rowStart,cols,mask,levelList,++stamp);
+		while(TRUE)
+		{	// last level starts after largest index with lower level, find its minimum degree DOF
+			int count=levelList[0];
+			int lastStart=levelList[1];
+			int newRoot=levelList[lastStart+2];
+			for(i=lastStart+1;i<count;i++)
+			{	if(degree[levelList[i+2]]<degree[newRoot]) newRoot=levelList[i+2];
+			}
+			int newLevels=BuildLevels(newRoot,nbase,rowStart,cols,mask,levelList,++stamp);
+			if(newLevels<=numLevels) break;
+			root=newRoot;
+			numLevels=newLevels;
+		}
+
+		// Cuthill-McKee numbering from root
+		int head=numbered;
+		perm[numbered++]=root;
+		mask[root]=0;
+		while(head<numbered)
+		{	int dof=perm[head++];
+			int start=numbered;
+			for(k=rowStart[dof+1];k<rowStart[dof+2];k++)
+			{	int nbr=cols[k]-1;
+				if(nbr>=nbase || mask[nbr]==0) continue;
+				perm[numbered++]=nbr;
+				mask[nbr]=0;
+			}
+
+			// insertion sort new DOFs by degree
+			for(i=start+1;i<numbered;i++)
+			{	int next=perm[i];
+				int j=i-1;
+				while(j>=start && degree[perm[j]]>degree[next])
+				{	perm[j+1]=perm[j];
+					j--;
+				}
+				perm[j+1]=next;
+			}
+		}
+	}
+
+	// reverse
+	for(i=0;i<nbase/2;i++)
+	{	k=perm[i];
+		perm[i]=perm[nbase-1-i];
+		perm[nbase-1-i]=k;
+	}
+
+	delete [] degree;
+	delete [] mask;
+	delete [] levelList;
+}
+
+/********************************************************************************
+	Level structure of component containing root among DOFs not yet numbered
+	On output levelList[0] is number of DOFs in the component, levelList[1]
+	is start of last level, and levelList[2...] are the DOFs by level
+	return value is number of levels
+********************************************************************************/
+
+static int BuildLevels(int root,int nbase,int *rowStart,int *cols,int *mask,int *levelList,int stamp)
+{
+	int *list=&levelList[2];
+	int count=0,levelStart=0,numLevels=0;
+	list[count++]=root;
+	mask[root]=stamp;
+	while(levelStart<count)
+	{	int levelEnd=count;
+		numLevels++;
+		levelList[1]=levelStart;
+		int i;
+		for(i=levelStart;i<levelEnd;i++)
+		{	int k,dof=list[i];
+			for(k=rowStart[dof+1];k<rowStart[dof+2];k++)
+			{	int nbr=cols[k]-1;
+				if(nbr>=nbase || mask[nbr]==0 || mask[nbr]==stamp) continue;
+				mask[nbr]=stamp;
+				list[count++]=nbr;
+			}
+		}
+		levelStart=levelEnd;
+	}
+	levelList[0]=count;
+	return numLevels;
+}
+
+#pragma mark SparseMatrix: PCG Solver
+
+/********************************************************************************
+	Incomplete Cholesky factor, IC(0), on lower half of matrix pattern
+	If a pivot is not positive, the diagonal is shifted by (1+shift) and
+		factorization restarted (Manteuffel shift)
+	Rows in one level only use rows in previous levels and are factored
+		in parallel
+	return value: 0 if no errors or 1 if matrix could not be factored
+********************************************************************************/
+
+int SparseMatrix::FactorIncompleteCholesky(void)
+{
+	int i;
+
+	// lower half of each row (columns are sorted, diagonal is last)
+	lowerStart=new int[n+2];
+	lowerStart[1]=0;
+	for(i=1;i<=n;i++)
+	{	int k=rowStart[i];
+		while(k<rowStart[i+1] && cols[k]<=i) k++;
+		lowerStart[i+1]=lowerStart[i]+k-rowStart[i];
+	}
+	lvals=new double[lowerStart[n+1]];
+	FindSolveLevels();
+
+	shift=0.;
+	while(TRUE)
+	{	int failed=0;
+#pragma omp parallel if(parallelLevels)
+		{	for(int l=0;l<numLevels;l++)
+			{
+#pragma omp for
+				for(int m=levelStart[l];m<levelStart[l+1];m++)
+				{	int row=levelRows[m];
+					int ri=rowStart[row];
+					int rlen=lowerStart[row+1]-lowerStart[row]-1;		// off-diagonal terms
+					double *li=&lvals[lowerStart[row]];
+					for(int p=0;p<rlen;p++)
+					{	// L(i,j) = (K(i,j) - sum(k<j) L(i,k)L(j,k))/L(j,j) on common pattern
+						int j=cols[ri+p];
+						int rj=rowStart[j];
+						int jlen=lowerStart[j+1]-lowerStart[j]-1;
+						double *lj=&lvals[lowerStart[j]];
+						double sum=0.;
+						int a=0,b=0;
+						while(a<p && b<jlen)
+						{	if(cols[ri+a]==cols[rj+b])
+							{	sum+=li[a]*lj[b];
+								a++;
+								b++;
+							}
+							else if(cols[ri+a]<cols[rj+b])
+								a++;
+							else
+								b++;
+						}
+						li[p]=(vals[ri+p]-sum)/lj[jlen];
+					}
+
+					// diagonal (if fails, finish the pass with unit diagonal and try again)
+					double d=vals[ri+rlen]*(1.+shift);
+					for(int p=0;p<rlen;p++) d-=li[p]*li[p];
+					if(d<=0.)
+					{
+#pragma omp atomic write
+						failed=1;
+						d=1.;
+					}
+					li[rlen]=sqrt(d);
+				}
+			}
+		}
+		if(!failed) break;
+
+		// try again with larger shift
+		shift = shift==0. ? 1.e-3 : 2.*shift;
+		if(shift>1.) return 1;
+	}
+	
+	// copy to rows of L^T, row k of L has the upper half entries in column k of L^T
+	// and rows are visited in order so they fill in order of sorted columns
+	uvals=new double[rowStart[n+1]-lowerStart[n+1]];
+	int *nextUpper=new int[n+1];
+	for(i=1;i<=n;i++) nextUpper[i]=rowStart[i]-lowerStart[i];
+	for(int k=1;k<=n;k++)
+	{	int rlen=lowerStart[k+1]-lowerStart[k]-1;
+		for(int p=0;p<rlen;p++)
+			uvals[nextUpper[cols[rowStart[k]+p]]++]=lvals[lowerStart[k]+p];
+	}
+	delete [] nextUpper;
+	
+	return 0;
+}
+
+/********************************************************************************
+	Solve by conjugate gradients preconditioned by IC(0)
+	Input parameters
+		b: right hand side (1 based)
+		tol: converge when |r| < tol |b|
+		maxIter: maximum number of iterations
+	Output parameters
+		b: solution
+		return value: 0 if converged
+				-1 if did not converge in maxIter iterations
+				 1 if matrix is not positive definite
+	Call FactorIncompleteCholesky() first
+********************************************************************************/
+
+int SparseMatrix::SolvePCG(double *b,double tol,int maxIter)
+{
+	int i,ierr=-1;
+	double *x=new double[n+1];
+	double *r=new double[n+1];
+	double *z=new double[n+1];
+	double *p=new double[n+1];
+	double *q=new double[n+1];
+
+	for(i=1;i<=n;i++)
+	{	x[i]=0.;
+		r[i]=b[i];
+	}
+	double bnorm=sqrt(DotProduct(&b[1],&b[1],n));
+	double rnorm=bnorm;
+	iterations=0;
+	if(bnorm==0.) ierr=0;
+
+	if(ierr!=0)
+	{	PreconditionerSolve(r,z);
+		for(i=1;i<=n;i++) p[i]=z[i];
+		double rz=DotProduct(&r[1],&z[1],n);
+
+		for(iterations=1;iterations<=maxIter;iterations++)
+		{	MatrixTimesVector(p,q);
+			double pq=DotProduct(&p[1],&q[1],n);
+			if(pq<=0.)
+			{	ierr=1;
+				break;
+			}
+			double alpha=rz/pq;
+#pragma omp parallel for
+			for(int ii=1;ii<=n;ii++)
+			{	x[ii]+=alpha*p[ii];
+				r[ii]-=alpha*q[ii];
+			}
+
+			// converged?
+			rnorm=sqrt(DotProduct(&r[1],&r[1],n));
+			if(rnorm<=tol*bnorm)
+			{	ierr=0;
+				break;
+			}
+
+			// next search direction
+			PreconditionerSolve(r,z);
+			double rznew=DotProduct(&r[1],&z[1],n);
+			double beta=rznew/rz;
+			rz=rznew;
+#pragma omp parallel for
+			for(int ii=1;ii<=n;ii++) p[ii]=z[ii]+beta*p[ii];
+		}
+		if(iterations>maxIter) iterations=maxIter;
+	}
+
+	residual = bnorm>0. ? rnorm/bnorm : 0.;
+	for(i=1;i<=n;i++) b[i]=x[i];
+
+	delete [] x;
+	delete [] r;
+	delete [] z;
+	delete [] p;
+	delete [] q;
+
+	return ierr;
+}
+
+// Find z = (L L^T)^-1 r using IC(0) factor (both 1 based)
+// Each solve is done by levels of independent rows
+void SparseMatrix::PreconditionerSolve(double *r,double *z)
+{
+#pragma omp parallel if(parallelLevels)
+	{	// L y = r
+		for(int l=0;l<numLevels;l++)
+		{
+#pragma omp for
+			for(int m=levelStart[l];m<levelStart[l+1];m++)
+			{	int i=levelRows[m];
+				int ri=rowStart[i];
+				int rlen=lowerStart[i+1]-lowerStart[i]-1;
+				double *li=&lvals[lowerStart[i]];
+				double sum=r[i];
+				for(int p=0;p<rlen;p++) sum-=li[p]*z[cols[ri+p]];
+				z[i]=sum/li[rlen];
+			}
+		}
+
+		// L^T z = y using rows of L^T (upper half of the pattern)
+		for(int l=0;l<numUpperLevels;l++)
+		{
+#pragma omp for
+			for(int m=upperLevelStart[l];m<upperLevelStart[l+1];m++)
+			{	int i=upperLevelRows[m];
+				int diag=rowStart[i]+lowerStart[i+1]-lowerStart[i]-1;
+				double *ui=&uvals[rowStart[i]-lowerStart[i]]-diag-1;
+				double sum=z[i];
+				for(int k=diag+1;k<rowStart[i+1];k++) sum-=ui[k]*z[cols[k]];
+				z[i]=sum/lvals[lowerStart[i+1]-1];
+			}
+		}
+	}
+}
+
+// Sort rows into levels for the IC(0) factorization and triangular solves. A row of L
+// depends only on rows of its lower pattern and a row of L^T only on its upper pattern.
+// When levels are too small for threads, use one level in natural order.
+void SparseMatrix::FindSolveLevels(void)
+{
+	int i,k;
+	int *level=new int[n+1];
+	
+	// forward: level(i) = 1 + max level of lower columns
+	numLevels=0;
+	for(i=1;i<=n;i++)
+	{	int lev=0;
+		for(k=rowStart[i];k<rowStart[i]+lowerStart[i+1]-lowerStart[i]-1;k++)
+		{	if(level[cols[k]]+1>lev) lev=level[cols[k]]+1;
+		}
+		level[i]=lev;
+		if(lev+1>numLevels) numLevels=lev+1;
+	}
+	parallelLevels = omp_get_max_threads()>1 && n>=PARALLEL_LEVEL*numLevels;
+	if(!parallelLevels)
+	{	for(i=1;i<=n;i++) level[i]=0;
+		numLevels=1;
+	}
+	levelStart=new int[numLevels+1];
+	levelRows=new int[n];
+	SortLevels(level,numLevels,levelStart,levelRows,n);
+	
+	// backward: level(i) = 1 + max level of upper columns
+	if(parallelLevels)
+	{	numUpperLevels=0;
+		for(i=n;i>=1;i--)
+		{	int lev=0;
+			for(k=rowStart[i]+lowerStart[i+1]-lowerStart[i];k<rowStart[i+1];k++)
+			{	if(level[cols[k]]+1>lev) lev=level[cols[k]]+1;
+			}
+			level[i]=lev;
+			if(lev+1>numUpperLevels) numUpperLevels=lev+1;
+		}
+		upperLevelStart=new int[numUpperLevels+1];
+		upperLevelRows=new int[n];
+		SortLevels(level,numUpperLevels,upperLevelStart,upperLevelRows,n);
+	}
+	else
+	{	numUpperLevels=1;
+		upperLevelStart=new int[2];
+		upperLevelStart[0]=0;
+		upperLevelStart[1]=n;
+		upperLevelRows=new int[n];
+		for(i=0;i<n;i++) upperLevelRows[i]=n-i;
+	}
+	delete [] level;
+}
+
+// Counting sort of rows 1 to n by level (rows stay in order within each level)
+static void SortLevels(int *level,int nlevels,int *start,int *rows,int n)
+{
+	int l,i;
+	for(l=0;l<=nlevels;l++) start[l]=0;
+	for(i=1;i<=n;i++) start[level[i]+1]++;
+	for(l=0;l<nlevels;l++) start[l+1]+=start[l];
+	int *next=new int[nlevels];
+	for(l=0;l<nlevels;l++) next[l]=start[l];
+	for(i=1;i<=n;i++) rows[next[level[i]]++]=i;
+	delete [] next;
+}
+
+// y = K x (both 1 based)
+void SparseMatrix::MatrixTimesVector(double *x,double *y)
+{
+#pragma omp parallel for
+	for(int i=1;i<=n;i++)
+	{	double sum=0.;
+		for(int k=rowStart[i];k<rowStart[i+1];k++)
+			sum+=vals[k]*x[cols[k]];
+		y[i]=sum;
+	}
+}
+
+// dot product of two vectors of length n
+static double DotProduct(double *a,double *b,int n)
+{
+	double sum=0.;
+#pragma omp parallel for reduction(+:sum)
+	for(int i=0;i<n;i++) sum+=a[i]*b[i];
+	return sum;
+}
+
+#pragma mark SparseMatrix: Accessors
+
+// number of nonzeros in upper half of K including diagonal
+int SparseMatrix::GetNumberNonzeros(void) { return (nnz+n)/2; }
+
+// memory for sparse matrix (in MB)
+double SparseMatrix::MatrixMemory(void)
+{	return ((double)nnz*(sizeof(int)+sizeof(double)) + (double)(n+2)*sizeof(int))/1048576.;
+}
+
+// memory for skyline or IC(0) factor (in MB)
+double SparseMatrix::FactorMemory(void)
+{	if(sky!=NULL)
+		return ((double)colPtr[n]*sizeof(double) + (double)n*(2*sizeof(int)+sizeof(long)))/1048576.;
+	else if(lvals!=NULL)
+		return ((double)rowStart[n+1]*sizeof(double) + (double)(3*n+numLevels+numUpperLevels+4)*sizeof(int))/1048576.;
+	return 0.;
+}
+
+// number of terms in the factor
+double SparseMatrix::FactorNonzeros(void)
+{	if(sky!=NULL)
+		return (double)colPtr[n];
+	else if(lvals!=NULL)
+		return (double)lowerStart[n+1];
+	return 0.;
+}
+
+int SparseMatrix::GetIterations(void) { return iterations; }
+double SparseMatrix::GetResidual(void) { return residual; }
+double SparseMatrix::GetShift(void) { return shift; }
@@ -0,0 +1,88 @@
+/********************************************************************************
+    SparseMatrix.hpp
+    NairnFEA
+
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	The global stiffness matrix in compressed sparse row (CSR) storage for
+	the sparse linear solvers. The full symmetric matrix is stored (both
+	halves) so displacement BCs and matrix-vector products can work by rows.
+	All row and column indices are 1 based to match rm[] and st[][].
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _SPARSEMATRIX_
+
+#define _SPARSEMATRIX_
+
+class SparseMatrix
+{
+    public:
+
+        //  Constructors and Destructor
+		SparseMatrix(int);
+		~SparseMatrix();
+
+		// assembly
+		void BuildPattern(int,int);
+		void AddValue(int,int,double);
+		double *Entry(int,int);
+		void FixDof(int,double,double *,int);
+		void RotateDofs(int,int,double,double *,int);
+
+		// solvers
+		int FactorSkyline(int);
+		void SolveSkyline(double *,int);
+		int FactorIncompleteCholesky(void);
+		int SolvePCG(double *,double,int);
+		void MatrixTimesVector(double *,double *);
+
+		// accessors
+		int GetNumberNonzeros(void);
+		double MatrixMemory(void);
+		double FactorMemory(void);
+		double FactorNonzeros(void);
+		int GetIterations(void);
+		double GetResidual(void);
+		double GetShift(void);
+
+	private:
+		int n;						// number of equations
+		int nnz;					// number of stored nonzeros (both halves)
+		int *rowStart;				// row i in cols[rowStart[i]] to cols[rowStart[i+1]-1]
+		int *cols;					// sorted column indices in each row
+		double *vals;				// values matching cols[]
+
+		// skyline factorization in reordered equations (0 based)
+		int *perm;					// perm[new]=old (0 based)
+		int *top;					// first row in each skyline column
+		long *colPtr;				// start of each column in sky[]
+		double *sky;				// reduced columns with D on the diagonal
+
+		// incomplete Cholesky preconditioner on lower half pattern
+		int *lowerStart;			// row i of L in lvals[lowerStart[i]] to lvals[lowerStart[i+1]-1]
+		double *lvals;				// L values matching first entries of each row in cols[]
+		int numLevels;				// levels of independent rows in L
+		int *levelStart;			// level l in levelRows[levelStart[l]] to levelRows[levelStart[l+1]-1]
+		int *levelRows;				// rows of L sorted by level
+		int numUpperLevels;			// levels of independent rows in L^T
+		int *upperLevelStart;
+		int *upperLevelRows;
+		double *uvals;				// L^T values matching upper half entries of each row in cols[]
+		bool parallelLevels;		// true if levels are done in parallel
+		double shift;				// diagonal shift needed for IC(0)
+		int iterations;				// PCG iterations used
+		double residual;			// final relative residual
+
+		void ReverseCuthillMcKee(int);
+		void ReduceSkylineRows(int,int,int);
+		void SolveSkylineOne(double *);
+		void SolveSkylineBlock(double *,int);
+		void FindSolveLevels(void);
+		void PreconditionerSolve(double *,double *);
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include "Read_FEA/NodalLoadController.hpp"
 #include "Read_FEA/ConstraintController.hpp"
 #include "Boundary_Conditions/Constraint.hpp"
+#include "Boundary_Conditions/LoadCase.hpp"
 #include <algorithm>
 
 #define MAX_CONNECTIVITY 41
@@ -44,6 +45,10 @@ typedef struct {
 FEAReadHandler::FEAReadHandler()
 {
 	resequence=-1;
+	currentCase=NULL;
+	loadCaseCtrl=NULL;
+	baseLoadCtrl=NULL;
+	baseEdgeCtrl=NULL;
 }
 
 FEAReadHandler::~FEAReadHandler()
@@ -101,6 +106,32 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
          input=OUTFLAGS_BLOCK;
     }
     
+	// Select linear solver
+    else if(strcmp(xName,"Solver")==0)
+	{	ValidateCommand(xName,HEADER,MUST_BE_2D);
+    	numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   value=XMLString::transcode(attrs.getValue(i));
+            aName=XMLString::transcode(attrs.getLocalName(i));
+            if(strcmp(aName,"type")==0)
+			{	if(strcmp(value,"band")==0)
+					fmobj->solverType=BAND_SOLVER;
+				else if(strcmp(value,"skyline")==0)
+					fmobj->solverType=SKYLINE_SOLVER;
+				else if(strcmp(value,"pcg")==0)
+					fmobj->solverType=PCG_SOLVER;
+				else
+					throw SAXException("<Solver> type must be band, skyline, or pcg.");
+			}
+            else if(strcmp(aName,"tolerance")==0)
+				sscanf(value,"%lf",&fmobj->solverTolerance);
+            else if(strcmp(aName,"maxiter")==0)
+				sscanf(value,"%d",&fmobj->solverMaxIterations);
+            delete [] aName;
+            delete [] value;
+        }
+	}
+    
 	// Select a node for output when explicitly listed
     else if(strcmp(xName,"Select")==0)
 	{	ValidateCommand(xName,HEADER,MUST_BE_2D);
@@ -332,6 +363,36 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
 		dispBCCtrl=new NodalDispBCController();		// deleted when GridBCs ends
 		loadBCCtrl=new NodalLoadController();		// deleted when GridBCs ends
 		edgeBCCtrl=new EdgeBCController();			// deleted when GridBCs ends
+		loadCaseCtrl=new ParseController();			// deleted when GridBCs ends
+    }
+	
+	// Start a load case (loads in it go to the case until it ends)
+    else if(strcmp(xName,"LoadCase")==0)
+	{	ValidateCommand(xName,GRIDBCHEADER,MUST_BE_2D);
+		if(currentCase!=NULL)
+			throw SAXException("<LoadCase> elements cannot be nested");
+		char *caseName=NULL;
+        numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   aName=XMLString::transcode(attrs.getLocalName(i));
+            value=XMLString::transcode(attrs.getValue(i));
+            if(strcmp(aName,"name")==0)
+			{	if(caseName!=NULL) delete [] caseName;
+				caseName=new char[strlen(value)+1];
+				strcpy(caseName,value);
+			}
+            delete [] aName;
+            delete [] value;
+        }
+		currentCase=new LoadCase(loadCaseCtrl->numObjects+1,caseName);
+		loadCaseCtrl->AddObject(currentCase);
+		if(caseName!=NULL) delete [] caseName;
+		
+		// case loads collected in new controllers (deleted when LoadCase ends)
+		baseLoadCtrl=loadBCCtrl;
+		baseEdgeCtrl=edgeBCCtrl;
+		loadBCCtrl=new NodalLoadController();
+		edgeBCCtrl=new EdgeBCController();
     }
 	
 	// LoadBCs section
@@ -393,6 +454,8 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
     // Store a line and tolerance into the current line (in theShape)
     else if(strcmp(xName,"BCPt")==0 || strcmp(xName,"Resequence")==0 || strcmp(xName,"Cracktip")==0)
 	{	ValidateCommand(xName,GRIDBCHEADER,MUST_BE_2D);
+		if(currentCase!=NULL && strcmp(xName,"BCPt")!=0)
+			throw SAXException("<Resequence> and <Cracktip> cannot be in a <LoadCase>");
 		if(strcmp(xName,"Cracktip")==0)
 		{	if(dispBCCtrl->numObjects>0 || loadBCCtrl->numObjects>0 || edgeBCCtrl->numObjects>0)
 				throw SAXException("<Cracktip> must be first command in <GridBCs> section");
@@ -451,6 +514,8 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
 	// Set periodic in one direction
     else if(strcmp(xName,"Periodic")==0)
 	{	ValidateCommand(xName,GRIDBCHEADER,MUST_BE_2D);
+		if(currentCase!=NULL)
+			throw SAXException("<Periodic> cannot be in a <LoadCase>");
 		int dof=0;
 		bool fixDu=FALSE,fixDudy=FALSE;
 		double du=0.,dudy=0.;
@@ -518,6 +583,8 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
 	// Set fixed displacement at a node
     else if(strcmp(xName,"fix")==0)
 	{	ValidateCommand(xName,FIXEDNODES,MUST_BE_2D);
+		if(currentCase!=NULL)
+			throw SAXException("Displacement BCs are shared by all load cases and cannot be in a <LoadCase>");
 		int node=0;
 		int dof=0;
     	numAttr=(int)attrs.getLength();
@@ -547,6 +614,8 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
 	{	ValidateCommand(xName,NO_BLOCK,MUST_BE_2D);
     	if(block!=FIXEDNODES && block!=BCSHAPE)
             ValidateCommand(xName,BAD_BLOCK,MUST_BE_2D);
+		if(currentCase!=NULL)
+			throw SAXException("Displacement BCs are shared by all load cases and cannot be in a <LoadCase>");
 		int node=0;
 		int axis=0;
 		double angle=0.;
@@ -651,6 +720,8 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
     // Read into displacements boundary conditions on current line (direction, value or function)
     else if(strcmp(xName,"DisBC")==0)
 	{	ValidateCommand(xName,BCSHAPE,MUST_BE_2D);
+		if(currentCase!=NULL)
+			throw SAXException("Displacement BCs are shared by all load cases and cannot be in a <LoadCase>");
         double disp=0.;
 		int dof=0;
 		char *function=NULL;
@@ -782,9 +853,12 @@ bool FEAReadHandler::myStartElement(char *xName,const Attributes& attrs)
     //-------------------------------------------------------
     // <Thermal> section
     
-	// set temperature expression
+	// set temperature expression (in <Thermal> or for a load case)
     else if(strcmp(xName,"Temperature")==0)
-	{	ValidateCommand(xName,THERMAL,MUST_BE_2D);
+	{	if(currentCase!=NULL)
+			ValidateCommand(xName,GRIDBCHEADER,MUST_BE_2D);
+		else
+			ValidateCommand(xName,THERMAL,MUST_BE_2D);
     	input=TEXT_BLOCK;
         inputID=TEMPERATURE_EXPR;
     }
@@ -820,9 +894,23 @@ void FEAReadHandler::myEndElement(char *xName)
 		firstDispBC=(NodalDispBC *)dispBCCtrl->firstObject;
 		firstLoadBC=(NodalLoad *)loadBCCtrl->firstObject;
 		firstEdgeBC=(EdgeBC *)edgeBCCtrl->firstObject;
+		firstLoadCase=(LoadCase *)loadCaseCtrl->firstObject;
+		numLoadCases=loadCaseCtrl->numObjects;
 		delete dispBCCtrl;
 		delete loadBCCtrl;
 		delete edgeBCCtrl;
+		delete loadCaseCtrl;
+		loadCaseCtrl=NULL;
+	}
+	
+	else if(strcmp(xName,"LoadCase")==0)
+	{	currentCase->firstLoad=(NodalLoad *)loadBCCtrl->firstObject;
+		currentCase->firstEdge=(EdgeBC *)edgeBCCtrl->firstObject;
+		delete loadBCCtrl;
+		delete edgeBCCtrl;
+		loadBCCtrl=baseLoadCtrl;
+		edgeBCCtrl=baseEdgeCtrl;
+		currentCase=NULL;
 	}
 	
 	else if(strcmp(xName,"LoadBCs")==0 || strcmp(xName,"EdgeBCs")==0)
@@ -871,6 +959,10 @@ void FEAReadHandler::myCharacters(char *xData,const unsigned int length)
 	{	case TEXT_BLOCK:
 			switch(inputID)
 			{	case TEMPERATURE_EXPR:
+					if(currentCase!=NULL)
+					{	currentCase->SetTemperatureExpr(xData);
+						break;
+					}
 					if(fmobj->temperatureExpr!=NULL) delete [] fmobj->temperatureExpr;
 					fmobj->temperatureExpr=new char[strlen(xData)+1];
 					strcpy(fmobj->temperatureExpr,xData);
@@ -1091,6 +1183,10 @@ void FEAReadHandler::ResequenceNodes(void)
 	NodalLoad *nextLoad=firstLoadBC;
 	while(nextLoad!=NULL)
 		nextLoad=nextLoad->MapNodes(revMap);
+	
+	LoadCase *nextCase=firstLoadCase;
+	while(nextCase!=NULL)
+		nextCase=nextCase->MapNodes(revMap);
 		
 	Constraint *nextConstraint=firstConstraint;
 	while(nextConstraint!=NULL)
@@ -1597,6 +1693,11 @@ void FEAReadHandler::RemoveEmptyElements(void)
 				nextLoadBC=tempLoadBC;
 			}
 			
+			// nodal loads in load cases
+			LoadCase *nextCase=firstLoadCase;
+			while(nextCase!=NULL)
+				nextCase=nextCase->DecrementNodeNum(nodeNum);
+			
 			// selected nodes
 			for(j=0;j<(int)fmobj->selectedNodes.size();j++)
 			{	if(fmobj->selectedNodes[j]>nodeNum)
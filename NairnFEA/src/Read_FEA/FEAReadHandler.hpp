@@ -18,6 +18,11 @@
 
 #include "Read_XML/CommonReadHandler.hpp"
 
+class LoadCase;
+class ParseController;
+class NodalLoadController;
+class EdgeBCController;
+
 class FEAReadHandler : public CommonReadHandler
 {
     public:
@@ -47,6 +52,10 @@ class FEAReadHandler : public CommonReadHandler
     private:
         int elemMat,resequence;
         double elemAngle,elemThick;
+		LoadCase *currentCase;
+		ParseController *loadCaseCtrl;
+		NodalLoadController *baseLoadCtrl;
+		EdgeBCController *baseEdgeCtrl;
 };
 
 #endif
@@ -27,21 +27,6 @@ BoundaryCondition::BoundaryCondition(int bcStyle,double bcValue,double bcTime)
 	bcID = 0;
 }
 
-// Reuse Rigid properties (subclass set other properties) and return this for calling function use
-// Set using internal units so no need for legacy scaling and always using CONSTANT_VALUE
-BoundaryCondition *BoundaryCondition::SetRigidProperties(int num,int dof,int bcStyle,double bcValue)
-{	// set direction
-    nd[num]->SetFixedDirection(dof);
-    
-    // set other properties
-    nodeNum = num;
-    style = bcStyle;
-    value = bcValue;
-	ftime = 0.;
-	bcID = 0;
-	return (BoundaryCondition *)this;
-}
-
 // Destructor (and it is virtual)
 BoundaryCondition::~BoundaryCondition()
 {	if(function!=NULL) delete function;
@@ -50,7 +35,7 @@ BoundaryCondition::~BoundaryCondition()
 // get set direction
 int BoundaryCondition::GetSetDirection(void) const { return 0; }
 
-// just unset condition, because may want to reuse it, return next one to unset
+// just unset condition, return next one to unset
 BoundaryCondition *BoundaryCondition::UnsetDirection(void)
 {	nd[nodeNum]->UnsetFixedDirection(GetSetDirection());
 	return (BoundaryCondition *)GetNextObject();
@@ -232,3 +217,65 @@ void BoundaryCondition::SetBCOffset(double bcoffset) { offset = bcoffset; }
 double BoundaryCondition::GetBCOffset(void) { return offset; }
 int BoundaryCondition::GetBCStyle(void) { return style; }
 
+
+// true if BC changes nodes other than its own node (then cannot be in parallel loops over nodes)
+bool BoundaryCondition::ChangesOtherNodes(void) const { return false; }
+
+#pragma mark BoundaryCondition: Class Methods
+
+// Group BCs in list starting at firstBC by node for parallel loops
+// Loop over BCs in one group in order matches same node in serial loop over the list
+// Any previous groups are replaced. If any BC changes other nodes, groups->useList is set
+//		to true and no groups are created
+// throws std::bad_alloc
+void BoundaryCondition::GroupByNode(BoundaryCondition *firstBC,NodalBCGroups *groups)
+{
+	// clear previous groups
+	if(groups->groupStart!=NULL) delete [] groups->groupStart;
+	if(groups->bcs!=NULL) delete [] groups->bcs;
+	groups->numGroups = 0;
+	groups->numBCs = 0;
+	groups->groupStart = NULL;
+	groups->bcs = NULL;
+	groups->useList = false;
+	
+	// count BCs on each node
+	int *nodeCount = new int[nnodes+1];
+	for(int i=0;i<=nnodes;i++) nodeCount[i] = 0;
+	BoundaryCondition *nextBC = firstBC;
+	while(nextBC!=NULL)
+	{	if(nextBC->ChangesOtherNodes()) groups->useList = true;
+		nodeCount[nextBC->GetNodeNum()]++;
+		groups->numBCs++;
+		nextBC = (BoundaryCondition *)nextBC->GetNextObject();
+	}
+	if(groups->numBCs==0 || groups->useList)
+	{	delete [] nodeCount;
+		return;
+	}
+	
+	// groups in node order and change counts to first slot on each node
+	for(int i=1;i<=nnodes;i++)
+	{	if(nodeCount[i]>0) groups->numGroups++;
+	}
+	groups->groupStart = new int[groups->numGroups+1];
+	int g = 0, offset = 0;
+	for(int i=1;i<=nnodes;i++)
+	{	if(nodeCount[i]==0) continue;
+		groups->groupStart[g++] = offset;
+		int count = nodeCount[i];
+		nodeCount[i] = offset;
+		offset += count;
+	}
+	groups->groupStart[g] = offset;
+	
+	// fill in list order (which keeps list order within each node)
+	groups->bcs = new BoundaryCondition *[groups->numBCs];
+	nextBC = firstBC;
+	while(nextBC!=NULL)
+	{	groups->bcs[nodeCount[nextBC->GetNodeNum()]++] = nextBC;
+		nextBC = (BoundaryCondition *)nextBC->GetNextObject();
+	}
+	
+	delete [] nodeCount;
+}
@@ -54,6 +54,18 @@ class Expression;
 // loading boundary conditions
 enum {	CONSTANT_VALUE=1,LINEAR_VALUE,SINE_VALUE,COSINE_VALUE,SILENT,FUNCTION_VALUE };
 
+class BoundaryCondition;
+
+// BCs in one list grouped by node for parallel loops over nodes
+// BCs on one node keep their list order
+typedef struct
+{	int numGroups;					// number of nodes with BCs
+	int numBCs;						// total number of BCs
+	int *groupStart;				// BCs on group g are bcs[groupStart[g]] to bcs[groupStart[g+1]-1]
+	BoundaryCondition **bcs;		// BCs sorted by node number
+	bool useList;					// true to loop over list instead (if some BC changes other nodes)
+} NodalBCGroups;
+
 class BoundaryCondition : public LinkedObject
 {
     public:
@@ -63,7 +75,6 @@ class BoundaryCondition : public LinkedObject
 		virtual ~BoundaryCondition();
         virtual int GetSetDirection(void) const;
         virtual BoundaryCondition *UnsetDirection(void);
-		virtual BoundaryCondition *SetRigidProperties(int,int,int,double);
 		
 		// pure virtual
         virtual BoundaryCondition *PrintBC(ostream &);
@@ -93,6 +104,10 @@ class BoundaryCondition : public LinkedObject
 		void SetBCOffset(double);
 		double GetBCOffset(void);
 		int GetBCStyle();
+		virtual bool ChangesOtherNodes(void) const;
+	
+		// class methods
+		static void GroupByNode(BoundaryCondition *,NodalBCGroups *);
 	
 	protected:
 		Expression *function;
@@ -15,14 +15,14 @@
 // Nodal concentration BC globals
 NodalConcBC *firstConcBC=NULL;
 NodalConcBC *lastConcBC=NULL;
-NodalConcBC *firstRigidConcBC=NULL;
-NodalConcBC *reuseRigidConcBC=NULL;
+NodalBCGroups concBCGroups={0,0,NULL,NULL,false};
 
 #pragma mark NodalConcBC: Constructors and Destructors
 
 NodalConcBC::NodalConcBC(int num,int setStyle,double concentration,double argTime)
                     : NodalValueBC(num,setStyle,concentration,argTime)
 {
+	nd[nodeNum]->SetFixedDirection(CONC_DIRECTION);
 }
 
 // print it (if can be used)
@@ -37,8 +37,7 @@ class NodalConcBC: public NodalValueBC
 // variables (changed in MPM time step)
 extern NodalConcBC *firstConcBC;
 extern NodalConcBC *lastConcBC;
-extern NodalConcBC *firstRigidConcBC;
-extern NodalConcBC *reuseRigidConcBC;
+extern NodalBCGroups concBCGroups;
 
 #endif
 
@@ -11,18 +11,19 @@
 #include "Nodes/NodalPoint.hpp"
 #include "Custom_Tasks/ConductionTask.hpp"
 #include "NairnMPM_Class/NairnMPM.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 
 // Nodal temperature BC global
 NodalTempBC *firstTempBC=NULL;
 NodalTempBC *lastTempBC=NULL;
-NodalTempBC *firstRigidTempBC=NULL;
-NodalTempBC *reuseRigidTempBC=NULL;
+NodalBCGroups tempBCGroups={0,0,NULL,NULL,false};
 
 #pragma mark NodalTempBC: Constructors and Destructors
 
 NodalTempBC::NodalTempBC(int num,int setStyle,double temperature,double argTime)
 		: NodalValueBC(num,setStyle,temperature,argTime)
 {
+	nd[nodeNum]->SetFixedDirection(TEMP_DIRECTION);
 	temperatureNoBC = NULL;
 }
 
@@ -85,6 +86,9 @@ double NodalTempBC::TotalHeatReaction(int matchID)
     while(nextBC!=NULL)
 		nextBC=nextBC->AddHeatReaction(&reactionTotal,matchID);
 	
+	// add those set by rigid particles
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->AddHeatReaction(&reactionTotal,matchID);
+	
 	return reactionTotal;
 }
 
@@ -43,8 +43,7 @@ class NodalTempBC: public NodalValueBC
 // variables (changed in MPM time step)
 extern NodalTempBC *firstTempBC;
 extern NodalTempBC *lastTempBC;
-extern NodalTempBC *firstRigidTempBC;
-extern NodalTempBC *reuseRigidTempBC;
+extern NodalBCGroups tempBCGroups;
 
 #endif
 
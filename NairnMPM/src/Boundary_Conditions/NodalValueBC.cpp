@@ -19,7 +19,7 @@ NodalValueBC::NodalValueBC(int num,int setStyle,double concentration,double argT
                 : BoundaryCondition(setStyle,concentration,argTime)
 {
     nodeNum=num;
-    nd[nodeNum]->SetFixedDirection(GetSetDirection());
+	// subclass constructor sets fixed direction (virtual GetSetDirection() not available here)
 }
 
 #pragma mark NodalValueBC: Methods
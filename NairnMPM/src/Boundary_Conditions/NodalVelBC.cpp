@@ -14,12 +14,12 @@
 #include "NairnMPM_Class/MeshInfo.hpp"
 #include "Global_Quantities/BodyForce.hpp"
 #include "NairnMPM_Class/UpdateStrainsFirstTask.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 
 // Nodal velocity BC globals
 NodalVelBC *firstVelocityBC=NULL;
 NodalVelBC *lastVelocityBC=NULL;
-NodalVelBC *firstRigidVelocityBC=NULL;
-NodalVelBC *reuseRigidVelocityBC=NULL;
+NodalBCGroups velocityBCGroups={0,0,NULL,NULL,false};
 
 #pragma mark NodalVelBC::Constructors and Destructors
 
@@ -32,7 +32,6 @@ NodalVelBC::NodalVelBC(int num,int dof,int setStyle,double velocity,double argTi
     nodeNum = num;
 	reflectedNode = -1;
 	reflectRatio = 1.;
-    mirrorSpacing = 0;                      // +1 shift higher nodes, -1 shift lower, 0 no mirroring
     angle1 = ang1;
     angle2 = ang2;
     dir = ConvertToDirectionBits(dof);      // change input settings to x,y,z bits
@@ -43,26 +42,6 @@ NodalVelBC::NodalVelBC(int num,int dof,int setStyle,double velocity,double argTi
 	nd[nodeNum]->SetFixedDirection(dir);		// three bits (1-8) for x, y, z or skewed in 2 or three directions
 }
 
-// Reuse Rigid properties
-// Warning: dof must be BC type and not input type
-BoundaryCondition *NodalVelBC::SetRigidProperties(int num,int dof,int setStyle,double velocity)
-{	// set dir and direction (cannot yet be skewed directions)
-    angle1 = 0.;
-    angle2 = 0.;
-    dir = dof;                          // internal calls already have correct bit settings
-    SetNormalVector();                  // get normal vector depending on dir and angles
-    
-    // old dir==0 was skewed condition, now do by setting two velocities, thus never 0 here
-    // direct set in parent lass		// x, y, or z (1,2,4) directions
-    
-    // not reflected yet
-    reflectedNode = -1;
-    mirrorSpacing = 0;                      // +1 shift higher nodes, -1 shift lower, 0 no mirroring
-	
-	// finish in base class (nodenum set there)
-	return BoundaryCondition::SetRigidProperties(num,dir,setStyle,velocity);
-}
-
 // get set direction
 int NodalVelBC::GetSetDirection(void) const { return dir; }
 
@@ -205,39 +184,6 @@ NodalVelBC *NodalVelBC::AddVelocityBC(double bctime,int passType)
     return (NodalVelBC *)GetNextObject();
 }
 
-// For rigid BC, see if it has a refleceted node
-NodalVelBC *NodalVelBC::SetMirroredVelBC(double bctime)
-{
-    // exit if not doing mirroring
-    if(mirrorSpacing==0) return (NodalVelBC *)GetNextObject();
-    
-    // set if has been activated
-	int i = GetNodeNum(bctime);
-    if(i>0)
-    {   // look at neighbor in mirror direction but only if node i has particles and neighbor is in the grid
-        int neighbor = i+mirrorSpacing;
-        if(nd[i]->NodeHasNonrigidParticles() && neighbor>0 && neighbor<=nnodes)
-        {	// see if neighbor fixes same dof
-            if(nd[neighbor]->fixedDirection&dir)
-            {	// the next node in mirror direction if in the grid
-                int mirror = neighbor+mirrorSpacing;
-
-                if(mirror>0 && mirror<=nnodes)
-                {   // it should not fix the direection and should have particles
-                    if((nd[mirror]->fixedDirection&dir)==0 && nd[mirror]->NodeHasNonrigidParticles())
-                    {   // maybe should verify neighbor is for same rigid material, but needs to check all BCs for their ID
-                        
-                        // found node to reflect
-                        reflectedNode = mirror;
-						reflectRatio = 1.;
-                    }
-                }
-            }
-        }
-	}
-	return (NodalVelBC *)GetNextObject();
-}
-
 // when getting total reaction force, add freaction to input vector
 // if matchID==0 include it, otherwise include only in matchID equals bcID
 NodalVelBC *NodalVelBC::AddReactionForce(Vector *totalReaction,int matchID)
@@ -252,32 +198,6 @@ void NodalVelBC::SetReflectedNode(int mirrored,double cellRatio)
 	reflectRatio = cellRatio;
 }
 
-// On rigid particle set spacing to mirrored node
-// Needs structured grid, but does not need equal element sizes
-// mirrorSpacing is node spacing in plane for this BCs node to be refected it needs:
-//	a. mirrorSpacing away is BC with same fixed direction and 2*mirrorSpacing away is free node in the object
-void NodalVelBC::SetMirrorSpacing(int mirrored)
-{
-	mirrorSpacing = 0;
-	if(mirrored==0) return;
-	if(!mpmgrid.IsStructuredEqualElementsGrid()) return;
-	
-	switch(dir)
-    {   case X_DIRECTION:
-			mirrorSpacing = mirrored<0 ? mpmgrid.xplane : -mpmgrid.xplane ;
-            break;
-        case Y_DIRECTION:
-			mirrorSpacing = mirrored<0 ? mpmgrid.yplane : -mpmgrid.yplane ;
-            break;
-        case Z_DIRECTION:
-			mirrorSpacing = mirrored<0 ? mpmgrid.zplane : -mpmgrid.zplane ;
-            break;
-		default:
-			break;
-	}
-
-}
-
 #pragma mark NodelVelBC::Class Methods
 
 /*******************************************************************
@@ -291,10 +211,30 @@ void NodalVelBC::GridVelocityBCValues(void)
 	// skip if no BCs or ot development mode that omits this calculation
 	if(firstVelocityBC==NULL) return;
 	
-	// Now zero nodes with velocity set by BC
-	NodalVelBC *nextBC=firstVelocityBC;
-	while(nextBC!=NULL)
-		nextBC = nextBC->GetCurrentBCValue(mtime);
+	// serial when BCs change other nodes
+	if(velocityBCGroups.useList)
+	{	NodalVelBC *nextBC=firstVelocityBC;
+		while(nextBC!=NULL)
+			nextBC = nextBC->GetCurrentBCValue(mtime);
+		return;
+	}
+	
+	// each BC gets its own value
+	CommonException *bcErr = NULL;
+#pragma omp parallel for
+	for(int k=0;k<velocityBCGroups.numBCs;k++)
+	{	try
+		{	((NodalVelBC *)velocityBCGroups.bcs[k])->GetCurrentBCValue(mtime);
+		}
+		catch(CommonException& err)
+		{	if(bcErr==NULL)
+			{
+#pragma omp critical (error)
+				bcErr = new CommonException(err);
+			}
+		}
+	}
+	if(bcErr!=NULL) throw *bcErr;
 }
 
 /*****************************************************************************
@@ -315,7 +255,7 @@ void NodalVelBC::GridVelocityBCValues(void)
 void NodalVelBC::GridVelocityConditions(int passType)
 {
 	// skip in no velocity BCs
-	if(firstVelocityBC==NULL) return;
+	if(firstVelocityBC==NULL && (rigidNodalBCs==NULL || !rigidNodalBCs->HasSetting(XYZ_SKEWED_DIRECTION))) return;
 	
 	switch(passType)
 	{	case UPDATE_GRID_STRAINS_CALL:
@@ -329,16 +269,33 @@ void NodalVelBC::GridVelocityConditions(int passType)
 #if ADJUST_COPIED_PK == 1
 			// I think this should only be done after initial extrapolation
 			// adjust for symmetry plane option
-			NodalVelBC *nextBC=firstVelocityBC;
-			while(nextBC!=NULL)
-			{	int i=nextBC->GetNodeNum();
-				if(nd[i]->fixedDirection&ANYSYMMETRYPLANE_DIRECTION)
-				{	for(int j=0;j<maxCrackFields;j++)
-					{	if(CrackVelocityField::ActiveField(nd[i]->cvf[j]))
-						nd[i]->cvf[j]->AdjustForSymmetryBC(nd[i]);
+			if(velocityBCGroups.useList)
+			{	NodalVelBC *nextBC=firstVelocityBC;
+				while(nextBC!=NULL)
+				{	int i=nextBC->GetNodeNum();
+					if(nd[i]->fixedDirection&ANYSYMMETRYPLANE_DIRECTION)
+					{	for(int j=0;j<maxCrackFields;j++)
+						{	if(CrackVelocityField::ActiveField(nd[i]->cvf[j]))
+							nd[i]->cvf[j]->AdjustForSymmetryBC(nd[i]);
+						}
+					}
+					nextBC = (NodalVelBC *)nextBC->GetNextObject();
+				}
+			}
+			else
+			{	// once for each BC on each node (same as list loop)
+#pragma omp parallel for
+				for(int g=0;g<velocityBCGroups.numGroups;g++)
+				{	int k = velocityBCGroups.groupStart[g];
+					int i = velocityBCGroups.bcs[k]->GetNodeNum();
+					if((nd[i]->fixedDirection&ANYSYMMETRYPLANE_DIRECTION)==0) continue;
+					for(;k<velocityBCGroups.groupStart[g+1];k++)
+					{	for(int j=0;j<maxCrackFields;j++)
+						{	if(CrackVelocityField::ActiveField(nd[i]->cvf[j]))
+							nd[i]->cvf[j]->AdjustForSymmetryBC(nd[i]);
+						}
 					}
 				}
-				nextBC = (NodalVelBC *)nextBC->GetNextObject();
 			}
 #endif
 			// no need when no strain update being done
@@ -375,15 +332,37 @@ void NodalVelBC::GridVelocityConditions(int passType)
 */
 void NodalVelBC::VelocityBCLoop(int passType)
 {
-	// Now zero nodes with velocity set by BC
-	NodalVelBC *nextBC=firstVelocityBC;
-	while(nextBC!=NULL)
-		nextBC = nextBC->ZeroVelocityBC(mtime,passType);
+	if(velocityBCGroups.useList)
+	{	// Now zero nodes with velocity set by BC
+		NodalVelBC *nextBC=firstVelocityBC;
+		while(nextBC!=NULL)
+			nextBC = nextBC->ZeroVelocityBC(mtime,passType);
+		if(rigidNodalBCs!=NULL) rigidNodalBCs->ZeroVelocityBCs(passType);
+		
+		// Now add all velocities to nodes with velocity BCs
+		nextBC=firstVelocityBC;
+		while(nextBC!=NULL)
+			nextBC = nextBC->AddVelocityBC(mtime,passType);
+		if(rigidNodalBCs!=NULL) rigidNodalBCs->AddVelocityBCs(passType);
+		return;
+	}
+	
+	// Zero nodes with velocity set by BC in parallel over nodes
+	// Reflected BCs read only their direction on mirror nodes, which is free (not zeroed or added)
+#pragma omp parallel for
+	for(int g=0;g<velocityBCGroups.numGroups;g++)
+	{	for(int k=velocityBCGroups.groupStart[g];k<velocityBCGroups.groupStart[g+1];k++)
+			((NodalVelBC *)velocityBCGroups.bcs[k])->ZeroVelocityBC(mtime,passType);
+	}
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->ZeroVelocityBCs(passType);
 	
 	// Now add all velocities to nodes with velocity BCs
-	nextBC=firstVelocityBC;
-	while(nextBC!=NULL)
-		nextBC = nextBC->AddVelocityBC(mtime,passType);
+#pragma omp parallel for
+	for(int g=0;g<velocityBCGroups.numGroups;g++)
+	{	for(int k=velocityBCGroups.groupStart[g];k<velocityBCGroups.groupStart[g+1];k++)
+			((NodalVelBC *)velocityBCGroups.bcs[k])->AddVelocityBC(mtime,passType);
+	}
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->AddVelocityBCs(passType);
 }
 
 /**********************************************************
@@ -401,5 +380,8 @@ Vector NodalVelBC::TotalReactionForce(int matchID)
     while(nextBC!=NULL)
 		nextBC=nextBC->AddReactionForce(&reactionTotal,matchID);
 	
+	// add those set by rigid particles
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->AddReactionForce(&reactionTotal,matchID);
+	
 	return reactionTotal;
 }
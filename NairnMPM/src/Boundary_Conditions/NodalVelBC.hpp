@@ -26,7 +26,6 @@ class NodalVelBC : public BoundaryCondition
         // constructors and destructors
         NodalVelBC(int,int,int,double,double,double,double);
         virtual int GetSetDirection(void) const;
-		virtual BoundaryCondition *SetRigidProperties(int,int,int,double);
         
         // virtual methods
         virtual BoundaryCondition *PrintBC(ostream &);
@@ -37,13 +36,11 @@ class NodalVelBC : public BoundaryCondition
 		virtual NodalVelBC *AddVelocityBC(double,int);
 	
 		// other methods
-		NodalVelBC *SetMirroredVelBC(double);
 		NodalVelBC *AddReactionForce(Vector *,int);
         int ConvertToDirectionBits(int);
         void SetNormalVector(void);
         int ConvertToInputDof(void);
 		void SetReflectedNode(int,double);
-		void SetMirrorSpacing(int);
 	
 		// class methods
 		static void GridVelocityBCValues(void);
@@ -56,7 +53,6 @@ class NodalVelBC : public BoundaryCondition
         double angle1,angle2;
 		Vector norm;
 		Vector freaction;
-        int mirrorSpacing;
 		int reflectedNode;
 		double reflectRatio;
 };
@@ -64,8 +60,7 @@ class NodalVelBC : public BoundaryCondition
 // variables (changed in MPM time step)
 extern NodalVelBC *firstVelocityBC;
 extern NodalVelBC *lastVelocityBC;
-extern NodalVelBC *firstRigidVelocityBC;
-extern NodalVelBC *reuseRigidVelocityBC;
+extern NodalBCGroups velocityBCGroups;
 
 #endif
 
@@ -194,6 +194,9 @@ NodalVelGradBC *NodalVelGradBC::AddVelocityBC(double bctime,int passType)
 
 #pragma mark NodalVelGradBC: Accessors
 
+// sets velocities on nodes from firstNode across the wall
+bool NodalVelGradBC::ChangesOtherNodes(void) const { return true; }
+
 // set gradient function (if forGradient is true) or displacement function (if false)
 // throws std::bad_alloc, SAXException()
 void NodalVelGradBC::SetGradFunction(char *bcFunction,bool forGradient)
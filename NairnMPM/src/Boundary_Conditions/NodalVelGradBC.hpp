@@ -28,6 +28,7 @@ class NodalVelGradBC : public NodalVelBC
 		virtual NodalVelGradBC *GetCurrentBCValue(double);
 		virtual NodalVelGradBC *ZeroVelocityBC(double,int);
 		virtual NodalVelGradBC *AddVelocityBC(double,int);
+		virtual bool ChangesOtherNodes(void) const;
 	
 		// accessors
 		int ConvertToDirectionBits(int);
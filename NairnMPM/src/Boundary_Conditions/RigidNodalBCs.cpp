@@ -0,0 +1,286 @@
+/********************************************************************************
+	RigidNodalBCs.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
+#include "Boundary_Conditions/BoundaryCondition.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "NairnMPM_Class/NairnMPM.hpp"
+#include "NairnMPM_Class/MeshInfo.hpp"
+#include "Custom_Tasks/TransportTask.hpp"
+
+// global object when rigid BC particles are in the analysis
+RigidNodalBCs *rigidNodalBCs=NULL;
+
+#pragma mark RigidNodalBCs::Constructors and Destructors
+
+// Create for grid with the provided number of nodes
+// throws std::bad_alloc
+RigidNodalBCs::RigidNodalBCs(int nodes)
+{
+	numNodes = nodes;
+	recordIndex = new int[numNodes+1];
+	for(int i=0;i<=numNodes;i++) recordIndex[i] = 0;
+	numRecords = 0;
+	setBits = 0;
+}
+
+RigidNodalBCs::~RigidNodalBCs()
+{	delete [] recordIndex;
+}
+
+#pragma mark RigidNodalBCs::Setting BCs
+
+// Unset nodal directions set on the previous time step and empty the records
+// Records are kept so later steps do not need new memory
+void RigidNodalBCs::ClearRigidBCs(void)
+{
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	int i = records[k].node;
+		nd[i]->UnsetFixedDirection(records[k].dir);
+		recordIndex[i] = 0;
+	}
+	numRecords = 0;
+	setBits = 0;
+}
+
+// Set BC on node mi in direction type (X, Y, Z, TEMP, or CONC_DIRECTION)
+// Ignored if that direction is already fixed by grid BC or by previous rigid particle
+// bcID is ID for reaction forces and mirrored is rigid material mirrored setting
+// Not thread safe, call in order of rigid particles to get conflict rule
+// throws std::bad_alloc
+void RigidNodalBCs::SetRigidBC(int mi,int type,double value,int bcID,int mirrored)
+{
+	// New rigid BC's can only be on free directions
+	if(nd[mi]->fixedDirection&type) return;
+
+	// get record for this node
+	RigidNodeBC *rec;
+	if(recordIndex[mi]==0)
+	{	if(numRecords==(int)records.size())
+			records.push_back(RigidNodeBC());
+		rec = &records[numRecords];
+		numRecords++;
+		recordIndex[mi] = numRecords;
+		rec->node = mi;
+		rec->dir = 0;
+	}
+	else
+		rec = &records[recordIndex[mi]-1];
+
+	// set it
+	int s = SettingIndex(type);
+	rec->dir |= type;
+	rec->value[s] = value;
+	rec->bcID[s] = bcID;
+	if(s<=RIGID_Z)
+	{	// mirrored velocity needs structured grid, but does not need equal element sizes
+		// node is reflected if node mirrorSpacing away has same fixed direction and node
+		// 2*mirrorSpacing away is free node in the object
+		int spacing = 0;
+		if(mirrored!=0 && mpmgrid.IsStructuredEqualElementsGrid())
+		{	if(s==RIGID_X)
+				spacing = mpmgrid.xplane;
+			else if(s==RIGID_Y)
+				spacing = mpmgrid.yplane;
+			else
+				spacing = mpmgrid.zplane;
+			if(mirrored>0) spacing = -spacing;
+		}
+		rec->mirrorSpacing[s] = spacing;
+		rec->reflectedNode[s] = -1;
+		ZeroVector(&rec->freaction[s]);
+	}
+	else if(s==RIGID_TEMP)
+		rec->qreaction = 0.;
+
+	nd[mi]->SetFixedDirection(type);
+	setBits |= type;
+}
+
+#pragma mark RigidNodalBCs::Velocity BCs
+
+// Find reflected nodes for mirrored velocity BCs
+// Call once per step after nodes know if they have nonrigid particles
+void RigidNodalBCs::SetMirroredVelBCs(void)
+{
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		int i = rec->node;
+		for(int s=RIGID_X;s<=RIGID_Z;s++)
+		{	int type = 1<<s;
+			if((rec->dir&type)==0 || rec->mirrorSpacing[s]==0) continue;
+
+			// look at neighbor in mirror direction but only if node i has particles and neighbor is in the grid
+			int neighbor = i+rec->mirrorSpacing[s];
+			if(!nd[i]->NodeHasNonrigidParticles() || neighbor<=0 || neighbor>nnodes) continue;
+
+			// neighbor fixes same dof and next node in mirror direction does not, but has particles
+			if(nd[neighbor]->fixedDirection&type)
+			{	int mirror = neighbor+rec->mirrorSpacing[s];
+				if(mirror>0 && mirror<=nnodes)
+				{	if((nd[mirror]->fixedDirection&type)==0 && nd[mirror]->NodeHasNonrigidParticles())
+						rec->reflectedNode[s] = mirror;
+				}
+			}
+		}
+	}
+}
+
+// Zero velocity in directions set by rigid particles (see NodalVelBC::ZeroVelocityBC())
+void RigidNodalBCs::ZeroVelocityBCs(int passType)
+{
+	if((setBits&XYZ_SKEWED_DIRECTION)==0) return;
+
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		for(int s=RIGID_X;s<=RIGID_Z;s++)
+		{	if((rec->dir&(1<<s))==0) continue;
+			Vector norm = MakeVector(s==RIGID_X ? 1. : 0.,s==RIGID_Y ? 1. : 0.,s==RIGID_Z ? 1. : 0.);
+			if(passType==GRID_FORCES_CALL) ZeroVector(&rec->freaction[s]);
+			nd[rec->node]->ZeroVelocityBC(&norm,passType,timestep,&rec->freaction[s]);
+		}
+	}
+}
+
+// Add velocity in directions set by rigid particles (see NodalVelBC::AddVelocityBC())
+void RigidNodalBCs::AddVelocityBCs(int passType)
+{
+	if((setBits&XYZ_SKEWED_DIRECTION)==0) return;
+
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		NodalPoint *ndptr = nd[rec->node];
+		for(int s=RIGID_X;s<=RIGID_Z;s++)
+		{	if((rec->dir&(1<<s))==0) continue;
+			Vector norm = MakeVector(s==RIGID_X ? 1. : 0.,s==RIGID_Y ? 1. : 0.,s==RIGID_Z ? 1. : 0.);
+			if(rec->reflectedNode[s]<0)
+				ndptr->AddVelocityBC(&norm,rec->value[s],passType,timestep,&rec->freaction[s]);
+			else
+			{	ndptr->ReflectVelocityBC(&norm,nd[rec->reflectedNode[s]],rec->value[s],1.,
+										 passType,timestep,&rec->freaction[s]);
+			}
+		}
+	}
+}
+
+// Add reaction forces to totalReaction
+// if matchID==0 include all, otherwise include only those with bcID equal to matchID
+void RigidNodalBCs::AddReactionForce(Vector *totalReaction,int matchID) const
+{
+	for(int k=0;k<numRecords;k++)
+	{	const RigidNodeBC *rec = &records[k];
+		for(int s=RIGID_X;s<=RIGID_Z;s++)
+		{	if((rec->dir&(1<<s))==0) continue;
+			if(rec->bcID[s]==matchID || matchID==0)
+				AddVector(totalReaction,&rec->freaction[s]);
+		}
+	}
+}
+
+#pragma mark RigidNodalBCs::Transport BCs
+
+// Save transport value before imposing BCs (see NodalValueBC::CopyNodalValue())
+void RigidNodalBCs::CopyTransportValues(TransportTask *task)
+{
+	int type = task->GetSetDirection();
+	if((setBits&type)==0) return;
+	int s = SettingIndex(type);
+
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		if(rec->dir&type)
+			rec->valueNoBC[s-RIGID_TEMP] = task->GetTransportFieldPtr(nd[rec->node])->gTValue;
+	}
+}
+
+// Impose transport values set by rigid particles
+void RigidNodalBCs::ImposeTransportValues(TransportTask *task)
+{
+	int type = task->GetSetDirection();
+	if((setBits&type)==0) return;
+	int s = SettingIndex(type);
+
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		if(rec->dir&type)
+			task->GetTransportFieldPtr(nd[rec->node])->gTValue = rec->value[s];
+	}
+}
+
+// Restore transport values and set forces to reach the rigid particle values
+// If getReaction, track reaction flow (for conduction)
+void RigidNodalBCs::SetTransportForces(TransportTask *task,double deltime,bool getReaction)
+{
+	int type = task->GetSetDirection();
+	if((setBits&type)==0) return;
+	int s = SettingIndex(type);
+
+#pragma omp parallel for
+	for(int k=0;k<numRecords;k++)
+	{	RigidNodeBC *rec = &records[k];
+		if((rec->dir&type)==0) continue;
+
+		// paste back no BC value and set force to - C*T(no BC)/timestep
+		TransportField *gTrans = task->GetTransportFieldPtr(nd[rec->node]);
+		gTrans->gTValue = rec->valueNoBC[s-RIGID_TEMP];
+		double qflow = -gTrans->gVCT*gTrans->gTValue/deltime;
+		if(getReaction) rec->qreaction = -gTrans->gQ+qflow;
+		gTrans->gQ = qflow;
+
+		// add C*TBC/timestep
+		qflow = gTrans->gVCT*rec->value[s]/deltime;
+		gTrans->gQ += qflow;
+		if(getReaction) rec->qreaction += qflow;
+	}
+}
+
+// Add heat reaction flows to totalReaction
+// if matchID==0 include all, otherwise include only those with bcID equal to matchID
+void RigidNodalBCs::AddHeatReaction(double *totalReaction,int matchID) const
+{
+	for(int k=0;k<numRecords;k++)
+	{	const RigidNodeBC *rec = &records[k];
+		if((rec->dir&TEMP_DIRECTION)==0) continue;
+		if(rec->bcID[RIGID_TEMP]==matchID || matchID==0)
+			*totalReaction += rec->qreaction;
+	}
+}
+
+#pragma mark RigidNodalBCs::Accessors
+
+// number of nodes with rigid BCs
+int RigidNodalBCs::NumberOfNodes(void) const { return numRecords; }
+
+// true if any node has any of the provided direction bits set
+bool RigidNodalBCs::HasSetting(int type) const { return (setBits&type)!=0; }
+
+#pragma mark RigidNodalBCs::Class Methods
+
+// convert direction bit to index into record settings
+int RigidNodalBCs::SettingIndex(int type)
+{
+	switch(type)
+	{	case X_DIRECTION:
+			return RIGID_X;
+		case Y_DIRECTION:
+			return RIGID_Y;
+		case Z_DIRECTION:
+			return RIGID_Z;
+		case TEMP_DIRECTION:
+			return RIGID_TEMP;
+		default:
+			return RIGID_CONC;
+	}
+}
@@ -0,0 +1,86 @@
+/********************************************************************************
+	RigidNodalBCs.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Grid boundary conditions set by rigid BC particles (nmpmsRC to nmpms-1) on
+	each time step. Rather than creating NodalVelBC, NodalTempBC, and
+	NodalConcBC objects, each node with rigid settings gets one record in a
+	flat array that is reused on every step. Each record holds the mask of
+	directions set on that node and the prescribed values. A node is found
+	from its record index+1 in recordIndex[] (0 if none).
+
+	Conflict rule: a direction is set by the first rigid particle (in particle
+	order) that projects to that node and only if no grid BC or previous rigid
+	particle already fixes that direction.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _RIGIDNODALBCS_
+
+#define _RIGIDNODALBCS_
+
+class TransportTask;
+
+// settings on each node
+enum { RIGID_X=0,RIGID_Y,RIGID_Z,RIGID_TEMP,RIGID_CONC,NUM_RIGID_SETTINGS };
+
+typedef struct
+{	int node;								// node number (1 based)
+	int dir;								// bits set on this node (X, Y, Z, TEMP, or CONC_DIRECTION)
+	int bcID[NUM_RIGID_SETTINGS];			// ID for reaction forces (1 based rigid material)
+	double value[NUM_RIGID_SETTINGS];		// prescribed velocity, temperature, or concentration
+	int mirrorSpacing[3];					// spacing to mirrored node for velocity BCs (0 if not mirrored)
+	int reflectedNode[3];					// reflected node this step (or -1)
+	Vector freaction[3];					// reaction force for each velocity direction
+	double valueNoBC[2];					// temperature and concentration before imposing BCs
+	double qreaction;						// reaction heat flow
+} RigidNodeBC;
+
+class RigidNodalBCs
+{
+	public:
+
+		// constructors and destructors
+		RigidNodalBCs(int);
+		~RigidNodalBCs();
+
+		// setting BCs
+		void ClearRigidBCs(void);
+		void SetRigidBC(int,int,double,int,int);
+
+		// velocity BCs
+		void SetMirroredVelBCs(void);
+		void ZeroVelocityBCs(int);
+		void AddVelocityBCs(int);
+		void AddReactionForce(Vector *,int) const;
+
+		// transport BCs
+		void CopyTransportValues(TransportTask *);
+		void ImposeTransportValues(TransportTask *);
+		void SetTransportForces(TransportTask *,double,bool);
+		void AddHeatReaction(double *,int) const;
+
+		// accessors
+		int NumberOfNodes(void) const;
+		bool HasSetting(int) const;
+
+		// class methods
+		static int SettingIndex(int);
+
+	private:
+		int numNodes;
+		int *recordIndex;
+		vector< RigidNodeBC > records;
+		int numRecords;
+		int setBits;
+};
+
+// global object when rigid BC particles are in the analysis (otherwise NULL)
+extern RigidNodalBCs *rigidNodalBCs;
+
+#endif
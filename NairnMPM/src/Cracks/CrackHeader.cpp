@@ -13,6 +13,7 @@
 #include "NairnMPM_Class/MeshInfo.hpp"
 #include "Cracks/CrackHeader.hpp"
 #include "Materials/MaterialBase.hpp"
+#include "Materials/TractionLaw.hpp"
 #include "System/ArchiveData.hpp"
 #include "Elements/ElementBase.hpp"
 #include "Cracks/CrackSurfaceContact.hpp"
@@ -383,51 +384,48 @@ void CrackHeader::Archive(ofstream &afile)
 // If contact.GetMoveOnlySurfaces() is FALSE, move all crack plane particles
 //		using CM velocities (precalculated and stored in field[0])
 // Also must recalculate extent of crack in cnear[i] and cfar[i]
+// Segments move in parallel. When preventing plane crosses, surfaces are checked after
+//		all segments have moved because the check needs positions of adjacent segments
 short CrackHeader::MoveCrack(void)
 {
-	CrackSegment *scrk=firstSeg;
-	// move only surfaces
-	if(contact.GetMoveOnlySurfaces())
-	{	while(scrk != NULL)
+	if(!fixedCrack)
+	{	int nsegs = FillSegmentList();
+		bool leftGrid = false;
+		
+		// move only surfaces
+		if(contact.GetMoveOnlySurfaces())
 		{
-			if(!fixedCrack)
-			{	// move to midpoint between upper and lower surface
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+			for(int i=0;i<nsegs;i++)
+			{	CrackSegment *scrk = segmentList[i];
+				
+				// move to midpoint between upper and lower surface
 				scrk->MovePosition();
 				
 				// did element move
-				if(!scrk->FindElement()) return false;
-				
-				// make sure surface are on correct side of the crack
-				if(contact.GetPreventPlaneCrosses())
-				{	if(!scrk->CheckSurfaces()) return false;
-				}
+				if(!scrk->FindElement()) leftGrid = true;
 			}
-
-			// next segments
-			scrk = scrk->nextSeg;
 		}
-	}
-	
-	// move crack plane particles by CM velocity
-	else
-	{	int iel;
-		double shapeNorm;
-		int j,nodeCounter;
-		Vector vcm,acm,delv,dela;
+		
+		// move crack plane particles by CM velocity
+		else
+		{
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+			for(int i=0;i<nsegs;i++)
+			{	CrackSegment *scrk = segmentList[i];
+				double shapeNorm;
+				int nodeCounter;
+				Vector vcm,acm,delv,dela;
 #ifdef CONST_ARRAYS
-		double fn[MAX_SHAPE_NODES];
-		int nds[MAX_SHAPE_NODES];
+				double fn[MAX_SHAPE_NODES];
+				int nds[MAX_SHAPE_NODES];
 #else
-		double fn[maxShapeNodes];
-		int nds[maxShapeNodes];
+				double fn[maxShapeNodes];
+				int nds[maxShapeNodes];
 #endif
-		
-		// loop over crack points
-		while(scrk != NULL)
-		{
-			if(!fixedCrack)
-			{	// get element and shape functions to extrapolate to the particle
-				iel=scrk->planeElemID();
+				
+				// get element and shape functions to extrapolate to the particle
+				int iel=scrk->planeElemID();
 				theElements[iel]->GetShapeFunctionsForCracks(fn,nds,scrk->cp);
 				int numnds = nds[0];
 				
@@ -438,7 +436,7 @@ short CrackHeader::MoveCrack(void)
 				shapeNorm=0.;
 				
 				// extrapolate to crack particle
-				for(j=1;j<=numnds;j++)
+				for(int j=1;j<=numnds;j++)
 				{	if(nd[nds[j]]->GetCMVelocityTask8(&vcm,&acm))
 					{	AddScaledVector(&delv,&vcm,fn[j]);
 						AddScaledVector(&dela,&acm,fn[j]);
@@ -447,7 +445,7 @@ short CrackHeader::MoveCrack(void)
 					}
 				}
 				
-				// move it or collapse it
+				// move it or collapse it (crack in free space does not move)
 				if(nodeCounter>0)
 				{	// pass unnormalized velocity and acceleration to segment
 					scrk->MovePosition(&delv,&dela,timestep,shapeNorm);
@@ -456,23 +454,21 @@ short CrackHeader::MoveCrack(void)
 					// to revert to moving at the midplane of the two surfaces
 					if(!scrk->FindElement())
 					{	scrk->MovePositionToMidpoint();
-						if(!scrk->FindElement()) return false;
-					}
-					
-					// check surfaces
-					if(contact.GetPreventPlaneCrosses())
-					{	if(!scrk->CheckSurfaces()) return false;
+						if(!scrk->FindElement()) leftGrid = true;
 					}
 				}
-				
-				else if(contact.GetPreventPlaneCrosses())
-				{	// crack in free space, but check if surfaces have moved
-					if(!scrk->CheckSurfaces()) return FALSE;
-				}
 			}
-
-			// next segments
-			scrk=scrk->nextSeg;
+		}
+		if(leftGrid) return false;
+		
+		// make sure surface are on correct side of the crack (in free space too)
+		if(contact.GetPreventPlaneCrosses())
+		{
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+			for(int i=0;i<nsegs;i++)
+			{	if(!segmentList[i]->CheckSurfaces()) leftGrid = true;
+			}
+			if(leftGrid) return false;
 		}
 	}
     
@@ -484,90 +480,119 @@ short CrackHeader::MoveCrack(void)
 
 // Move one crack surface according to current velocities
 // side==ABOVE_CRACK (1) or BELOW_CRACK (2)
+// Segments move in parallel because each only changes its own surface
 short CrackHeader::MoveCrack(short side)
 {
-    CrackSegment *scrk=firstSeg;
-    int iel;
-    short js=side-1,nodeCounter,j;
-	double fnorm;
-	Vector svelnp1,surfAcc;
+	if(fixedCrack) return true;
+	
+	int nsegs = FillSegmentList();
+	short js=side-1;
+	bool leftGrid = false;
+	
+    // loop over crack points
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+	for(int i=0;i<nsegs;i++)
+	{	CrackSegment *scrk = segmentList[i];
+		short nodeCounter;
+		double fnorm;
+		Vector svelnp1,surfAcc;
 #ifdef CONST_ARRAYS
-	double fn[MAX_SHAPE_NODES];
-	int nds[MAX_SHAPE_NODES];
+		double fn[MAX_SHAPE_NODES];
+		int nds[MAX_SHAPE_NODES];
 #else
-	double fn[maxShapeNodes];
-	int nds[maxShapeNodes];
+		double fn[maxShapeNodes];
+		int nds[maxShapeNodes];
 #endif
-    
-    // loop over crack points
-    while(scrk!=NULL)
-	{
-		if(!fixedCrack)
-		{	// get element and shape functions to extrapolate to the particle
-			iel = scrk->surfaceElemID(side);			// now zero based
-			theElements[iel]->GetShapeFunctionsForCracks(fn,nds,scrk->surf[js]);
-			int numnds = nds[0];
-
-			// get S v+ or PIC velocity in svelnp1
-			ZeroVector(&svelnp1);
-			ZeroVector(&surfAcc);
-			fnorm = 0;
-			nodeCounter = 0;
-			double surfaceMass = 0;
-			
-			// extrapolate those with velocity to the particle
-			for(j=1;j<=numnds;j++)
-			{	if(nd[nds[j]]->IncrementDelvSideTask8(side,number,fn[j],&svelnp1,&surfAcc,&fnorm,scrk,surfaceMass))
-					nodeCounter++;
-			}
-			
-			// svelnp1 is Sum(fi wi vi), surfAcc is Sum(fi wi ai), and fnorm = Sum(fi wi)
-			//    where wi = mass (if MASS_WEIGHTED) or 1 otherwise
-			if(nodeCounter>0)
-			{	ScaleVector(&svelnp1,1./fnorm);
-				ScaleVector(&surfAcc,1./fnorm);
-			}
-			else
-				nodeCounter=0;
-			
-			// Update crack surfave velocity and positiong
-			if(scrk->MoveSurfacePosition(side,&svelnp1,&surfAcc,timestep,(nodeCounter>0)))
-			{	if(!scrk->FindElement(ABOVE_CRACK)) return false;
-			}
-			
-			// did surface move elements
-			if(!scrk->FindElement(side))
-			{	return false;
-			}
+		
+		// get element and shape functions to extrapolate to the particle
+		int iel = scrk->surfaceElemID(side);			// now zero based
+		theElements[iel]->GetShapeFunctionsForCracks(fn,nds,scrk->surf[js]);
+		int numnds = nds[0];
+
+		// get S v+ or PIC velocity in svelnp1
+		ZeroVector(&svelnp1);
+		ZeroVector(&surfAcc);
+		fnorm = 0;
+		nodeCounter = 0;
+		double surfaceMass = 0;
+		
+		// extrapolate those with velocity to the particle
+		for(int j=1;j<=numnds;j++)
+		{	if(nd[nds[j]]->IncrementDelvSideTask8(side,number,fn[j],&svelnp1,&surfAcc,&fnorm,scrk,surfaceMass))
+				nodeCounter++;
 		}
-            
-        // on to next segement
-        scrk=scrk->nextSeg;
+		
+		// svelnp1 is Sum(fi wi vi), surfAcc is Sum(fi wi ai), and fnorm = Sum(fi wi)
+		//    where wi = mass (if MASS_WEIGHTED) or 1 otherwise
+		if(nodeCounter>0)
+		{	ScaleVector(&svelnp1,1./fnorm);
+			ScaleVector(&surfAcc,1./fnorm);
+		}
+		else
+			nodeCounter=0;
+		
+		// Update crack surfave velocity and positiong
+		if(scrk->MoveSurfacePosition(side,&svelnp1,&surfAcc,timestep,(nodeCounter>0)))
+		{	if(!scrk->FindElement(ABOVE_CRACK)) leftGrid = true;
+		}
+		
+		// did surface move elements
+		if(!scrk->FindElement(side)) leftGrid = true;
     }
-    return true;
+	
+    return !leftGrid;
 }
 
 // Update crack tractions on any segments with traction loaws
+// Segments are done in parallel (each changes only its own traction and history). Debonds
+//		found by traction laws are reported after the loop in segment order
 void CrackHeader::UpdateCrackTractions(void)
 {	if(!hasTractionLaws) return;
 	
-    // loop over crack points
-	CrackSegment *scrk=firstSeg;
-    while(scrk!=NULL)
-	{	scrk->UpdateTractions(this);
-		scrk=scrk->nextSeg;
-    }
+	int nsegs = FillSegmentList();
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+	for(int i=0;i<nsegs;i++)
+		segmentList[i]->UpdateTractions(this);
+	
+	TractionLaw::OutputDebonds(segmentList);
 }
 
 // called in forces step for each crack to convert crack tractions laws into external forces
+// Nodal forces for segments are found in parallel, but added to nodes in segment order so
+//		that results do not depend on number of threads
 void CrackHeader::AddTractionForce(void)
 {
 	if(!hasTractionLaws) return;
-	CrackSegment *cs=firstSeg;
-	while(cs!=NULL)
-	{	cs->AddTractionForceSeg(this);
-		cs=cs->nextSeg;
+	
+	int nsegs = FillSegmentList();
+	int segForces = 2*maxShapeNodes;
+	if((int)tractionForces.size()<nsegs*segForces)
+		tractionForces.resize(nsegs*segForces);
+	if((int)numTractionForces.size()<nsegs)
+		numTractionForces.resize(nsegs);
+	
+#pragma omp parallel for if(nsegs>=MIN_PARALLEL_SEGMENTS)
+	for(int i=0;i<nsegs;i++)
+		numTractionForces[i] = segmentList[i]->GetTractionForces(this,&tractionForces[i*segForces]);
+	
+	for(int i=0;i<nsegs;i++)
+	{	CrackTractionForce *forces = &tractionForces[i*segForces];
+		for(int j=0;j<numTractionForces[i];j++)
+			nd[forces[j].nodeNum]->AddFtotSpreadTask3(forces[j].vfld,forces[j].force);
+	}
+}
+
+// Collect segments in order into segmentList for parallel loops and return number of segments
+// Rebuilt on each call because propagation adds segments
+int CrackHeader::FillSegmentList(void)
+{
+	segmentList.clear();
+	CrackSegment *scrk=firstSeg;
+	while(scrk!=NULL)
+	{	segmentList.push_back(scrk);
+		scrk=scrk->nextSeg;
 	}
+	return (int)segmentList.size();
 }
 
 // load vector with initial crack tip direction
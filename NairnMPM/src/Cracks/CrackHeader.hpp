@@ -47,6 +47,16 @@ class ParseController;
 #define END_OF_CRACK 1
 #define EXTERIOR_CRACK -2
 
+// minimum segments in a crack to loop over its segments in parallel
+#define MIN_PARALLEL_SEGMENTS 64
+
+// traction law force on one node from one crack segment
+typedef struct {
+	int nodeNum;
+	short vfld;
+	Vector force;
+} CrackTractionForce;
+
 class CrackHeader : public LinkedObject
 {
     public:
@@ -148,7 +158,11 @@ class CrackHeader : public LinkedObject
 		double thickness;						// 2D tractions and crack-tip heating
         CrackLeaf *rootLeaf;
 		ParseController *crossedCracks;
-    
+		vector< CrackSegment * > segmentList;			// segments for parallel loops
+		vector< CrackTractionForce > tractionForces;	// 2*maxShapeNodes per segment
+		vector< int > numTractionForces;				// forces found for each segment
+	
+		int FillSegmentList(void);
 };
 
 extern CrackHeader *firstCrack;
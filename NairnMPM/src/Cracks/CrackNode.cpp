@@ -24,6 +24,9 @@
 // global point to contact conditions
 vector< CrackNode * > CrackNode::crackContactNodes;
 
+// crack nodes are reused on each time step (see ReserveContactNodes())
+vector< CrackNode * > CrackNode::crackNodePool;
+
 #pragma mark CrackNode: Constructors and Destructors
 
 // Constructors
@@ -34,6 +37,14 @@ CrackNode::CrackNode(NodalPoint *nd,int flags,CrackNode *prev)
 	hasFlags = flags;
 }
 
+// Reuse pooled crack node for a new node
+void CrackNode::ReuseForNode(NodalPoint *nd,int flags)
+{
+	theNode = nd;
+	prevNode = NULL;
+	hasFlags = flags;
+}
+
 #pragma mark CrackNode: Methods
 
 // check contact on this node during update strains last
@@ -60,6 +71,9 @@ bool CrackNode::ContactOnKnownNodes(double deltime,int passType)
 	CommonException *ccErr = NULL;
 	int numNodesPerProc = (int)((double)numCrackNodes/(double)(fmobj->GetNumberOfProcessors()));
 	
+	// deterministic mode is serial so interface energy and friction work are summed in node order
+	if(fmobj->deterministicPatches>0) numNodesPerProc = 0;
+	
 #pragma omp parallel if(numNodesPerProc>1)
 	{
 #pragma omp for
@@ -84,15 +98,33 @@ bool CrackNode::ContactOnKnownNodes(double deltime,int passType)
 	return true;
 }
 
-// delete the contact node (which delink to node), clear vector of pointers
+// clear vector of pointers (crack nodes stay in the pool for next time step)
 void CrackNode::ReleaseContactNodes(void)
 {
-	long numCrackNodes = crackContactNodes.size();
-	if(numCrackNodes==0) return;
-	
-	for(long i=0;i<numCrackNodes;i++)
-		delete crackContactNodes[i];
-	
 	crackContactNodes.clear();
 }
 
+// Prepare for num crack nodes on this time step, which are then set by SetContactNode()
+// Pool only grows, thus new crack nodes are only needed when step has more than any previous step
+// Call outside parallel loops, but SetContactNode() can then be done in parallel
+// throws std::bad_alloc
+void CrackNode::ReserveContactNodes(int num)
+{
+	while((int)crackNodePool.size()<num)
+		crackNodePool.push_back(new CrackNode(NULL,0,NULL));
+	crackContactNodes.resize(num);
+}
+
+// Set crack node k (0 based) to pooled node for nodal point nd
+void CrackNode::SetContactNode(int k,NodalPoint *nd,int flags)
+{	CrackNode *cn = crackNodePool[k];
+	cn->ReuseForNode(nd,flags);
+	crackContactNodes[k] = cn;
+}
+
+// bytes used by pooled crack contact nodes and the list of contact nodes
+size_t CrackNode::MemoryBytes(void)
+{	return (crackNodePool.capacity()+crackContactNodes.capacity())*sizeof(CrackNode *)
+				+ crackNodePool.size()*sizeof(CrackNode);
+}
+
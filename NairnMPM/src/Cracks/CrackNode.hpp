@@ -20,9 +20,11 @@ class CrackNode
     public:
 		// list of crack nodes
 		static vector< CrackNode * > crackContactNodes;
+		static vector< CrackNode * > crackNodePool;
 
         // constructors and destructors
 		CrackNode(NodalPoint *,int,CrackNode *);
+		void ReuseForNode(NodalPoint *,int);
 	
 		// common methods
 		void SetPrevNode(CrackNode *);
@@ -34,6 +36,9 @@ class CrackNode
 		// class methods
 		static bool ContactOnKnownNodes(double,int);
 		static void ReleaseContactNodes(void);
+		static void ReserveContactNodes(int);
+		static void SetContactNode(int,NodalPoint *,int);
+		static size_t MemoryBytes(void);
 	
 	protected:
 		// variables (changed in MPM time step)
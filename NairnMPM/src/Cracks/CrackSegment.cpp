@@ -211,19 +211,22 @@ bool CrackSegment::MoveSurfacePosition(short side,Vector *svelnp1,Vector *surfAc
 }
 
 // calculate tractions due to this segment
-void CrackSegment::AddTractionForceSeg(CrackHeader *theCrack)
+// Nodal forces are stored in forces (room for 2*maxShapeNodes) rather than added to the nodes
+//    so segments can be done in parallel. Return number of forces (above the crack first)
+int CrackSegment::GetTractionForces(CrackHeader *theCrack,CrackTractionForce *forces)
 {	// exit if no traction law
-	if(MatID()<0) return;
+	if(MatID()<0) return 0;
 
-	// Add force on this segement to both sides of the crack
-	AddTractionForceSegSide(theCrack,ABOVE_CRACK,1.);
-	AddTractionForceSegSide(theCrack,BELOW_CRACK,-1.);
+	// Force on this segement to both sides of the crack
+	int numForces = GetTractionForcesSide(theCrack,ABOVE_CRACK,1.,forces);
+	numForces += GetTractionForcesSide(theCrack,BELOW_CRACK,-1.,&forces[numForces]);
+	return numForces;
 }
 
 // calculate tractions on one side of crack for this segment
-// add forces to material velocity fields on one side of the crack
+// find forces for material velocity fields on one side of the crack and return number found
 // side = ABOVE_CRACK (1) or BELOW_CRACK (2)
-void CrackSegment::AddTractionForceSegSide(CrackHeader *theCrack,int side,double scale)
+int CrackSegment::GetTractionForcesSide(CrackHeader *theCrack,int side,double scale,CrackTractionForce *forces)
 {
 #ifdef CONST_ARRAYS
 	int nds[MAX_SHAPE_NODES];
@@ -237,6 +240,7 @@ void CrackSegment::AddTractionForceSegSide(CrackHeader *theCrack,int side,double
 	double fnorm = 0.;
 	NodalPoint *ndi;
 	int	cnum=theCrack->GetNumber();
+	int numForces = 0;
 	
 	// get element and shape function to extrapolate to the node
 	int js = side-1;
@@ -270,8 +274,10 @@ void CrackSegment::AddTractionForceSegSide(CrackHeader *theCrack,int side,double
 	for(int i=1;i<=numnds;i++)
 	{	// if has particles (and they see cracks), add force and track normalization
 		if(cvfld[i]>=0)
-		{	ndi = nd[nds[i]];
-			ndi->AddFtotSpreadTask3(cvfld[i],FTract(fnorm*fn[i]));
+		{	forces[numForces].nodeNum = nds[i];
+			forces[numForces].vfld = cvfld[i];
+			forces[numForces].force = FTract(fnorm*fn[i]);
+			numForces++;
 		}
 	}
 #else
@@ -287,7 +293,7 @@ void CrackSegment::AddTractionForceSegSide(CrackHeader *theCrack,int side,double
 	}
 
 	// skip if not enough
-	if(fnorm<1.e-3) return;
+	if(fnorm<1.e-3) return 0;
 	
 	// normlization and side
 	fnorm = scale/fnorm;
@@ -296,11 +302,14 @@ void CrackSegment::AddTractionForceSegSide(CrackHeader *theCrack,int side,double
 	for(int i=1;i<=numnds;i++)
 	{	// if has particles (and they see cracks), add force and track normalization
 		if(cvfld[i]>=0)
-		{	ndi = nd[nds[i]];
-			ndi->AddFtotSpreadTask3(cvfld[i],FTract(fnorm*fn[i]));
+		{	forces[numForces].nodeNum = nds[i];
+			forces[numForces].vfld = cvfld[i];
+			forces[numForces].force = FTract(fnorm*fn[i]);
+			numForces++;
 		}
 	}
 #endif
+	return numForces;
 }
 
 
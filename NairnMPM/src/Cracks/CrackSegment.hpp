@@ -59,8 +59,8 @@ class CrackSegment
 		virtual Vector SlightlyMovedIfNotMovedYet(int);
 		int MatID(void);
 		void SetMatID(int);
-		void AddTractionForceSeg(CrackHeader *);
-		void AddTractionForceSegSide(CrackHeader *,int,double);
+		int GetTractionForces(CrackHeader *,CrackTractionForce *);
+		int GetTractionForcesSide(CrackHeader *,int,double,CrackTractionForce *);
 		void FindCrackTipMaterial(int);
 		virtual void UpdateTractions(CrackHeader *);
 		virtual double GetNormalAndTangent(CrackHeader *,Vector *,Vector *,double &,double &) const;
@@ -119,6 +119,7 @@ CustomTask *CalcJKTask::StepCalculation(void)
 	//double xDeriv[maxShapeNodes],yDeriv[maxShapeNodes],zDeriv[maxShapeNodes];
     
     // set up strain fields for crack extrapolations
+    int totalPatches = fmobj->GetTotalNumberOfPatches();
 //#pragma omp parallel private(nds,fn,xDeriv,yDeriv,zDeriv)
 #pragma omp parallel private(ndsArray,fn)
     {	// in case 2D planar
@@ -128,72 +129,73 @@ CustomTask *CalcJKTask::StepCalculation(void)
         for(int i=1;i<=nnodes;i++)
             nd[i]->ZeroDisp();
 	
-        // zero displacement fields on ghost nodes
-        int pn = MPMTask::GetPatchNumber();
-        patches[pn]->ZeroDisp();
-        
-        // loop over only non-rigid particles in patch that do not ignore cracks
-        MPMBase *mpnt = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
-        while(mpnt!=NULL)
-        {   // material reference
-            const MaterialBase *matref = theMaterials[mpnt->MatID()];
+        // zero displacement fields on ghost nodes of each patch and extrapolate its particles
+#pragma omp for
+        for(int pn=0;pn<totalPatches;pn++)
+        {   patches[pn]->ZeroDisp();
+            
+            // loop over only non-rigid particles in patch that do not ignore cracks
+            MPMBase *mpnt = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
+            while(mpnt!=NULL)
+            {   // material reference
+                const MaterialBase *matref = theMaterials[mpnt->MatID()];
 		
-            // find shape functions and derviatives
-            const ElementBase *elref = theElements[mpnt->ElemID()];
-			int *nds = ndsArray;
-			elref->GetShapeFunctions(fn,&nds,mpnt);
-            int numnds = nds[0];
+                // find shape functions and derviatives
+                const ElementBase *elref = theElements[mpnt->ElemID()];
+				int *nds = ndsArray;
+				elref->GetShapeFunctions(fn,&nds,mpnt);
+                int numnds = nds[0];
 		
-            // Add particle property to each node in the element
-            NodalPoint *ndmi;
-            short vfld;
-            double fnmp;
-            for(int i=1;i<=numnds;i++)
-            {   // global mass matrix
-                vfld=(short)mpnt->vfld[i];				// velocity field to use
-                fnmp=fn[i]*mpnt->mp;
+                // Add particle property to each node in the element
+                NodalPoint *ndmi;
+                short vfld;
+                double fnmp;
+                for(int i=1;i<=numnds;i++)
+                {   // global mass matrix
+                    vfld=(short)mpnt->vfld[i];				// velocity field to use
+                    fnmp=fn[i]*mpnt->mp;
                 
-                // get node pointer
-                ndmi = MPMTask::GetNodePointer(pn,nds[i]);
+                    // get node pointer
+                    ndmi = MPMTask::GetNodePointer(pn,nds[i]);
 			
-                // get 2D gradient terms (dimensionless) and track material (if needed)
-                int activeMatField = matref->GetActiveField();
-				Matrix3 gradU = mpnt->GetDisplacementGradientMatrix();
-                ndmi->AddUGradient(vfld,fnmp,gradU(0,0),gradU(0,1),gradU(1,0),gradU(1,1),activeMatField,mpnt->mp);
-
-				// GRID_JTERMS
-				double rho = matref->GetRho(NULL);
-				if(JGridEnergy)
-				{	// Add velocity (scaled by sqrt(rho) such that v^2 is 2 X grid kinetic energy in nJ/mm^3)
-					// In axisymmetric, kinetic energy density is 2 pi (0.5 m v^2)/(2 pi rp Ap), but since m = rho rp Ap
-					//		kinetic energy density is still 0.5 rho v^2
-					ndmi->AddGridVelocity(vfld,fnmp*sqrt(rho),mpnt->vel.x,mpnt->vel.y);
+                    // get 2D gradient terms (dimensionless) and track material (if needed)
+                    int activeMatField = matref->GetActiveField();
+					Matrix3 gradU = mpnt->GetDisplacementGradientMatrix();
+                    ndmi->AddUGradient(vfld,fnmp,gradU(0,0),gradU(0,1),gradU(1,0),gradU(1,1),activeMatField,mpnt->mp);
+
+					// GRID_JTERMS
+					double rho = matref->GetRho(NULL);
+					if(JGridEnergy)
+					{	// Add velocity (scaled by sqrt(rho) such that v^2 is 2 X grid kinetic energy in nJ/mm^3)
+						// In axisymmetric, kinetic energy density is 2 pi (0.5 m v^2)/(2 pi rp Ap), but since m = rho rp Ap
+						//		kinetic energy density is still 0.5 rho v^2
+						ndmi->AddGridVelocity(vfld,fnmp*sqrt(rho),mpnt->vel.x,mpnt->vel.y);
 					
-					// scale by rho to get actual stress
-					fnmp *= rho;
-				}
-				else
-				{	// scale by rho to get specific energy and actual stress
-					fnmp *= rho;
+						// scale by rho to get actual stress
+						fnmp *= rho;
+					}
+					else
+					{	// scale by rho to get specific energy and actual stress
+						fnmp *= rho;
 					
-					// get energy and rho*energy has units nJ/mm^3
-					// In axisymmetric, energy density is 2 pi m U/(2 pi rp Ap), but since m = rho rp Ap
-					//		energy density is still rho*energy
-					ndmi->AddEnergy(vfld,fnmp,mpnt->vel.x,mpnt->vel.y,mpnt->GetWorkEnergy());
-				}
+						// get energy and rho*energy has units nJ/mm^3
+						// In axisymmetric, energy density is 2 pi m U/(2 pi rp Ap), but since m = rho rp Ap
+						//		energy density is still rho*energy
+						ndmi->AddEnergy(vfld,fnmp,mpnt->vel.x,mpnt->vel.y,mpnt->GetWorkEnergy());
+					}
 			
-                // get a nodal stress (rho*stress has units N/m^2 = uN/mm^2)
-                Tensor sp = mpnt->ReadStressTensor();
-                ndmi->AddStress(vfld,fnmp,&sp);
-            }
+                    // get a nodal stress (rho*stress has units N/m^2 = uN/mm^2)
+                    Tensor sp = mpnt->ReadStressTensor();
+                    ndmi->AddStress(vfld,fnmp,&sp);
+                }
             
-            // next non-rigid material point
-            mpnt = (MPMBase *)mpnt->GetNextObject();
+                // next non-rigid material point
+                mpnt = (MPMBase *)mpnt->GetNextObject();
+            }
         }
     }
         
     // copy ghost to real nodes
-    int totalPatches = fmobj->GetTotalNumberOfPatches();
     if(totalPatches>1)
     {	for(int j=0;j<totalPatches;j++)
             patches[j]->JKTaskReduction();
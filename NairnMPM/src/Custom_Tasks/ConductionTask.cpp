@@ -26,6 +26,7 @@
 #include "Materials/MaterialBase.hpp"
 #include "Boundary_Conditions/NodalTempBC.hpp"
 #include "Boundary_Conditions/MatPtHeatFluxBC.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 #include "Cracks/CrackHeader.hpp"
 #include "MPM_Classes/MPMBase.hpp"
 #include "Nodes/NodalPoint.hpp"
@@ -82,17 +83,30 @@ TransportTask *ConductionTask::Initialize(void)
 	
 	// allocate conduction data on each particle
     // done before know number of nonrigid, so do on all
-	int size = 3;
-	if(crackGradT>0) size+=3;
-	if(materialGradT>0) size+=3;
 	for(int p=0;p<nmpms;p++)
-	{	mpm[p]->pTemp = new double[size];
-		for(int i=0;i<size;i++) mpm[p]->pTemp[i] = 0.;
-	}
+		AllocateParticleGradients(mpm[p]);
 	
 	return nextTask;
 }
 
+// allocate and zero conduction gradient(s) on a particle
+// throws std::bad_alloc
+void ConductionTask::AllocateParticleGradients(MPMBase *mptr) const
+{
+	int size = NumberOfParticleGradients();
+	mptr->pTemp = new double[size];
+	for(int i=0;i<size;i++) mptr->pTemp[i] = 0.;
+}
+
+// number of doubles in conduction gradient(s) on each particle
+int ConductionTask::NumberOfParticleGradients(void) const
+{
+	int size = 3;
+	if(crackGradT>0) size+=3;
+	if(materialGradT>0) size+=3;
+	return size;
+}
+
 #pragma mark MASS AND MOMENTUM EXTRAPOLATIONS
 
 // Task 1 Extrapolation of temperature to the grid
@@ -150,52 +164,69 @@ TransportTask *ConductionTask::AddForces(NodalPoint *ndptr,MPMBase *mptr,double
 // one selected by grid based BC
 TransportTask *ConductionTask::SetTransportForceAndFluxBCs(double deltime)
 {
-    // Paste back noBC temperature
-    int i;
-    NodalTempBC *nextBC=firstTempBC;
-    while(nextBC!=NULL)
-    {   i=nextBC->GetNodeNum(mtime);
-		if(i!=0)
-		{	nextBC->PasteNodalValue(nd[i]);
-			nextBC->InitQReaction();
-			double qflow = -nd[i]->gCond.gQ;
-			nextBC->SuperposeQReaction(qflow);
-			nd[i]->gCond.gQ = 0.;
+	// BCs grouped by node to loop over nodes in parallel
+	CommonException *bcErr = NULL;
+	
+#pragma omp parallel for
+	for(int g=0;g<tempBCGroups.numGroups;g++)
+	{	int k,i;
+		NodalTempBC *nextBC;
+		try
+		{	// Paste back noBC temperature
+			for(k=tempBCGroups.groupStart[g];k<tempBCGroups.groupStart[g+1];k++)
+			{	nextBC = (NodalTempBC *)tempBCGroups.bcs[k];
+				i=nextBC->GetNodeNum(mtime);
+				if(i!=0)
+				{	nextBC->PasteNodalValue(nd[i]);
+					nextBC->InitQReaction();
+					double qflow = -nd[i]->gCond.gQ;
+					nextBC->SuperposeQReaction(qflow);
+					nd[i]->gCond.gQ = 0.;
+				}
+			}
+			
+			// Set force to - T(no BC)/timestep (only once per node)
+			for(k=tempBCGroups.groupStart[g];k<tempBCGroups.groupStart[g+1];k++)
+			{	nextBC = (NodalTempBC *)tempBCGroups.bcs[k];
+				i=nextBC->GetNodeNum(mtime);
+				if(i!=0)
+				{	// but only once per node in case more than one Temperature BC on the node
+					if(nd[i]->gCond.gQ==0.)
+					{	// Power (energy/time)
+						double qflow = -nd[i]->gCond.gVCT*nd[i]->gCond.gTValue/deltime;
+						nd[i]->gCond.gQ = qflow;
+						// for global archive of boundary heat
+						nextBC->SuperposeQReaction(qflow);
+					}
+				}
+			}
+			
+			// Now add each superposed temperature BC at incremented time
+			// Can superpose T, but one should be absolute T and others as T increments
+			for(k=tempBCGroups.groupStart[g];k<tempBCGroups.groupStart[g+1];k++)
+			{	nextBC = (NodalTempBC *)tempBCGroups.bcs[k];
+				i=nextBC->GetNodeNum(mtime);
+				if(i!=0)
+				{	// Power (energy/time)
+					double qflow = nd[i]->gCond.gVCT*nextBC->BCValue(mtime)/deltime;
+					nd[i]->gCond.gQ += qflow;
+					// for global archive of boundary flow
+					nextBC->SuperposeQReaction(qflow);
+				}
+			}
 		}
-        nextBC=(NodalTempBC *)nextBC->GetNextObject();
-	}
-
-    // Set force to - T(no BC)/timestep (only once per node)
-    nextBC=firstTempBC;
-    while(nextBC!=NULL)
-	{   i=nextBC->GetNodeNum(mtime);
-		if(i!=0)
-		{	// but only once per node in case more than one Temperature BC on the node
-			if(nd[i]->gCond.gQ==0.)
-			{	// Power (energy/time)
-				double qflow = -nd[i]->gCond.gVCT*nd[i]->gCond.gTValue/deltime;
-				nd[i]->gCond.gQ = qflow;
-				// for global archive of boundary heat
-				nextBC->SuperposeQReaction(qflow);
+		catch(CommonException& err)
+		{	if(bcErr==NULL)
+			{
+#pragma omp critical (error)
+				bcErr = new CommonException(err);
 			}
 		}
-        nextBC=(NodalTempBC *)nextBC->GetNextObject();
 	}
-    
-    // Now add each superposed temperature BC at incremented time
-	// Can superpose T, but one should be absolute T and others as T increments
-    nextBC=firstTempBC;
-    while(nextBC!=NULL)
-    {	i=nextBC->GetNodeNum(mtime);
-		if(i!=0)
-		{	// Power (energy/time)
-			double qflow = nd[i]->gCond.gVCT*nextBC->BCValue(mtime)/deltime;
-			nd[i]->gCond.gQ += qflow;
-			// for global archive of boundary flow
-			nextBC->SuperposeQReaction(qflow);
-		}
-        nextBC=(NodalTempBC *)nextBC->GetNextObject();
-    }
+	if(bcErr!=NULL) throw *bcErr;
+	
+	// same for temperatures set by rigid particles
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->SetTransportForces(this,deltime,true);
 	
 	// --------- heat flux BCs -------------
 	MatPtLoadBC *nextFlux = firstHeatFluxPt;
@@ -239,8 +270,10 @@ TransportTask *ConductionTask::TransportTimeStepFactor(int matid,double *diffCon
 // return point on node to transport field
 TransportField *ConductionTask::GetTransportFieldPtr(NodalPoint *ndpt) const { return &(ndpt->gCond); }
 
-// return first boundary condition
+// return first boundary condition and direction bit for its BCs
 NodalValueBC *ConductionTask::GetFirstBCPtr(void) const { return firstTempBC; }
+int ConductionTask::GetSetDirection(void) const { return TEMP_DIRECTION; }
+NodalBCGroups *ConductionTask::GetBCGroups(void) const { return &tempBCGroups; }
 MatPtLoadBC *ConductionTask::GetFirstFluxBCPtr(void) const { return firstHeatFluxPt; }
 
 // particle values
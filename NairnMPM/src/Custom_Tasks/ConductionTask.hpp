@@ -29,6 +29,8 @@ class ConductionTask : public TransportTask
 	
 		// initialize
 		virtual TransportTask *Initialize(void);
+		virtual void AllocateParticleGradients(MPMBase *) const;
+		virtual int NumberOfParticleGradients(void) const;
 	
 		// mass and momentum
 		virtual TransportTask *Task1Extrapolation(NodalPoint *,MPMBase *,double,short,int);
@@ -49,6 +51,8 @@ class ConductionTask : public TransportTask
         virtual TransportTask *TransportTimeStepFactor(int,double *);
         virtual TransportField *GetTransportFieldPtr(NodalPoint *) const;
         virtual NodalValueBC *GetFirstBCPtr(void) const;
+		virtual int GetSetDirection(void) const;
+		virtual NodalBCGroups *GetBCGroups(void) const;
 		virtual MatPtLoadBC *GetFirstFluxBCPtr(void) const;
         virtual double *GetParticleValuePtr(MPMBase *mptr) const;
         virtual double *GetPrevParticleValuePtr(MPMBase *mptr) const;
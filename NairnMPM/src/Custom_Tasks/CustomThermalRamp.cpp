@@ -450,7 +450,9 @@ CustomTask *CustomThermalRamp::StepCalculation(void)
 		for(int p=0;p<nmpmsNR;p++)
         {   double dTp = deltaT;
 			if(scaleFxn!=NULL)
-				dTp = deltaT*scaleFxn->XYZTValue(&mpm[p]->pos,mtime*UnitsController::Scaling(1000.));
+			{	Vector xp = mpm[p]->pos;
+				dTp = deltaT*scaleFxn->XYZTValue(&xp,mtime*UnitsController::Scaling(1000.));
+			}
 			
 			if(property==RAMP_TEMP)
 			{	mpm[p]->pTemperature += dTp;
@@ -45,9 +45,7 @@ TransportTask *DiffusionTask::Initialize(void)
 	// allocate diffusion data on each particle
     // done before know number of nonrigid, so do on all
 	for(int p=0;p<nmpms;p++)
-	{	mpm[p]->pDiffusion = new double[3];
-		for(int i=0;i<3;i++) mpm[p]->pDiffusion[i] = 0.;
-	}
+		AllocateParticleGradients(mpm[p]);
 	
 	cout << "Coupled " << TaskName() << endl;
 	
@@ -77,6 +75,18 @@ TransportTask *DiffusionTask::Initialize(void)
 	return nextTask;
 }
 
+// allocate and zero diffusion gradient on a particle
+// throws std::bad_alloc
+void DiffusionTask::AllocateParticleGradients(MPMBase *mptr) const
+{
+	int size = NumberOfParticleGradients();
+	mptr->pDiffusion = new double[size];
+	for(int i=0;i<size;i++) mptr->pDiffusion[i] = 0.;
+}
+
+// number of doubles in diffusion gradient on each particle
+int DiffusionTask::NumberOfParticleGradients(void) const { return 3; }
+
 #pragma mark MASS AND MOMENTUM EXTRAPOLATIONS
 
 // Task 1 Extrapolation of temperature to the grid
@@ -157,8 +167,10 @@ TransportTask *DiffusionTask::TransportTimeStepFactor(int matid,double *diffCon)
 // return pointer on node to transport field
 TransportField *DiffusionTask::GetTransportFieldPtr(NodalPoint *ndpt) const { return &(ndpt->gDiff); }
 
-// return first boundary condition
+// return first boundary condition and direction bit for its BCs
 NodalValueBC *DiffusionTask::GetFirstBCPtr(void) const { return firstConcBC; }
+int DiffusionTask::GetSetDirection(void) const { return CONC_DIRECTION; }
+NodalBCGroups *DiffusionTask::GetBCGroups(void) const { return &concBCGroups; }
 MatPtLoadBC *DiffusionTask::GetFirstFluxBCPtr(void) const { return firstFluxPt; }
 
 // particle values
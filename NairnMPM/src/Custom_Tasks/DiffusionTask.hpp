@@ -30,6 +30,8 @@ class DiffusionTask : public TransportTask
 
 		// initialize
 		virtual TransportTask *Initialize(void);
+		virtual void AllocateParticleGradients(MPMBase *) const;
+		virtual int NumberOfParticleGradients(void) const;
 	
 		// mass and momentum
 		virtual TransportTask *Task1Extrapolation(NodalPoint *,MPMBase *,double,short,int);
@@ -48,6 +50,8 @@ class DiffusionTask : public TransportTask
         virtual TransportTask *TransportTimeStepFactor(int,double *);
         virtual TransportField *GetTransportFieldPtr(NodalPoint *) const;
         virtual NodalValueBC *GetFirstBCPtr(void) const;
+		virtual int GetSetDirection(void) const;
+		virtual NodalBCGroups *GetBCGroups(void) const;
 		virtual MatPtLoadBC *GetFirstFluxBCPtr(void) const;
         virtual double *GetParticleValuePtr(MPMBase *mptr) const;
         virtual double *GetPrevParticleValuePtr(MPMBase *mptr) const;
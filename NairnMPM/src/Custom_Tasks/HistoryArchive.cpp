@@ -11,6 +11,7 @@
 #include "NairnMPM_Class/NairnMPM.hpp"
 #include "System/ArchiveData.hpp"
 #include "System/UnitsController.hpp"
+#include "System/ColumnArchive.hpp"
 
 static int historyArg;
 
@@ -21,10 +22,12 @@ HistoryArchive::HistoryArchive()
 {
 	customArchiveTime = -1.;
 	nextCustomArchiveTime = -1.;
+	binary = 0;
+	historyColumns = NULL;
 }
 
 // Return name of this task
-const char *HistoryArchive::TaskName(void) { return "Archive particle history data to a tab-delimited file"; }
+const char *HistoryArchive::TaskName(void) { return "Archive particle history data to a tab-delimited or binary file"; }
 
 // Read task parameter - if pName is valid, set input for type
 //    and return pointer to the class variable
@@ -41,6 +44,11 @@ char *HistoryArchive::InputParam(char *pName,int &input,double &gScaling)
 		return UnitsController::ScaledPtr((char *)&nextCustomArchiveTime,gScaling,1.e-3);
     }
 	
+    else if(strcmp(pName,"binary")==0)
+    {	input=INT_NUM;
+		return (char *)&binary;
+    }
+	
 	else
 	{	// assume an integer
 		int historyNum;
@@ -61,7 +69,10 @@ char *HistoryArchive::InputParam(char *pName,int &input,double &gScaling)
 // called once at start of MPM analysis - initialize and print info
 CustomTask *HistoryArchive::Initialize(void)
 {
-    cout << "Archive particle history results to tab-delimited text files." << endl;
+	if(binary)
+		cout << "Archive particle history results to binary columnar file." << endl;
+	else
+		cout << "Archive particle history results to tab-delimited text files." << endl;
 	
 	// time interval
 	cout << "   Archive time: ";
@@ -118,6 +129,10 @@ CustomTask *HistoryArchive::PrepareForStep(bool &needExtraps)
 CustomTask *HistoryArchive::StepCalculation(void)
 {
 	if(doHistoryExport)
-		archiver->ArchiveHistoryFile(mtime+timestep,quantity);
+	{	// binary file created at first archive (after archive folder is ready)
+		if(binary && historyColumns==NULL)
+			historyColumns = archiver->CreateHistoryColumns(quantity);
+		archiver->ArchiveHistoryFile(mtime+timestep,quantity,historyColumns);
+	}
     return nextTask;
 }
@@ -5,6 +5,10 @@
 	Created by John Nairn on 10/26/12.
 	Copyright (c) 2012 John A. Nairn, All rights reserved.
 
+	Particle history is written to tab-delimited text files, one per archive,
+	or to a single binary columnar file when the binary parameter is set
+	(see ColumnArchive.hpp for file format).
+
 	Dependencies
 		CustomTask.hpp
 ********************************************************************************/
@@ -15,6 +19,8 @@
 
 #include "Custom_Tasks/CustomTask.hpp"
 
+class ColumnArchive;
+
 class HistoryArchive : public CustomTask
 {
 public:
@@ -34,6 +40,8 @@ private:
 	vector< int > quantity;
 	double customArchiveTime,nextCustomArchiveTime;
 	bool doHistoryExport;			// flag to export the file this step
+	int binary;						// nonzero for binary columnar file
+	ColumnArchive *historyColumns;	// binary file (created at first archive)
 	
 };
 
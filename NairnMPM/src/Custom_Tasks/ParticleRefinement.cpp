@@ -0,0 +1,535 @@
+/********************************************************************************
+	ParticleRefinement.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Particles are split or merged only in the custom task step, which is
+	after particle updates and before elements are reset. New and changed
+	particles are therefore assigned to their correct elements and patches
+	by ResetElementsTask before the next time step.
+ ********************************************************************************/
+
+#include "stdafx.h"
+#include "Custom_Tasks/ParticleRefinement.hpp"
+#include "NairnMPM_Class/NairnMPM.hpp"
+#include "NairnMPM_Class/MeshInfo.hpp"
+#include "MPM_Classes/MatPoint2D.hpp"
+#include "MPM_Classes/MatPoint3D.hpp"
+#include "Materials/MaterialBase.hpp"
+#include "Elements/ElementBase.hpp"
+#include "Patches/GridPatch.hpp"
+#include "Custom_Tasks/TransportTask.hpp"
+#include "Boundary_Conditions/MatPtLoadBC.hpp"
+#include "Boundary_Conditions/MatPtTractionBC.hpp"
+#include "Boundary_Conditions/MatPtFluxBC.hpp"
+#include "Boundary_Conditions/MatPtHeatFluxBC.hpp"
+#include "Global_Quantities/GlobalQuantity.hpp"
+#include "Cracks/CrackHeader.hpp"
+#include "Exceptions/CommonException.hpp"
+
+#pragma mark Constructors and Destructors
+
+// Constructors
+ParticleRefinement::ParticleRefinement()
+{
+	maxStretch = 1.5;
+	minStretch = 0.5;
+	maxPerCell = -1;
+	maxParticles = -1;
+	refineSteps = 10;
+	verbose = 0;
+
+	totalSplit = 0;
+	totalMerged = 0;
+	doRefine = false;
+}
+
+// Return name of this task
+const char *ParticleRefinement::TaskName(void) { return "Adaptive particle refinement"; }
+
+// Read task parameter - if pName is valid, set input for type
+//    and return pointer to the class variable
+char *ParticleRefinement::InputParam(char *pName,int &input,double &gScaling)
+{
+	if(strcmp(pName,"maxStretch")==0)
+	{	input=DOUBLE_NUM;
+		return (char *)&maxStretch;
+	}
+
+	else if(strcmp(pName,"minStretch")==0)
+	{	input=DOUBLE_NUM;
+		return (char *)&minStretch;
+	}
+
+	else if(strcmp(pName,"maxPerCell")==0)
+	{	input=INT_NUM;
+		return (char *)&maxPerCell;
+	}
+
+	else if(strcmp(pName,"maxParticles")==0)
+	{	input=INT_NUM;
+		return (char *)&maxParticles;
+	}
+
+	else if(strcmp(pName,"refineSteps")==0)
+	{	input=INT_NUM;
+		return (char *)&refineSteps;
+	}
+
+	else if(strcmp(pName,"verbose")==0)
+	{	input=INT_NUM;
+		return (char *)&verbose;
+	}
+
+	// check remaining commands
+	return CustomTask::InputParam(pName,input,gScaling);
+}
+
+// Called while reading when done setting all parameters
+// Make and needed settings, throw SAXExecption on error
+void ParticleRefinement::Finalize(void)
+{
+	if(maxStretch<=0. && minStretch<=0.)
+		ThrowSAXException("ParticleRefinement custom task did not activate splitting or merging of particles");
+
+	if(maxStretch>0. && maxStretch<=1.)
+		ThrowSAXException("ParticleRefinement custom task maxStretch must be greater than 1");
+
+	if(minStretch>=1.)
+		ThrowSAXException("ParticleRefinement custom task minStretch must be less than 1");
+
+	// merged particles must not be split again
+	if(maxStretch>0. && minStretch>0. && 2.*minStretch>=maxStretch)
+		ThrowSAXException("ParticleRefinement custom task maxStretch must be more than twice minStretch");
+
+	if(refineSteps<1) refineSteps = 1;
+}
+
+// called once at start of MPM analysis - initialize and print info
+// throws CommonException()
+CustomTask *ParticleRefinement::Initialize(void)
+{
+	if(fmobj->IsAxisymmetric())
+		throw CommonException("ParticleRefinement custom task is not available for axisymmetric analyses","ParticleRefinement::Initialize");
+	if(firstCrack!=NULL)
+		throw CommonException("ParticleRefinement custom task is not available for analyses with cracks","ParticleRefinement::Initialize");
+	if(!mpmgrid.IsStructuredEqualElementsGrid())
+		throw CommonException("ParticleRefinement custom task needs a grid with equally sized elements","ParticleRefinement::Initialize");
+
+	// nominal particle size from points per element
+	double ptsPerSide = fmobj->IsThreeD() ? pow((double)fmobj->ptsPerElement,1./3.) : sqrt((double)fmobj->ptsPerElement);
+	double lp0 = 1./floor(ptsPerSide+0.5);
+	Vector cell = mpmgrid.GetCellSize();
+	nominalSize = MakeVector(0.5*lp0*cell.x,0.5*lp0*cell.y,0.5*lp0*cell.z);
+
+	if(maxPerCell<=0) maxPerCell = 2*fmobj->ptsPerElement;
+
+	cout << "Split and merge particles every ";
+	if(refineSteps>1)
+		cout << refineSteps << " time steps" << endl;
+	else
+		cout << "time step" << endl;
+	if(maxStretch>0.)
+		cout << "   Split particles stretched by more than " << maxStretch << endl;
+	else
+		cout << "   Splitting not used" << endl;
+	if(minStretch>0.)
+	{	cout << "   Merge particles compressed below " << minStretch
+				<< " in elements with more than " << maxPerCell << " particles" << endl;
+	}
+	else
+		cout << "   Merging not used" << endl;
+	if(maxParticles>0)
+		cout << "   Maximum number of particles: " << maxParticles << endl;
+
+	nextRefineStep = refineSteps;
+
+	return nextTask;
+}
+
+#pragma mark GENERIC TASK METHODS
+
+// called when MPM step is getting ready to do custom tasks
+// never uses extrapolations so no need to set needExtraps
+CustomTask *ParticleRefinement::PrepareForStep(bool &needExtraps)
+{
+	doRefine = false;
+	if(fmobj->mstep>=nextRefineStep)
+	{	doRefine = true;
+		nextRefineStep += refineSteps;
+	}
+	return nextTask;
+}
+
+// Split and merge particles now
+// throws CommonException() or std::bad_alloc
+CustomTask *ParticleRefinement::StepCalculation(void)
+{
+	if(!doRefine) return nextTask;
+
+	// particles that must keep their number or cannot be copied
+	vector< char > pinned;
+	FindPinnedParticles(pinned);
+
+	// split first, then merge remaining particles
+	vector< MPMBase * > children;
+	int numSplit = SplitParticles(pinned,children);
+	vector< char > removed(nmpmsNR,0);
+	int numMerged = MergeParticles(pinned,removed);
+	if(numSplit==0 && numMerged==0) return nextTask;
+
+	// take merged particles out of patches and create new particle list
+	if(numMerged>0) RemoveMergedParticles(removed);
+	RebuildParticleList(removed,children);
+	totalSplit += numSplit;
+	totalMerged += numMerged;
+
+	if(verbose)
+	{	cout << "# Step " << fmobj->mstep << ": split " << numSplit << " and merged " << numMerged
+				<< " particles (now " << nmpms << " particles; " << totalSplit << " split and "
+				<< totalMerged << " merged since start)" << endl;
+	}
+
+	return nextTask;
+}
+
+#pragma mark ParticleRefinement::Methods
+
+// Flag particles that cannot be split or merged (particles with boundary conditions or
+// tracked by global quantities, particles that left the grid, and particles whose history
+// is not stored as doubles)
+void ParticleRefinement::FindPinnedParticles(vector< char > &pinned) const
+{
+	pinned.assign(nmpmsNR,0);
+
+	MatPtLoadBC *ptBCs[4] = { firstLoadedPt,(MatPtLoadBC *)firstTractionPt,
+								(MatPtLoadBC *)firstFluxPt,(MatPtLoadBC *)firstHeatFluxPt };
+	for(int i=0;i<4;i++)
+	{	MatPtLoadBC *nextBC = ptBCs[i];
+		while(nextBC!=NULL)
+		{	if(nextBC->ptNum>0 && nextBC->ptNum<=nmpmsNR) pinned[nextBC->ptNum-1] = 1;
+			nextBC = (MatPtLoadBC *)nextBC->GetNextObject();
+		}
+	}
+
+	GlobalQuantity *nextGlobal = firstGlobal;
+	while(nextGlobal!=NULL)
+	{	int p = nextGlobal->GetTracerParticleNumber();
+		if(p>=0 && p<nmpmsNR) pinned[p] = 1;
+		nextGlobal = nextGlobal->GetNextGlobal();
+	}
+
+	for(int p=0;p<nmpmsNR;p++)
+	{	MPMBase *mptr = mpm[p];
+		int numHistory = theMaterials[mptr->MatID()]->NumberOfHistoryDoubles();
+		if(mptr->HasLeftTheGridBefore() || (mptr->GetHistoryPtr(0)!=NULL) != (numHistory>0))
+			pinned[p] = 1;
+	}
+}
+
+// Get semi side vectors and their stretch relative to nominal particle size
+// r and lam must have room for three values (3rd one is 1 in 2D)
+void ParticleRefinement::GetStretches(MPMBase *mptr,Vector *r,double *lam) const
+{
+	ZeroVector(&r[2]);
+	mptr->GetSemiSideVectors(&r[0],&r[1],&r[2]);
+	lam[0] = sqrt(DotVectors(&r[0],&r[0]))/nominalSize.x;
+	lam[1] = sqrt(DotVectors(&r[1],&r[1]))/nominalSize.y;
+	lam[2] = fmobj->IsThreeD() ? sqrt(DotVectors(&r[2],&r[2]))/nominalSize.z : 1. ;
+}
+
+// Split particles stretched beyond maxStretch along their most stretched axis
+// Return number split and new particles in children (not yet in mpm[])
+// throws CommonException() or std::bad_alloc
+int ParticleRefinement::SplitParticles(vector< char > &pinned,vector< MPMBase * > &children)
+{
+	if(maxStretch<=0.) return 0;
+
+	int numAxes = fmobj->IsThreeD() ? 3 : 2;
+	Vector r[3];
+	double lam[3];
+	for(int p=0;p<nmpmsNR;p++)
+	{	if(pinned[p]) continue;
+		if(maxParticles>0 && nmpms+(int)children.size()>=maxParticles) break;
+
+		// most stretched axis
+		MPMBase *mptr = mpm[p];
+		GetStretches(mptr,r,lam);
+		int axis = 0;
+		for(int i=1;i<numAxes;i++)
+		{	if(lam[i]>lam[axis]) axis = i;
+		}
+		if(lam[axis]<=maxStretch) continue;
+
+		MPMBase *child;
+		if(SplitParticle(mptr,r,axis,&child))
+		{	children.push_back(child);
+			pinned[p] = 1;				// split particles are not merged in the same step
+		}
+	}
+
+	return (int)children.size();
+}
+
+// Split particle in half along one semi side vector. The particle becomes one
+// half and the other half is returned in child. Return false if either half
+// would be outside the grid.
+// throws CommonException() or std::bad_alloc
+bool ParticleRefinement::SplitParticle(MPMBase *mptr,Vector *r,int axis,MPMBase **child)
+{
+	// new centers at middle of each half
+	Vector posA = mptr->pos;
+	AddScaledVector(&posA,&r[axis],-0.5);
+	Vector posB = mptr->pos;
+	AddScaledVector(&posB,&r[axis],0.5);
+	if(!InsideGrid(&posA) || !InsideGrid(&posB)) return false;
+
+	// shift of centers in initial configuration
+	double ru[3] = {0.,0.,0.};
+	mptr->GetUndeformedSemiSides(&ru[0],&ru[1],&ru[2]);
+	Vector shift;
+	ZeroVector(&shift);
+	if(axis==0)
+		shift.x = 0.5*ru[0];
+	else if(axis==1)
+		shift.y = 0.5*ru[1];
+	else
+		shift.z = 0.5*ru[2];
+
+	// halve mass, external force, and size along the axis
+	mptr->mp *= 0.5;
+	ScaleVector(mptr->GetPFext(),0.5);
+	Vector lp;
+	mptr->GetDimensionlessSize(lp);
+	if(axis==0)
+		lp.x *= 0.5;
+	else if(axis==1)
+		lp.y *= 0.5;
+	else
+		lp.z *= 0.5;
+	mptr->SetDimensionlessSize(&lp);
+
+	// the new half has the same state
+	*child = CopyParticle(mptr);
+
+	mptr->pos = posA;
+	Vector xorig = mptr->origpos;
+	mptr->origpos = *SubVector(&xorig,&shift);
+	(*child)->pos = posB;
+	xorig = (*child)->origpos;
+	(*child)->origpos = *AddVector(&xorig,&shift);
+
+	// the child joins the parent's patch (ResetElementsTask will move it if needed)
+	int pn = fmobj->GetTotalNumberOfPatches()>1 ? mpmgrid.GetPatchForElement(mptr->ElemID()) : 0 ;
+	patches[pn]->AddParticle(*child);
+
+	return true;
+}
+
+// Create new particle with the same structures and state as mptr
+// throws CommonException() or std::bad_alloc
+MPMBase *ParticleRefinement::CopyParticle(MPMBase *mptr) const
+{
+	// element and material numbers are 1 based in constructors
+	int matid = mptr->MatID();
+	MPMBase *newMptr;
+	if(fmobj->IsThreeD())
+		newMptr = new MatPoint3D(mptr->ElemID()+1,matid+1,0.);
+	else
+		newMptr = new MatPoint2D(mptr->ElemID()+1,matid+1,0.,mptr->thickness());
+
+	// same structures as the original particle
+	int numHistory = theMaterials[matid]->NumberOfHistoryDoubles();
+	if(numHistory>0)
+		newMptr->SetHistoryPtr((char *)theMaterials[matid]->CreateAndZeroDoubles(NULL,numHistory));
+	if(mptr->GetVelGrad()!=NULL)
+		newMptr->AllocateJStructures();
+	if(mptr->GetRtotPtr()!=NULL)
+		newMptr->InitRtot(*mptr->GetRtotPtr());
+	if(!newMptr->AllocateCPDIorGIMPStructures(ElementBase::useGimp,fmobj->IsThreeD()))
+		throw CommonException("Out of memory allocating CPDI domain structures","ParticleRefinement::CopyParticle");
+	TransportTask *nextTransport = transportTasks;
+	while(nextTransport!=NULL)
+	{	nextTransport->AllocateParticleGradients(newMptr);
+		nextTransport = nextTransport->GetNextTransportTask();
+	}
+
+	// copy the state
+	vector< char > state(mptr->SizeOfState());
+	mptr->PackState(&state[0]);
+	newMptr->UnpackState(&state[0]);
+
+	return newMptr;
+}
+
+// In elements with too many particles, merge pairs of adjacent particles of the same material and
+// size that are both compressed below minStretch along the same axis
+// Return number merged and set removed[p] for particles merged into another particle
+int ParticleRefinement::MergeParticles(vector< char > &pinned,vector< char > &removed)
+{
+	if(minStretch<=0.) return 0;
+
+	// nonrigid particles in each element
+	unordered_map< int,vector< int > > cells;
+	for(int p=0;p<nmpmsNR;p++)
+		cells[mpm[p]->ElemID()].push_back(p);
+
+	int numAxes = fmobj->IsThreeD() ? 3 : 2;
+	int numMerged = 0;
+	Vector ra[3],rb[3],lpa,lpb;
+	double lama[3],lamb[3];
+	unordered_map< int,vector< int > >::iterator cell;
+	for(cell=cells.begin();cell!=cells.end();++cell)
+	{	vector< int > &pts = cell->second;
+		int count = (int)pts.size();
+		for(int a=0;a<(int)pts.size() && count>maxPerCell;a++)
+		{	if(pinned[pts[a]] || removed[pts[a]]) continue;
+			MPMBase *mpa = mpm[pts[a]];
+			GetStretches(mpa,ra,lama);
+			mpa->GetDimensionlessSize(lpa);
+
+			for(int b=a+1;b<(int)pts.size();b++)
+			{	if(pinned[pts[b]] || removed[pts[b]]) continue;
+				MPMBase *mpb = mpm[pts[b]];
+				if(mpb->MatID()!=mpa->MatID()) continue;
+				mpb->GetDimensionlessSize(lpb);
+				if(fabs(lpa.x-lpb.x)>1.e-6*lpa.x || fabs(lpa.y-lpb.y)>1.e-6*lpa.y ||
+				   	fabs(lpa.z-lpb.z)>1.e-6*lpa.z) continue;
+				GetStretches(mpb,rb,lamb);
+
+				// find axis where both are compressed and particles are adjacent along that axis
+				Vector xa = mpa->pos,xb = mpb->pos;
+				Vector d = SetDiffVectors(&xb,&xa);
+				double dist = sqrt(DotVectors(&d,&d));
+				int axis = -1;
+				for(int i=0;i<numAxes;i++)
+				{	if(lama[i]>=minStretch || lamb[i]>=minStretch) continue;
+					double ria = sqrt(DotVectors(&ra[i],&ra[i]));
+					double rib = sqrt(DotVectors(&rb[i],&rb[i]));
+					if(dist>1.25*(ria+rib)) continue;
+					if(fabs(DotVectors(&d,&ra[i]))<0.9*dist*ria) continue;
+					axis = i;
+					break;
+				}
+				if(axis<0) continue;
+
+				// merge b into a and double size of a along the axis
+				mpa->MergeState(mpb);
+				if(axis==0)
+					lpa.x *= 2.;
+				else if(axis==1)
+					lpa.y *= 2.;
+				else
+					lpa.z *= 2.;
+				mpa->SetDimensionlessSize(&lpa);
+				removed[pts[b]] = 1;
+				pinned[pts[a]] = 1;
+				count--;
+				numMerged++;
+				break;
+			}
+		}
+	}
+
+	return numMerged;
+}
+
+// Remove merged particles from the nonrigid lists of all patches
+void ParticleRefinement::RemoveMergedParticles(vector< char > &removed) const
+{
+	unordered_map< MPMBase *,int > mergedPts;
+	for(int p=0;p<nmpmsNR;p++)
+	{	if(removed[p]) mergedPts[mpm[p]] = p;
+	}
+
+	int totalPatches = fmobj->GetTotalNumberOfPatches();
+	for(int pn=0;pn<totalPatches;pn++)
+	{	MPMBase *mptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
+		MPMBase *prevMptr = NULL;
+		while(mptr!=NULL)
+		{	MPMBase *nextMptr = (MPMBase *)mptr->GetNextObject();
+			if(mergedPts.find(mptr)!=mergedPts.end())
+				patches[pn]->RemoveParticleAfter(mptr,prevMptr);
+			else
+				prevMptr = mptr;
+			mptr = nextMptr;
+		}
+	}
+}
+
+// Create new mpm[] with remaining nonrigid particles, then new particles, then rigid particles
+// Delete merged particles and renumber particles in boundary conditions and global quantities
+// throws std::bad_alloc
+void ParticleRefinement::RebuildParticleList(vector< char > &removed,vector< MPMBase * > &children) const
+{
+	int numRemoved = 0;
+	for(int p=0;p<nmpmsNR;p++)
+	{	if(removed[p]) numRemoved++;
+	}
+	int newNR = nmpmsNR-numRemoved+(int)children.size();
+	int newTotal = newNR+nmpms-nmpmsNR;
+	MPMBase **newMpm = new MPMBase *[newTotal];
+
+	// new zero-based number of each old particle (-1 if deleted)
+	vector< int > newNum(nmpms,-1);
+	int np = 0;
+	for(int p=0;p<nmpmsNR;p++)
+	{	if(removed[p])
+		{	mpm[p]->DeleteStructures();
+			delete mpm[p];
+		}
+		else
+		{	newNum[p] = np;
+			newMpm[np++] = mpm[p];
+		}
+	}
+	for(int i=0;i<(int)children.size();i++)
+		newMpm[np++] = children[i];
+	for(int p=nmpmsNR;p<nmpms;p++)
+	{	newNum[p] = np;
+		newMpm[np++] = mpm[p];
+	}
+
+	// particle boundary conditions (these particles are never removed)
+	MatPtLoadBC *ptBCs[4] = { firstLoadedPt,(MatPtLoadBC *)firstTractionPt,
+								(MatPtLoadBC *)firstFluxPt,(MatPtLoadBC *)firstHeatFluxPt };
+	for(int i=0;i<4;i++)
+	{	MatPtLoadBC *nextBC = ptBCs[i];
+		while(nextBC!=NULL)
+		{	if(nextBC->ptNum>0 && nextBC->ptNum<=nmpms) nextBC->ptNum = newNum[nextBC->ptNum-1]+1;
+			nextBC = (MatPtLoadBC *)nextBC->GetNextObject();
+		}
+	}
+
+	// tracer particles
+	GlobalQuantity *nextGlobal = firstGlobal;
+	while(nextGlobal!=NULL)
+	{	int p = nextGlobal->GetTracerParticleNumber();
+		if(p>=0 && p<nmpms) nextGlobal->SetTracerParticleNumber(newNum[p]);
+		nextGlobal = nextGlobal->GetNextGlobal();
+	}
+
+	// new list and counts
+	int shift = newNR-nmpmsNR;
+	nmpmsRB += shift;
+	nmpmsRC += shift;
+	nmpmsNR = newNR;
+	nmpms = newTotal;
+	delete [] mpm;
+	mpm = newMpm;
+}
+
+// true if point is in a non-edge element of the grid
+bool ParticleRefinement::InsideGrid(Vector *pt) const
+{
+	try
+	{	int iel = mpmgrid.FindElementFromPoint(pt,NULL)-1;
+		if(theElements[iel]->OnTheEdge()) return false;
+	}
+	catch(...)
+	{	return false;
+	}
+	return true;
+}
@@ -0,0 +1,69 @@
+/********************************************************************************
+	ParticleRefinement.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Optional adaptive particle refinement. Every refineSteps time steps,
+	non-rigid particles stretched along one of their initial axes by more
+	than maxStretch (relative to the nominal particle size for the grid)
+	are split in two along that axis. In elements with more than maxPerCell
+	non-rigid particles, pairs of neighboring particles of the same material
+	and size that are both compressed below minStretch along the same axis
+	are merged. Both conserve mass and momentum.
+
+	Dependencies
+		CustomTask.hpp
+********************************************************************************/
+
+#ifndef _PARTICLEREFINEMENT_
+
+#define _PARTICLEREFINEMENT_
+
+#include "Custom_Tasks/CustomTask.hpp"
+
+class ParticleRefinement : public CustomTask
+{
+	public:
+
+		// constructors and destructors
+		ParticleRefinement();
+
+		// standard methods
+		virtual void Finalize(void);
+		virtual const char *TaskName(void);
+		virtual char *InputParam(char *,int &,double &);
+
+		virtual CustomTask *Initialize(void);
+
+		virtual CustomTask *PrepareForStep(bool &);
+		virtual CustomTask *StepCalculation(void);
+
+	private:
+		// parameters
+		double maxStretch;
+		double minStretch;
+		int maxPerCell;
+		int maxParticles;
+		int refineSteps;
+		int verbose;
+
+		// settings
+		Vector nominalSize;			// undeformed semi sides of particles created by the grid
+		int nextRefineStep;
+		bool doRefine;
+		long totalSplit,totalMerged;
+
+		void FindPinnedParticles(vector< char > &) const;
+		void GetStretches(MPMBase *,Vector *,double *) const;
+		int SplitParticles(vector< char > &,vector< MPMBase * > &);
+		int MergeParticles(vector< char > &,vector< char > &);
+		bool SplitParticle(MPMBase *,Vector *,int,MPMBase **);
+		MPMBase *CopyParticle(MPMBase *) const;
+		void RemoveMergedParticles(vector< char > &) const;
+		void RebuildParticleList(vector< char > &,vector< MPMBase * > &) const;
+		bool InsideGrid(Vector *) const;
+};
+
+#endif
@@ -88,6 +88,7 @@
 #include "Exceptions/CommonException.hpp"
 #include "Boundary_Conditions/NodalValueBC.hpp"
 #include "Boundary_Conditions/MatPtLoadBC.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 
 // Task list
 TransportTask *transportTasks=NULL;
@@ -149,40 +150,58 @@ void TransportTask::GetContactNodalValue(NodalPoint *ndptr) {}
 // Task 1b - impose grid-based transport value BCs
 void TransportTask::ImposeValueBCs(double stepTime,bool copyFirst)
 {
-    int i;
-	NodalValueBC *nextBC;
-    
-    // Copy no-BC transport value
-	if(copyFirst)
-	{	nextBC = GetFirstBCPtr();
-		while(nextBC!=NULL)
-		{   i = nextBC->GetNodeNum(stepTime);
-			if(i!=0) nextBC->CopyNodalValue(nd[i]);
-			nextBC = (NodalValueBC *)nextBC->GetNextObject();
+	// BCs grouped by node to loop over nodes in parallel
+	NodalBCGroups *groups = GetBCGroups();
+	CommonException *bcErr = NULL;
+	
+#pragma omp parallel for
+	for(int g=0;g<groups->numGroups;g++)
+	{	int k,i;
+		NodalValueBC *nextBC;
+		try
+		{	// Copy no-BC transport value
+			if(copyFirst)
+			{	for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+				{	nextBC = (NodalValueBC *)groups->bcs[k];
+					i = nextBC->GetNodeNum(stepTime);
+					if(i!=0) nextBC->CopyNodalValue(nd[i]);
+				}
+			}
+			
+			// Zero them all
+			for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+			{	i = groups->bcs[k]->GetNodeNum(stepTime);
+				if(i!=0)
+				{   TransportField *gTrans = GetTransportFieldPtr(nd[i]);
+					gTrans->gTValue = 0.;
+				}
+			}
+			
+			// Now add all transport values to nodes with value BCs
+			for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+			{	nextBC = (NodalValueBC *)groups->bcs[k];
+				i = nextBC->GetNodeNum(stepTime);
+				if(i!=0)
+				{   TransportField *gTrans = GetTransportFieldPtr(nd[i]);
+					gTrans->gTValue += nextBC->BCValue(stepTime);
+				}
+			}
+		}
+		catch(CommonException& err)
+		{	if(bcErr==NULL)
+			{
+#pragma omp critical (error)
+				bcErr = new CommonException(err);
+			}
 		}
 	}
-    
-    // Zero them all
-    nextBC = GetFirstBCPtr();
-    while(nextBC!=NULL)
-    {   i = nextBC->GetNodeNum(stepTime);
-        if(i!=0)
-        {   TransportField *gTrans = GetTransportFieldPtr(nd[i]);
-            gTrans->gTValue = 0.;
-        }
-        nextBC = (NodalValueBC *)nextBC->GetNextObject();
-    }
-    
-    // Now add all transport values to nodes with value BCs
-    nextBC = GetFirstBCPtr();
-    while(nextBC!=NULL)
-    {   i = nextBC->GetNodeNum(stepTime);
-        if(i!=0)
-        {   TransportField *gTrans = GetTransportFieldPtr(nd[i]);
-            gTrans->gTValue += nextBC->BCValue(stepTime);
-        }
-        nextBC = (NodalValueBC *)nextBC->GetNextObject();
-    }
+	if(bcErr!=NULL) throw *bcErr;
+	
+	// Values set by rigid particles (on nodes without grid BCs)
+	if(rigidNodalBCs!=NULL)
+	{	if(copyFirst) rigidNodalBCs->CopyTransportValues(this);
+		rigidNodalBCs->ImposeTransportValues(this);
+	}
 }
 
 // Task 1b - get gradients in transport value on particles
@@ -279,38 +298,54 @@ TransportTask *TransportTask::SetTransportForceAndFluxBCs(double deltime)
 {
 	// --------- consistent forces for grid transport BCs ------------
 	// note that conducution overrides and gets reaction energy
-	int i;
-	TransportField *gTrans;
-
-	// Paste back noBC transport value
-	NodalValueBC *nextBC = GetFirstBCPtr();
-	while(nextBC!=NULL)
-	{	i = nextBC->GetNodeNum(mtime);
-		if(i!=0) nextBC->PasteNodalValue(nd[i]);
-		nextBC = (NodalValueBC *)nextBC->GetNextObject();
-	}
+	// BCs grouped by node to loop over nodes in parallel
+	NodalBCGroups *groups = GetBCGroups();
+	CommonException *bcErr = NULL;
 	
-	// Set force to - Ci*Ti(no BC)/timestep
-	nextBC = GetFirstBCPtr();
-	while(nextBC!=NULL)
-	{	i = nextBC->GetNodeNum(mtime);
-		if(i!=0)
-		{	gTrans = GetTransportFieldPtr(nd[i]);
-			gTrans->gQ = -gTrans->gVCT*gTrans->gTValue/deltime;
+#pragma omp parallel for
+	for(int g=0;g<groups->numGroups;g++)
+	{	int k,i;
+		NodalValueBC *nextBC;
+		TransportField *gTrans;
+		try
+		{	// Paste back noBC transport value
+			for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+			{	nextBC = (NodalValueBC *)groups->bcs[k];
+				i = nextBC->GetNodeNum(mtime);
+				if(i!=0) nextBC->PasteNodalValue(nd[i]);
+			}
+			
+			// Set force to - Ci*Ti(no BC)/timestep
+			for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+			{	i = groups->bcs[k]->GetNodeNum(mtime);
+				if(i!=0)
+				{	gTrans = GetTransportFieldPtr(nd[i]);
+					gTrans->gQ = -gTrans->gVCT*gTrans->gTValue/deltime;
+				}
+			}
+			
+			// Now add each superposed BC (ci*TiBC/timestep) at incremented time
+			for(k=groups->groupStart[g];k<groups->groupStart[g+1];k++)
+			{	nextBC = (NodalValueBC *)groups->bcs[k];
+				i = nextBC->GetNodeNum(mtime);
+				if(i!=0)
+				{	gTrans = GetTransportFieldPtr(nd[i]);
+					gTrans->gQ += gTrans->gVCT*nextBC->BCValue(mtime)/deltime;
+				}
+			}
 		}
-		nextBC = (NodalValueBC *)nextBC->GetNextObject();
-	}
-	
-	// Now add each superposed BC (ci*TiBC/timestep) at incremented time
-	nextBC = GetFirstBCPtr();
-	while(nextBC!=NULL)
-	{	i = nextBC->GetNodeNum(mtime);
-		if(i!=0)
-		{	gTrans = GetTransportFieldPtr(nd[i]);
-			gTrans->gQ += gTrans->gVCT*nextBC->BCValue(mtime)/deltime;
+		catch(CommonException& err)
+		{	if(bcErr==NULL)
+			{
+#pragma omp critical (error)
+				bcErr = new CommonException(err);
+			}
 		}
-		nextBC = (NodalValueBC *)nextBC->GetNextObject();
 	}
+	if(bcErr!=NULL) throw *bcErr;
+	
+	// same for values set by rigid particles
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->SetTransportForces(this,deltime,false);
 	
 	// --------- concentration flux BCs -------------
 	MatPtLoadBC *nextFlux = GetFirstFluxBCPtr();
@@ -397,7 +432,7 @@ void TransportTask::TransportBCsAndGradients(double bctime)
 	}
 }
 
-// Set transport BCs (not parallel because small and possible use of function/global variables)
+// Set transport BCs (each task loops over nodes with BCs in parallel)
 void TransportTask::TransportForceBCs(double dtime)
 {
     TransportTask *nextTransport=transportTasks;
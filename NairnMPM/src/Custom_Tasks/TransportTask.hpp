@@ -6,13 +6,15 @@
     Copyright (c) 2006 John A. Nairn, All rights reserved.
 	
 	Dependencies
-		none
+		BoundaryCondition.hpp
 ********************************************************************************/
 
 #ifndef _TRANSPORTTASK_
 
 #define _TRANSPORTTASK_
 
+#include "Boundary_Conditions/BoundaryCondition.hpp"
+
 class NodalPoint;
 class MPMBase;
 class MatVelocityField;
@@ -37,6 +39,8 @@ class TransportTask
 	
 		// called before first time step, but after preliminary calcs
 		virtual TransportTask *Initialize(void) = 0;
+		virtual void AllocateParticleGradients(MPMBase *) const = 0;
+		virtual int NumberOfParticleGradients(void) const = 0;
 	
 		// Mass and Momentum extrapolation and post extrapolation for transport property to the grid
 		virtual TransportTask *Task1Extrapolation(NodalPoint *,MPMBase *,double,short,int) = 0;
@@ -89,6 +93,8 @@ class TransportTask
     
         // pointer to the first boundary condition
         virtual NodalValueBC *GetFirstBCPtr(void) const = 0;
+		virtual int GetSetDirection(void) const = 0;
+		virtual NodalBCGroups *GetBCGroups(void) const = 0;
 		virtual MatPtLoadBC *GetFirstFluxBCPtr(void) const = 0;
 	
         // get pointers to particle value for this transport property
@@ -54,8 +54,10 @@ void ElementBase::GetShapeFunctionData(MPMBase *mpmptr) const
 		case BSPLINE_GIMP_AS:
 		case BSPLINE:
 		case POINT_GIMP:
-			GetXiPos(&mpmptr->pos,mpmptr->GetNcpos());
+		{	Vector xp = mpmptr->pos;
+			GetXiPos(&xp,mpmptr->GetNcpos());
 			break;
+		}
 			
         case LINEAR_CPDI:
 		case LINEAR_CPDI_AS:
@@ -115,6 +117,17 @@ void ElementBase::GetShapeFunctionsForTractions(double *fn,int *nds,Vector *xipo
 	}
 }
 
+#ifdef FLOAT_CPDI
+// Same for single precision CPDI domain coordinates
+void ElementBase::GetShapeFunctionsForTractions(double *fn,int *nds,CPDIVector *cxipos) const
+{	Vector xipos;
+	xipos.x = cxipos->x;
+	xipos.y = cxipos->y;
+	xipos.z = cxipos->z;
+	GetShapeFunctionsForTractions(fn,nds,&xipos);
+}
+#endif
+
 /*
  Return list of nodes (possible change array with address in ndsHandle)
 	and the shape functions
@@ -322,6 +335,20 @@ void ElementBase::GetXiPos(const Vector *pos,Vector *xipos) const
     }
 }
 
+#ifdef FLOAT_CPDI
+// Find dimensionless coordinates of CPDI domain node for single precision storage
+void ElementBase::GetXiPos(const Vector *pos,CPDIVector *cxipos) const
+{	Vector xipos;
+	xipos.x = cxipos->x;
+	xipos.y = cxipos->y;
+	xipos.z = cxipos->z;
+	GetXiPos(pos,&xipos);
+	cxipos->x = (CPDIReal)xipos.x;
+	cxipos->y = (CPDIReal)xipos.y;
+	cxipos->z = (CPDIReal)xipos.z;
+}
+#endif
+
 // return dimensionless location for material points
 void ElementBase::MPMPoints(short numPerElement,Vector *mpos) const
 {
@@ -563,7 +590,11 @@ int ElementBase::GetCPDIFunctions(int *nds,double *fn,double *xDeriv,double *yDe
 		for(j=1;j<=numnds;j++)
 		{   cnodes[ncnds] = nds[j];
 			wsSi[ncnds] = cpdi[i]->ws*fn[j];
-			if(xDeriv!=NULL) CopyScaleVector(&wgSi[ncnds], &cpdi[i]->wg, fn[j]);
+			if(xDeriv!=NULL)
+			{	wgSi[ncnds].x = fn[j]*cpdi[i]->wg.x;
+				wgSi[ncnds].y = fn[j]*cpdi[i]->wg.y;
+				wgSi[ncnds].z = fn[j]*cpdi[i]->wg.z;
+			}
 			ncnds++;
 		}
 	}
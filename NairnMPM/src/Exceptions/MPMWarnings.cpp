@@ -22,6 +22,9 @@ MPMWarnings::MPMWarnings()
 {	lastWarning = NULL;
 	numWarnings = 0;
 	warningSet = NULL;
+	numThreads = 0;
+	countStride = 0;
+	threadCounts = NULL;
 }
 
 // add a warning message
@@ -44,6 +47,9 @@ int MPMWarnings::CreateWarning(const char *message,int abortStep,int maxIDs)
 	
 	// it is a new warning
 	WarningsData *newWarning = new WarningsData;
+	newWarning->given=false;
+	newWarning->issuedTotal=0;
+	newWarning->firstStep=0;
 	newWarning->numSteps=0;
 	newWarning->numWarnings=0;
 	newWarning->maxIssues=abortStep;
@@ -53,8 +59,9 @@ int MPMWarnings::CreateWarning(const char *message,int abortStep,int maxIDs)
 	if(maxIDs<=0)
 		newWarning->issuedIDs = NULL;
 	else
-	{	newWarning->issuedIDs = new int[maxIDs+1];
-		newWarning->issuedIDs[0] = 0;
+	{	// all zero so list stays terminated while IDs are added
+		newWarning->issuedIDs = new int[maxIDs+1];
+		for(int j=0;j<=maxIDs;j++) newWarning->issuedIDs[j] = 0;
 	}
 	newWarning->prevWarning = (void *)lastWarning;
 	
@@ -63,7 +70,8 @@ int MPMWarnings::CreateWarning(const char *message,int abortStep,int maxIDs)
 	return numWarnings-1;
 }
 
-// assemble are created warnings into a list
+// assemble are created warnings into a list and create counts for each thread
+// throws std::bad_alloc
 void MPMWarnings::CreateWarningList(void)
 {
 	// no warnings
@@ -79,22 +87,23 @@ void MPMWarnings::CreateWarningList(void)
 		nextWarning = (WarningsData *)(warningSet[i]->prevWarning);
 		i--;
 	}
+	
+	// counts for each thread padded to 64 bytes so threads do not share cache lines
+	numThreads = fmobj->GetTotalNumberOfPatches();
+	countStride = 16*((numWarnings+15)/16);
+	threadCounts = new int[numThreads*countStride];
+	for(i=0;i<numThreads*countStride;i++) threadCounts[i] = 0;
 }
 
 #pragma mark MPMWarnings: Methods
 
-// Activate all warnings for the next step
-void MPMWarnings::BeginStep(void)
-{	int i;
-	for(i=0;i<numWarnings;i++)
-	{	warningSet[i]->thisStep = true;
-	}
-}
+// Merge warnings in the previous step (must not be in parallel code)
+void MPMWarnings::BeginStep(void) { MergeThreadCounts(); }
 
 // issue a warning of a certain type
 // but, only count once per step, and display message only on the first step this warning occurs
 // return SILENT_WARNING, GAVE_WARNING, or REACHED_MAX_WARNINGS
-// not thread safe due to push_back()
+// thread safe, but only the first warning (or first for new ID) needs a lock
 int MPMWarnings::Issue(int warnKind,int theID) { return Issue(warnKind,theID,NULL); }
 int MPMWarnings::Issue(int warnKind,int theID,char *comment)
 {	int warnResult=SILENT_WARNING;
@@ -105,42 +114,39 @@ int MPMWarnings::Issue(int warnKind,int theID,char *comment)
 	// check the warning
 	WarningsData *warn=warningSet[warnKind];
 	
-	// will output warning if first time or if first time for this ID for warning that use IDs
-	bool newID = false, tooManyIDs = false;
-	if(theID>0 && warn->issuedIDs!=NULL)
-	{	int i=0;
-		newID = true;
-		while(warn->issuedIDs[i]!=0)
-		{	if(theID==warn->issuedIDs[i])
-			{	newID = false;
-				break;
-			}
-			i++;
-		}
-		if(newID)
-		{	// warning - when create warning, better save room for all possible IDs
-			if(i<warn->maxIDs)
-			{	warn->issuedIDs[i] = theID;
-				warn->issuedIDs[i+1] = 0;
-			}
-			else
-				tooManyIDs = true;
-		}
+	// count in this thread (threads beyond patch threads share first count)
+	int tn = MPMTask::GetPatchNumber();
+	if(tn>0 && tn<numThreads)
+		threadCounts[tn*countStride+warnKind]++;
+	else
+	{
+#pragma omp atomic
+		threadCounts[warnKind]++;
 	}
-
-	// if in parallel, changes to warn object need to be critical
-	if(MPMTask::GetNumberOfThreads()>0)
+	
+	// total for warnings that abort
+	int issuedTotal = 0;
+	if(warn->maxIssues>0)
+	{
+#pragma omp atomic capture
+		issuedTotal = ++warn->issuedTotal;
+	}
+	
+	// will output warning if first time or if first time for this ID for warning that use IDs
+	bool tooManyIDs = false;
+	bool newID = IsNewID(warn,theID,tooManyIDs);
+	
+	// if first time in analysis, print message and force archiving
+	bool given;
+#pragma omp atomic read
+	given = warn->given;
+	if(!given || newID)
 	{
 #pragma omp critical (output)
-		{	// increment number of steps (first time on each step)
-			if(warn->thisStep) warn->numSteps++;
-			
-			// increment total number of warnings
-			warn->numWarnings++;
-			
-			// if first time in analysis, print message and force archiving
-			if((warn->numSteps==1 && warn->thisStep) || newID)
+		{	if(!warn->given || newID)
 			{	warn->firstStep=fmobj->mstep;
+#pragma omp atomic write
+				warn->given = true;
 				warnResult=GAVE_WARNING;
 				archiver->ForceArchiving();
 				cout << "# " << warn->msg;
@@ -149,48 +155,87 @@ int MPMWarnings::Issue(int warnKind,int theID,char *comment)
 				cout << endl;
 				if(comment!=NULL) cout << "#  " << comment << endl;
 			}
-			
-			// deactivate for this step
-			warn->thisStep = false;
-		}
-	}
-	else
-	{	// increment number of steps (first time on each step)
-		if(warn->thisStep) warn->numSteps++;
-    
-		// increment total number of warnings
-		warn->numWarnings++;
-	
-		// if first time in analysis, print message and force archiving
-		if((warn->numSteps==1 && warn->thisStep) || newID)
-		{	warn->firstStep=fmobj->mstep;
-			warnResult=GAVE_WARNING;
-			archiver->ForceArchiving();
-			cout << "# " << warn->msg;
-			if(theID>0) cout << " (ID=" << theID << ")";
-			if(tooManyIDs) cout << " (exceeded maximum allowed IDs)";
-			cout << endl;
-			if(comment!=NULL) cout << "#  " << comment << endl;
 		}
 	}
 	
-	// deactivate for this step
-	warn->thisStep = false;
-	
 	// abort if reach maximum issues or encoutered too many IDs
-	if((warn->numWarnings>=warn->maxIssues && warn->maxIssues>0) || tooManyIDs)
+	if((issuedTotal>=warn->maxIssues && warn->maxIssues>0) || tooManyIDs)
 		warnResult=REACHED_MAX_WARNINGS;
     
     // return result
 	return warnResult;
 }
 
+// Check if ID is new for warning that tracks IDs, and add it to the list if it is
+// IDs are only added in critical section by atomic write into a zero-filled list
+// so other threads can search it with atomic reads while it changes
+bool MPMWarnings::IsNewID(WarningsData *warn,int theID,bool &tooManyIDs)
+{
+	if(theID<=0 || warn->issuedIDs==NULL) return false;
+	
+	// usually already in the list
+	int i=0;
+	while(true)
+	{	int issuedID;
+#pragma omp atomic read
+		issuedID = warn->issuedIDs[i];
+		if(issuedID==0) break;
+		if(theID==issuedID) return false;
+		i++;
+	}
+	
+	// search again and add
+	bool newID = true;
+#pragma omp critical (warningids)
+	{	i=0;
+		while(warn->issuedIDs[i]!=0)
+		{	if(theID==warn->issuedIDs[i])
+			{	newID = false;
+				break;
+			}
+			i++;
+		}
+		if(newID)
+		{	// warning - when create warning, better save room for all possible IDs
+			if(i<warn->maxIDs)
+			{
+#pragma omp atomic write
+				warn->issuedIDs[i] = theID;
+			}
+			else
+				tooManyIDs = true;
+		}
+	}
+	return newID;
+}
+
+// Add counts in each thread to totals and count steps that had each warning
+// Must not be in parallel code
+void MPMWarnings::MergeThreadCounts(void)
+{
+	for(int i=0;i<numWarnings;i++)
+	{	int stepCount = 0;
+		for(int tn=0;tn<numThreads;tn++)
+		{	stepCount += threadCounts[tn*countStride+i];
+			threadCounts[tn*countStride+i] = 0;
+		}
+		WarningsData *warn=warningSet[i];
+		if(stepCount>0)
+		{	warn->numSteps++;
+			warn->numWarnings += stepCount;
+		}
+	}
+}
+
 // Report all warning results
 void MPMWarnings::Report(void)
 {
 	int i;
 	bool hasTitle=FALSE;
 	
+	// add warnings on the last step
+	MergeThreadCounts();
+	
 	// check for any warning
 	for(i=0;i<numWarnings;i++)
 	{	WarningsData *warn=warningSet[i];
@@ -5,6 +5,13 @@
     Created by John Nairn on Tues Feb 08 2005.
     Copyright (c) 2005 John A. Nairn, All rights reserved.    
 
+	Each thread counts its own warnings, which are merged into the warning
+	totals once per step (in BeginStep()) and before the report. Only the
+	first warning in the analysis (or for a new ID) takes the output lock to
+	print the message; the flag and ID list are checked with atomic reads. Warnings that abort the calculation (maxIssues>0) also
+	keep an atomic total so the abort happens on the same warning as in
+	serial code.
+
 	Dependencies
 		none
 ********************************************************************************/
@@ -17,7 +24,8 @@ enum { SILENT_WARNING=0, GAVE_WARNING, REACHED_MAX_WARNINGS };
 
 // WarningsData structure
 typedef struct {
-	short thisStep;				// was there a warning this step yet?
+	bool given;					// has the warning message been printed?
+	int issuedTotal;			// total warnings (only kept when maxIssues>0)
 	int firstStep;				// first step with this warning
 	int numSteps;				// how many steps had this warning
     int numWarnings;            // how many total warnings happened
@@ -46,6 +54,11 @@ class MPMWarnings
 		WarningsData *lastWarning;
 		int numWarnings;
 		WarningsData **warningSet;
+		int numThreads,countStride;
+		int *threadCounts;			// [tn*countStride+warnKind] warnings this step by each thread
+	
+		void MergeThreadCounts(void);
+		bool IsNewID(WarningsData *,int,bool &);
 };
 
 extern MPMWarnings warnings;
@@ -24,6 +24,7 @@
 #include "Boundary_Conditions/NodalTempBC.hpp"
 #include "System/UnitsController.hpp"
 #include "Elements/ElementBase.hpp"
+#include "System/ColumnArchive.hpp"
 
 // Single global contact law object
 GlobalQuantity *firstGlobal=NULL;
@@ -318,6 +319,16 @@ GlobalQuantity *GlobalQuantity::AppendName(char *fline)
 	return nextGlobal;
 }
 
+// append column for this quantity to binary archive schema
+GlobalQuantity *GlobalQuantity::AppendColumn(ColumnArchive *columns)
+{
+	if(quantity==UNKNOWN_QUANTITY || quantity==DECOHESION)
+		return nextGlobal;
+	
+	columns->AddColumn(name,COLUMN_DOUBLE);
+	return nextGlobal;
+}
+
 // append quantity
 GlobalQuantity *GlobalQuantity::AppendQuantity(vector<double> &toArchive)
 {
@@ -877,7 +888,8 @@ GlobalQuantity *GlobalQuantity::AppendQuantity(vector<double> &toArchive)
 			{	matid = mpm[p]->MatID();
 				if(IncludeThisMaterial(matid))
 				{	// get Mp Xp X Vp
-					CrossProduct(&cp,&mpm[p]->pos,&mpm[p]->vel);
+					Vector xp = mpm[p]->pos,vp = mpm[p]->vel;
+					CrossProduct(&cp,&xp,&vp);
 					AddScaledVector(&Ltot,&cp,mpm[p]->mp);
 				}
 			}
@@ -996,6 +1008,10 @@ int GlobalQuantity::GetQuantity(void) { return quantity; }
 // true if is tracer particle
 bool GlobalQuantity::IsTracerParticle(void) { return ptPos!=NULL; }
 
+// zero-based tracer particle number (or -1 if not a tracer particle) and change when particles are renumbered
+int GlobalQuantity::GetTracerParticleNumber(void) const { return ptNum; }
+void GlobalQuantity::SetTracerParticleNumber(int p) { ptNum = p; }
+
 // Set name when known
 GlobalQuantity *GlobalQuantity::SetTracerParticle(void)
 {	if(ptPos!=NULL)
@@ -13,6 +13,8 @@
 
 #define _GLOBALQUANTITY_
 
+class ColumnArchive;
+
 // possible global averages
 enum { UNKNOWN_QUANTITY,AVG_SXX,AVG_SYY,AVG_SXY,AVG_SZZ,AVG_SXZ,AVG_SYZ,
 			AVG_EXXE,AVG_EYYE,AVG_EXYE,AVG_EZZE,AVG_EXZE,AVG_EYZE,
@@ -41,6 +43,7 @@ class GlobalQuantity
         // methods
 		GlobalQuantity *AppendName(char *);
 		GlobalQuantity *AppendColor(char *);
+		GlobalQuantity *AppendColumn(ColumnArchive *);
 		GlobalQuantity *AppendQuantity(vector<double> &);
 	
 		// accessors
@@ -51,6 +54,8 @@ class GlobalQuantity
 		int GetQuantity(void);
 		bool IsTracerParticle(void);
 		GlobalQuantity *SetTracerParticle(void);
+		int GetTracerParticleNumber(void) const;
+		void SetTracerParticleNumber(int);
 	
 		// class methods
 		static int DecodeGlobalQuantity(const char *,int *);
@@ -21,6 +21,8 @@
 #include "Custom_Tasks/DiffusionTask.hpp"
 #include "Custom_Tasks/ConductionTask.hpp"
 #include "Global_Quantities/BodyForce.hpp"
+#include "Exceptions/CommonException.hpp"
+#include "MPM_Classes/ParticleArena.hpp"
 
 // globals
 MPMBase **mpm;		// list of material points
@@ -56,11 +58,11 @@ MPMBase::MPMBase(int elem,int theMatl,double angin)
         vfld[i]=NO_CRACK;
 	
     // zero stresses and strains
-	ZeroTensor(&sp);
+	sp = MakeTensor(0.,0.,0.,0.,0.,0.);
     pressure = 0.;
-	ZeroTensor(&ep);
+	ep = MakeTensor(0.,0.,0.,0.,0.,0.);
 	ZeroTensor(&eplast);
-	ZeroTensorAntisym(&wrot);
+	wrot.yz = wrot.xz = wrot.xy = 0.;
 	ZeroVector(&acc);
 	
 	// zero increment initial residual strains
@@ -97,7 +99,7 @@ MPMBase::MPMBase(int elem,int theMatl,double angin)
     faceArea = NULL;
 
     // PS - when point created, velocity and position and ext force should be set too
-	ZeroVector(&vel);
+	vel = MakeVector(0.,0.,0.);
 	
 	// counts crossing and sign is whether or not left the grid
 	elementCrossings=0;
@@ -116,24 +118,35 @@ void MPMBase::AllocateJStructures(void)
 // throws std::bad_alloc
 bool MPMBase::AllocateCPDIorGIMPStructures(int gimpType,bool isThreeD)
 {
-    int cpdiSize=0;
-    
 	// If CPDI find size of CPDI datastructuress, otherwise pass on to GIMP structur allocation
-    if(gimpType==LINEAR_CPDI || gimpType==LINEAR_CPDI_AS || gimpType==BSPLINE_CPDI)
-        cpdiSize = isThreeD ? 8 : 4 ;
-    else if(gimpType==QUADRATIC_CPDI)
-        cpdiSize = 9;
-	else
-		return true;
+    int cpdiSize = NumberOfCPDIDomains(gimpType,isThreeD);
+	if(cpdiSize==0) return true;
 	
     // create memory for cpdiSize pointers
-    CPDIDomain **cpdi = new (nothrow) CPDIDomain *[cpdiSize];
-    if(cpdi == NULL) return false;
+	CPDIDomain **cpdi;
+	CPDIDomain *domains = NULL;
+	if(particleArena!=NULL && particleArena->IsOpen())
+	{	// pointers followed by the domains in one piece of the arena
+		size_t ptrSize = sizeof(CPDIDomain *)*(cpdiSize+(cpdiSize&1));
+		char *p;
+		try
+		{	p = particleArena->Allocate(ptrSize+cpdiSize*sizeof(CPDIDomain));
+		}
+		catch(std::bad_alloc&)
+		{	return false;
+		}
+		cpdi = (CPDIDomain **)p;
+		domains = (CPDIDomain *)(p+ptrSize);
+	}
+	else
+	{	cpdi = new (nothrow) CPDIDomain *[cpdiSize];
+		if(cpdi == NULL) return false;
+	}
 	
     // create each one
     int i;
     for(i=0;i<cpdiSize;i++)
-    {   cpdi[i] = new CPDIDomain;
+    {   cpdi[i] = domains!=NULL ? &domains[i] : new CPDIDomain;
         cpdi[i]->wg.z = 0.;             // set zero once for 2D calculations
         cpdi[i]->ncpos.z = 0.;          // set zero once for 2D calculations
 		
@@ -152,7 +165,11 @@ bool MPMBase::AllocateCPDIorGIMPStructures(int gimpType,bool isThreeD)
     
     // save face areas (or lengths in 2D)
     if(firstTractionPt!=NULL || firstFluxPt!=NULL || firstHeatFluxPt!=NULL)
-		faceArea = new Vector;
+	{	if(domains!=NULL)
+			faceArea = (Vector *)particleArena->Allocate(sizeof(Vector));
+		else
+			faceArea = new Vector;
+	}
 	
 	// load to generic variable
 	cpdi_or_gimp = (char *)cpdi;
@@ -163,6 +180,64 @@ bool MPMBase::AllocateCPDIorGIMPStructures(int gimpType,bool isThreeD)
 // Destructor (and it is virtual)
 MPMBase::~MPMBase() { }
 
+// Delete structures allocated for this particle before deleting a particle created
+// by the full constructor (particles in the arena only delete heap data)
+void MPMBase::DeleteStructures(void)
+{
+	delete [] vfld;
+	vfld = NULL;
+	if(pTemp!=NULL) delete [] pTemp;
+	pTemp = NULL;
+	if(pDiffusion!=NULL) delete [] pDiffusion;
+	pDiffusion = NULL;
+	if(velGrad!=NULL) delete velGrad;
+	velGrad = NULL;
+	if(Rtot!=NULL) delete Rtot;
+	Rtot = NULL;
+	
+	// history
+	if(matData!=NULL && (particleArena==NULL || !particleArena->Owns(matData)))
+		delete [] matData;
+	matData = NULL;
+	
+	// CPDI domains and face areas
+	if(cpdi_or_gimp!=NULL && (particleArena==NULL || !particleArena->Owns(cpdi_or_gimp)))
+	{	CPDIDomain **cpdi = GetCPDIInfo();
+		int cpdiSize = NumberOfCPDIDomains(ElementBase::useGimp,fmobj->IsThreeD());
+		for(int i=0;i<cpdiSize;i++) delete cpdi[i];
+		delete [] cpdi;
+		if(faceArea!=NULL) delete faceArea;
+	}
+	cpdi_or_gimp = NULL;
+	faceArea = NULL;
+}
+
+// Add bytes allocated by this particle (not including the object) to particleBytes and bytes
+// of its history and domain data to dataBytes, unless they are in the particle arena
+void MPMBase::AddMemoryBytes(size_t &particleBytes,size_t &dataBytes) const
+{
+	particleBytes += maxShapeNodes*sizeof(char);
+	if(pTemp!=NULL && conduction!=NULL) particleBytes += conduction->NumberOfParticleGradients()*sizeof(double);
+	if(pDiffusion!=NULL && diffusion!=NULL) particleBytes += diffusion->NumberOfParticleGradients()*sizeof(double);
+	if(velGrad!=NULL) particleBytes += sizeof(Tensor);
+	if(Rtot!=NULL) particleBytes += sizeof(Matrix3);
+	
+	// history (some materials store more than doubles)
+	if(matData!=NULL && (particleArena==NULL || !particleArena->Owns(matData)))
+	{	const MaterialBase *matref = theMaterials[MatID()];
+		int historySize = matref->SizeOfHistoryData();
+		int doublesSize = matref->NumberOfHistoryDoubles()*sizeof(double);
+		dataBytes += historySize>doublesSize ? historySize : doublesSize;
+	}
+	
+	// CPDI domains and face areas
+	if(cpdi_or_gimp!=NULL && (particleArena==NULL || !particleArena->Owns(cpdi_or_gimp)))
+	{	int cpdiSize = NumberOfCPDIDomains(ElementBase::useGimp,fmobj->IsThreeD());
+		dataBytes += cpdiSize*(sizeof(CPDIDomain *)+sizeof(CPDIDomain));
+		if(faceArea!=NULL) dataBytes += sizeof(Vector);
+	}
+}
+
 #pragma mark MPMBase::Methods
 
 // hold or reverse the direction (should only be done for rigid material particles)
@@ -172,10 +247,10 @@ void MPMBase::ReverseParticle(bool holdFirst,bool holding)
 {
 	if(holdFirst)
     {   acc = vel;
-        ZeroVector(&vel);
+        vel = MakeVector(0.,0.,0.);
     }
     else if(holding)
-    {   CopyScaleVector(&vel,&acc,-1.);
+    {   vel = MakeVector(-acc.x,-acc.y,-acc.z);
         ZeroVector(&acc);
     }
     else
@@ -195,6 +270,167 @@ void MPMBase::StopParticle(void)
 // Subclass must override to support exact tractions
 void MPMBase::GetExactTractionInfo(int face,int dof,int *cElem,Vector *corners,Vector *tscaled,int *numDnds) const {}
 
+// Number of bytes needed to pack state of this particle (used to copy state to new particles)
+// Only values that change in time steps or are needed to continue the calculations are packed
+// throws CommonException if material history cannot be packed
+int MPMBase::SizeOfState(void) const
+{
+	int size = 2*sizeof(PositionVector) + sizeof(VelocityVector) + 3*sizeof(Vector) + sizeof(StressTensor)
+				+ sizeof(StrainTensor) + sizeof(Tensor) + sizeof(RotationTensor) + sizeof(ResidualStrains);
+	size += 17*sizeof(double) + 2*sizeof(int);
+	if(velGrad!=NULL) size += sizeof(Tensor);
+	if(Rtot!=NULL) size += sizeof(Matrix3);
+	
+	// history must be contiguous doubles
+	int numHistory = theMaterials[MatID()]->NumberOfHistoryDoubles();
+	if(matData!=NULL && numHistory==0)
+		throw CommonException("Particle history of this material cannot be copied to another particle","MPMBase::SizeOfState");
+	size += numHistory*sizeof(double);
+	return size;
+}
+
+// Copy state into buffer and return pointer to next free byte (see SizeOfState())
+char *MPMBase::PackState(char *buf) const
+{
+	buf = CopyStateBytes(buf,&pos,sizeof(PositionVector));
+	buf = CopyStateBytes(buf,&vel,sizeof(VelocityVector));
+	buf = CopyStateBytes(buf,&origpos,sizeof(PositionVector));
+	buf = CopyStateBytes(buf,&mpm_lp,sizeof(Vector));
+	buf = CopyStateBytes(buf,&pFext,sizeof(Vector));
+	buf = CopyStateBytes(buf,&acc,sizeof(Vector));
+	buf = CopyStateBytes(buf,&sp,sizeof(StressTensor));
+	buf = CopyStateBytes(buf,&ep,sizeof(StrainTensor));
+	buf = CopyStateBytes(buf,&eplast,sizeof(Tensor));
+	buf = CopyStateBytes(buf,&wrot,sizeof(RotationTensor));
+	buf = CopyStateBytes(buf,&dTrans,sizeof(ResidualStrains));
+	
+	double dvals[17] = { pTemperature,pPreviousTemperature,pConcentration,pPreviousConcentration,
+							oopIncrement,mp,pressure,plastEnergy,prev_dTad,buffer_dTad,workEnergy,
+							heatEnergy,entropy,resEnergy,anglez0,angley0,anglex0 };
+	buf = CopyStateBytes(buf,dvals,17*sizeof(double));
+	int ivals[2] = { inElem,elementCrossings };
+	buf = CopyStateBytes(buf,ivals,2*sizeof(int));
+	
+	if(velGrad!=NULL) buf = CopyStateBytes(buf,velGrad,sizeof(Tensor));
+	if(Rtot!=NULL) buf = CopyStateBytes(buf,Rtot,sizeof(Matrix3));
+	
+	int numHistory = theMaterials[MatID()]->NumberOfHistoryDoubles();
+	if(numHistory>0) buf = CopyStateBytes(buf,matData,numHistory*sizeof(double));
+	return buf;
+}
+
+// Restore state from buffer in same order as PackState() and return pointer to next unread byte
+// The particle must already have the same material, allocated structures, and history
+const char *MPMBase::UnpackState(const char *buf)
+{
+	buf = ReadStateBytes(buf,&pos,sizeof(PositionVector));
+	buf = ReadStateBytes(buf,&vel,sizeof(VelocityVector));
+	buf = ReadStateBytes(buf,&origpos,sizeof(PositionVector));
+	buf = ReadStateBytes(buf,&mpm_lp,sizeof(Vector));
+	buf = ReadStateBytes(buf,&pFext,sizeof(Vector));
+	buf = ReadStateBytes(buf,&acc,sizeof(Vector));
+	buf = ReadStateBytes(buf,&sp,sizeof(StressTensor));
+	buf = ReadStateBytes(buf,&ep,sizeof(StrainTensor));
+	buf = ReadStateBytes(buf,&eplast,sizeof(Tensor));
+	buf = ReadStateBytes(buf,&wrot,sizeof(RotationTensor));
+	buf = ReadStateBytes(buf,&dTrans,sizeof(ResidualStrains));
+	
+	double dvals[17];
+	buf = ReadStateBytes(buf,dvals,17*sizeof(double));
+	pTemperature = dvals[0];
+	pPreviousTemperature = dvals[1];
+	pConcentration = dvals[2];
+	pPreviousConcentration = dvals[3];
+	oopIncrement = dvals[4];
+	mp = dvals[5];
+	pressure = dvals[6];
+	plastEnergy = dvals[7];
+	prev_dTad = dvals[8];
+	buffer_dTad = dvals[9];
+	workEnergy = dvals[10];
+	heatEnergy = dvals[11];
+	entropy = dvals[12];
+	resEnergy = dvals[13];
+	anglez0 = dvals[14];
+	angley0 = dvals[15];
+	anglex0 = dvals[16];
+	int ivals[2];
+	buf = ReadStateBytes(buf,ivals,2*sizeof(int));
+	inElem = ivals[0];
+	elementCrossings = ivals[1];
+	
+	if(velGrad!=NULL) buf = ReadStateBytes(buf,velGrad,sizeof(Tensor));
+	if(Rtot!=NULL) buf = ReadStateBytes(buf,Rtot,sizeof(Matrix3));
+	
+	int numHistory = theMaterials[MatID()]->NumberOfHistoryDoubles();
+	if(numHistory>0) buf = ReadStateBytes(buf,matData,numHistory*sizeof(double));
+	return buf;
+}
+
+// Combine other particle into this one (used when merging particles)
+// Mass and momentum are conserved, position is center of mass, forces are summed, and
+//	specific quantities (stresses, strains, energies, temperature, concentration) are
+//	mass-weighted averages. This particle keeps its material history, rotations, and angles.
+void MPMBase::MergeState(MPMBase *other)
+{
+	double mtot = mp+other->mp;
+	double wa = mp/mtot;
+	double wb = other->mp/mtot;
+	
+	// vectors (combined in double precision if stored in single precision)
+	Vector va = pos,vb = other->pos;
+	pos = *AddScaledVector(ScaleVector(&va,wa),&vb,wb);
+	va = origpos;
+	vb = other->origpos;
+	origpos = *AddScaledVector(ScaleVector(&va,wa),&vb,wb);
+	va = vel;
+	vb = other->vel;
+	vel = *AddScaledVector(ScaleVector(&va,wa),&vb,wb);
+	ScaleVector(&acc,wa);
+	AddScaledVector(&acc,&other->acc,wb);
+	AddVector(&pFext,&other->pFext);
+	
+	// tensors
+	Tensor ta = sp,tb = other->sp;
+	sp = *AddTensor(ScaleTensor(&ta,wa),ScaleTensor(&tb,wb));
+	ta = ep;
+	tb = other->ep;
+	ep = *AddTensor(ScaleTensor(&ta,wa),ScaleTensor(&tb,wb));
+	tb = other->eplast;
+	AddTensor(ScaleTensor(&eplast,wa),ScaleTensor(&tb,wb));
+	wrot.xy = wa*wrot.xy + wb*other->wrot.xy;
+	wrot.xz = wa*wrot.xz + wb*other->wrot.xz;
+	wrot.yz = wa*wrot.yz + wb*other->wrot.yz;
+	
+	// residual strains and scalars
+	dTrans.dT = wa*dTrans.dT + wb*other->dTrans.dT;
+	dTrans.dC = wa*dTrans.dC + wb*other->dTrans.dC;
+	dTrans.doopse = wa*dTrans.doopse + wb*other->dTrans.doopse;
+	double *dvals[13] = { &pTemperature,&pPreviousTemperature,&pConcentration,&pPreviousConcentration,
+							&oopIncrement,&pressure,&plastEnergy,&prev_dTad,&buffer_dTad,&workEnergy,
+							&heatEnergy,&entropy,&resEnergy };
+	const double *ovals[13] = { &other->pTemperature,&other->pPreviousTemperature,&other->pConcentration,
+							&other->pPreviousConcentration,&other->oopIncrement,&other->pressure,&other->plastEnergy,
+							&other->prev_dTad,&other->buffer_dTad,&other->workEnergy,&other->heatEnergy,
+							&other->entropy,&other->resEnergy };
+	for(int i=0;i<13;i++)
+		*dvals[i] = wa*(*dvals[i]) + wb*(*ovals[i]);
+	
+	mp = mtot;
+}
+
+// copy bytes into buffer and return next location
+char *MPMBase::CopyStateBytes(char *buf,const void *src,int size)
+{	memcpy(buf,src,size);
+	return buf+size;
+}
+
+// copy bytes from buffer and return next location
+const char *MPMBase::ReadStateBytes(const char *buf,void *dest,int size)
+{	memcpy(dest,buf,size);
+	return buf+size;
+}
+
 #pragma mark MPMBase::Accessors
 
 // scale residual strains for current update method
@@ -464,7 +700,7 @@ void MPMBase::IncrementRotationStrain(double rotXY,double rotXZ,double rotYZ)
 	wrot.xz+=rotXZ;
 	wrot.yz+=rotYZ;
 }
-TensorAntisym *MPMBase::GetRotationStrainTensor(void) { return &wrot; }
+RotationTensor *MPMBase::GetRotationStrainTensor(void) { return &wrot; }
 
 // For 2D or axisymmetric, increment Fzz to Fzz(n) = (1+dezz)*Fzz(n-1)
 // In the strain tensor, we store Fzz(n)-1 and Fzz(n-1) = 1 + ep.zz
@@ -536,15 +772,27 @@ double MPMBase::GetInternalEnergy(void) { return workEnergy + heatEnergy; }
 Vector *MPMBase::GetPFext(void) { return &pFext; }
 Vector *MPMBase::GetNcpos(void) { return &ncpos; }
 CPDIDomain **MPMBase::GetCPDIInfo(void) { return (CPDIDomain **)cpdi_or_gimp; }
+
+// number of CPDI domains for each particle (zero if not CPDI)
+int MPMBase::NumberOfCPDIDomains(int gimpType,bool isThreeD)
+{	if(gimpType==LINEAR_CPDI || gimpType==LINEAR_CPDI_AS || gimpType==BSPLINE_CPDI)
+		return isThreeD ? 8 : 4 ;
+	else if(gimpType==QUADRATIC_CPDI)
+		return 9;
+	return 0;
+}
 Vector *MPMBase::GetAcc(void) { return &acc; }
 Tensor *MPMBase::GetVelGrad(void) { return velGrad; }
-Tensor *MPMBase::GetStrainTensor(void) { return &ep; }
+StrainTensor *MPMBase::GetStrainTensor(void) { return &ep; }
 
 // material classes only should call GetStressTensor and can change the stress
 // all others should use ReadStressTensor() because that gives materials a chance to
 //  customize the way stresses are stored, such as to separate pressure and deviatoric stress
-Tensor *MPMBase::GetStressTensor(void) { return &sp; }
-Tensor MPMBase::ReadStressTensor(void) { return theMaterials[MatID()]->GetStress(&sp,pressure,this); }
+StressTensor *MPMBase::GetStressTensor(void) { return &sp; }
+Tensor MPMBase::ReadStressTensor(void)
+{	Tensor stress = sp;
+	return theMaterials[MatID()]->GetStress(&stress,pressure,this);
+}
 void MPMBase::StoreStressTensor(Tensor *newsp) { theMaterials[MatID()]->SetStress(newsp,this); }
 void MPMBase::StoreThicknessStressIncrement(double dszz)
 {	theMaterials[MatID()]->IncrementThicknessStress(dszz,this);
@@ -566,7 +814,7 @@ Tensor *MPMBase::GetAltStrainTensor(void) { return &eplast; }
 // history data (offset is in bytes and not in number of doubles)
 char *MPMBase::GetHistoryPtr(int offset) { return matData+offset; }
 void MPMBase::SetHistoryPtr(char *createMatData)
-{	if(matData!=NULL) delete [] matData;
+{	if(matData!=NULL && (particleArena==NULL || !particleArena->Owns(matData))) delete [] matData;
 	matData=createMatData;
 }
 double MPMBase::GetHistoryDble(int index,int offset)
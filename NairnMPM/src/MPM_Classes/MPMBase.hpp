@@ -28,7 +28,8 @@ class MPMBase : public LinkedObject
 {
     public:
 		//  variables (changed in MPM time step)
-		Vector pos,vel;
+		PositionVector pos;
+		VelocityVector vel;
 		char *vfld;
 	
 		// for conduction, pTemp have 3, 6, or 9 depending on gradient needs
@@ -45,7 +46,7 @@ class MPMBase : public LinkedObject
 
 		// constants (not changed in MPM time step)
         double mp;
-		Vector origpos;
+		PositionVector origpos;
                
         // constructors and destructors and other intializers
         MPMBase();
@@ -54,6 +55,8 @@ class MPMBase : public LinkedObject
 		void AllocateJStructures(void);
         bool AllocateCPDIorGIMPStructures(int,bool);
 		bool AllocateGIMPStructures(int,bool);
+		void DeleteStructures(void);
+		void AddMemoryBytes(size_t &,size_t &) const;
     
         // virtual methods
 		virtual ResidualStrains ScaledResidualStrains(int);
@@ -100,6 +103,10 @@ class MPMBase : public LinkedObject
         // defined virtual methods
 		virtual double GetUnscaledVolume(void);
 		virtual void IncrementDeformationGradientZZ(double dezz);
+		virtual int SizeOfState(void) const;
+		virtual char *PackState(char *) const;
+		virtual const char *UnpackState(const char *);
+		virtual void MergeState(MPMBase *);
 
 		// base only methods (make virtual if need to override)
 		int MatID(void) const;
@@ -151,6 +158,7 @@ class MPMBase : public LinkedObject
 		Vector *GetPFext(void);
 		Vector *GetNcpos(void);
 		CPDIDomain **GetCPDIInfo(void);
+		static int NumberOfCPDIDomains(int,bool);
 		Vector *GetAcc(void);
 		Tensor *GetVelGrad(void);
 		double GetPlastEnergy(void);
@@ -179,10 +187,10 @@ class MPMBase : public LinkedObject
 		void StoreStressTensor(Tensor *);
 		void StoreThicknessStressIncrement(double);
 		void StoreThicknessStrainIncrement(double);
-		Tensor *GetStressTensor(void);
-		Tensor *GetStrainTensor(void);
+		StressTensor *GetStressTensor(void);
+		StrainTensor *GetStrainTensor(void);
  		Tensor *GetAltStrainTensor(void);
-		TensorAntisym *GetRotationStrainTensor(void);
+		RotationTensor *GetRotationStrainTensor(void);
 		char *GetHistoryPtr(int);
 		void SetHistoryPtr(char *);
 		double GetHistoryDble(int,int);
@@ -202,11 +210,11 @@ class MPMBase : public LinkedObject
         Vector *faceArea;           // make pointer when needed
 		Vector acc;					// acceleration (hold velocity of rigid particle in hold phase)
 		Tensor *velGrad;			// used for J Integral only on non-rigid particles only
-		Tensor sp;					// stress tensor (init 0)
+		StressTensor sp;			// stress tensor (init 0)
         double pressure;            // for use if materials wants to, otherwise it is zero
-		Tensor ep;					// total strain tensor (init 0)
+		StrainTensor ep;			// total strain tensor (init 0)
 		Tensor eplast;				// plastic strain tensor (init 0)
-		TensorAntisym wrot;			// rotation strain tensor (init 0)
+		RotationTensor wrot;		// rotation strain tensor (init 0)
 		double plastEnergy;			// total plastic energy
 		double prev_dTad;			// adiabatic temperature rise in previous step
     	double buffer_dTad;			// adiabatic temperature rise current step
@@ -222,6 +230,10 @@ class MPMBase : public LinkedObject
 		double angley0;				// initial cw y rotation (3D)
 		double anglex0;				// initial cw x rotation (3D)
 	
+		// state packing
+		static char *CopyStateBytes(char *,const void *,int);
+		static const char *ReadStateBytes(const char *,void *,int);
+	
     private:
 		// variables (changed in MPM time step)
 		int inElem;
@@ -525,7 +525,8 @@ void MatPoint2D::GetCPDINodesAndWeights(int cpdiType)
 			
 			// node on material point
 			cpdi[8]->inElem = ElemID();
-			theElements[cpdi[8]->inElem]->GetXiPos(&pos,&cpdi[8]->ncpos);
+			Vector xp = pos;
+			theElements[cpdi[8]->inElem]->GetXiPos(&xp,&cpdi[8]->ncpos);
 			
 			// gradient weighting values - use linear weights
 			Ap = 1./(3.*Ap);
@@ -953,3 +954,18 @@ Matrix3 MatPoint2D::GetInitialRotation(void)
 	return Matrix3(cs,sn,-sn,cs,1.);
 }
 
+
+// add thickness to packed state
+int MatPoint2D::SizeOfState(void) const { return MPMBase::SizeOfState()+sizeof(double); }
+
+// pack base state and thickness
+char *MatPoint2D::PackState(char *buf) const
+{	buf = MPMBase::PackState(buf);
+	return CopyStateBytes(buf,&thick,sizeof(double));
+}
+
+// unpack base state and thickness
+const char *MatPoint2D::UnpackState(const char *buf)
+{	buf = MPMBase::UnpackState(buf);
+	return ReadStateBytes(buf,&thick,sizeof(double));
+}
@@ -56,6 +56,9 @@ class MatPoint2D : public MPMBase
 		virtual Matrix3 GetInitialRotation(void);
 		virtual Matrix3 GetElasticBiotStrain(void);
 		virtual void GetExactTractionInfo(int,int,int *,Vector *,Vector *,int *) const;
+		virtual int SizeOfState(void) const;
+		virtual char *PackState(char *) const;
+		virtual const char *UnpackState(const char *);
 	
     protected:
         double thick;
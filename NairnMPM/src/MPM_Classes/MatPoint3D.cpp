@@ -104,7 +104,9 @@ void MatPoint3D::MoveParticle(GridToParticleExtrap *gp)
 	
 	// find Adamp0
 	Vector Adamp0;
-	Adamp0 = SetScaledVector(&vel,gp->particleAlpha);
+	Adamp0.x = gp->particleAlpha*vel.x;
+	Adamp0.y = gp->particleAlpha*vel.y;
+	Adamp0.z = gp->particleAlpha*vel.z;
 	
 	Vector delV;
 	if(gp->m>=0)
@@ -114,14 +116,18 @@ void MatPoint3D::MoveParticle(GridToParticleExtrap *gp)
 		delV.z = (gp->Sacc.z - Adamp0.z)*timestep;
 		
 		// velocity
-		AddVector(&vel,&delV);
+		vel.x += delV.x;
+		vel.y += delV.y;
+		vel.z += delV.z;
 		
 		// position update
 		Vector delXRate;
 		delXRate.x = vm.x + 0.5*delV.x;
 		delXRate.y = vm.y + 0.5*delV.y;
 		delXRate.z = vm.z + 0.5*delV.z;
-		AddScaledVector(&pos,&delXRate,timestep);
+		pos.x += delXRate.x*timestep;
+		pos.y += delXRate.y*timestep;
+		pos.z += delXRate.z*timestep;
 	}
 	else
 	{	// XPIC update
@@ -144,7 +150,9 @@ void MatPoint3D::MoveParticle(GridToParticleExtrap *gp)
 		delXRate.x = vm.x + 0.5*delV.x;
 		delXRate.y = vm.y + 0.5*delV.y;
 		delXRate.z = vm.z + 0.5*delV.z;
-		AddScaledVector(&pos,&delXRate,timestep);
+		pos.x += delXRate.x*timestep;
+		pos.y += delXRate.y*timestep;
+		pos.z += delXRate.z*timestep;
 	}
 
 	// J Integral needs effective particle acceleration
@@ -0,0 +1,98 @@
+/********************************************************************************
+	ParticleArena.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "MPM_Classes/ParticleArena.hpp"
+
+// global arena for particle data
+ParticleArena *particleArena=NULL;
+
+#pragma mark ParticleArena::Constructors and Destructors
+
+// Create empty and open arena (blocks are added when needed)
+ParticleArena::ParticleArena()
+{
+	next = NULL;
+	remaining = 0;
+	bytesUsed = 0;
+	numAllocations = 0;
+	open = true;
+}
+
+// Destructor releases all particle data
+ParticleArena::~ParticleArena()
+{
+	for(int i=0;i<(int)blocks.size();i++)
+		delete [] blocks[i];
+}
+
+#pragma mark ParticleArena::Methods
+
+// Get aligned memory for size bytes (contents not initialized)
+// Requests larger than a block get their own block
+// throws std::bad_alloc
+char *ParticleArena::Allocate(size_t size)
+{
+	size = ARENA_ALIGNMENT*((size+ARENA_ALIGNMENT-1)/ARENA_ALIGNMENT);
+	if(size==0) size = ARENA_ALIGNMENT;
+
+	char *p;
+	if(size>ARENA_BLOCK_SIZE)
+		p = AddBlock(size);
+	else
+	{	if(size>remaining)
+		{	next = AddBlock(ARENA_BLOCK_SIZE);
+			remaining = ARENA_BLOCK_SIZE;
+		}
+		p = next;
+		next += size;
+		remaining -= size;
+	}
+
+	bytesUsed += size;
+	numAllocations++;
+	return p;
+}
+
+// No more allocations (data created later uses the heap)
+void ParticleArena::Close(void) { open = false; }
+
+// true if ptr is within one of the arena blocks
+bool ParticleArena::Owns(const char *ptr) const
+{
+	for(int i=0;i<(int)blocks.size();i++)
+	{	if(ptr>=blocks[i] && ptr<blocks[i]+blockSizes[i])
+			return true;
+	}
+	return false;
+}
+
+// new block of size bytes
+// throws std::bad_alloc
+char *ParticleArena::AddBlock(size_t size)
+{
+	char *block = new char[size];
+	blocks.push_back(block);
+	blockSizes.push_back(size);
+	return block;
+}
+
+#pragma mark ParticleArena::Accessors
+
+bool ParticleArena::IsOpen(void) const { return open; }
+size_t ParticleArena::BytesUsed(void) const { return bytesUsed; }
+long ParticleArena::NumberOfAllocations(void) const { return numAllocations; }
+int ParticleArena::NumberOfBlocks(void) const { return (int)blocks.size(); }
+
+// total bytes in all blocks
+size_t ParticleArena::BytesReserved(void) const
+{	size_t total = 0;
+	for(int i=0;i<(int)blockSizes.size();i++)
+		total += blockSizes[i];
+	return total;
+}
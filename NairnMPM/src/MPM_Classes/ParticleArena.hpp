@@ -0,0 +1,63 @@
+/********************************************************************************
+	ParticleArena.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Pooled memory for particle data that lives for the whole calculation
+	(material history and CPDI or GIMP domain data). While open, data is
+	carved sequentially from large blocks in particle order, so each
+	particle's history and domain data are adjacent and particles that
+	were created together (and later share a patch) are contiguous.
+	Memory is never freed individually; it is released when the arena is
+	deleted.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _PARTICLEARENA_
+
+#define _PARTICLEARENA_
+
+// size of each block and alignment of each allocation in bytes
+#define ARENA_BLOCK_SIZE 4194304
+#define ARENA_ALIGNMENT 16
+
+class ParticleArena
+{
+	public:
+
+		// constructors and destructors
+		ParticleArena();
+		virtual ~ParticleArena();
+
+		// methods
+		char *Allocate(size_t);
+		void Close(void);
+		bool Owns(const char *) const;
+
+		// accessors
+		bool IsOpen(void) const;
+		size_t BytesUsed(void) const;
+		size_t BytesReserved(void) const;
+		long NumberOfAllocations(void) const;
+		int NumberOfBlocks(void) const;
+
+	private:
+		vector< char * > blocks;
+		vector< size_t > blockSizes;
+		char *next;					// next free byte in current block
+		size_t remaining;			// bytes left in current block
+		size_t bytesUsed;
+		long numAllocations;
+		bool open;
+
+		char *AddBlock(size_t);
+};
+
+// global arena for particle data (NULL until particles are initialized)
+extern ParticleArena *particleArena;
+
+#endif
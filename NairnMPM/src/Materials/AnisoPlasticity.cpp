@@ -270,7 +270,7 @@ void AnisoPlasticity::LRElasticConstitutiveLaw(MPMBase *mptr,Matrix3 &de,Matrix3
 	
 	// get stress increment in material axes by first rotating current stress
 	// to material and then adding elastic increment
-	Tensor *sp = mptr->GetStressTensor();
+	StressTensor *sp = mptr->GetStressTensor();
 	
 	// effective strains
 	double dvxxeff = de(0,0)-er(0,0);
@@ -347,8 +347,8 @@ void BistableIsotropic::LRConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTim
 	
     // Calculate critical value for transition
     double dmechV,dTrace,ds1,ds2,ds3;
-	Tensor *sp=mptr->GetStressTensor();
-	Tensor *ep=mptr->GetStrainTensor();
+	StressTensor *sp=mptr->GetStressTensor();
+	StrainTensor *ep=mptr->GetStrainTensor();
 	
 	switch(rule)
 	{	case DILATION_RULE:
@@ -455,8 +455,8 @@ void BistableIsotropic::SRConstitutiveLaw(MPMBase *mptr,Matrix3 dv,double delTim
 	
     // Calculate critical value for transition
     double dmechV,dTrace,ds1,ds2,ds3;
-	Tensor *sp=mptr->GetStressTensor();
-	Tensor *ep=mptr->GetStrainTensor();
+	StressTensor *sp=mptr->GetStressTensor();
+	StrainTensor *ep=mptr->GetStrainTensor();
 	
 	switch(rule)
 	{	case DILATION_RULE:
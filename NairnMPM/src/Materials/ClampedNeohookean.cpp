@@ -196,7 +196,7 @@ void ClampedNeohookean::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTi
 	}
 	
 	// store B elastic
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     Tensor *B = mptr->GetAltStrainTensor();
 	B->xx = Belas(0,0);
 	B->yy = Belas(1,1);
@@ -230,7 +230,7 @@ void ClampedNeohookean::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTi
 	double Jeff = Je/Jres;
 		
 	// for incremental energy, store initial stress and pressure
-	Tensor *sporig=mptr->GetStressTensor();
+	StressTensor *sporig=mptr->GetStressTensor();
 	Tensor st0 = *sporig;
 	double Pfinal,p0=mptr->GetPressure();
 	
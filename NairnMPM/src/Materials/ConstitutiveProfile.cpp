@@ -0,0 +1,164 @@
+/********************************************************************************
+	ConstitutiveProfile.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Materials/ConstitutiveProfile.hpp"
+#include "Materials/MaterialBase.hpp"
+
+// global object when accounting for constitutive law costs
+ConstitutiveProfile *constitutiveProfile=NULL;
+
+#pragma mark ConstitutiveProfile::Constructors and Destructors
+
+// Create for threads and materials
+// throws std::bad_alloc
+ConstitutiveProfile::ConstitutiveProfile(int threads,int mats)
+{
+	numThreads = threads>1 ? threads : 1;
+	numMats = mats;
+	MaterialCost zero = {0.,0,0,0,0,0,0};
+	threadCosts.assign(numThreads*numMats,zero);
+	totalCosts.assign(numMats,zero);
+}
+
+#pragma mark ConstitutiveProfile::Methods
+
+// Add strain update on particle of material matID (0 based) by thread tn that took seconds
+void ConstitutiveProfile::AddUpdate(int tn,int matID,double seconds)
+{
+	if(tn>=numThreads || matID<0 || matID>=numMats) return;
+	MaterialCost &cost = threadCosts[tn*numMats+matID];
+	cost.time += seconds;
+	cost.calls++;
+}
+
+// Add plastic return solution on particle of material matID
+// Thread is found from OpenMP thread number, which must be the strain update thread
+void ConstitutiveProfile::AddSolve(int matID,int iterations,bool bracketed,bool limited)
+{
+	int tn = ThreadNumber();
+	if(tn>=numThreads || matID<0 || matID>=numMats) return;
+	MaterialCost &cost = threadCosts[tn*numMats+matID];
+	cost.solves++;
+	if(bracketed) cost.bracketed++;
+	cost.iterations += iterations;
+	if(limited) cost.atLimit++;
+}
+
+// Add bracketed solution that could not be bracketed
+void ConstitutiveProfile::AddBracketFailure(int matID)
+{
+	int tn = ThreadNumber();
+	if(tn>=numThreads || matID<0 || matID>=numMats) return;
+	threadCosts[tn*numMats+matID].unbracketed++;
+}
+
+// Write costs for each non-rigid material since last interval
+// Time in ms/step and ns/update, counts are totals for nsteps
+// JSON is array of objects, CSV is one line per material
+void ConstitutiveProfile::WriteProfileInterval(ostream &os,bool json,int step,double atime,int nsteps)
+{
+	vector< MaterialCost > costs(numMats);
+	SumThreadCosts(costs);
+
+	bool first = true;
+	if(json) os << "[";
+	for(int i=0;i<numMats;i++)
+	{	if(theMaterials[i]->IsRigid()) continue;
+		const MaterialCost &cost = costs[i];
+		double msPerStep = 1000.*cost.time/(double)nsteps;
+		double nsPerUpdate = cost.calls>0 ? 1.e9*cost.time/(double)cost.calls : 0.;
+		double itersPerSolve = cost.solves>0 ? (double)cost.iterations/(double)cost.solves : 0.;
+		if(json)
+		{	os << (first ? "" : ",") << "{\"material\":" << i+1 << ",\"name\":\"" << theMaterials[i]->name
+				<< "\",\"type\":\"" << theMaterials[i]->MaterialType() << "\",\"calls\":" << cost.calls
+				<< ",\"ms_per_step\":" << msPerStep << ",\"ns_per_update\":" << nsPerUpdate
+				<< ",\"solves\":" << cost.solves << ",\"bracketed\":" << cost.bracketed
+				<< ",\"iterations_per_solve\":" << itersPerSolve << ",\"at_limit\":" << cost.atLimit
+				<< ",\"unbracketed\":" << cost.unbracketed << "}";
+		}
+		else
+		{	// step,time,steps,material,name,type,calls,ms_per_step,ns_per_update,solves,bracketed,iterations_per_solve,at_limit,unbracketed
+			os << step << "," << atime << "," << nsteps << "," << i+1 << ",\"" << theMaterials[i]->name << "\",\""
+				<< theMaterials[i]->MaterialType() << "\"," << cost.calls << "," << msPerStep << "," << nsPerUpdate << ","
+				<< cost.solves << "," << cost.bracketed << "," << itersPerSolve << "," << cost.atLimit << ","
+				<< cost.unbracketed << endl;
+		}
+		first = false;
+	}
+	if(json) os << "]";
+}
+
+// add interval to run totals and start new interval
+void ConstitutiveProfile::ResetProfileInterval(void)
+{
+	SumThreadCosts(totalCosts);
+	MaterialCost zero = {0.,0,0,0,0,0,0};
+	for(int i=0;i<(int)threadCosts.size();i++)
+		threadCosts[i] = zero;
+}
+
+// Print totals for the run to standard output
+void ConstitutiveProfile::PrintCosts(int nsteps) const
+{
+	vector< MaterialCost > costs(totalCosts);
+	SumThreadCosts(costs);
+
+	double totalTime = 0.;
+	for(int i=0;i<numMats;i++) totalTime += costs[i].time;
+	if(nsteps<=0 || totalTime<=0.) return;
+
+	char fline[200];
+	cout << "\nConstitutive Law Costs (strain updates: " << 1000.*totalTime/(double)nsteps << " ms/step)" << endl;
+	for(int i=0;i<numMats;i++)
+	{	const MaterialCost &cost = costs[i];
+		if(cost.calls==0) continue;
+		cout << "Material #" << i+1 << ": " << theMaterials[i]->name << ": ";
+		sprintf(fline,"%s: %.3lf ms/step (%.1lf%%), %.1lf ns/update",theMaterials[i]->MaterialType(),
+				1000.*cost.time/(double)nsteps,100.*cost.time/totalTime,1.e9*cost.time/(double)cost.calls);
+		cout << fline << endl;
+		if(cost.solves>0)
+		{	sprintf(fline,"   plastic returns: %ld (%ld bracketed), %.2lf iterations/return, %ld at iteration limit, %ld not bracketed",
+					cost.solves,cost.bracketed,(double)cost.iterations/(double)cost.solves,cost.atLimit,cost.unbracketed);
+			cout << fline << endl;
+		}
+	}
+}
+
+// add costs in all threads to sums (which are not zeroed first)
+void ConstitutiveProfile::SumThreadCosts(vector< MaterialCost > &sums) const
+{
+	for(int tn=0;tn<numThreads;tn++)
+	{	for(int i=0;i<numMats;i++)
+			AddCost(sums[i],threadCosts[tn*numMats+i]);
+	}
+}
+
+#pragma mark ConstitutiveProfile::Class Methods
+
+// add cost b to a
+void ConstitutiveProfile::AddCost(MaterialCost &a,const MaterialCost &b)
+{
+	a.time += b.time;
+	a.calls += b.calls;
+	a.solves += b.solves;
+	a.bracketed += b.bracketed;
+	a.iterations += b.iterations;
+	a.atLimit += b.atLimit;
+	a.unbracketed += b.unbracketed;
+}
+
+// OpenMP thread number (or 0)
+int ConstitutiveProfile::ThreadNumber(void)
+{
+#ifdef _OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,62 @@
+/********************************************************************************
+	ConstitutiveProfile.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Optional cost accounting for constitutive laws (see <MaterialProfile>
+	command). For each material ID, it tracks time and number of particle
+	strain updates and, for plasticity using hardening laws, the number of
+	plastic return solutions, total iterations, solutions stopped at the
+	iteration limit, and bracketed solutions that could not bracket. Each
+	thread adds to its own counts, which are summed when reported at the
+	end of the run or in archives.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _CONSTITUTIVEPROFILE_
+
+#define _CONSTITUTIVEPROFILE_
+
+typedef struct
+{	double time;				// time in strain updates (sec)
+	long calls;					// number of particle strain updates
+	long solves;				// plastic return solutions
+	long bracketed;				// solutions using safe (bracketed) Newton's method
+	long iterations;			// total iterations in all solutions
+	long atLimit;				// solutions stopped at iteration limit
+	long unbracketed;			// bracketed solutions that failed to bracket
+} MaterialCost;
+
+class ConstitutiveProfile
+{
+	public:
+
+		// constructors and destructors
+		ConstitutiveProfile(int,int);
+
+		// methods
+		void AddUpdate(int,int,double);
+		void AddSolve(int,int,bool,bool);
+		void AddBracketFailure(int);
+		void WriteProfileInterval(ostream &,bool,int,double,int);
+		void ResetProfileInterval(void);
+		void PrintCosts(int) const;
+
+	private:
+		int numThreads,numMats;
+		vector< MaterialCost > threadCosts;			// [thread*numMats+matID] since last archive
+		vector< MaterialCost > totalCosts;			// [matID] prior to last archive
+
+		void SumThreadCosts(vector< MaterialCost > &) const;
+		static void AddCost(MaterialCost &,const MaterialCost &);
+		static int ThreadNumber(void);
+};
+
+// global object when accounting for constitutive law costs (otherwise NULL)
+extern ConstitutiveProfile *constitutiveProfile;
+
+#endif
@@ -117,7 +117,7 @@ void Elastic::LRElasticConstitutiveLaw(MPMBase *mptr,Matrix3 &de,Matrix3 &er,Mat
 	double dgamxy = 2.*de(0,1);
 	
     // save initial stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
  
 	// stress increments
 	// cast pointer to material-specific data
@@ -137,8 +137,9 @@ void Elastic::LRElasticConstitutiveLaw(MPMBase *mptr,Matrix3 &de,Matrix3 &er,Mat
 
 		// update sigma = dR signm1 dRT + Rtot dsigma RtotT
 		dsig = Rtot.RVoightRT(&dsig, true, false);
-		*sp = dR.RVoightRT(sp, true, false);
-		AddTensor(sp, &dsig);
+		Tensor str = *sp;
+		str = dR.RVoightRT(&str, true, false);
+		*sp = *AddTensor(&str, &dsig);
 		
 		// stresses are in global coordinates so need to rotate strain and residual
 		// strain to get work energy increment per unit mass (dU/(rho0 V0))
@@ -165,8 +166,9 @@ void Elastic::LRElasticConstitutiveLaw(MPMBase *mptr,Matrix3 &de,Matrix3 &er,Mat
 		
 		// update sigma = dR signm1 dRT + Rtot dsigma RtotT
 		dsig = Rtot.RVoightRT(&dsig, true, true);
-		*sp = dR.RVoightRT(sp, true, true);
-		AddTensor(sp, &dsig);
+		Tensor str = *sp;
+		str = dR.RVoightRT(&str, true, true);
+		*sp = *AddTensor(&str, &dsig);
 		
 		// stresses are in global coordinate so need to rotate strain and residual
 		// strain to get work energy increment per unit mass (dU/(rho0 V0))
@@ -243,7 +245,7 @@ void Elastic::SRConstitutiveLaw2D(MPMBase *mptr,Matrix3 du,double delTime,int np
 	double dgameff = dgam - erxy;
     
     // save initial stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     Tensor st0=*sp;
 	
 	// find stress (Units N/m^2  mm^3/g)
@@ -342,7 +344,7 @@ void Elastic::SRConstitutiveLaw3D(MPMBase *mptr,Matrix3 du,double delTime,int np
 	double dgamxyeff = dgamxy-exyr;
 	
     // save initial stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     Tensor st0=*sp;
 	
 	// stress increments
@@ -576,7 +578,7 @@ void Elastic::PostFailureUpdate(double &decxx,double &dgcxy,double &dgcxz,Tensor
 // Update cracking strain and total stress
 // Here str is current particle stress rotated by dR to updated configuration
 // Return cracking strain in updated configuration in ecrack
-void Elastic::UpdateCrackingStrainStress(int np,Tensor *ecrack,Tensor *sp,double decxx,double dgcxy,double dgcxz,
+void Elastic::UpdateCrackingStrainStress(int np,Tensor *ecrack,StressTensor *sp,double decxx,double dgcxy,double dgcxz,
 										 Tensor *dsig,Tensor *str,Matrix3 Rtot) const
 {
 	if(np==THREED_MPM)
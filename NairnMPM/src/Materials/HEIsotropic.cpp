@@ -189,7 +189,7 @@ void HEIsotropic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 	HEPlasticProperties *p = (HEPlasticProperties *)properties;
 
     // store initial stress
-    Tensor *sp = mptr->GetStressTensor();
+    StressTensor *sp = mptr->GetStressTensor();
     Tensor st0 = *sp;
     
     // Compute Elastic Predictor
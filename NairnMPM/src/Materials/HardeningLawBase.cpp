@@ -13,6 +13,7 @@
 #include "MPM_Classes/MPMBase.hpp"
 #include "Exceptions/CommonException.hpp"
 #include "System/UnitsController.hpp"
+#include "Materials/ConstitutiveProfile.hpp"
 
 #pragma mark HardeningLawBase::Constructors and Destructors
 
@@ -160,7 +161,7 @@ double HardeningLawBase::SolveForLambda(MPMBase *mptr,int np,double strial,Tenso
 {
 	// initial lambdk from dalpha set before call, often 0, but might be otherwise
 	double lambdak=a->dalpha/SQRT_TWOTHIRDS;
-	int step=1;
+	int step=1,iterations=0;
 	
 	if(np==PLANE_STRESS_MPM)
 	{	double n2trial = -stk->xx+stk->yy;
@@ -170,6 +171,7 @@ double HardeningLawBase::SolveForLambda(MPMBase *mptr,int np,double strial,Tenso
 		n1trial *= n1trial/6.;
 		while(true)
 		{	// update iterative variables (lambda, alpha, stress)
+			iterations++;
 			double d1 = (1 + psKred*lambdak);
 			double d2 = (1.+2.*Gred*lambdak);
 			double fnp12 = n1trial/(d1*d1) + n2trial/(d2*d2);
@@ -188,6 +190,7 @@ double HardeningLawBase::SolveForLambda(MPMBase *mptr,int np,double strial,Tenso
 	else
 	{	while(true)
         {	// update iterative variables (lambda, alpha)
+            iterations++;
             double glam = -SQRT_TWOTHIRDS*GetYield(mptr,np,delTime,a,p) + strial - 2*Gred*lambdak;
             double slope = -2.*Gred - GetKPrime(mptr,np,delTime,a,p);
             double delLam = -glam/slope;
@@ -198,6 +201,11 @@ double HardeningLawBase::SolveForLambda(MPMBase *mptr,int np,double strial,Tenso
             if(LambdaConverged(step++,lambdak,delLam)) break;
         }
 	}
+	
+	// cost accounting (iterations done, which exceed the limit only if stopped there)
+	if(constitutiveProfile!=NULL)
+		constitutiveProfile->AddSolve(mptr->MatID(),iterations,false,iterations>MAX_LAMBDA_STEPS);
+	
 	return lambdak;
 }
 
@@ -217,14 +225,18 @@ double HardeningLawBase::SolveForLambdaBracketed(MPMBase *mptr,int np,double str
     
     // if fails to bracket, convert to zero deviatoric stress and continue
     // This option does not happen in plane stress calculations
-    if(xh>xl) return xh;
+    if(xh>xl)
+	{	if(constitutiveProfile!=NULL)
+			constitutiveProfile->AddBracketFailure(mptr->MatID());
+		return xh;
+	}
     
 	// initial lambdk midpoint of the brackets
 	double lambdak=0.5*(xl+xh);
     UpdateTrialAlpha(mptr,np,lambdak,(double)0.,a,offset);
     double dxold=fabs(xh-xl);
     double dx=dxold;
-	int step=1;
+	int step=1,iterations=0;
 	
 	if(np==PLANE_STRESS_MPM)
 	{	double n2trial = -stk->xx+stk->yy;
@@ -234,6 +246,7 @@ double HardeningLawBase::SolveForLambdaBracketed(MPMBase *mptr,int np,double str
 		n1trial *= n1trial/6.;
         while(true)
         {	// update iterative variables (lambda, alpha)
+			iterations++;
 			double d1 = (1 + psKred*lambdak);
 			double d2 = (1.+2.*Gred*lambdak);
 			double fnp12 = n1trial/(d1*d1) + n2trial/(d2*d2);
@@ -272,6 +285,7 @@ double HardeningLawBase::SolveForLambdaBracketed(MPMBase *mptr,int np,double str
 	else
 	{	while(true)
         {	// update iterative variables (lambda, alpha)
+            iterations++;
             double glam = strial - 2*Gred*lambdak - SQRT_TWOTHIRDS*GetYield(mptr,np,delTime,a,p);
             double slope = -2.*Gred - GetKPrime(mptr,np,delTime,a,p);
             
@@ -302,6 +316,10 @@ double HardeningLawBase::SolveForLambdaBracketed(MPMBase *mptr,int np,double str
                 xh = lambdak;
         }
 	}
+	
+	// cost accounting (iterations done, which exceed the limit only if stopped there)
+	if(constitutiveProfile!=NULL)
+		constitutiveProfile->AddSolve(mptr->MatID(),iterations,true,iterations>MAX_LAMBDA_STEPS);
     
     // return final answer
 	return lambdak;
@@ -357,6 +375,8 @@ void HardeningLawBase::BracketSolution(MPMBase *mptr,int np,double strial,Tensor
         }
         
         // exception if did not find answer in 20 orders of magnitude in strain rate
+		if(constitutiveProfile!=NULL)
+			constitutiveProfile->AddBracketFailure(mptr->MatID());
 		cout << "# Material point information that caused the exception:" << endl;
 		mptr->Describe();
 		char errMsg[250];
@@ -387,7 +407,7 @@ void HardeningLawBase::BracketSolution(MPMBase *mptr,int np,double strial,Tensor
 // subclass can override to change convergence rules
 bool HardeningLawBase::LambdaConverged(int step,double lambda,double delLam) const
 {
-	if(step>20 || fabs(delLam/lambda)<0.0001) return true;
+	if(step>MAX_LAMBDA_STEPS || fabs(delLam/lambda)<0.0001) return true;
 	return false;
 }
 
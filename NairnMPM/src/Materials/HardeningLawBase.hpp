@@ -15,6 +15,9 @@
 
 #include "Materials/MaterialBase.hpp"
 
+// maximum steps in numerical solutions for lambda (see LambdaConverged())
+#define MAX_LAMBDA_STEPS 20
+
 class MPMBase;
 
 class HardeningLawBase
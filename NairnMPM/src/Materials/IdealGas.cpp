@@ -101,7 +101,7 @@ void IdealGas::SetInitialParticleState(MPMBase *mptr,int np,int offset) const
     double Psp = -P0sp * (thermal.reference/T0);
     
     // set the particle pressure
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
 	sp->xx = Psp;
 	sp->yy = Psp;
 	sp->zz = Psp;
@@ -163,7 +163,7 @@ void IdealGas::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int np
 	}
 	
     // update stress (which is -P)
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     double mPnsp = sp->xx;
 
 //#define INCREMENTAL_PSP
@@ -216,7 +216,7 @@ const char *IdealGas::MaterialType(void) const { return "Ideal Gas (Hyperelastic
 double IdealGas::WaveSpeed(bool threeD,MPMBase *mptr) const
 {	double Pspcurr;
 	if(mptr!=NULL)
-	{	Tensor *sp=mptr->GetStressTensor();
+	{	StressTensor *sp=mptr->GetStressTensor();
 		Pspcurr = fmax(-sp->xx,0.);
 	}
 	else
@@ -193,7 +193,7 @@ void IsoPlasticity::PlasticityConstLaw(MPMBase *mptr,Matrix3 de,double delTime,i
 	// Task 3: Rotate state n-1 to configuration n
 	//----------------------------------------------
 	Tensor *eplast=mptr->GetAltStrainTensor();
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
 	Tensor st0;
 	if(useLargeRotation)
 	{	// plastic strain (stored on particle)
@@ -201,7 +201,8 @@ void IsoPlasticity::PlasticityConstLaw(MPMBase *mptr,Matrix3 de,double delTime,i
 		*eplast = etr;
 		
 		// prior stress (not stored on particle until later)
-		st0 = dR->RVoightRT(sp,true,is2D);
+		st0 = *sp;
+		st0 = dR->RVoightRT(&st0,true,is2D);
 	}
 	else
 	{	// plastic strain (stored on particle)
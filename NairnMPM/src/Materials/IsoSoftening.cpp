@@ -367,7 +367,7 @@ void IsoSoftening::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 	ElasticProperties *p = GetElasticPropertiesPointer(properties);
 	
 	// initial stresses
-	Tensor *sp = mptr->GetStressTensor();
+	StressTensor *sp = mptr->GetStressTensor();
 	
 	// residual strain (thermal and moisture)
 	// (CTE1 and CME1 are reduced to plane strain, but not CTE3 and CME3)
@@ -399,7 +399,8 @@ void IsoSoftening::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 		
 		// Load str with effective stress in initial configuraiton used to look for initiation of failure
 		// It is particle stress
-		Tensor str = Rnm1.RTVoightR(sp,true,is2D);
+		Tensor str = *sp;
+		str = Rnm1.RTVoightR(&str,true,is2D);
 
 		// Add incremental stress
 		AddTensor(&str,&dstr);
@@ -444,7 +445,8 @@ void IsoSoftening::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 	Rtot *= RToCrack;
 	
 	// Get particle stress now rotated to the crack axis system
-	Tensor str = Rnm1.RTVoightR(sp,true,is2D);
+	Tensor str = *sp;
+	str = Rnm1.RTVoightR(&str,true,is2D);
 
 	// get cracking strain in crack axis system and apply
 	// incremental rotation to particle cracking strain
@@ -645,8 +647,9 @@ Vector IsoSoftening::DamageEvolution(MPMBase *mptr,int np,double *soft,Tensor &d
 	// current was rotated by dR (above) now add increment rotated by Rtot
 	
 	// rotate previous stress by rotation increment
-	Tensor *sp = mptr->GetStressTensor();
-	str = dR.RVoightRT(sp,true,is2D);
+	StressTensor *sp = mptr->GetStressTensor();
+	str = *sp;
+	str = dR.RVoightRT(&str,true,is2D);
 
 	// get stress incement for other stresses in crack axis system
 	if(np==THREED_MPM)
@@ -678,7 +681,8 @@ Vector IsoSoftening::DamageEvolution(MPMBase *mptr,int np,double *soft,Tensor &d
 	de = Rtot.RVoightRT(&de,false,is2D);
 	if(np==THREED_MPM)
 	{	// work and residual energy
-		mptr->AddWorkEnergyAndResidualEnergy(DotTensors(sp,&de),(sp->xx + sp->yy + sp->zz)*eres);
+		Tensor stress = *sp;
+		mptr->AddWorkEnergyAndResidualEnergy(DotTensors(&stress,&de),(sp->xx + sp->yy + sp->zz)*eres);
 		
 	}
 	else
@@ -776,7 +780,7 @@ Tensor IsoSoftening::GetStressIncrement(Tensor &deij,int np,void *properties) co
 // For isotropic elastic material, accept new trial stress state
 // str, de in initial configuration and need to rotate to current using Rtot
 // Need rotate to current axes and update stress and all other terms
-void IsoSoftening::AcceptTrialStress(MPMBase *mptr,Tensor &str,Tensor *sp,int np,Matrix3 *Rtot,
+void IsoSoftening::AcceptTrialStress(MPMBase *mptr,Tensor &str,StressTensor *sp,int np,Matrix3 *Rtot,
 									 void *properties,Tensor &de,double eres,double ezzres) const
 {
 	if(np==THREED_MPM)
@@ -49,7 +49,7 @@ class IsoSoftening : public IsotropicMat
 	
 		// isotropic elasticity methods
 		virtual Tensor GetStressIncrement(Tensor &,int,void *) const;
-		virtual void AcceptTrialStress(MPMBase *,Tensor &,Tensor *,int,Matrix3 *,void *,Tensor &,double,double) const;
+		virtual void AcceptTrialStress(MPMBase *,Tensor &,StressTensor *,int,Matrix3 *,void *,Tensor &,double,double) const;
 	
 		// accessors
 		virtual const char *MaterialType() const;
@@ -32,6 +32,7 @@
 #include "Materials/SmoothStep3.hpp"
 #include "Global_Quantities/BodyForce.hpp"
 #include "Materials/FailureSurface.hpp"
+#include "MPM_Classes/ParticleArena.hpp"
 #include <vector>
 
 // global
@@ -762,7 +763,7 @@ double MaterialBase::GetHistory(int num,char *historyPtr) const
 int MaterialBase::SizeOfHistoryData(void) const { return -1; }
 
 // if pchr==NULL, create buffer for material data with the requested number of double
-//		otherwise assume it already exists and is big enough
+//		(in particle arena while it is open) otherwise assume it already exists and is big enough
 // set each double in the history data to zero
 // throws std::bad_alloc
 double *MaterialBase::CreateAndZeroDoubles(char *pchr,int numDoubles) const
@@ -771,7 +772,10 @@ double *MaterialBase::CreateAndZeroDoubles(char *pchr,int numDoubles) const
 	if(pchr==NULL)
 	{	// allocate history data space
 		int historySize = numDoubles*sizeof(double);
-		pchr = new char[historySize];
+		if(particleArena!=NULL && particleArena->IsOpen())
+			pchr = particleArena->Allocate(historySize);
+		else
+			pchr = new char[historySize];
 	}
 	
 	// cast to double *
@@ -787,6 +791,10 @@ double *MaterialBase::CreateAndZeroDoubles(char *pchr,int numDoubles) const
 
 #pragma mark MaterialBase::Methods
 
+// Called (not in parallel) before strain updates on all particles with strainTime that will be
+//	passed as delTime to the constitutive law. Materials can find terms that depend only on the time step
+void MaterialBase::PrepareStrainUpdates(double strainTime) {}
+
 // Material classes thet need grid/non local stress must override this law to get that stresses
 void MaterialBase::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 dv,double delTime,int np,void *properties,
 									  ResidualStrains *res,int historyOffset,Tensor *gStress) const
@@ -930,7 +938,7 @@ void MaterialBase::IncrementHeatEnergy(MPMBase *mptr,double dTq0,double dPhi) co
 // This methods increments in-plane stresses only
 void MaterialBase::Hypo2DCalculations(MPMBase *mptr,double dwrotxy,double dsxx,double dsyy,double dtxy) const
 {
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
 	double dnorm = dwrotxy*sp->xy;
 	double dshear =  0.5*dwrotxy*(sp->xx-sp->yy);
 	sp->xx += dsxx - dnorm;
@@ -945,7 +953,7 @@ void MaterialBase::Hypo2DCalculations(MPMBase *mptr,double dwrotxy,double dsxx,d
 void MaterialBase::Hypo3DCalculations(MPMBase *mptr,double dwxy,double dwxz,double dwyz,double *dsig) const
 {
 	// get stress tensor
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
 	
 	// stress increments involving current stress
 	Tensor st;
@@ -1540,14 +1548,14 @@ Tensor MaterialBase::GetStressPandDev(Tensor *sp,double pressure,MPMBase *mptr)
 
 // store a new total stress on a particle's stress and pressure variables
 void MaterialBase::SetStress(Tensor *spnew,MPMBase *mptr) const
-{	Tensor *sp = mptr->GetStressTensor();
+{	StressTensor *sp = mptr->GetStressTensor();
 	*sp = *spnew;
 }
 
 // store a new total stress on a particle's stress and pressure variables
 void MaterialBase::SetStressPandDev(Tensor *spnew,MPMBase *mptr) const
 {	double newP = -(spnew->xx+spnew->yy+spnew->zz)/3.;
-	Tensor *sp = mptr->GetStressTensor();
+	StressTensor *sp = mptr->GetStressTensor();
 	*sp = *spnew;
 	sp->xx += newP;
 	sp->yy += newP;
@@ -1557,14 +1565,14 @@ void MaterialBase::SetStressPandDev(Tensor *spnew,MPMBase *mptr) const
 
 // For generalized plane stress, increment thickness (zz) stress
 void MaterialBase::IncrementThicknessStress(double dszz,MPMBase *mptr) const
-{	Tensor *sp = mptr->GetStressTensor();
+{	StressTensor *sp = mptr->GetStressTensor();
 	sp->zz += dszz;
 }
 
 // For generalized plane stress, increment thickness (zz) stress through deviatoric stress and pressure
 void MaterialBase::IncrementThicknessStressPandDev(double dszz,MPMBase *mptr) const
 {	double delP = -dszz/3.;
-	Tensor *sp = mptr->GetStressTensor();
+	StressTensor *sp = mptr->GetStressTensor();
 	sp->xx += delP;
 	sp->yy += delP;
 	sp->zz -= 2.*delP;
@@ -180,7 +180,7 @@ void Mooney::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int np,v
 								ResidualStrains *res,int historyOffset) const
 {
 	// incremental energy, store initial stress
-	Tensor *sporig=mptr->GetStressTensor();
+	StressTensor *sporig=mptr->GetStressTensor();
 	Tensor st0 = *sporig;
 	
 	// Update strains and rotations and Left Cauchy strain
@@ -206,7 +206,7 @@ void Mooney::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int np,v
 		
 		// Newton-Rapheson starting at B.zz = 1
 		// In tests finds answer in 3 or less steps
-		Tensor *ep=mptr->GetStrainTensor();
+		StrainTensor *ep=mptr->GetStrainTensor();
 		double xn16,xn12,xnp1,xn = (1.+ep->zz)*(1.+ep->zz);
 		double fx,fxp,J13,J0,Jeff;
 		int iter=1;
@@ -294,7 +294,7 @@ void Mooney::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int np,v
 	//JforG2 *= Jres;			// this uses Jeff to get Kirchoff stress
     
 	// find deviatoric (Cauchy stress)J/rho0 = deviatoric (Kirchoff stress)/rho0
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     
 	sp->xx = (2*B->xx-B->yy-B->zz)*G1sp/(3.*JforG1)
             + (B->xx*(B->yy+B->zz)-2*B->yy*B->zz-B->xy*B->xy)*G2sp/(3.*JforG2);
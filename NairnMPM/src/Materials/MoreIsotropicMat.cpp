@@ -61,7 +61,7 @@ void IsotropicMat::LRConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 	ElasticProperties *p = (ElasticProperties *)properties;
 	
 	// save initial stresses
-	Tensor *sp = mptr->GetStressTensor();
+	StressTensor *sp = mptr->GetStressTensor();
 	
 	// residual strains (thermal and moisture)
 	double eres = CTE1*res->dT;
@@ -98,8 +98,9 @@ void IsotropicMat::LRConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 		delsp.xy = p->C[5][5]*dgamxy;
 		
 		// increment stress: rotate previous stress and add new one
-		*sp = dR.RVoightRT(sp,true,false);
-		AddTensor(sp,&delsp);
+		Tensor str = *sp;
+		str = dR.RVoightRT(&str,true,false);
+		*sp = *AddTensor(&str,&delsp);
 		
 		// work energy increment per unit mass (dU/(rho0 V0))
 		mptr->AddWorkEnergyAndResidualEnergy(sp->xx*de(0,0) + sp->yy*de(1,1) + sp->zz*de(2,2)
@@ -122,7 +123,8 @@ void IsotropicMat::LRConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 		}
 		
 		// increment stress: rotate previous stress and add in-plane components
-		*sp = dR.RVoightRT(sp,true,true);
+		Tensor str = *sp;
+		*sp = dR.RVoightRT(&str,true,true);
 		sp->xx += delsp.xx;
 		sp->yy += delsp.yy;
 		sp->xy += delsp.xy;
@@ -209,7 +211,7 @@ void IsotropicMat::SRConstitutiveLaw2D(MPMBase *mptr,Matrix3 du,double delTime,i
 	double dVoverV = dvxx + dvyy;
     
     // save initial stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     Tensor st0=*sp;
 	
 	// find stress (Units N/m^2  mm^3/g)
@@ -307,7 +309,7 @@ void IsotropicMat::SRConstitutiveLaw3D(MPMBase *mptr,Matrix3 du,double delTime,i
 	double dVoverV = dvxx + dvyy + dvzz;
 	
     // save initial stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     Tensor st0=*sp;
 	
 	// stress increments
@@ -189,7 +189,7 @@ void Neohookean::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 	{	// Find B->zz required to have zero stress in z direction
 		double arg = B->xx*B->yy - B->xy*B->xy;
 		double xn;
-		Tensor *ep=mptr->GetStrainTensor();
+		StrainTensor *ep=mptr->GetStrainTensor();
 		
 		switch(UofJOption)
 		{   case J_MINUS_1_SQUARED:
@@ -240,7 +240,7 @@ void Neohookean::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
     mptr->SetHistoryDble(J_History,J,historyOffset);
 	
 	// for incremental energy, store initial stress
-	Tensor *sporig=mptr->GetStressTensor();
+	StressTensor *sporig=mptr->GetStressTensor();
 	Tensor st0 = *sporig;
 	
 	// account for residual stresses
@@ -275,7 +275,7 @@ void Neohookean::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
 	double GJeff = resStretch*pr.Gsp;		// = J*(Jres^(1/3) G/J) to get Kirchoff
     
 	// find deviatoric (Cauchy stress)J/rho0 = deviatoric (Kirchoff stress)/rho0
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     
     double I1third = (B->xx+B->yy+B->zz)/3.;
 	sp->xx = GJeff*(B->xx-I1third);
@@ -337,7 +337,7 @@ void TaitLiquid::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,int
     shear.Scale(J*twoetaspRate/delTime);
     
     // update deviatoric stress
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
     sp->xx = shear(0,0);
     sp->yy = shear(1,1);
     sp->zz = shear(2,2);
@@ -7,11 +7,15 @@
 ********************************************************************************/
 
 #include "stdafx.h"
+#include <sstream>
 #include "Materials/TractionLaw.hpp"
 #include "Cracks/CrackSegment.hpp"
 #include "System/ArchiveData.hpp"
 #include "System/UnitsController.hpp"
 
+// debond messages waiting for output in segment order
+unordered_map< CrackSegment *,string > TractionLaw::pendingDebonds;
+
 #pragma mark TractionLaw::Constructors and Destructors
 
 // Constructor 
@@ -50,12 +54,15 @@ const char *TractionLaw::VerifyAndLoadProperties(int np) { return NULL; }
 
 // report debond in same format for all cohesive laws
 // dtime in sec, cs if the debonded segment, fractionI is fraction mode I at time of debond
+// Traction laws are found in parallel so message is saved until OutputDebonds() is called
 void TractionLaw::ReportDebond(double dtime,CrackSegment *cs,double fractionI,double Gtotal)
 {
-	archiver->IncrementPropagationCounter();
-	cout << "# Debond: t=" << dtime*UnitsController::Scaling(1000.) << " (x,y) = (" << cs->cp.x << "," << cs->cp.y << ")"
+	ostringstream msg;
+	msg << "# Debond: t=" << dtime*UnitsController::Scaling(1000.) << " (x,y) = (" << cs->cp.x << "," << cs->cp.y << ")"
 			<< " GI(%) = " << 100.*fractionI << " G = "
-			<< Gtotal*UnitsController::Scaling(0.001) << endl;
+			<< Gtotal*UnitsController::Scaling(0.001);
+#pragma omp critical (debond)
+	pendingDebonds[cs] = msg.str();
 }
 
 // evaluate pressure at current time
@@ -88,3 +95,22 @@ const char *TractionLaw::MaterialType(void) const { return "Crack Traction Law";
 // check if traction law material
 int TractionLaw::MaterialStyle(void) const { return TRACTION_MAT; }
 
+#pragma mark TractionLaw::Class Methods
+
+// Output debonds for segments of one crack in segment order (called after crack's tractions are updated)
+void TractionLaw::OutputDebonds(vector< CrackSegment * > &segs)
+{
+#pragma omp critical (debond)
+	{	if(pendingDebonds.size()>0)
+		{	for(int i=0;i<(int)segs.size();i++)
+			{	unordered_map< CrackSegment *,string >::iterator found = pendingDebonds.find(segs[i]);
+				if(found==pendingDebonds.end()) continue;
+				archiver->IncrementPropagationCounter();
+#pragma omp critical (output)
+				cout << found->second << endl;
+				pendingDebonds.erase(found);
+			}
+		}
+	}
+}
+
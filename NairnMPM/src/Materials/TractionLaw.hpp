@@ -41,9 +41,13 @@ class TractionLaw : public MaterialBase
 		virtual double WaveSpeed(bool,MPMBase *) const;
 		virtual int MaterialStyle(void) const;
 	
+		// class methods
+		static void OutputDebonds(vector< CrackSegment * > &);
+	
 	protected:
 		double stress1,stress2;
 	
+		static unordered_map< CrackSegment *,string > pendingDebonds;
  };
 
 #endif
@@ -36,6 +36,10 @@ Viscoelastic::Viscoelastic(char *matName,int matID) : MaterialBase(matName,matID
 	// MGEOS variables
 	pressureLaw = LINEAR_PRESSURE;
 	mptrHistory=-1;		// Store J and J res if using MGEOS
+	akStart=0;
+	numComponents=4;
+	decayTerms=NULL;
+	decayTime=-1.;
 	gamma0=1.64;		// dimensionless
 	C0=4004000.;		// m/sec
 	S1=1.35;			// dimsionless
@@ -206,6 +210,9 @@ const char *Viscoelastic::VerifyAndLoadProperties(int np)
 		TwoGkred[k] = 2.*Gk[k]/rho;
     }
 	
+	// decay terms found once per time step
+	decayTerms = new double[4*ntaus];
+	
 	// Convert to specific moduli
 	Gered /= rho;
 	
@@ -244,6 +251,13 @@ const char *Viscoelastic::VerifyAndLoadProperties(int np)
 	else
 		return "Invalid option for the pressure law";
 	
+	// history layout
+	numComponents = np==THREED_MPM ? 6 : 4;
+	if(pressureLaw!=LINEAR_PRESSURE)
+	{	mptrHistory = 0;
+		akStart = MGJRES_HISTORY+1;
+	}
+	
     // for Cp-Cv (units nJ/(g-K^2))
     Ka2sp = 9.*Kered*CTE*CTE;
 	
@@ -272,91 +286,34 @@ void Viscoelastic::ValidateForUse(int np) const
 #pragma mark Viscoelastic::History Data Methods
 
 // create and return pointer to history variables
-// initialize all to zero
+// J and Jres (if MGEOS) are followed by ntaus internal variables for each strain
+//	component, which are read in MPMConstitutiveLaw() at ak[akStart+ij_HISTORY*ntaus+k]
+// initialize J's to one and all others to zero
 // throws std::bad_alloc
 char *Viscoelastic::InitHistoryData(char *pchr,MPMBase *mptr)
 {
-	// if none, only need particle history
-    if(ntaus==0)
-	{	if(pressureLaw!=LINEAR_PRESSURE)
-		{	char *p;
-			if(pchr==NULL)
-				p = new char[sizeof(double *)];
-			else
-				p = pchr;
-			double **h = (double **)p;
-			mptrHistory=0;
-			h[mptrHistory] = new double[2];
-			h[mptrHistory][MGJ_HISTORY] = 1.;					// J
-			h[mptrHistory][MGJRES_HISTORY] = 1.;				// Jres
-			return p;
-		}
-		else
-			return NULL;
-	}
-	
-    // allocate array of double pointers (3)
-	int blocks;
-	if(fmobj->IsThreeD())
-		blocks = 6;
-	else
-		blocks = 4;
+	int numHistory = NumberOfHistoryDoubles();
+	if(numHistory==0) return NULL;
 	
-	// one extra for any additional history variables
-	if(pressureLaw!=LINEAR_PRESSURE)
-	{	mptrHistory=blocks;
-		blocks++;
-	}
-	
-	// history variables are pointers to arrays of doubles
-    char *p = new char[sizeof(double *)*blocks];
-	
-    double **h = (double **)p;
-    
-    // for each allocate ntaus doubles
-    //	h[ij_HISTORY][0] to h[ij_HISTORY][ntaus-1] can be read
-    //	in MPMConstitutiveLaw() by casting mptr->GetHistoryPtr(0) pointer as
-    //		double **h=(double **)(mptr->GetHistoryPtr(0))
-    h[XX_HISTORY] = new double[ntaus];
-    h[YY_HISTORY] = new double[ntaus];
-    h[XY_HISTORY] = new double[ntaus];
-	h[ZZ_HISTORY] = new double[ntaus];
-	if(fmobj->IsThreeD())
-	{	h[XZ_HISTORY] = new double[ntaus];
-		h[YZ_HISTORY] = new double[ntaus];
-	}		
-    
-    // initialize to zero
-    int k;
-    for(k=0;k<ntaus;k++)
-    {	h[XX_HISTORY][k] = 0.;
-        h[YY_HISTORY][k] = 0.;
-        h[XY_HISTORY][k] = 0.;
-		h[ZZ_HISTORY][k] = 0.;
-		if(fmobj->IsThreeD())
-		{	h[XZ_HISTORY][k] = 0.;
-			h[YZ_HISTORY][k] = 0.;
-		}
-    }
-    
-	// extra particle history variables
+	double *h = CreateAndZeroDoubles(pchr,numHistory);
 	if(mptrHistory>=0)
-	{	h[mptrHistory] = new double[2];
-		h[mptrHistory][MGJ_HISTORY] = 1.;					// J
-		h[mptrHistory][MGJRES_HISTORY] = 1.;				// Jres
+	{	h[mptrHistory+MGJ_HISTORY] = 1.;					// J
+		h[mptrHistory+MGJRES_HISTORY] = 1.;				// Jres
 	}
-	
-    return p;
+	return (char *)h;
 }
 
+// Number of history doubles (zero if not MGEOS and no taus)
+int Viscoelastic::NumberOfHistoryDoubles(void) const { return akStart + numComponents*ntaus; }
+
 // Get J and Jres only and only in nonlinear pressure law
 double Viscoelastic::GetHistory(int num,char *historyPtr) const
 {
     double history=0.;
 	if(num>0 && num<=MGJRES_HISTORY+1)
 	{	if(mptrHistory>=0)
-		{	double **h =(double **)historyPtr;
-			history = h[mptrHistory][num-1];
+		{	double *h =(double *)historyPtr;
+			history = h[mptrHistory+num-1];
 		}
 		else
 			history = 1.;
@@ -366,6 +323,17 @@ double Viscoelastic::GetHistory(int num,char *historyPtr) const
 
 #pragma mark Viscoelastic::Methods
 
+// buffer for decay terms if a strain update uses a time other than the one prepared
+int Viscoelastic::SizeOfMechanicalProperties(int &altBufferSize) const
+{	altBufferSize = 0;
+	return ntaus>0 ? 4*ntaus*sizeof(double) : 0;
+}
+
+// Properties are constant, but return the buffer as scratch space for MPMConstitutiveLaw()
+void *Viscoelastic::GetCopyOfMechanicalProps(MPMBase *mptr,int np,void *matBuffer,void *altBuffer,int offset) const
+{	return matBuffer;
+}
+
 /* Take increments in strain and calculate new Particle: strains, rotation strain,
 	stresses, strain energy,
 	du are (gradient rates X time increment) to give deformation gradient change
@@ -406,19 +374,19 @@ void Viscoelastic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 	double delV = traceDe - 3.*eres;
 	
 	// history data
-	double **ak =(double **)(mptr->GetHistoryPtr(0));
+	double *ak =(double *)(mptr->GetHistoryPtr(0));
 
 	// find dJ and J if needed (plane stress not allowed)
 	if(mptrHistory>=0)
 	{	// large strain volume change
 		detdF = dF.determinant();
-		J = detdF*ak[mptrHistory][MGJ_HISTORY];
-		ak[mptrHistory][MGJ_HISTORY] = J;
+		J = detdF*ak[mptrHistory+MGJ_HISTORY];
+		ak[mptrHistory+MGJ_HISTORY] = J;
 		
 		// account for residual strains if needed
 		double dJres = exp(3.*eres);
-		double Jres = dJres*ak[mptrHistory][MGJRES_HISTORY];
-		ak[mptrHistory][MGJRES_HISTORY] = Jres;
+		double Jres = dJres*ak[mptrHistory+MGJRES_HISTORY];
+		ak[mptrHistory+MGJRES_HISTORY] = Jres;
 	}
 	
 	// deviatoric strains increment in de
@@ -433,6 +401,8 @@ void Viscoelastic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 	{	de.xz = 2.*detot(0,2);
 		de.yz = 2.*detot(1,2);
 	}
+	else
+		de.xz = de.yz = 0.;
 	
 	// Find initial 2*e(t) (deviatoric strain) in ed
 	Tensor ed;
@@ -456,74 +426,103 @@ void Viscoelastic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 	{	dsig[XZ] = Gered*de.xz;
 		dsig[YZ] = Gered*de.yz;
 	}
-	
-	// get internal variable increments, update them, add to incremental stress, and get dissipated energy6
+	else
+		dsig[XZ] = dsig[YZ] = 0.;
+	
+	// decay terms for this time step (found in PrepareStrainUpdates() unless called with different time,
+	// which uses the thread's property buffer)
+	const double *tmpm1 = decayTerms;
+	if(delTime!=decayTime && ntaus>0)
+	{	double *stepTerms = (double *)properties;
+		FillDecayTerms(stepTerms,delTime);
+		tmpm1 = stepTerms;
+	}
+	const double *tmpp1 = tmpm1+ntaus;
+	const double *arg = tmpp1+ntaus;
+	const double *phik = arg+ntaus;
+	
+	// internal variables for each component
+	double *akxx = ak+akStart+XX_HISTORY*ntaus;
+	double *akyy = ak+akStart+YY_HISTORY*ntaus;
+	double *akxy = ak+akStart+XY_HISTORY*ntaus;
+	double *akzz = ak+akStart+ZZ_HISTORY*ntaus;
+	double *akxz = np==THREED_MPM ? ak+akStart+XZ_HISTORY*ntaus : NULL;
+	double *akyz = np==THREED_MPM ? ak+akStart+YZ_HISTORY*ntaus : NULL;
+	
+	// get internal variable increments, update them, add to incremental stress, and get dissipated energy
 	Tensor dak;
 	int k;
-    for(k=0;k<ntaus;k++)
-    {   double tmp = exp(-delTime/tauk[k]);
-		double tmpm1 = tmp-1.;
-		double tmpp1 = tmp+1.;
-		double arg = 0.25*delTime/tauk[k];					// 0.25 because e's have factor of 2
-		dak.xx = tmpm1*ak[XX_HISTORY][k] + arg*(tmpp1*ed.xx + de.xx);
-		dak.yy = tmpm1*ak[YY_HISTORY][k] + arg*(tmpp1*ed.yy + de.yy);
-		dak.xy = tmpm1*ak[XY_HISTORY][k] + arg*(tmpp1*ed.xy + de.xy);
-		dak.zz = tmpm1*ak[ZZ_HISTORY][k] + arg*(tmpp1*ed.zz + de.zz);
-		
-		// add to stress increments
-		dsig[XX] -= TwoGkred[k]*dak.xx;
-		dsig[YY] -= TwoGkred[k]*dak.yy;
-		dsig[ZZ] -= TwoGkred[k]*dak.zz;
-		dsig[XY] -= TwoGkred[k]*dak.xy;
-		
-		// extra terms for 3D
-		if(np==THREED_MPM)
+	if(np==THREED_MPM)
+	{	for(k=0;k<ntaus;k++)
 		{	// internal variables
-			dak.xz = tmpm1*ak[XZ_HISTORY][k] + arg*(tmpp1*ed.xz + de.xz);
-			dak.yz = tmpm1*ak[YZ_HISTORY][k] + arg*(tmpp1*ed.yz + de.yz);
+			dak.xx = tmpm1[k]*akxx[k] + arg[k]*(tmpp1[k]*ed.xx + de.xx);
+			dak.yy = tmpm1[k]*akyy[k] + arg[k]*(tmpp1[k]*ed.yy + de.yy);
+			dak.xy = tmpm1[k]*akxy[k] + arg[k]*(tmpp1[k]*ed.xy + de.xy);
+			dak.zz = tmpm1[k]*akzz[k] + arg[k]*(tmpp1[k]*ed.zz + de.zz);
+			dak.xz = tmpm1[k]*akxz[k] + arg[k]*(tmpp1[k]*ed.xz + de.xz);
+			dak.yz = tmpm1[k]*akyz[k] + arg[k]*(tmpp1[k]*ed.yz + de.yz);
 			
 			// add to stress increments
+			dsig[XX] -= TwoGkred[k]*dak.xx;
+			dsig[YY] -= TwoGkred[k]*dak.yy;
+			dsig[ZZ] -= TwoGkred[k]*dak.zz;
+			dsig[XY] -= TwoGkred[k]*dak.xy;
 			dsig[XZ] -= TwoGkred[k]*dak.xz;
 			dsig[YZ] -= TwoGkred[k]*dak.yz;
 			
 			// update history on particle
-			ak[XX_HISTORY][k] += dak.xx;
-			ak[YY_HISTORY][k] += dak.yy;
-			ak[ZZ_HISTORY][k] += dak.zz;
-			ak[XY_HISTORY][k] += dak.xy;
-			ak[XZ_HISTORY][k] += dak.xz;
-			ak[YZ_HISTORY][k] += dak.yz;
+			akxx[k] += dak.xx;
+			akyy[k] += dak.yy;
+			akzz[k] += dak.zz;
+			akxy[k] += dak.xy;
+			akxz[k] += dak.xz;
+			akyz[k] += dak.yz;
 			
 			// dissipation
-			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-ak[XX_HISTORY][k])
-									   + dak.yy*(ed.yy-ak[YY_HISTORY][k])
-									   + dak.zz*(ed.zz-ak[ZZ_HISTORY][k])
-									   + dak.xy*(ed.xy-ak[XY_HISTORY][k])
-									   + dak.xz*(ed.xz+-ak[XZ_HISTORY][k])
-									   + dak.yz*(ed.yz-ak[YZ_HISTORY][k]));
+			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-akxx[k])
+									   + dak.yy*(ed.yy-akyy[k])
+									   + dak.zz*(ed.zz-akzz[k])
+									   + dak.xy*(ed.xy-akxy[k])
+									   + dak.xz*(ed.xz-akxz[k])
+									   + dak.yz*(ed.yz-akyz[k]));
 		}
-		else if(np!=PLANE_STRESS_MPM)
-		{	// update history on particle
-			ak[XX_HISTORY][k] += dak.xx;
-			ak[YY_HISTORY][k] += dak.yy;
-			ak[ZZ_HISTORY][k] += dak.zz;
-			ak[XY_HISTORY][k] += dak.xy;
-
+	}
+	else
+	{	for(k=0;k<ntaus;k++)
+		{	// internal variables
+			dak.xx = tmpm1[k]*akxx[k] + arg[k]*(tmpp1[k]*ed.xx + de.xx);
+			dak.yy = tmpm1[k]*akyy[k] + arg[k]*(tmpp1[k]*ed.yy + de.yy);
+			dak.xy = tmpm1[k]*akxy[k] + arg[k]*(tmpp1[k]*ed.xy + de.xy);
+			dak.zz = tmpm1[k]*akzz[k] + arg[k]*(tmpp1[k]*ed.zz + de.zz);
+			
+			// add to stress increments
+			dsig[XX] -= TwoGkred[k]*dak.xx;
+			dsig[YY] -= TwoGkred[k]*dak.yy;
+			dsig[ZZ] -= TwoGkred[k]*dak.zz;
+			dsig[XY] -= TwoGkred[k]*dak.xy;
+			
+			// plane stress updates history after finding dezz
+			if(np==PLANE_STRESS_MPM) continue;
+			
+			// update history on particle
+			akxx[k] += dak.xx;
+			akyy[k] += dak.yy;
+			akzz[k] += dak.zz;
+			akxy[k] += dak.xy;
+			
 			// dissipation
-			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-ak[XX_HISTORY][k])
-									   + dak.yy*(ed.yy-ak[YY_HISTORY][k])
-									   + dak.zz*(ed.zz-ak[ZZ_HISTORY][k])
-									   + dak.xy*(ed.xy-ak[XY_HISTORY][k]));
+			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-akxx[k])
+									   + dak.yy*(ed.yy-akyy[k])
+									   + dak.zz*(ed.zz-akzz[k])
+									   + dak.xy*(ed.xy-akxy[k]));
 		}
 	}
 	
 	// For plane stress, find dezz and adjust all terms
 	if(np==PLANE_STRESS_MPM)
-	{	double phik,phi = Gered;
+	{	double phi = Gered;
 		for(k=0;k<ntaus;k++)
-		{   phik = 0.25*delTime*(exp(-delTime/tauk[k])+2.)/tauk[k];			// extra 1/2 because stored 2Gk
-			phi -= TwoGkred[k]*phik;
-		}
+			phi -= TwoGkred[k]*phik[k];
 		
 		// dezz
 		double dezz = -(Kered*delV + dsig[ZZ])/(Kered + 4.*phi/3.);
@@ -555,31 +554,27 @@ void Viscoelastic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
 		
 		// update history and get dissipation
 		for(k=0;k<ntaus;k++)
-		{   double tmp = exp(-delTime/tauk[k]);
-			double tmpm1 = tmp-1.;
-			double tmpp1 = tmp+1.;
-			double arg = 0.25*delTime/tauk[k];					// 0.25 because e's have factor of 2
-			dak.xx = tmpm1*ak[XX_HISTORY][k] + arg*(tmpp1*ed.xx + de.xx);
-			dak.yy = tmpm1*ak[YY_HISTORY][k] + arg*(tmpp1*ed.yy + de.yy);
-			dak.xy = tmpm1*ak[XY_HISTORY][k] + arg*(tmpp1*ed.xy + de.xy);
-			dak.zz = tmpm1*ak[ZZ_HISTORY][k] + arg*(tmpp1*ed.zz + de.zz);
+		{	dak.xx = tmpm1[k]*akxx[k] + arg[k]*(tmpp1[k]*ed.xx + de.xx);
+			dak.yy = tmpm1[k]*akyy[k] + arg[k]*(tmpp1[k]*ed.yy + de.yy);
+			dak.xy = tmpm1[k]*akxy[k] + arg[k]*(tmpp1[k]*ed.xy + de.xy);
+			dak.zz = tmpm1[k]*akzz[k] + arg[k]*(tmpp1[k]*ed.zz + de.zz);
 			
 			// update history on particle
-			ak[XX_HISTORY][k] += dak.xx;
-			ak[YY_HISTORY][k] += dak.yy;
-			ak[ZZ_HISTORY][k] += dak.zz;
-			ak[XY_HISTORY][k] += dak.xy;
+			akxx[k] += dak.xx;
+			akyy[k] += dak.yy;
+			akzz[k] += dak.zz;
+			akxy[k] += dak.xy;
 			
 			// dissipation
-			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-ak[XX_HISTORY][k])
-									   + dak.yy*(ed.yy-ak[YY_HISTORY][k])
-									   + dak.zz*(ed.zz-ak[ZZ_HISTORY][k])
-									   + dak.xy*(ed.xy-ak[XY_HISTORY][k]));
+			dispEnergy += TwoGkred[k]*(dak.xx*(ed.xx-akxx[k])
+									   + dak.yy*(ed.yy-akyy[k])
+									   + dak.zz*(ed.zz-akzz[k])
+									   + dak.xy*(ed.xy-akxy[k]));
 		}
 	}
 	
 	// Update particle deviatoric stresses
-	Tensor *sp=mptr->GetStressTensor();
+	StressTensor *sp=mptr->GetStressTensor();
 	
 	//Tensor st0 = *sp;
 	if(np==THREED_MPM)
@@ -647,6 +642,26 @@ void Viscoelastic::MPMConstitutiveLaw(MPMBase *mptr,Matrix3 du,double delTime,in
     IncrementHeatEnergy(mptr,dTq0,dispEnergy);
 }
 
+// Find decay terms for the time step used by all particles in the coming strain updates
+void Viscoelastic::PrepareStrainUpdates(double strainTime)
+{	if(ntaus<=0 || strainTime==decayTime) return;
+	FillDecayTerms(decayTerms,strainTime);
+	decayTime = strainTime;
+}
+
+// Fill terms with exp(-dt/tauk)-1, exp(-dt/tauk)+1, dt/(4 tauk), and plane stress
+//	phik = dt (exp(-dt/tauk)+2)/(4 tauk) for each tau (each in block of ntaus)
+// 0.25 because e's have factor of 2 (and extra 1/2 in phik because stored 2Gk)
+void Viscoelastic::FillDecayTerms(double *terms,double delTime) const
+{	for(int k=0;k<ntaus;k++)
+	{	double tmp = exp(-delTime/tauk[k]);
+		terms[k] = tmp-1.;
+		terms[ntaus+k] = tmp+1.;
+		terms[2*ntaus+k] = 0.25*delTime/tauk[k];
+		terms[3*ntaus+k] = 0.25*delTime*(tmp+2.)/tauk[k];
+	}
+}
+
 // This method handles the pressure equation of state. Its tasks are
 // 1. Calculate the new pressure
 // 2. Update particle pressure
@@ -685,9 +700,9 @@ void Viscoelastic::UpdatePressure(MPMBase *mptr,double delV,ResidualStrains *res
 		//		to stress-free state
 		
 		// history pointer
-		double **h =(double **)(mptr->GetHistoryPtr(0));
-		double J = h[mptrHistory][MGJ_HISTORY];
-		double Jres = h[mptrHistory][MGJRES_HISTORY];
+		double *h =(double *)(mptr->GetHistoryPtr(0));
+		double J = h[mptrHistory+MGJ_HISTORY];
+		double Jres = h[mptrHistory+MGJRES_HISTORY];
 		
 		// previous pressure
 		double P,P0 = mptr->GetPressure();
@@ -840,8 +855,8 @@ double Viscoelastic::CurrentWaveSpeed(bool threeD,MPMBase *mptr,int offset) cons
 // Get current relative volume change = J (which this material tracks)
 double Viscoelastic::GetCurrentRelativeVolume(MPMBase *mptr,int offset) const
 {	if(mptrHistory<0) return 1.;
-	double **h =(double **)mptr->GetHistoryPtr(offset);
-	return h[mptrHistory][MGJ_HISTORY];
+	double *h =(double *)mptr->GetHistoryPtr(offset);
+	return h[mptrHistory+MGJ_HISTORY];
 }
 
 // not supported yet, need to deal with aniostropi properties
@@ -34,12 +34,16 @@ class Viscoelastic : public MaterialBase
 		// history data
 		virtual char *InitHistoryData(char *,MPMBase *);
 		virtual double GetHistory(int,char *) const;
+		virtual int NumberOfHistoryDoubles(void) const;
 	
 		// const methods
 		virtual void PrintMechanicalProperties(void) const;
 		virtual void ValidateForUse(int) const;
     
 		// methods
+		virtual void PrepareStrainUpdates(double);
+		virtual int SizeOfMechanicalProperties(int &) const;
+		virtual void *GetCopyOfMechanicalProps(MPMBase *,int,void *,void *,int) const;
 		virtual void MPMConstitutiveLaw(MPMBase *,Matrix3,double,int,void *,ResidualStrains *,int) const;
         virtual double GetCpMinusCv(MPMBase *) const;
 		virtual void UpdatePressure(MPMBase *,double,ResidualStrains *,double,double,double,double,double &,double &) const;
@@ -72,6 +76,14 @@ class Viscoelastic : public MaterialBase
 		double C0squared;
 		double Kmax,Xmax;
 		int mptrHistory;
+	
+		// history is contiguous doubles: J and Jres (if MGEOS) then ntaus values for each component
+		int akStart,numComponents;
+	
+		// decay terms for each tau (tmp-1, tmp+1, arg, and plane stress phik) at decayTime
+		double *decayTerms,decayTime;
+	
+		void FillDecayTerms(double *,double) const;
 };
 
 #endif
@@ -19,14 +19,13 @@
 
 #include "stdafx.h"
 #include "NairnMPM_Class/ExtrapolateRigidBCsTask.hpp"
-#include "NairnMPM_Class/ProjectRigidBCsTask.hpp"
 #include "NairnMPM_Class/NairnMPM.hpp"
 #include "Materials/RigidMaterial.hpp"
 #include "MPM_Classes/MPMBase.hpp"
 #include "Elements/ElementBase.hpp"
-#include "Boundary_Conditions/NodalVelBC.hpp"
-#include "Boundary_Conditions/NodalTempBC.hpp"
-#include "Boundary_Conditions/NodalConcBC.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "Boundary_Conditions/BoundaryCondition.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 #include "Custom_Tasks/ConductionTask.hpp"
 
 #pragma mark CONSTRUCTORS
@@ -47,14 +46,8 @@ void ExtrapolateRigidBCsTask::Execute(int taskOption)
 	double fn[maxShapeNodes];
 #endif
 	
-	// undo dynamic velocity, temp, and conc BCs from rigid materials
-	// and get pointer to first empty one in reuseRigid...BC
-	ProjectRigidBCsTask::UnsetRigidBCs((BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-				  (BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-	ProjectRigidBCsTask::UnsetRigidBCs((BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,
-				  (BoundaryCondition **)&firstRigidTempBC,(BoundaryCondition **)&reuseRigidTempBC);
-	ProjectRigidBCsTask::UnsetRigidBCs((BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,
-				  (BoundaryCondition **)&firstRigidConcBC,(BoundaryCondition **)&reuseRigidConcBC);
+	// undo velocity, temp, and conc BCs set by rigid materials on the previous step
+	rigidNodalBCs->ClearRigidBCs();
 	
 	int i,numnds,setFlags;
 	Vector rvel;
@@ -73,7 +66,10 @@ void ExtrapolateRigidBCsTask::Execute(int taskOption)
 		// May not need to set to zero because setting BC will ignore those direction anyway
 		setFlags = rigid->SetDirection();
 		ZeroVector(&rvel);
-		if(rigid->GetVectorSetting(&mpmptr->vel,hasDir,mtime,&mpmptr->pos))
+		Vector rpos = mpmptr->pos,rpvel = mpmptr->vel;
+		bool velSet = rigid->GetVectorSetting(&rpvel,hasDir,mtime,&rpos);
+		mpmptr->vel = rpvel;
+		if(velSet)
 		{	if(hasDir[0]) rvel.x = mpmptr->vel.x;
 			if(hasDir[1]) rvel.y = mpmptr->vel.y;
 			if(hasDir[2]) rvel.z = mpmptr->vel.z;
@@ -87,13 +83,13 @@ void ExtrapolateRigidBCsTask::Execute(int taskOption)
 		// get rigid particle temperature
 		if(rigid->RigidTemperature() && ConductionTask::active)
 		{	setFlags += CONTROL_TEMPERATURE;
-			if(rigid->GetValueSetting(&tempValue,mtime,&mpmptr->pos)) mpmptr->pTemperature = tempValue;
+			if(rigid->GetValueSetting(&tempValue,mtime,&rpos)) mpmptr->pTemperature = tempValue;
 		}
 		
 		// concentration
 		if(rigid->RigidConcentration() && fmobj->HasFluidTransport())
 		{	setFlags += CONTROL_CONCENTRATION;
-			if(rigid->GetValueSetting(&concValue,mtime,&mpmptr->pos)) mpmptr->pConcentration = concValue;
+			if(rigid->GetValueSetting(&concValue,mtime,&rpos)) mpmptr->pConcentration = concValue;
 		}
 		
 		// get nodes and classic shape function for rigid material point p
@@ -120,35 +116,11 @@ void ExtrapolateRigidBCsTask::Execute(int taskOption)
 		setFlags = ndptr->ReadAndZeroRigidBCInfo(&rvel,&tempValue,&concValue);
 		if(setFlags==0) continue;
 
-		if(setFlags&CONTROL_X_DIRECTION)
-		{	ProjectRigidBCsTask::SetRigidBCs(i,-40,X_DIRECTION,rvel.x,0.,0,
-						(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-						(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-		}
-		if(setFlags&CONTROL_Y_DIRECTION)
-		{	ProjectRigidBCsTask::SetRigidBCs(i,-40,Y_DIRECTION,rvel.y,0.,0,
-						(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-						(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-		}
-		if(setFlags&CONTROL_Z_DIRECTION)
-		{	ProjectRigidBCsTask::SetRigidBCs(i,-40,Z_DIRECTION,rvel.z,0.,0,
-						(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-						(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-		}
-		if(setFlags&CONTROL_TEMPERATURE)
-		{	ProjectRigidBCsTask::SetRigidBCs(i,0,TEMP_DIRECTION,tempValue,0.,0,
-						(BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,
-						(BoundaryCondition **)&firstRigidTempBC,(BoundaryCondition **)&reuseRigidTempBC);
-		}
-		if(setFlags&CONTROL_CONCENTRATION)
-		{	ProjectRigidBCsTask::SetRigidBCs(i,0,CONC_DIRECTION,concValue,0.,0,
-						(BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,
-						(BoundaryCondition **)&firstRigidConcBC,(BoundaryCondition **)&reuseRigidConcBC);
-		}
+		// -39 is reaction force ID that does not match any material
+		if(setFlags&CONTROL_X_DIRECTION) rigidNodalBCs->SetRigidBC(i,X_DIRECTION,rvel.x,-39,0);
+		if(setFlags&CONTROL_Y_DIRECTION) rigidNodalBCs->SetRigidBC(i,Y_DIRECTION,rvel.y,-39,0);
+		if(setFlags&CONTROL_Z_DIRECTION) rigidNodalBCs->SetRigidBC(i,Z_DIRECTION,rvel.z,-39,0);
+		if(setFlags&CONTROL_TEMPERATURE) rigidNodalBCs->SetRigidBC(i,TEMP_DIRECTION,tempValue,-39,0);
+		if(setFlags&CONTROL_CONCENTRATION) rigidNodalBCs->SetRigidBC(i,CONC_DIRECTION,concValue,-39,0);
 	}
-	
-	// if any left over rigid BCs, delete them now
-	ProjectRigidBCsTask::RemoveRigidBCs((BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,(BoundaryCondition **)&firstRigidVelocityBC);
-	ProjectRigidBCsTask::RemoveRigidBCs((BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,(BoundaryCondition **)&firstRigidTempBC);
-	ProjectRigidBCsTask::RemoveRigidBCs((BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,(BoundaryCondition **)&firstRigidConcBC);
 }
@@ -50,12 +50,14 @@ void GridForcesTask::Execute(int taskOption)
 
 	// loop over non-rigid particles - this parallel part changes only particle p
 	// forces are stored on ghost nodes, which are sent to real nodes in next non-parallel loop
-#pragma omp parallel private(ndsArray,fn,xDeriv,yDeriv,zDeriv)
+	int totalPatches = fmobj->GetTotalNumberOfPatches();
+#pragma omp parallel for private(ndsArray,fn,xDeriv,yDeriv,zDeriv)
+	for(int pn=0;pn<totalPatches;pn++)
 	{	// in case 2D planar
         for(int i=0;i<maxShapeNodes;i++) zDeriv[i] = 0.;
         
-        // patch for this thread
-        int pn = GetPatchNumber();
+		double threadStart = ThreadTime();
+		long numParticles = 0,numNodes = 0;
 		
 		try
 		{	MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
@@ -73,6 +75,8 @@ void GridForcesTask::Execute(int taskOption)
 				int *nds = ndsArray;
 				elemref->GetShapeGradients(fn,&nds,xDeriv,yDeriv,zDeriv,mpmptr);
 				int numnds = nds[0];
+				numParticles++;
+				numNodes += numnds;
 				
 				// Add particle property to buffer on the material point (needed to allow parallel code)
 				short vfld;
@@ -123,15 +127,17 @@ void GridForcesTask::Execute(int taskOption)
 				forceErr = new CommonException("Unexpected error","GridForcesTask::Execute");
 			}
 		}
+		TrackThreadWork(threadStart,numParticles,numNodes);
 	}
 
 	// throw errors now
 	if(forceErr!=NULL) throw *forceErr;
 	
 	// reduction of ghost node forces to real nodes
-	int totalPatches = fmobj->GetTotalNumberOfPatches();
+	double serialStart = ThreadTime();
 	if(totalPatches>1)
 	{	for(int pn=0;pn<totalPatches;pn++)
 			patches[pn]->GridForcesReduction();
 	}
+	TrackSerialTime(serialStart);
 }
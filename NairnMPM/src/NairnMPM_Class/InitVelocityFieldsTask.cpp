@@ -58,126 +58,134 @@ void InitVelocityFieldsTask::Execute(int taskOption)
 		double fn[maxShapeNodes];
 #endif
 		
-		int pn = GetPatchNumber();
-		
-		// do non-rigid, rigid block, and rigid contact particles in patch pn
-		for(int block=FIRST_NONRIGID;block<=FIRST_RIGID_CONTACT;block++)
-		{   // get material point (only in this patch)
-			MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(block);
+#pragma omp for
+		for(int pn=0;pn<tp;pn++)
+		{	double threadStart = ThreadTime();
+			long numParticles = 0,numNodes = 0;
+			
+			// do non-rigid, rigid block, and rigid contact particles in patch pn
+			for(int block=FIRST_NONRIGID;block<=FIRST_RIGID_CONTACT;block++)
+			{   // get material point (only in this patch)
+				MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(block);
 
-			while(mpmptr!=NULL)
-			{	const MaterialBase *matID = theMaterials[mpmptr->MatID()];		// material object for this particle
-				const int matfld = matID->GetField();                           // material velocity field
+				while(mpmptr!=NULL)
+				{	const MaterialBase *matID = theMaterials[mpmptr->MatID()];		// material object for this particle
+					const int matfld = matID->GetField();                           // material velocity field
 				
-				// get nodes and shape function for material point p
-				const ElementBase *elref = theElements[mpmptr->ElemID()];		// element containing this particle
+					// get nodes and shape function for material point p
+					const ElementBase *elref = theElements[mpmptr->ElemID()];		// element containing this particle
 				
-				// don't actually need shape functions, but need to screen out zero shape function
-				// like done in subsequent tasks, otherwise node numbers will not align correctly
-				// only thing used from return are numnds and nds
-				int *nds = ndsArray;
-				elref->GetShapeFunctions(fn,&nds,mpmptr);
-				int numnds = nds[0];
+					// don't actually need shape functions, but need to screen out zero shape function
+					// like done in subsequent tasks, otherwise node numbers will not align correctly
+					// only thing used from return are numnds and nds
+					int *nds = ndsArray;
+					elref->GetShapeFunctions(fn,&nds,mpmptr);
+					int numnds = nds[0];
+					numParticles++;
+					numNodes += numnds;
 				
-				// Only need to decipher crack velocity field if has cracks (firstCrack!=NULL)
-				//      and if this material allows cracks.
-				bool decipherCVF = (firstCrack!=NULL) && matID->AllowsCracks();
+					// Only need to decipher crack velocity field if has cracks (firstCrack!=NULL)
+					//      and if this material allows cracks.
+					bool decipherCVF = (firstCrack!=NULL) && matID->AllowsCracks();
 				
-				// Check each node
-				for(int i=1;i<=numnds;i++)
-				{	// use real node in this loop
-					NodalPoint *ndptr = nd[nds[i]];
-					Vector ndpt = MakeVector(ndptr->x,ndptr->y,ndptr->z);
+					// Check each node
+					for(int i=1;i<=numnds;i++)
+					{	// use real node in this loop
+						NodalPoint *ndptr = nd[nds[i]];
+						Vector ndpt = MakeVector(ndptr->x,ndptr->y,ndptr->z);
 					
-					// always zero when no cracks (or when ignoring cracks)
-					short vfld = 0;
+						// always zero when no cracks (or when ignoring cracks)
+						short vfld = 0;
 					
-					// If need, find velocity field and for each field set location
-					// (above or below crack) and crack number (1 based) or 0 for NO_CRACK
-					if(decipherCVF)
-					{	// in CRAMP, find crack crossing and appropriate velocity field
-						CrackField cfld[2];
-						cfld[0].loc = NO_CRACK;			// NO_CRACK=0, ABOVE_CRACK=1, or BELOW_CRACK=2
-						cfld[1].loc = NO_CRACK;
-						int cfound=0;
-						Vector norm;					// track normal vector for crack plane
+						// If need, find velocity field and for each field set location
+						// (above or below crack) and crack number (1 based) or 0 for NO_CRACK
+						if(decipherCVF)
+						{	// in CRAMP, find crack crossing and appropriate velocity field
+							CrackField cfld[2];
+							cfld[0].loc = NO_CRACK;			// NO_CRACK=0, ABOVE_CRACK=1, or BELOW_CRACK=2
+							cfld[1].loc = NO_CRACK;
+							int cfound=0;
+							Vector norm;					// track normal vector for crack plane
 						
-						CrackHeader *nextCrack = firstCrack;
-						while(nextCrack!=NULL)
-						{	// get cross details
-							vfld = nextCrack->CrackCross(&(mpmptr->pos), &ndpt, &norm, nds[i]);
+							CrackHeader *nextCrack = firstCrack;
+							while(nextCrack!=NULL)
+							{	// get cross details
+								Vector xp = mpmptr->pos;
+								vfld = nextCrack->CrackCross(&xp, &ndpt, &norm, nds[i]);
 							
-							if(vfld!=NO_CRACK)
-							{	cfld[cfound].loc=vfld;
-								cfld[cfound].norm=norm;
+								if(vfld!=NO_CRACK)
+								{	cfld[cfound].loc=vfld;
+									cfld[cfound].norm=norm;
 #ifdef IGNORE_CRACK_INTERACTIONS
-								// appears to always be same crack, and stop when found one
-								cfld[cfound].crackNum=1;
-								break;
+									// appears to always be same crack, and stop when found one
+									cfld[cfound].crackNum=1;
+									break;
 #endif
 								
-								// Get crack number (default code does not ignore interactions)
-								cfld[cfound].crackNum=nextCrack->GetNumber();
-								cfound++;
+									// Get crack number (default code does not ignore interactions)
+									cfld[cfound].crackNum=nextCrack->GetNumber();
+									cfound++;
 								
-								// stop if found two because code can only handle two interacting cracks
-								// It exits loop now to go ahead with the first two found, by physics may be off
-								if(cfound>1) break;
+									// stop if found two because code can only handle two interacting cracks
+									// It exits loop now to go ahead with the first two found, by physics may be off
+									if(cfound>1) break;
+								}
+								nextCrack=(CrackHeader *)nextCrack->GetNextObject();
 							}
-							nextCrack=(CrackHeader *)nextCrack->GetNextObject();
-						}
 						
-						// find (and allocate if needed) the velocity field
-						// Use vfld=0 if no cracks found
-						if(cfound>0)
-						{   // Some stuff in below needs critical. Two options to are to make it all critical
-							// (use here comment all pragma's inside the method) or comment out here and keep
-							// all in the method
-//#pragma omp critical (addcvf)
+							// find (and allocate if needed) the velocity field
+							// Use vfld=0 if no cracks found
+							if(cfound>0)
+							{   // Some stuff in below needs critical. Two options to are to make it all critical
+								// (use here comment all pragma's inside the method) or comment out here and keep
+								// all in the method
+	//#pragma omp critical (addcvf)
+								{   try
+									{   vfld = ndptr->AddCrackVelocityField(matfld,cfld);
+									}
+									catch(std::bad_alloc&)
+									{   if(initErr==NULL)
+											initErr = new CommonException("Memory error","InitVelocityFieldsTask::Execute");
+									}
+									catch(...)
+									{	if(initErr==NULL)
+											initErr = new CommonException("Unexpected error","InitVelocityFieldsTask::Execute");
+									}
+								}
+							}
+						}
+					
+						// make sure material velocity field is created too
+						// (Note: when maxMaterialFields==1 (Singe Mat Mode), mvf[0] is always there
+						//        so no need to create it here)
+						// When some materials ignore cracks, those materials always use [0]
+						if(maxMaterialFields>1 && ndptr->NeedsMatVelocityField(vfld,matfld))
+						{   // If parallel, this is critical code
+#pragma omp critical (addcvf)
 							{   try
-								{   vfld = ndptr->AddCrackVelocityField(matfld,cfld);
+								{   ndptr->AddMatVelocityField(vfld,matfld);
 								}
 								catch(std::bad_alloc&)
 								{   if(initErr==NULL)
 										initErr = new CommonException("Memory error","InitVelocityFieldsTask::Execute");
 								}
 								catch(...)
-								{	if(initErr==NULL)
+							 	{	if(initErr==NULL)
 										initErr = new CommonException("Unexpected error","InitVelocityFieldsTask::Execute");
 								}
 							}
-						}
-					}
-					
-					// make sure material velocity field is created too
-					// (Note: when maxMaterialFields==1 (Singe Mat Mode), mvf[0] is always there
-					//        so no need to create it here)
-					// When some materials ignore cracks, those materials always use [0]
-					if(maxMaterialFields>1 && ndptr->NeedsMatVelocityField(vfld,matfld))
-					{   // If parallel, this is critical code
-#pragma omp critical (addcvf)
-						{   try
-							{   ndptr->AddMatVelocityField(vfld,matfld);
-							}
-							catch(std::bad_alloc&)
-							{   if(initErr==NULL)
-									initErr = new CommonException("Memory error","InitVelocityFieldsTask::Execute");
-							}
-							catch(...)
-						 	{	if(initErr==NULL)
-									initErr = new CommonException("Unexpected error","InitVelocityFieldsTask::Execute");
-							}
+						
 						}
 						
+						// set material point velocity field for this node
+						mpmptr->vfld[i] = (char)vfld;
 					}
-						
-					// set material point velocity field for this node
-					mpmptr->vfld[i] = (char)vfld;
-				}
 				
-				// next material point
-				mpmptr = (MPMBase *)mpmptr->GetNextObject();
+					// next material point
+					mpmptr = (MPMBase *)mpmptr->GetNextObject();
+				}
 			}
+			TrackThreadWork(threadStart,numParticles,numNodes);
 		}
 	}
 		
@@ -186,7 +194,9 @@ void InitVelocityFieldsTask::Execute(int taskOption)
 	
 	// copy crack and material fields on real nodes to ghost nodes
 	if(tp>1)
-	{   for(int pn=0;pn<tp;pn++)
+	{	double serialStart = ThreadTime();
+		for(int pn=0;pn<tp;pn++)
 			patches[pn]->InitializationReduction();
+		TrackSerialTime(serialStart);
 	}
 }
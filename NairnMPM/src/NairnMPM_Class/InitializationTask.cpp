@@ -47,6 +47,7 @@ void InitializationTask::Execute(int taskOption)
 	// Zero Mass Matrix and vectors
 	warnings.BeginStep();
 	
+	int totalPatches = fmobj->GetTotalNumberOfPatches();
 #pragma omp parallel
 	{
 		// zero active nodal variables on real nodes (first step does all)
@@ -55,9 +56,10 @@ void InitializationTask::Execute(int taskOption)
 		for(int i=1;i<=*nda;i++)
 			nd[nda[i]]->InitializeForTimeStep();
 		
-        // zero ghost nodes in patch for this thread
-        int pn = GetPatchNumber();
-        patches[pn]->InitializeForTimeStep();
+        // zero ghost nodes in each patch
+#pragma omp for nowait
+        for(int pn=0;pn<totalPatches;pn++)
+            patches[pn]->InitializeForTimeStep();
 		
 #pragma omp for nowait
 		for(int p=0;p<nmpms;p++)
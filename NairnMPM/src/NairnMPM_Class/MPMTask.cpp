@@ -15,8 +15,20 @@
 
 #pragma mark MPMTask::Constructors
 
+// task currently running in the MPM step (for thread profiling)
+MPMTask *MPMTask::runningTask = NULL;
+
 // constructor
-MPMTask::MPMTask(const char *name) : CommonTask(name) {}
+// profile arrays have one entry per thread (patches may outnumber threads in deterministic mode)
+MPMTask::MPMTask(const char *name) : CommonTask(name)
+{	int numThreads = fmobj->GetNumberOfProcessors();
+	if(numThreads<1) numThreads = 1;
+	threadBusyTime.resize(numThreads);
+	threadParticles.resize(numThreads);
+	threadNodes.resize(numThreads);
+	tracksThreads = false;
+	ResetProfileInterval();
+}
 
 #pragma mark MPMTask::Progress and Profiling Methods
 
@@ -43,7 +55,9 @@ void MPMTask::WriteLogFile(const char *comment)
 // track times
 void MPMTask::TrackTimes(double beginTime,double beginETime)
 {	totalTaskTime += fmobj->CPUTime()-beginTime;
-	totalTaskETime += fmobj->ElapsedTime()-beginETime;
+	double eTime = fmobj->ElapsedTime()-beginETime;
+	totalTaskETime += eTime;
+	intervalETime += eTime;
 }
 
 // report on times
@@ -64,6 +78,63 @@ void MPMTask::WriteProfileResults(int nsteps,double timePerStep,double eTimePerS
 	cout << endl;
 }
 
+// Write profile since last profile archive (times in ms/step and counts per step)
+// CSV has one line per thread and JSON has one object per task
+// Idle time is time in the task outside serial sections not busy in the thread
+void MPMTask::WriteProfileInterval(ostream &os,bool json,int step,double atime,int nsteps)
+{
+	double scale = 1000./(double)nsteps;
+	double eTime = scale*intervalETime;
+	double serialTime = scale*intervalSerialTime;
+	int numThreads = tracksThreads ? (int)threadBusyTime.size() : 0;
+	
+	if(json)
+	{	// load imbalance is maximum/mean busy time
+		double maxBusy=0.,sumBusy=0.;
+		for(int i=0;i<numThreads;i++)
+		{	maxBusy = fmax(maxBusy,threadBusyTime[i]);
+			sumBusy += threadBusyTime[i];
+		}
+		os << "{\"task\":\"" << GetTaskName() << "\",\"elapsed_ms\":" << eTime << ",\"serial_ms\":" << serialTime
+			<< ",\"serial_fraction\":" << (intervalETime>0. ? intervalSerialTime/intervalETime : 0.);
+		if(numThreads>0)
+		{	os << ",\"imbalance\":" << (sumBusy>0. ? maxBusy*(double)numThreads/sumBusy : 1.) << ",\"threads\":[";
+			for(int i=0;i<numThreads;i++)
+			{	double busy = scale*threadBusyTime[i];
+				os << (i>0 ? "," : "") << "{\"busy_ms\":" << busy << ",\"idle_ms\":" << fmax(eTime-serialTime-busy,0.)
+					<< ",\"particles\":" << (double)threadParticles[i]/(double)nsteps
+					<< ",\"nodes\":" << (double)threadNodes[i]/(double)nsteps << "}";
+			}
+			os << "]";
+		}
+		os << "}";
+	}
+	else
+	{	// step,time,steps,task,thread,elapsed_ms,serial_ms,busy_ms,idle_ms,particles,nodes (thread -1 if not tracked)
+		if(numThreads==0)
+		{	os << step << "," << atime << "," << nsteps << ",\"" << GetTaskName() << "\",-1," << eTime << ","
+				<< serialTime << "," << eTime-serialTime << ",0,0,0" << endl;
+		}
+		for(int i=0;i<numThreads;i++)
+		{	double busy = scale*threadBusyTime[i];
+			os << step << "," << atime << "," << nsteps << ",\"" << GetTaskName() << "\"," << i << "," << eTime << ","
+				<< serialTime << "," << busy << "," << fmax(eTime-serialTime-busy,0.) << ","
+				<< (double)threadParticles[i]/(double)nsteps << "," << (double)threadNodes[i]/(double)nsteps << endl;
+		}
+	}
+}
+
+// start new profile interval
+void MPMTask::ResetProfileInterval(void)
+{	intervalETime = 0.;
+	intervalSerialTime = 0.;
+	for(int i=0;i<(int)threadBusyTime.size();i++)
+	{	threadBusyTime[i] = 0.;
+		threadParticles[i] = 0;
+		threadNodes[i] = 0;
+	}
+}
+
 #pragma mark MPMTASK::Static Parallel Methods
 
 // get patch number of the current thread (or 0 if not parallel
@@ -96,3 +167,39 @@ int MPMTask::GetNumberOfThreads(void)
 	return 1;
 #endif
 }
+
+#pragma mark MPMTASK::Static Profiling Methods
+
+// set task now running in MPM step (or NULL when done)
+void MPMTask::SetRunningTask(MPMTask *task) { runningTask = task; }
+
+// elapsed time (in sec) that can be read in threads
+double MPMTask::ThreadTime(void)
+{
+#ifdef _OPENMP
+	return omp_get_wtime();
+#else
+	return fmobj->ElapsedTime();
+#endif
+}
+
+// Add work done by the calling thread in running task since beginTime (from ThreadTime())
+// along with number of particles and particle-node contributions (or nodes in node loops)
+// Call at end of each parallel section, or at end of each patch in loops over patches,
+// in which case a thread's work adds up over all patches it did
+void MPMTask::TrackThreadWork(double beginTime,long particles,long nodes)
+{
+	int tn = GetPatchNumber();
+	if(runningTask==NULL || tn>=(int)runningTask->threadBusyTime.size()) return;
+	runningTask->threadBusyTime[tn] += ThreadTime()-beginTime;
+	runningTask->threadParticles[tn] += particles;
+	runningTask->threadNodes[tn] += nodes;
+	runningTask->tracksThreads = true;
+}
+
+// Add serial time since beginTime (from ThreadTime()) to running task
+void MPMTask::TrackSerialTime(double beginTime)
+{
+	if(runningTask==NULL) return;
+	runningTask->intervalSerialTime += ThreadTime()-beginTime;
+}
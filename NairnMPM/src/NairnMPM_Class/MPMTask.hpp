@@ -32,14 +32,28 @@ class MPMTask : public CommonTask
 	
 		void WriteProfileResults(int,double,double);
 		void TrackTimes(double,double);
+		void WriteProfileInterval(ostream &,bool,int,double,int);
+		void ResetProfileInterval(void);
 	
         // class methods
         static int GetPatchNumber(void);
         static NodalPoint *GetNodePointer(int,int);
 		static int GetNumberOfThreads(void);
+		static void SetRunningTask(MPMTask *);
+		static double ThreadTime(void);
+		static void TrackThreadWork(double,long,long);
+		static void TrackSerialTime(double);
     
 	protected:
+		// profile since last profile archive
+		double intervalETime,intervalSerialTime;
+		vector< double > threadBusyTime;
+		vector< long > threadParticles,threadNodes;
+		bool tracksThreads;
 	
+		static MPMTask *runningTask;
 };
 
+extern MPMTask *firstMPMTask;
+
 #endif
@@ -58,11 +58,11 @@ void MassAndMomentumTask::Execute(int taskOption)
 	
 	// loop over non-rigid and rigid contact particles - this parallel part changes only particle p
 	// mass, momenta, etc are stored on ghost nodes, which are sent to real nodes in next non-parallel loop
-    //for(int pn=0;pn<4;pn++)
-#pragma omp parallel private(fn,xDeriv,yDeriv,zDeriv,ndsArray)
-	{
-        // thread for patch pn
-		int pn = GetPatchNumber();
+	int totalPatches = fmobj->GetTotalNumberOfPatches();
+#pragma omp parallel for private(fn,xDeriv,yDeriv,zDeriv,ndsArray)
+	for(int pn=0;pn<totalPatches;pn++)
+	{	double threadStart = ThreadTime();
+		long numParticles = 0,numNodes = 0;
         
 		// in case 2D planar
         for(int i=0;i<maxShapeNodes;i++) zDeriv[i] = 0.;
@@ -80,6 +80,8 @@ void MassAndMomentumTask::Execute(int taskOption)
 					nds = ndsArray;
 					matfld = GetParticleFunctions(mpmptr,&nds,fn,xDeriv,yDeriv,zDeriv);
 					numnds = nds[0];
+					numParticles++;
+					numNodes += numnds;
 					
 					// Add particle property to each node in the element
 					for(i=1;i<=numnds;i++)
@@ -111,17 +113,19 @@ void MassAndMomentumTask::Execute(int taskOption)
 				massErr = new CommonException("Unexpected error","MassAndMomentumTask::Execute");
 			}
 		}
+		TrackThreadWork(threadStart,numParticles,numNodes);
 	}
 	
 	// throw now - only possible error if too many CPDI nodes in 3D
 	if(massErr!=NULL) throw *massErr;
     
 	// reduction of ghost node forces to real nodes
-	int totalPatches = fmobj->GetTotalNumberOfPatches();
+	double serialStart = ThreadTime();
 	if(totalPatches>1)
 	{	for(int pn=0;pn<totalPatches;pn++)
 			patches[pn]->MassAndMomentumReduction();
 	}
+	TrackSerialTime(serialStart);
 }
 
 // Get Particle functions and constants
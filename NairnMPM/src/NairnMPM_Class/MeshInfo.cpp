@@ -468,7 +468,7 @@ int MeshInfo::FindShiftedNodeFromNode(int n0,double position,int dir,int side,in
 
 // For structured, find element from location and return result (1-based element number)
 // Calling code must be sure it is structured grid
-// NairnMPM requires equal element sizes, but OSParticulas allows unequal (in Tartan grid)
+// Unequal element sizes (tartan grid) use lookup tables from CreateTartanLookup()
 // throws CommonException()
 int MeshInfo::FindElementFromPoint(const Vector *pt,MPMBase *mptr)
 {
@@ -523,31 +523,33 @@ int MeshInfo::FindElementFromPoint(const Vector *pt,MPMBase *mptr)
 			if(theElements[theElem]->PtInElement(testPt))
 				return theElem+1;
 			
-			// look at nearest neighbors
-			int i=0,elemNeighbors[27];
-			theElements[mptr->ElemID()]->GetListOfNeighbors(elemNeighbors);
-			while(elemNeighbors[i]!=0)
-			{	if(theElements[elemNeighbors[i]-1]->PtInElement(testPt))
-					return elemNeighbors[i];
-				i++;
+			// look at nearest neighbors (only needed before lookup tables are created)
+			if(tartanEdges[0].empty())
+			{	int i=0,elemNeighbors[27];
+				theElements[mptr->ElemID()]->GetListOfNeighbors(elemNeighbors);
+				while(elemNeighbors[i]!=0)
+				{	if(theElements[elemNeighbors[i]-1]->PtInElement(testPt))
+						return elemNeighbors[i];
+					i++;
+				}
 			}
 		}
 		
 		// x axis elements 0 to horiz-1
-		col = BinarySearchForElement(0,pt->x,horiz-1,1);
+		col = TartanElementIndex(0,pt->x,horiz-1,1);
 		if(col<0)
 		{	throw CommonException("column for tartan grid out of range","");
 		}
 
 		// y axis elements 0 to (vert-1)*horiz
-		row = BinarySearchForElement(1,pt->y,vert-1,horiz);
+		row = TartanElementIndex(1,pt->y,vert-1,horiz);
 		if(row<0)
 		{	throw CommonException("row for tartan grid out of range","");
 		}
 
 		if(fmobj->IsThreeD())
 		{	// z axis element 0 to (depth-1)*horiz*vert
-			zrow = BinarySearchForElement(2,pt->z,depth-1,horiz*vert);
+			zrow = TartanElementIndex(2,pt->z,depth-1,horiz*vert);
 			if(zrow<0)
 			{	throw CommonException("rank for tartan grid out of range","");
 			}
@@ -616,8 +618,116 @@ int MeshInfo::BinarySearchForElement(int ax,double pt,int last,int numGap)
 	return emid;
 }
 
+// Create lookup tables to find elements in constant time in grid with unequal element sizes
+// Each axis is divided into equal buckets no larger than its smallest element (up to
+//   TARTAN_BUCKETS_PER_ELEMENT buckets per element) and each bucket stores the element
+//   containing its start. Elements must be created before calling.
+// throws std::bad_alloc
+void MeshInfo::CreateTartanLookup(void)
+{
+	if(equalElementSizes || horiz<=0) return;
+	
+	int num[3] = {horiz,vert,depth};
+	int gap[3] = {1,horiz,horiz*vert};
+	int ndim = fmobj->IsThreeD() ? 3 : 2;
+	double amin,amax;
+	
+	for(int ax=0;ax<ndim;ax++)
+	{	// element edges and smallest element
+		vector< double > &edges = tartanEdges[ax];
+		edges.resize(num[ax]+1);
+		double minSize = -1.;
+		for(int i=0;i<num[ax];i++)
+		{	theElements[i*gap[ax]]->GetRange(ax,amin,amax);
+			edges[i] = amin;
+			if(minSize<0. || amax-amin<minSize) minSize = amax-amin;
+		}
+		edges[num[ax]] = amax;
+		
+		// number of buckets
+		double length = edges[num[ax]]-edges[0];
+		int numBuckets = (int)ceil(length/minSize);
+		if(numBuckets>TARTAN_BUCKETS_PER_ELEMENT*num[ax]) numBuckets = TARTAN_BUCKETS_PER_ELEMENT*num[ax];
+		if(numBuckets<1) numBuckets = 1;
+		tartanScale[ax] = (double)numBuckets/length;
+		
+		// element at start of each bucket
+		vector< int > &buckets = tartanBuckets[ax];
+		buckets.resize(numBuckets);
+		int elem = 0;
+		for(int b=0;b<numBuckets;b++)
+		{	double bstart = edges[0]+(double)b/tartanScale[ax];
+			while(elem<num[ax]-1 && bstart>=edges[elem+1]) elem++;
+			buckets[b] = elem;
+		}
+	}
+}
+
+// Find zero-based element index along axis ax for tartan grid (last is last index and numGap is
+//   element number spacing along that axis). Return -1 if out of range.
+// Uses lookup tables, but uses binary search if called before they are created
+// element is >=min to <max (except <= last one's max)
+int MeshInfo::TartanElementIndex(int ax,double pt,int last,int numGap)
+{
+	const vector< double > &edges = tartanEdges[ax];
+	if(edges.empty()) return BinarySearchForElement(ax,pt,last,numGap);
+	
+	// out of range
+	if(pt<edges[0] || pt>edges[last+1]) return -1;
+	
+	// start at element for its bucket and adjust for round off or bucket with several elements
+	const vector< int > &buckets = tartanBuckets[ax];
+	int b = (int)((pt-edges[0])*tartanScale[ax]);
+	if(b>=(int)buckets.size()) b = (int)buckets.size()-1;
+	int elem = buckets[b];
+	while(elem>0 && pt<edges[elem]) elem--;
+	while(elem<last && pt>=edges[elem+1]) elem++;
+	return elem;
+}
+
+// Find zero-based column, row, and rank ranges (emin[] to emax[] inclusive) of elements
+// in a structured grid that may contain points in the box from bmin to bmax. The range
+// is expanded one element on each side. Return false if box misses the grid
+// Feature that calls this method must require the problem to have a structured <Grid>
+bool MeshInfo::FindElementRangeInBox(const Vector *bmin,const Vector *bmax,int *emin,int *emax)
+{
+	double lo[3] = {bmin->x,bmin->y,bmin->z};
+	double hi[3] = {bmax->x,bmax->y,bmax->z};
+	double gmin[3] = {xmin,ymin,zmin};
+	double gmax[3] = {xmax,ymax,zmax};
+	double cell[3] = {grid.x,grid.y,grid.z};
+	int num[3] = {horiz,vert,depth};
+	int gap[3] = {1,horiz,horiz*vert};
+	int ndim = fmobj->IsThreeD() ? 3 : 2;
+	
+	emin[2] = emax[2] = 0;
+	for(int ax=0;ax<ndim;ax++)
+	{	// clip to the grid
+		if(hi[ax]<gmin[ax] || lo[ax]>gmax[ax]) return false;
+		if(lo[ax]<gmin[ax]) lo[ax] = gmin[ax];
+		if(hi[ax]>gmax[ax]) hi[ax] = gmax[ax];
+		
+		if(equalElementSizes)
+		{	emin[ax] = (int)((lo[ax]-gmin[ax])/cell[ax]);
+			emax[ax] = (int)((hi[ax]-gmin[ax])/cell[ax]);
+		}
+		else
+		{	emin[ax] = TartanElementIndex(ax,lo[ax],num[ax]-1,gap[ax]);
+			emax[ax] = TartanElementIndex(ax,hi[ax],num[ax]-1,gap[ax]);
+			if(emin[ax]<0) emin[ax] = 0;
+			if(emax[ax]<0) emax[ax] = num[ax]-1;
+		}
+		
+		// expand one element and keep in the grid
+		emin[ax] = emin[ax]>0 ? emin[ax]-1 : 0;
+		emax[ax] = emax[ax]+1<num[ax] ? emax[ax]+1 : num[ax]-1;
+	}
+	
+	return true;
+}
+
 // For structured, find element from location and return result coordinates
-// Calling code must be sure it is structured grid with equal element sizes
+// Calling code must be sure it is structured grid
 // col, row, and zrow are zero based
 void MeshInfo::FindElementCoordinatesFromPoint(Vector *pt,int &col,int &row,int &zrow)
 {
@@ -662,7 +772,16 @@ void MeshInfo::FindElementCoordinatesFromPoint(Vector *pt,int &col,int &row,int
 	}
 	
 	else
-		throw CommonException("Invalid attempt to find coordinates from point in grid with unequal element sizes","");
+	{	// tartan grid
+		col = TartanElementIndex(0,pt->x,horiz-1,1);
+		row = TartanElementIndex(1,pt->y,vert-1,horiz);
+		if(grid.z > 0.) zrow = TartanElementIndex(2,pt->z,depth-1,horiz*vert);
+		if(col<0 || row<0 || zrow<0)
+		{	char msg[100];
+			sprintf(msg,"column, row, or rank for point (%lf,%lf,%lf)",pt->x,pt->y,pt->z);
+			throw CommonException(msg,"");
+		}
+	}
 }
 
 // Create the patches for the grid
@@ -1304,9 +1423,12 @@ double MeshInfo::GetCellRatio(NodalPoint *ndptr,int dir,int mirrorSpacing)
 
 // cell size in mm
 // Feature that calls this method must require the problem to have a structured <Grid>
+// For unequal element sizes, average size of the particle's element
 double MeshInfo::GetAverageCellSize(MPMBase *mptr)
 {
-    return avgCellSize;
+	if(equalElementSizes) return avgCellSize;
+	Vector cell = theElements[mptr->ElemID()]->GetDeltaBox();
+	return fmobj->IsThreeD() ? (cell.x+cell.y+cell.z)/3. : (cell.x+cell.y)/2. ;
 }
 
 // grid thickness. For 3D returns z extent but not used in 3D
@@ -34,6 +34,9 @@ enum { MAXIMUM_VOLUME_GRADIENT=0,MAXIMUM_VOLUME,AVERAGE_MAT_VOLUME_GRADIENTS,EAC
 // method to deal with 3+ nodes
 enum { LUMP_OTHER_MATERIALS=0, EXPLICIT_PAIRS };
 
+// maximum lookup buckets per element along each axis of a tartan grid
+#define TARTAN_BUCKETS_PER_ELEMENT 4
+
 class MeshInfo
 {
     public:
@@ -93,6 +96,9 @@ class MeshInfo
 		int FindShiftedNodeFromNode(int,double,int,int,int &,double);
 		int FindElementFromPoint(const Vector *,MPMBase *);
 		int BinarySearchForElement(int,double,int,int);
+		void CreateTartanLookup(void);
+		int TartanElementIndex(int,double,int,int);
+		bool FindElementRangeInBox(const Vector *,const Vector *,int *,int *);
 		void FindElementCoordinatesFromPoint(Vector *,int &,int &,int &);
 		double GetCellVolume(NodalPoint *);
 		double GetCellRatio(NodalPoint *,int,int);
@@ -123,6 +129,11 @@ class MeshInfo
 		double avgCellSize;             // average cell size when equal element sizes
         Vector grid;                    // cell size when equal element sizes
 	
+		// lookup tables when unequal element sizes (tartan grid)
+		vector< double > tartanEdges[3];	// element edges along each axis (num+1 values)
+		vector< int > tartanBuckets[3];		// element containing start of each bucket along each axis
+		double tartanScale[3];				// buckets per unit length along each axis
+	
 		// for contact
 		ContactLaw ***mmContactLaw;
 
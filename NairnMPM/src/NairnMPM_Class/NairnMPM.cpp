@@ -16,6 +16,10 @@
 #include "NairnMPM_Class/InitVelocityFieldsTask.hpp"
 #include "NairnMPM_Class/ProjectRigidBCsTask.hpp"
 #include "NairnMPM_Class/ExtrapolateRigidBCsTask.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
+#include "Boundary_Conditions/NodalVelBC.hpp"
+#include "Boundary_Conditions/NodalTempBC.hpp"
+#include "Boundary_Conditions/NodalConcBC.hpp"
 #include "NairnMPM_Class/PostExtrapolationTask.hpp"
 #include "NairnMPM_Class/SetRigidContactVelTask.hpp"
 #include "NairnMPM_Class/MassAndMomentumTask.hpp"
@@ -50,6 +54,10 @@
 #include "Boundary_Conditions/InitialCondition.hpp"
 #include "Exceptions/CommonException.hpp"
 #include "Exceptions/MPMWarnings.hpp"
+#include "Read_MPM/ParticleFile.hpp"
+#include "Materials/ConstitutiveProfile.hpp"
+#include "System/MemoryProfile.hpp"
+#include "MPM_Classes/ParticleArena.hpp"
 #include <time.h>
 
 // Activate this to print steps as they run. If too many steps happen before failure
@@ -100,6 +108,7 @@ NairnMPM::NairnMPM()
 	multiMaterialMode = false;		// multi-material mode
 	skipPostExtrapolation = false;	// if changed to true, will extrapolate for post update strain updates
 	exactTractions=false;			// exact traction BCs
+	deterministicPatches=0;			// >0 for results independent of number of processors
 	hasNoncrackingParticles=false;	// particles that ignore cracks in multimaterial mode (rigid only in NairnMPM)
 	
 	// initialize objects
@@ -128,13 +137,18 @@ void NairnMPM::CMPreparations(void)
 	SetupMaterialModeContactXPIC();
 	
 	// create patches or a single patch
-	patches = mpmgrid.CreatePatches(np,numProcs);
+	if(deterministicPatches>0) SetDeterministicPatches();
+	patches = mpmgrid.CreatePatches(np,GetTotalNumberOfPatches());
 	if(patches==NULL)
 		throw CommonException("Out of memory creating the patches","NairnMPM::PreliminaryParticleCalcs");
 	
 	// create buffers for copies of material properties
 	UpdateStrainsFirstTask::CreatePropertyBuffers(GetTotalNumberOfPatches());
 	
+	// constitutive law cost accounting
+	if(archiver->GetMaterialProfile()!=NO_PROFILE)
+		constitutiveProfile = new ConstitutiveProfile(GetTotalNumberOfPatches(),nmat);
+	
 	// if cracks
 	PreliminaryCrackCalcs();
 	
@@ -146,6 +160,9 @@ void NairnMPM::CMPreparations(void)
 	
 	// Create step tasks
 	CreateTasks();
+	
+	// memory accounting (every step if archived)
+	memoryProfile = new MemoryProfile(archiver->GetMemoryProfile()!=NO_PROFILE);
 }
 
 // Do the MPM analysis
@@ -161,6 +178,9 @@ void NairnMPM::CMAnalysis(bool abort)
 		// optional validation of parameters
  		ValidateOptions();
 		
+		// memory at the start
+		memoryProfile->Sample(mstep);
+		
 		// exit if do not want analysis
 		if(abort) mtime=maxtime+1;
 		
@@ -170,6 +190,7 @@ void NairnMPM::CMAnalysis(bool abort)
 		{	// MPM Calculations
 			mstep++;			// step number
             MPMStep();
+			memoryProfile->SampleStep(mstep);
 
 			// advance time and archive if desired
 			mtime+=timestep;
@@ -238,7 +259,15 @@ void NairnMPM::CMAnalysis(bool abort)
 		{	nextMPMTask->WriteProfileResults(mstep,timePerStep,eTimePerStep);
 			nextMPMTask=(MPMTask *)nextMPMTask->GetNextTask();
 		}
+		
+		// constitutive law costs
+		if(constitutiveProfile!=NULL)
+			constitutiveProfile->PrintCosts(mstep);
 	}
+	
+	// memory use
+	memoryProfile->Sample(mstep);
+	memoryProfile->PrintSummary();
     
     //---------------------------------------------------
     // Trailer
@@ -269,6 +298,7 @@ void NairnMPM::MPMStep(void)
 #endif
 		double beginTime=fmobj->CPUTime();
 		double beginETime=fmobj->ElapsedTime();
+		MPMTask::SetRunningTask(nextMPMTask);
 		nextMPMTask->Execute(0);
 		nextMPMTask->TrackTimes(beginTime,beginETime);
         
@@ -281,6 +311,7 @@ void NairnMPM::MPMStep(void)
 		cout << "#            Done"  << endl;
 #endif
 	}
+	MPMTask::SetRunningTask(NULL);
 }
 
 #pragma mark PREPARATION TASKS
@@ -367,13 +398,16 @@ void NairnMPM::GridAndElementCalcs(void)
 	
 	// Ser number of CPDI nodes being used
 	ElementBase::InitializeCPDI(IsThreeD());
+	
+	// constant time element lookup if elements have unequal sizes
+	mpmgrid.CreateTartanLookup();
 }
 
 // Preliminary particle Calclations prior to analysis in loop over particles
 //  Verify material type, initialize history, damage, mass, and concentration potential
 //  Get time steps (mechanics and transport) with no CFL
 //  Set velocity field
-//  Allocate GIMP or CPDI info
+//  Allocate GIMP or CPDI info (history and domain data in the particle arena)
 //  Reorder rigid and nonrigid particles and rigid contact particles
 // throws CommonException()
 void NairnMPM::PreliminaryParticleCalcs(void)
@@ -387,6 +421,10 @@ void NairnMPM::PreliminaryParticleCalcs(void)
 	int hasRigidContactParticles = NO_RIGID_MM;
 	int firstRigidPt = -1;
 	double area,volume;
+	
+	// history and CPDI or GIMP data for all particles in large blocks
+	particleArena = new ParticleArena();
+	
     for(int p=0;p<nmpms;p++)
 	{	// verify material is defined
 		int matid=mpm[p]->MatID();
@@ -497,6 +535,10 @@ void NairnMPM::PreliminaryParticleCalcs(void)
             throw CommonException("Out of memory allocating CPDI domain structures","NairnMPM::PreliminaryParticleCalcs");
 		
 	}
+	particleArena->Close();
+	
+	// initial stresses from particle files (needs densities and must precede reordering)
+	ParticleFile::SetInitialStresses();
 	
 	// get unadjusted time steps to final time steps
 	CFLTimeStep();
@@ -608,6 +650,25 @@ void NairnMPM::CreateWarnings(void)
 
 }
 
+// Deterministic mode uses a fixed number of patches that does not depend on number of processors.
+// Patches are divided among the threads and ghost nodes are always reduced in patch order. Because
+// each thread needs its own buffers, the number of processors is reduced to number of patches
+// if needed. Contact nodes are done serially to add interface energy and friction work in node order.
+void NairnMPM::SetDeterministicPatches(void)
+{
+#ifdef _OPENMP
+	if(numProcs>deterministicPatches)
+	{	numProcs = deterministicPatches;
+		omp_set_num_threads(numProcs);
+	}
+	SetNumberOfPatches(deterministicPatches);
+	cout << "Deterministic mode: " << deterministicPatches << " patches on " << numProcs << " processors" << endl;
+#else
+	// serial code is already deterministic
+	cout << "Deterministic mode: serial calculation" << endl;
+#endif
+}
+
 // create all the tasks needed for current simulation
 // Custom task (add CalcJKTask() if needed) and Initialize them all
 // MPM time step tasks
@@ -680,6 +741,12 @@ void NairnMPM::CreateTasks(void)
 	
 	// MASS AND MOMENTUM TASKS
 	
+	// grid BCs grouped by node for parallel loops and those set by rigid BC particles
+	BoundaryCondition::GroupByNode(firstVelocityBC,&velocityBCGroups);
+	BoundaryCondition::GroupByNode(firstTempBC,&tempBCGroups);
+	BoundaryCondition::GroupByNode(firstConcBC,&concBCGroups);
+	if(nmpms>nmpmsRC) rigidNodalBCs = new RigidNodalBCs(nnodes);
+	
 	// if rigid BCs by extrapolation, extrapolate now
 	if(nmpms>nmpmsRC && MaterialBase::extrapolateRigidBCs)
 	{	nextMPMTask=(MPMTask *)new ExtrapolateRigidBCsTask("Rigid BCs by Extrapolation");
@@ -980,10 +1047,22 @@ void NairnMPM::ReorderPtBCs(MatPtLoadBC *firstBC,int p1,int p2)
 // throws CommonException()
 void NairnMPM::ValidateOptions(void)
 {
-	// Disable non-structured or variable element grid sizes in NairnMPM - need OSParticulas for those options
+	// Disable non-structured grids in NairnMPM - need OSParticulas for those options
+	// Structured grids with unequal element sizes (tartan grid) allow classic or CPDI shape functions (see below),
+	//    but not features that assume one cell size
 	if(!mpmgrid.IsStructuredEqualElementsGrid())
-	{	throw CommonException("Non-structured grids or grids with unequal element sizes are currently disabled in NairnMPM because they are not verified for all features.",
-							  "NairnMPM::ValidateOptions");
+	{	if(!mpmgrid.IsStructuredGrid())
+		{	throw CommonException("Non-structured grids are currently disabled in NairnMPM because they are not verified for all features.",
+								  "NairnMPM::ValidateOptions");
+		}
+		if(firstCrack!=NULL)
+		{	throw CommonException("Cracks need a generated structured grid with equally sized elements",
+								  "NairnMPM::ValidateOptions");
+		}
+		if(multiMaterialMode)
+		{	throw CommonException("Multimaterial mode needs a generated structured grid with equally sized elements",
+								  "NairnMPM::ValidateOptions");
+		}
 	}
 	
 	// GIMP and CPDI and SPLINE require regular
@@ -19,6 +19,10 @@ class MPMBase;
 class BoundaryCondition;
 class MatPtLoadBC;
 
+// deterministic mode patches (when not specified) and random number seed
+#define DEFAULT_DETERMINISTIC_PATCHES 8
+#define DETERMINISTIC_SEED 1
+
 // global variables
 extern double mtime,propTime,timestep,strainTimestepFirst,strainTimestepLast,fractionUSF;
 extern int maxCrackFields,maxMaterialFields,numActiveMaterials;
@@ -40,6 +44,7 @@ class NairnMPM : public CommonAnalysis
 		bool skipPostExtrapolation;		// Skip post update extrapolation
 		double timeStepMinMechanics;	// time step for  mechanics
 		bool exactTractions;			// implement exact tractions
+		int deterministicPatches;		// >0 for fixed patches and reduction order
 	
         //  Constructors and Destructor
 		NairnMPM();
@@ -63,6 +68,7 @@ class NairnMPM : public CommonAnalysis
 		void PreliminaryCrackCalcs(void);
 		void CreateWarnings(void);
 		void CreateTasks(void);
+		void SetDeterministicPatches(void);
 	
 		// support
 		void ReorderParticles(int,int);
@@ -14,7 +14,8 @@
 	* Transport tasks get value
 	  (also do for CVF and MVF if contact flow activated)
 	* After main loop
- 		- Find active nodes
+ 		- Find active nodes (by prefix sum over thread counts)
+ 		- Fill material and crack contact nodes from pooled records
  		- locate mirrored BCs
  		- material and crack contact
  		- impose velocity BCs
@@ -29,6 +30,7 @@
 #include "Exceptions/CommonException.hpp"
 #include "Cracks/CrackNode.hpp"
 #include "Boundary_Conditions/NodalVelBC.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 #include "Nodes/MaterialContactNode.hpp"
 #include "NairnMPM_Class/UpdateMomentaTask.hpp"
 
@@ -36,6 +38,16 @@
 
 PostExtrapolationTask::PostExtrapolationTask(const char *name) : MPMTask(name)
 {
+	numThreads = 0;
+	threadOffsets = NULL;
+	threadMCNodes = NULL;
+	threadCrackNodes = NULL;
+}
+
+PostExtrapolationTask::~PostExtrapolationTask()
+{	if(threadOffsets!=NULL) delete [] threadOffsets;
+	if(threadMCNodes!=NULL) delete [] threadMCNodes;
+	if(threadCrackNodes!=NULL) delete [] threadCrackNodes;
 }
 
 #pragma mark REQUIRED METHODS
@@ -50,17 +62,42 @@ void PostExtrapolationTask::Execute(int taskOption)
 	// Only rigid materials ignore cracks in NairnMPM. Use OSParticulas to ignore cracks in non-rigid materials
 	bool mirrorIgnored = firstCrack!=NULL && fmobj->multiMaterialMode && fmobj->hasNoncrackingParticles;
 	
+	// per-thread space (kept for all steps)
+	if(threadOffsets==NULL)
+	{	numThreads = fmobj->GetTotalNumberOfPatches();
+		threadOffsets = new int[3*(numThreads+1)];
+		threadMCNodes = new vector< int >[numThreads];
+		threadCrackNodes = new vector< int >[numThreads];
+	}
+	int *activeStart = threadOffsets;
+	int *mcStart = &threadOffsets[numThreads+1];
+	int *crackStart = &threadOffsets[2*(numThreads+1)];
+	
 	// First node pass does some calculations and gets transport values
 	// If needed, find material contact nodes (if numberMaterials>1)
-#pragma omp parallel
+	// Each thread takes a contiguous block of nodes. After prefix sums of the counts in
+	//   each block, threads write active nodes and contact nodes in node order
+	//   (which does not depend on number of threads)
+	int teamSize = fmobj->GetNumberOfProcessors();
+	if(teamSize<1 || teamSize>numThreads) teamSize = numThreads;
+#pragma omp parallel num_threads(teamSize)
 	{
-		// variables for each thread
-		MaterialContactNode *lastMCNode=NULL;
-		CrackNode *lastCrackNode=NULL;
+		// block of nodes for this thread
+		int tn = GetPatchNumber();
+		int nthreads = GetNumberOfThreads();
+		int blockSize = nnodes/nthreads, extra = nnodes%nthreads;
+		int firstNode = 1 + tn*blockSize + (tn<extra ? tn : extra);
+		int lastNode = firstNode + blockSize + (tn<extra ? 1 : 0);
+		
+		// variables for each thread (vectors keep their memory between steps)
+		int numActive = 0;
+		vector< int > &mcNodes = threadMCNodes[tn];
+		vector< int > &crackNodes = threadCrackNodes[tn];
+		mcNodes.clear();
+		crackNodes.clear();
 		
 		// Each pass in this loop should be independent
-#pragma omp for nowait
-		for(int i=1;i<=nnodes;i++)
+		for(int i=firstNode;i<lastNode;i++)
 		{	// node reference
 			NodalPoint *ndptr = nd[i];
 			
@@ -73,20 +110,23 @@ void PostExtrapolationTask::Execute(int taskOption)
 				// Get total nodal masses and count materials if multimaterial mode
 				if(ndptr->CalcTotalMassAndCount())
 				{	// save multimaterial nodes that might have contact
-					lastMCNode = new MaterialContactNode(ndptr,lastMCNode);
-					ndptr->contactData = lastMCNode;
+					mcNodes.push_back(i);
 				}
 				
-				// if needed create crack contact node and added to this patches linked list
+				// if needed save crack contact node and its flags
 				if(firstCrack!=NULL)
 				{	int hasFlags = ndptr->HasCrackContact();
 					if(hasFlags)
-					{	lastCrackNode = new CrackNode(ndptr,hasFlags,lastCrackNode);
+					{	crackNodes.push_back(i);
+						crackNodes.push_back(hasFlags);
 					}
 				}
 
 				// get transport values on nodes
 				TransportTask::GetTransportValues(ndptr);
+				
+				// count active nodes
+				if(ndptr->NodeHasParticles()) numActive++;
 			}
 			catch(std::bad_alloc&)
 			{	if(massErr==NULL)
@@ -103,51 +143,58 @@ void PostExtrapolationTask::Execute(int taskOption)
 				}
 			}
 		}
-	
-		// as each thread exits above loop, insert into list (if was needed)
-		if(lastMCNode != NULL)
-		{
-#pragma omp critical (linknodes)
-			{	// add to node vector
-				MaterialContactNode *prevMCNode = lastMCNode;
-				while(prevMCNode!=NULL)
-				{	MaterialContactNode::materialContactNodes.push_back(prevMCNode);
-					prevMCNode = prevMCNode->GetPrevNode();
+		activeStart[tn+1] = numActive;
+		mcStart[tn+1] = (int)mcNodes.size();
+		crackStart[tn+1] = (int)crackNodes.size()/2;
+		
+#pragma omp barrier
+		
+		// prefix sums to get first slot for each thread and pooled contact nodes for all
+#pragma omp single
+		{	activeStart[0] = mcStart[0] = crackStart[0] = 0;
+			for(int p=1;p<=nthreads;p++)
+			{	activeStart[p] += activeStart[p-1];
+				mcStart[p] += mcStart[p-1];
+				crackStart[p] += crackStart[p-1];
+			}
+			nda[0] = activeStart[nthreads];
+			
+			try
+			{	if(mcStart[nthreads]>0) MaterialContactNode::ReserveContactNodes(mcStart[nthreads]);
+				if(crackStart[nthreads]>0) CrackNode::ReserveContactNodes(crackStart[nthreads]);
+			}
+			catch(std::bad_alloc&)
+			{	if(massErr==NULL)
+				{
+#pragma omp critical (error)
+					massErr = new CommonException("Memory error","PostExtrapolationTask::Execute");
 				}
 			}
 		}
 		
-		// as each thread exits above loop, insert into list (if was needed)
-		if(lastCrackNode != NULL)
-		{
-#pragma omp critical (linknodes)
-			{	// add to node vector
-				CrackNode *prevCNode = lastCrackNode;
-				while(prevCNode!=NULL)
-				{	CrackNode::crackContactNodes.push_back(prevCNode);
-					prevCNode = prevCNode->GetPrevNode();
-				}
-			}
+		// Create list of active nodes in this block
+		int k = activeStart[tn];
+		for(int i=firstNode;i<lastNode;i++)
+		{	if(nd[i]->NodeHasParticles())
+				nda[++k] = i;
+		}
+		
+		// link contact nodes in this block to pooled records
+		if(massErr==NULL)
+		{	k = mcStart[tn];
+			for(int j=0;j<(int)mcNodes.size();j++)
+				MaterialContactNode::SetContactNode(k++,nd[mcNodes[j]]);
+			k = crackStart[tn];
+			for(int j=0;j<(int)crackNodes.size();j+=2)
+				CrackNode::SetContactNode(k++,nd[crackNodes[j]],crackNodes[j+1]);
 		}
 	}
 	
 	// throw any errors
 	if(massErr!=NULL) throw *massErr;	// Post mass and momentum extrapolation calculations on nodes
 
-	// Create list of active nodes
-	int numActive = 0;
-	for(int i=1;i<=nnodes;i++)
-	{	if(nd[i]->NodeHasParticles())
-			nda[++numActive] = i;
-	}
-	nda[0] = numActive;
-
-	// locate BCs with reflected nodes
-	if(firstRigidVelocityBC!=NULL)
-	{   NodalVelBC *nextBC=firstRigidVelocityBC;
-		while(nextBC!=NULL)
-			nextBC = nextBC->SetMirroredVelBC(mtime);
-	}
+	// locate rigid BCs with reflected nodes
+	if(rigidNodalBCs!=NULL) rigidNodalBCs->SetMirroredVelBCs();
 	
 	// precalculate velocity BC values
 	NodalVelBC::GridVelocityBCValues();
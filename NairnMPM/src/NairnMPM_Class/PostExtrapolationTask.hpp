@@ -21,6 +21,7 @@ class PostExtrapolationTask : public MPMTask
 	
 		// constructor
 		PostExtrapolationTask(const char *);
+		virtual ~PostExtrapolationTask();
 	
 		// required methods
 		virtual void Execute(int);
@@ -28,6 +29,11 @@ class PostExtrapolationTask : public MPMTask
 		// custom methods
 	
 	protected:
+		// per-thread counts and nodes found in each thread's block of nodes
+		int numThreads;
+		int *threadOffsets;
+		vector< int > *threadMCNodes;
+		vector< int > *threadCrackNodes;
 };
 
 #endif
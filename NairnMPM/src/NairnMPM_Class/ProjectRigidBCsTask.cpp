@@ -12,6 +12,9 @@
 	* Project values of rigid particles to all nodes in the element
 	  containing the particle
 	* May be velocity, temperature, and concentration
+	* Shape functions and settings are found in parallel, then settings
+	  are stored in rigidNodalBCs in particle order (the first rigid
+	  particle to reach a free direction on a node sets it)
 ********************************************************************************/
 
 #include "stdafx.h"
@@ -20,21 +23,30 @@
 #include "Materials/RigidMaterial.hpp"
 #include "MPM_Classes/MPMBase.hpp"
 #include "Elements/ElementBase.hpp"
-#include "Boundary_Conditions/NodalVelBC.hpp"
-#include "Boundary_Conditions/NodalTempBC.hpp"
-#include "Boundary_Conditions/NodalConcBC.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "Boundary_Conditions/BoundaryCondition.hpp"
+#include "Boundary_Conditions/RigidNodalBCs.hpp"
 #include "Exceptions/CommonException.hpp"
 
 #pragma mark CONSTRUCTORS
 
 ProjectRigidBCsTask::ProjectRigidBCsTask(const char *name) : MPMTask(name)
 {
+	numRigidPts = 0;
+	rigidNodes = NULL;
+	rigidFlags = NULL;
+}
+
+ProjectRigidBCsTask::~ProjectRigidBCsTask()
+{	if(rigidNodes!=NULL) delete [] rigidNodes;
+	if(rigidFlags!=NULL) delete [] rigidFlags;
 }
 
 #pragma mark REQUIRED METHODS
 
 // Get mass matrix, find dimensionless particle locations,
 //	and find grid momenta
+// throws CommonException()
 void ProjectRigidBCsTask::Execute(int taskOption)
 {
 #ifdef CONST_ARRAYS
@@ -45,257 +57,109 @@ void ProjectRigidBCsTask::Execute(int taskOption)
 	int ndsArray[maxShapeNodes];
 #endif
 	
-	// undo dynamic velocity, temp, and conc BCs from rigid materials
-	// and get pointer to first empty one in reuseRigid...BC
-	UnsetRigidBCs((BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-				  (BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-	UnsetRigidBCs((BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,
-				  (BoundaryCondition **)&firstRigidTempBC,(BoundaryCondition **)&reuseRigidTempBC);
-	UnsetRigidBCs((BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,
-				  (BoundaryCondition **)&firstRigidConcBC,(BoundaryCondition **)&reuseRigidConcBC);
+	// space for nodes and settings of each rigid particle (only allocated on first step)
+	if(nmpms-nmpmsRC>numRigidPts)
+	{	if(rigidNodes!=NULL) delete [] rigidNodes;
+		if(rigidFlags!=NULL) delete [] rigidFlags;
+		numRigidPts = nmpms-nmpmsRC;
+		rigidNodes = new int[numRigidPts*maxShapeNodes];
+		rigidFlags = new int[numRigidPts];
+	}
+	
+	// undo velocity, temp, and conc BCs set by rigid materials on the previous step
+	rigidNodalBCs->ClearRigidBCs();
 	
-	// For Rigid BC materials create velocity BC on each node in the element
+	// Find nodes and settings for each rigid BC particle
+	CommonException *rigidErr = NULL;
+#pragma omp parallel for private(fn,ndsArray)
 	for(int p=nmpmsRC;p<nmpms;p++)
-	{	MPMBase *mpmptr = mpm[p];										// pointer
-		
-		int matid0 = mpmptr->MatID();
-		const MaterialBase *matID = theMaterials[matid0];				// material object for this particle
-		RigidMaterial *rigid=(RigidMaterial *)matID;
-
-		const ElementBase *elref = theElements[mpmptr->ElemID()];		// element containing this particle
-		int *nds = ndsArray;
-		elref->GetShapeFunctions(fn,&nds,mpmptr);
-		int numnds = nds[0];
-
-		double rvalue;
-		for(int i=1;i<=numnds;i++)
-		{
-			int mi=nds[i];
+	{	try
+		{	MPMBase *mpmptr = mpm[p];
+			RigidMaterial *rigid = (RigidMaterial *)theMaterials[mpmptr->MatID()];
+			
+			// save nodes for this particle
+			const ElementBase *elref = theElements[mpmptr->ElemID()];		// element containing this particle
+			int *nds = ndsArray;
+			elref->GetShapeFunctions(fn,&nds,mpmptr);
+			int *pnds = &rigidNodes[(p-nmpmsRC)*maxShapeNodes];
+			for(int i=0;i<=nds[0];i++) pnds[i] = nds[i];
 			
 			// look for setting function in one to three directions in rigid BC particle
 			// GetVectorSetting() returns true if function has set the velocity, otherwise it returns FALSE
+			int setFlags = 0;
 			bool hasDir[3];
-			if(rigid->GetVectorSetting(&mpmptr->vel,hasDir,mtime,&mpmptr->pos))
-			{   // velocity set by 1 to 3 functions as determined by hasDir[i]
-				if(hasDir[0])
-				{	SetRigidBCs(mi,matid0,X_DIRECTION,mpmptr->vel.x,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
-				if(hasDir[1])
-				{	SetRigidBCs(mi,matid0,Y_DIRECTION,mpmptr->vel.y,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
-				if(hasDir[2])
-				{	SetRigidBCs(mi,matid0,Z_DIRECTION,mpmptr->vel.z,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
+			Vector rpos = mpmptr->pos,rpvel = mpmptr->vel;
+			bool velSet = rigid->GetVectorSetting(&rpvel,hasDir,mtime,&rpos);
+			mpmptr->vel = rpvel;
+			if(velSet)
+			{	// velocity set by 1 to 3 functions as determined by hasDir[i]
+				if(hasDir[0]) setFlags |= X_DIRECTION;
+				if(hasDir[1]) setFlags |= Y_DIRECTION;
+				if(hasDir[2]) setFlags |= Z_DIRECTION;
 			}
 			else
-			{   // velocity set by particle velocity in selected directions
-				if(rigid->RigidDirection(X_DIRECTION))
-				{	SetRigidBCs(mi,matid0,X_DIRECTION,mpmptr->vel.x,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
-				if(rigid->RigidDirection(Y_DIRECTION))
-				{	SetRigidBCs(mi,matid0,Y_DIRECTION,mpmptr->vel.y,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
-				if(rigid->RigidDirection(Z_DIRECTION))
-				{	SetRigidBCs(mi,matid0,Z_DIRECTION,mpmptr->vel.z,0.,rigid->mirrored,
-								(BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,
-								(BoundaryCondition **)&firstRigidVelocityBC,(BoundaryCondition **)&reuseRigidVelocityBC);
-				}
+			{	// velocity set by particle velocity in selected directions
+				if(rigid->RigidDirection(X_DIRECTION)) setFlags |= X_DIRECTION;
+				if(rigid->RigidDirection(Y_DIRECTION)) setFlags |= Y_DIRECTION;
+				if(rigid->RigidDirection(Z_DIRECTION)) setFlags |= Z_DIRECTION;
 			}
 			
 			// temperature
+			double rvalue;
 			if(rigid->RigidTemperature())
-			{	if(rigid->GetValueSetting(&rvalue,mtime,&mpmptr->pos)) mpmptr->pTemperature=rvalue;
-				SetRigidBCs(mi,matid0,TEMP_DIRECTION,mpmptr->pTemperature,0.,0,
-							(BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,
-							(BoundaryCondition **)&firstRigidTempBC,(BoundaryCondition **)&reuseRigidTempBC);
+			{	if(rigid->GetValueSetting(&rvalue,mtime,&rpos)) mpmptr->pTemperature=rvalue;
+				setFlags |= TEMP_DIRECTION;
 			}
 			
 			// concentration
 			if(rigid->RigidConcentration() && fmobj->HasFluidTransport())
-			{	if(rigid->GetValueSetting(&rvalue,mtime,&mpmptr->pos)) mpmptr->pConcentration=rvalue;
+			{	if(rigid->GetValueSetting(&rvalue,mtime,&rpos)) mpmptr->pConcentration=rvalue;
 				if(fmobj->HasDiffusion())
 				{	if(mpmptr->pConcentration<0.)
 						mpmptr->pConcentration=0.;
 					else if(mpmptr->pConcentration>1.)
 						mpmptr->pConcentration=1.;
 				}
-				SetRigidBCs(mi,matid0,CONC_DIRECTION,mpmptr->pConcentration,0.,0,
-							(BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,
-							(BoundaryCondition **)&firstRigidConcBC,(BoundaryCondition **)&reuseRigidConcBC);
+				setFlags |= CONC_DIRECTION;
 			}
+			
+			rigidFlags[p-nmpmsRC] = setFlags;
 		}
-	}
-	
-	// if any left over rigid BCs, delete them now
-	RemoveRigidBCs((BoundaryCondition **)&firstVelocityBC,(BoundaryCondition **)&lastVelocityBC,(BoundaryCondition **)&firstRigidVelocityBC);
-	RemoveRigidBCs((BoundaryCondition **)&firstTempBC,(BoundaryCondition **)&lastTempBC,(BoundaryCondition **)&firstRigidTempBC);
-	RemoveRigidBCs((BoundaryCondition **)&firstConcBC,(BoundaryCondition **)&lastConcBC,(BoundaryCondition **)&firstRigidConcBC);
-}
-
-// Unset nodal dof for rigid BCs so can try to reuse
-//   them without needing new memory allocations
-// No rigid BCs are deleted and when done, reuseRigidBC is set to first empty one (excess deleted later)
-// Note that set BC will set a direction thereby preventing any dynamic BC in the same direction
-//		Thus dynamic ones should not be in the same direction
-//		Furthermore, nodal set direction will always be correct indicator of any BC (set of dynamic) on that node
-void ProjectRigidBCsTask::UnsetRigidBCs(BoundaryCondition **firstBC,BoundaryCondition **lastBC,
-										BoundaryCondition **firstRigidBC,BoundaryCondition **reuseRigidBC)
-{
-	// exit if none
-	if(*firstRigidBC==NULL) return;
-	
-	// unset dynamic ones
-    BoundaryCondition *nextBC=*firstRigidBC;
-	while(nextBC!=NULL)
-		nextBC=nextBC->UnsetDirection();
-	
-	// were they all rigid BCs, but still has some?
-	if(*firstBC==*firstRigidBC)
-	{	*lastBC=NULL;				// since none set yet
-		*reuseRigidBC=*firstRigidBC;
-		return;
-	}
-	
-	// otherwise search for last actual grid BC
-    nextBC=*firstBC;
-	while(nextBC->GetNextObject()!=*firstRigidBC)
-		nextBC=(BoundaryCondition *)nextBC->GetNextObject();
-	*lastBC=nextBC;
-	*reuseRigidBC=*firstRigidBC;
-}
-
-// Set boundary conditions determined by moving rigid paticles
-// throws std::bad_alloc
-void ProjectRigidBCsTask::SetRigidBCs(int mi,int matid0,int type,double value,double angle,int mirrored,
-									  BoundaryCondition **firstBC,BoundaryCondition **lastBC,
-									  BoundaryCondition **firstRigidBC,BoundaryCondition **reuseRigidBC)
-{
-	BoundaryCondition *newBC=NULL;
-	
-	// check if already set in that direction by actual BC or by previous rigid BC
-	// New rigid BC's can only be on free directions
-	if(nd[mi]->fixedDirection&type) return;
-	
-	// create new boundary conditions
-	switch(type)
-    {   case X_DIRECTION:
-		case Y_DIRECTION:
-		case Z_DIRECTION:
-			if(*reuseRigidBC!=NULL)
-				newBC=(*reuseRigidBC)->SetRigidProperties(mi,type,CONSTANT_VALUE,value);
-			else
-            {   int newType = type==Z_DIRECTION ? Z_DIRECTION_INPUT : type ;
-				newBC=(BoundaryCondition *)(new NodalVelBC(mi,newType,CONSTANT_VALUE,value,(double)0.,(double)0.,(double)0.));
+		catch(CommonException& err)
+		{	if(rigidErr==NULL)
+			{
+#pragma omp critical (error)
+				rigidErr = new CommonException(err);
 			}
-			((NodalVelBC *)newBC)->SetMirrorSpacing(mirrored);
-			break;
-			
-		case TEMP_DIRECTION:
-			if(*reuseRigidBC!=NULL)
-				newBC=(*reuseRigidBC)->SetRigidProperties(mi,type,CONSTANT_VALUE,value);
-			else
-				newBC=(BoundaryCondition *)(new NodalTempBC(mi,CONSTANT_VALUE,value,(double)0.));
-			break;
-			
-		case CONC_DIRECTION:
-			if(*reuseRigidBC!=NULL)
-				newBC=(*reuseRigidBC)->SetRigidProperties(mi,type,CONSTANT_VALUE,value);
-			else
-				newBC=(BoundaryCondition *)(new NodalConcBC(mi,CONSTANT_VALUE,value,(double)0.));
-			break;
-			
-		default:
-			break;
-			
-	}
-	
-	// set BC id in case needed to 1-based material number
-	newBC->SetID(matid0+1);
-	
-	// *firstBC and *lastBC are first and last of this type
-	// *firstRigidBC will save the first one
-	// if *reuseRigidBC!=NULL, then reusing previous rigid BCs
-	if(*firstBC==NULL)
-	{	// Only happens when no normal BCs and no rigidBCs to reuse so start with this one
-		*firstBC=newBC;
-		*firstRigidBC=newBC;
-		// reuseRigidBC must be NULL already
-	}
-	else
-	{	if(*reuseRigidBC!=NULL)
-		{	// next object of last BC is already set
-			// firstRigidBC is already valid
-			// advance to reuse next one (or could get to NULL if all used up)
-			*reuseRigidBC=(BoundaryCondition *)(*reuseRigidBC)->GetNextObject();
 		}
-		else
-		{	// created a new one or ran out of ones to reuse
-			(*lastBC)->SetNextObject(newBC);
-			if(*firstRigidBC==NULL) *firstRigidBC=newBC;
+		catch(...)
+		{	if(rigidErr==NULL)
+			{
+#pragma omp critical (error)
+				rigidErr = new CommonException("Unexpected error","ProjectRigidBCsTask::Execute");
+			}
 		}
 	}
-	*lastBC=newBC;
-}
-
-// Remove any dynamically created boundary conditions
-//    that are no longer needed
-void ProjectRigidBCsTask::RemoveRigidBCs(BoundaryCondition **firstBC,BoundaryCondition **lastBC,BoundaryCondition **firstRigidBC)
-{
-	// exit if none
-	if(*firstRigidBC==NULL) return;
 	
-	// trap if this step did not reuse any BCs
-	BoundaryCondition *nextBC,*prevBC;
-	if(*lastBC==NULL)
-	{	nextBC=*firstBC;		// will be deleting them all below
-		// None reused and no grid ones either?
-		*firstBC=NULL;
-		*firstRigidBC=NULL;
-	}
-	else
-	{	nextBC=(BoundaryCondition *)(*lastBC)->GetNextObject();
-		(*lastBC)->SetNextObject(NULL);			// next one on lastBC needs to be NULL
-		// Were none of the rigid ones resued? (they are deleted below)
-		if(nextBC==*firstRigidBC) *firstRigidBC=NULL;
-	}
-	
-	// delete any rigid BCs that were not reused
-	while(nextBC!=NULL)
-	{	prevBC=nextBC;
-		nextBC=(BoundaryCondition *)prevBC->GetNextObject();
-		delete prevBC;
-	}
-}
-
-// Debugging aid to count BCs on each step
-void ProjectRigidBCsTask::CountBCs(BoundaryCondition **firstBC,BoundaryCondition **lastBC,BoundaryCondition **firstRigidBC)
-{
-	if(*firstBC==NULL) return;
+	// throw any errors
+	if(rigidErr!=NULL) throw *rigidErr;
 	
-	BoundaryCondition *nextBC=*firstBC;
-	int count=0,fullcount=0;
-	while(nextBC!=NULL)
-	{	if(nextBC==*firstRigidBC)
-		{	cout << "# " << count << " on grid, ";
-			count=0;
-		}
-		count++;
-		fullcount++;
-		if(nextBC==*lastBC)
-		{	cout << count << " rigid, ";
-			count=0;
+	// Set nodal BCs in particle order (only integer checks and copying values)
+	for(int p=nmpmsRC;p<nmpms;p++)
+	{	int setFlags = rigidFlags[p-nmpmsRC];
+		if(setFlags==0) continue;
+		
+		MPMBase *mpmptr = mpm[p];
+		int matid0 = mpmptr->MatID();
+		int mirrored = ((RigidMaterial *)theMaterials[matid0])->mirrored;
+		int *pnds = &rigidNodes[(p-nmpmsRC)*maxShapeNodes];
+		for(int i=1;i<=pnds[0];i++)
+		{	int mi = pnds[i];
+			if(setFlags&X_DIRECTION) rigidNodalBCs->SetRigidBC(mi,X_DIRECTION,mpmptr->vel.x,matid0+1,mirrored);
+			if(setFlags&Y_DIRECTION) rigidNodalBCs->SetRigidBC(mi,Y_DIRECTION,mpmptr->vel.y,matid0+1,mirrored);
+			if(setFlags&Z_DIRECTION) rigidNodalBCs->SetRigidBC(mi,Z_DIRECTION,mpmptr->vel.z,matid0+1,mirrored);
+			if(setFlags&TEMP_DIRECTION) rigidNodalBCs->SetRigidBC(mi,TEMP_DIRECTION,mpmptr->pTemperature,matid0+1,0);
+			if(setFlags&CONC_DIRECTION) rigidNodalBCs->SetRigidBC(mi,CONC_DIRECTION,mpmptr->pConcentration,matid0+1,0);
 		}
-		nextBC=(BoundaryCondition *)nextBC->GetNextObject();
 	}
-	cout << count << " undeleted, total = " << fullcount << endl;
 }
@@ -13,8 +13,6 @@
 
 #define _PROJECTRIGIDBCSTASK_
 
-class BoundaryCondition;
-
 #include "NairnMPM_Class/MPMTask.hpp"
 
 class ProjectRigidBCsTask : public MPMTask
@@ -23,17 +21,16 @@ class ProjectRigidBCsTask : public MPMTask
 	
 		// constructor
 		ProjectRigidBCsTask(const char *);
+		virtual ~ProjectRigidBCsTask();
 	
 		// required methods
 		virtual void Execute(int);
 	
-		// class methods
-		static void UnsetRigidBCs(BoundaryCondition **,BoundaryCondition **,BoundaryCondition **,BoundaryCondition **);
-		static void SetRigidBCs(int,int,int,double,double,int,BoundaryCondition **,BoundaryCondition **,BoundaryCondition **,BoundaryCondition **);
-		static void RemoveRigidBCs(BoundaryCondition **,BoundaryCondition **,BoundaryCondition **);
-		static void CountBCs(BoundaryCondition **,BoundaryCondition **,BoundaryCondition **);
-
 	protected:
+		// nodes and settings for each rigid BC particle found in parallel
+		int numRigidPts;
+		int *rigidNodes;
+		int *rigidFlags;
 };
 
 #endif
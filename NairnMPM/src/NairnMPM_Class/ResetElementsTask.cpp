@@ -57,10 +57,10 @@ void ResetElementsTask::Execute(int taskOption)
 	CommonException *resetErr = NULL;
 
 	// parallel over patches
-#pragma omp parallel
-	{
-        // thread for patch pn
-		int pn = GetPatchNumber();
+#pragma omp parallel for
+	for(int pn=0;pn<totalPatches;pn++)
+	{	double threadStart = ThreadTime();
+		long numParticles = 0;
         
 		try
 		{	// resetting all element types
@@ -70,6 +70,7 @@ void ResetElementsTask::Execute(int taskOption)
 				MPMBase *prevMptr = NULL;		// previous one of this type in current patch
 				while(mptr!=NULL)
 				{	int status = ResetElement(mptr);
+					numParticles++;
 					
 					if(status==LEFT_GRID)
 					{	// particle has left the grid
@@ -153,14 +154,32 @@ void ResetElementsTask::Execute(int taskOption)
 				resetErr = new CommonException("Unexepected error","ResetElementsTask::Execute");
 			}
 		}
+		TrackThreadWork(threadStart,numParticles,0);
 	}
 
 	// throw now if was an error
 	if(resetErr!=NULL) throw *resetErr;
     
-	// reduction phase moves the particles
+	// move the particles in two parallel phases: remove from old patches, then add to new patches
+	double serialStart = ThreadTime();
+	int numMoving = 0;
 	for(int pn=0;pn<totalPatches;pn++)
-		patches[pn]->MoveParticlesToNewPatches();
+		numMoving += patches[pn]->NumberOfMovingParticles();
+	if(numMoving>0)
+	{
+#pragma omp parallel for
+		for(int pn=0;pn<totalPatches;pn++)
+			patches[pn]->RemoveMovingParticles();
+		
+#pragma omp parallel for
+		for(int pn=0;pn<totalPatches;pn++)
+			patches[pn]->AddMovedParticles(totalPatches);
+		
+		for(int pn=0;pn<totalPatches;pn++)
+			patches[pn]->ClearMovingParticles();
+	}
+	
+	TrackSerialTime(serialStart);
 	
 #else
 	
@@ -243,14 +262,15 @@ int ResetElementsTask::ResetElement(MPMBase *mpt)
 	}
 	
 	// check current element
-	if(theElements[mpt->ElemID()]->PtInElement(mpt->pos))
+	Vector ptpos = mpt->pos;
+	if(theElements[mpt->ElemID()]->PtInElement(ptpos))
 	{	// it has not changed elements
 		return SAME_ELEMENT;
 	}
     
 	// calculate from coordinates
 	try
-	{   int j = mpmgrid.FindElementFromPoint(&mpt->pos,mpt)-1;		// elem ID (0 based)
+	{   int j = mpmgrid.FindElementFromPoint(&ptpos,mpt)-1;		// elem ID (0 based)
 		if(theElements[j]->OnTheEdge()) return LEFT_GRID;
 		if(fmobj->IsAxisymmetric() && mpt->pos.x<=0.) return LEFT_GRID;
 		mpt->ChangeElemID(j,!mpmgrid.IsStructuredEqualElementsGrid());
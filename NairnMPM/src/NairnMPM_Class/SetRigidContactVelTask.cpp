@@ -41,7 +41,9 @@ void SetRigidContactVelTask::Execute(int taskOption)
 	{   MPMBase *mpmptr = mpm[p];
 		const RigidMaterial *matID = (RigidMaterial *)theMaterials[mpm[p]->MatID()];
 		try
-		{	matID->GetVectorSetting(&mpmptr->vel,hasDir,mtime,&mpmptr->pos);
+		{	Vector rvel = mpmptr->vel,rpos = mpmptr->pos;
+			matID->GetVectorSetting(&rvel,hasDir,mtime,&rpos);
+			mpmptr->vel = rvel;
 		}
 		catch(CommonException &err)
 		{   if(rcErr==NULL)
@@ -43,15 +43,22 @@ UpdateMomentaTask::UpdateMomentaTask(const char *name) : MPMTask(name)
 // throws CommonException()
 void UpdateMomentaTask::Execute(int taskOption)
 {	
-#pragma omp parallel for
-	for(int i=1;i<=*nda;i++)
-	{	NodalPoint *ndptr = nd[nda[i]];
+#pragma omp parallel
+	{	double threadStart = ThreadTime();
+		long numNodes = 0;
 		
-		// update nodal momenta
-		ndptr->UpdateMomentum(timestep);
-		
-		// get grid transport rates
-		TransportTask::UpdateTransportOnGrid(ndptr);
+#pragma omp for nowait
+		for(int i=1;i<=*nda;i++)
+		{	NodalPoint *ndptr = nd[nda[i]];
+			numNodes++;
+			
+			// update nodal momenta
+			ndptr->UpdateMomentum(timestep);
+			
+			// get grid transport rates
+			TransportTask::UpdateTransportOnGrid(ndptr);
+		}
+		TrackThreadWork(threadStart,0,numNodes);
 	}
 	
 	// contact and BCs
@@ -78,143 +78,151 @@ void UpdateParticlesTask::Execute(int taskOption)
 	m = -m;
 
 	// Update particle position, velocity, temp, and conc
-#pragma omp parallel for private(ndsArray,fn,gp)
-	for(int p=0;p<nmpmsNR;p++)
-	{	MPMBase *mpmptr = mpm[p];
-		try
-		{	// get shape functions
-			const ElementBase *elemRef = theElements[mpmptr->ElemID()];
-			int *nds = ndsArray;
-			elemRef->GetShapeFunctions(fn,&nds,mpmptr);
-			int numnds = nds[0];
-			
-			// Update particle position and velocity
-			const MaterialBase *matRef=theMaterials[mpmptr->MatID()];
-			int matfld=matRef->GetField();
-			
-			// Allow material to override global settings
-			gp.m = m;
-			gp.gridAlpha = gridAlpha;
-			gp.particleAlpha = matRef->GetMaterialDamping(particleAlpha);
+#pragma omp parallel private(ndsArray,fn,gp)
+	{	double threadStart = ThreadTime();
+		long numParticles = 0,numNodes = 0;
+		
+#pragma omp for nowait
+		for(int p=0;p<nmpmsNR;p++)
+		{	MPMBase *mpmptr = mpm[p];
+			try
+			{	// get shape functions
+				const ElementBase *elemRef = theElements[mpmptr->ElemID()];
+				int *nds = ndsArray;
+				elemRef->GetShapeFunctions(fn,&nds,mpmptr);
+				int numnds = nds[0];
+				numParticles++;
+				numNodes += numnds;
+				
+				// Update particle position and velocity
+				const MaterialBase *matRef=theMaterials[mpmptr->MatID()];
+				int matfld=matRef->GetField();
+				
+				// Allow material to override global settings
+				gp.m = m;
+				gp.gridAlpha = gridAlpha;
+				gp.particleAlpha = matRef->GetMaterialDamping(particleAlpha);
 
-			// extrapolate nodal velocity from grid to particle S v+(k)
-			ZeroVector(&gp.Svtilde);
-			
-			if(m<=0)
-			{	// acceleration on the particle or S a (for FLIP and XPIC)
-				ZeroVector(&gp.Sacc);
+				// extrapolate nodal velocity from grid to particle S v+(k)
+				ZeroVector(&gp.Svtilde);
 				
-				// XPIC(k>1) needs separate velocity extrapolation
-				if(m<-1) ZeroVector(&gp.Svlumped);
-			}
-			
-			// only two possible transport tasks
-			double rate[2],value[2];
-			if(transportTasks!=NULL)
-			{	rate[0] = rate[1] = value[0] = value[1] = 0.;
-			}
-			int task;
-			TransportTask *nextTransport;
-			
-			// Loop over nodes
-			for(int i=1;i<=numnds;i++)
-			{	// increment velocity and acceleraton
-				NodalPoint *ndptr = nd[nds[i]];
-				short vfld = (short)mpmptr->vfld[i];
+				if(m<=0)
+				{	// acceleration on the particle or S a (for FLIP and XPIC)
+					ZeroVector(&gp.Sacc);
+					
+					// XPIC(k>1) needs separate velocity extrapolation
+					if(m<-1) ZeroVector(&gp.Svlumped);
+				}
+				
+				// only two possible transport tasks
+				double rate[2],value[2];
+				if(transportTasks!=NULL)
+				{	rate[0] = rate[1] = value[0] = value[1] = 0.;
+				}
+				int task;
+				TransportTask *nextTransport;
+				
+				// Loop over nodes
+				for(int i=1;i<=numnds;i++)
+				{	// increment velocity and acceleraton
+					NodalPoint *ndptr = nd[nds[i]];
+					short vfld = (short)mpmptr->vfld[i];
 
-				// increment
-				ndptr->IncrementDelvaTask5(vfld,matfld,fn[i],&gp);
+					// increment
+					ndptr->IncrementDelvaTask5(vfld,matfld,fn[i],&gp);
+					
+					// increment transport rates
+					nextTransport=transportTasks;
+					task=0;
+					while(nextTransport!=NULL)
+					{	value[task] += nextTransport->IncrementValueExtrap(ndptr,fn[i],vfld,matfld);
+						rate[task] += nextTransport->IncrementTransportRate(ndptr,fn[i],vfld,matfld);
+						nextTransport = nextTransport->GetNextTransportTask();
+						task++;
+					}
+				}
+				
+				// Update velocity and position
+				mpmptr->MoveParticle(&gp);
 				
-				// increment transport rates
+				// update transport values
+				ResidualStrains res;
+				res.dT = res.dC = 0.;
+				double dTcond = 0.,dTad = 0.;
 				nextTransport=transportTasks;
 				task=0;
 				while(nextTransport!=NULL)
-				{	value[task] += nextTransport->IncrementValueExtrap(ndptr,fn[i],vfld,matfld);
-					rate[task] += nextTransport->IncrementTransportRate(ndptr,fn[i],vfld,matfld);
-					nextTransport = nextTransport->GetNextTransportTask();
+				{	// mechanics would need to add to store returned value on particle (or get delta from rate?)
+					if(nextTransport == conduction)
+					{	res.dT = nextTransport->GetDeltaValue(mpmptr,value[task]);
+						dTcond = rate[task]*timestep;
+					}
+					else
+						res.dC = nextTransport->GetDeltaValue(mpmptr,value[task]);
+					nextTransport=nextTransport->MoveTransportValue(mpmptr,timestep,rate[task],value[task]);
 					task++;
 				}
-			}
-			
-			// Update velocity and position
-			mpmptr->MoveParticle(&gp);
-			
-			// update transport values
-			ResidualStrains res;
-			res.dT = res.dC = 0.;
-			double dTcond = 0.,dTad = 0.;
-			nextTransport=transportTasks;
-			task=0;
-			while(nextTransport!=NULL)
-			{	// mechanics would need to add to store returned value on particle (or get delta from rate?)
-				if(nextTransport == conduction)
-				{	res.dT = nextTransport->GetDeltaValue(mpmptr,value[task]);
-					dTcond = rate[task]*timestep;
+				
+				// energy coupling here adds adiabatic temperature rise
+				if(ConductionTask::adiabatic)
+				{	dTad = mpmptr->GetClear_dTad();						// in K
+					mpmptr->pTemperature += dTad;						// in K
+					mpmptr->pPreviousTemperature += dTad;				// in K
+					res.dT += dTad;
+				}
+				
+				// for heat energy and entropy
+				if(ConductionTask::active)
+				{	double dq = matRef->GetHeatCapacity(mpmptr)*dTcond;
+					mpmptr->AddHeatEnergy(dq);
+					mpmptr->AddEntropy(dq,mpmptr->pPreviousTemperature);
 				}
 				else
-					res.dC = nextTransport->GetDeltaValue(mpmptr,value[task]);
-				nextTransport=nextTransport->MoveTransportValue(mpmptr,timestep,rate[task],value[task]);
-				task++;
-			}
-			
-			// energy coupling here adds adiabatic temperature rise
-			if(ConductionTask::adiabatic)
-			{	dTad = mpmptr->GetClear_dTad();						// in K
-				mpmptr->pTemperature += dTad;						// in K
-				mpmptr->pPreviousTemperature += dTad;				// in K
-				res.dT += dTad;
-			}
-			
-			// for heat energy and entropy
-			if(ConductionTask::active)
-			{	double dq = matRef->GetHeatCapacity(mpmptr)*dTcond;
-				mpmptr->AddHeatEnergy(dq);
-				mpmptr->AddEntropy(dq,mpmptr->pPreviousTemperature);
-			}
-			else
-			{	// when conduction off, update previous temp here
-				res.dT = mpmptr->pTemperature - mpmptr->pPreviousTemperature;
-				mpmptr->pPreviousTemperature = mpmptr->pTemperature;
-			}
-			
-			// for generalized plane stress or strain, increment szz if needed
-			if(fmobj->np==PLANE_STRESS_MPM || fmobj->np==PLANE_STRAIN_MPM)
-			{	res.doopse = mpmptr->oopIncrement;
-				mpmptr->oopIncrement = 0.;
+				{	// when conduction off, update previous temp here
+					res.dT = mpmptr->pTemperature - mpmptr->pPreviousTemperature;
+					mpmptr->pPreviousTemperature = mpmptr->pTemperature;
+				}
+				
+				// for generalized plane stress or strain, increment szz if needed
+				if(fmobj->np==PLANE_STRESS_MPM || fmobj->np==PLANE_STRAIN_MPM)
+				{	res.doopse = mpmptr->oopIncrement;
+					mpmptr->oopIncrement = 0.;
+				}
+				
+				// store increments on the particles
+				mpmptr->dTrans = res;
+				
 			}
-			
-			// store increments on the particles
-			mpmptr->dTrans = res;
-			
-		}
-		catch(CommonException& err)
-		{	if(upErr==NULL)
-			{
+			catch(CommonException& err)
+			{	if(upErr==NULL)
+				{
 #pragma omp critical (error)
-				upErr = new CommonException(err);
+					upErr = new CommonException(err);
+				}
 			}
-		}
-		catch(CommonException* err)
-		{	if(upErr==NULL)
-			{
+			catch(CommonException* err)
+			{	if(upErr==NULL)
+				{
 #pragma omp critical (error)
-				upErr = new CommonException(*err);
+					upErr = new CommonException(*err);
+				}
 			}
-		}
-		catch(std::bad_alloc&)
-		{	if(upErr==NULL)
-			{
+			catch(std::bad_alloc&)
+			{	if(upErr==NULL)
+				{
 #pragma omp critical (error)
-				upErr = new CommonException("Memory error","UpdateParticlesTask::Execute");
+					upErr = new CommonException("Memory error","UpdateParticlesTask::Execute");
+				}
 			}
-		}
-		catch(...)
-		{	if(upErr==NULL)
-			{
+			catch(...)
+			{	if(upErr==NULL)
+				{
 #pragma omp critical (error)
-				upErr = new CommonException("Unexpected error","UpdateParticlesTask::Execute");
+					upErr = new CommonException("Unexpected error","UpdateParticlesTask::Execute");
+				}
 			}
 		}
+		TrackThreadWork(threadStart,numParticles,numNodes);
 	}
 	
 	// throw any errors
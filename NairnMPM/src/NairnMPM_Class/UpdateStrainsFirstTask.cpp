@@ -32,6 +32,7 @@
 #include "Boundary_Conditions/NodalVelBC.hpp"
 #include "NairnMPM_Class/XPICExtrapolationTask.hpp"
 #include "Global_Quantities/BodyForce.hpp"
+#include "Materials/ConstitutiveProfile.hpp"
 
 // class globals
 UpdateStrainsFirstTask *USFTask = NULL;
@@ -101,48 +102,65 @@ void UpdateStrainsFirstTask::FullStrainUpdate(double strainTime,int secondPass,i
 #pragma omp parallel for
 	for(int i=1;i<=*nda;i++)
 		nd[nda[i]]->GridValueCalculation(VELOCITY_FOR_STRAIN_UPDATE);
+	
+	// time step terms in materials
+	for(int i=0;i<nmat;i++)
+		theMaterials[i]->PrepareStrainUpdates(strainTime);
 
 	// loop over nonrigid particles
 	// This works as parallel when material properties change with particle state because
 	//	all such materials should create a copy of material properties in the threads
-#pragma omp parallel for
-	for(int p=0;p<nmpmsNR;p++)
-    {   // next particle
-        MPMBase *mptr = mpm[p];
-		
-        // this particle's material
-        const MaterialBase *matRef = theMaterials[mptr->MatID()];
+#pragma omp parallel
+	{	int tn = GetPatchNumber();
+		double threadStart = ThreadTime();
+		long numParticles = 0;
 		
-		try
-		{	// make sure have mechanical properties for this material and angle
-            int tn = GetPatchNumber();
-			void *properties = matRef->GetCopyOfMechanicalProps(mptr,np,matBuffer[tn],altBuffer[tn],0);
+#pragma omp for nowait
+		for(int p=0;p<nmpmsNR;p++)
+		{	// next particle
+			MPMBase *mptr = mpm[p];
+			numParticles++;
 			
-			// finish on the particle
-			mptr->UpdateStrain(strainTime,secondPass,np,properties,matRef->GetField());
-		}
-		catch(CommonException& err)
-		{	if(usfErr==NULL)
-			{
+			// this particle's material
+			const MaterialBase *matRef = theMaterials[mptr->MatID()];
+			
+			try
+			{	// make sure have mechanical properties for this material and angle
+				void *properties = matRef->GetCopyOfMechanicalProps(mptr,np,matBuffer[tn],altBuffer[tn],0);
+				
+				// finish on the particle
+				if(constitutiveProfile!=NULL)
+				{	double lawStart = ThreadTime();
+					mptr->UpdateStrain(strainTime,secondPass,np,properties,matRef->GetField());
+					constitutiveProfile->AddUpdate(tn,mptr->MatID(),ThreadTime()-lawStart);
+				}
+				else
+					mptr->UpdateStrain(strainTime,secondPass,np,properties,matRef->GetField());
+			}
+			catch(CommonException& err)
+			{	if(usfErr==NULL)
+				{
 #pragma omp critical (error)
-				usfErr = new CommonException(err);
+					usfErr = new CommonException(err);
+				}
 			}
-		}
-		catch(std::bad_alloc&)
-		{	if(usfErr==NULL)
-			{
+			catch(std::bad_alloc&)
+			{	if(usfErr==NULL)
+				{
 #pragma omp critical (error)
-				usfErr = new CommonException("Memory error","UpdateStrainsFirstTask::FullStrainUpdat");
+					usfErr = new CommonException("Memory error","UpdateStrainsFirstTask::FullStrainUpdat");
+				}
 			}
-		}
-		catch(...)
-		{	if(usfErr==NULL)
-			{
+			catch(...)
+			{	if(usfErr==NULL)
+				{
 #pragma omp critical (error)
-				usfErr = new CommonException("Unexpected error","UpdateStrainsFirstTask::FullStrainUpdat");
+					usfErr = new CommonException("Unexpected error","UpdateStrainsFirstTask::FullStrainUpdat");
+				}
 			}
 		}
-    }
+		TrackThreadWork(threadStart,numParticles,0);
+	}
 	
 	// throw error if it occurred
 	if(usfErr!=NULL) throw *usfErr;
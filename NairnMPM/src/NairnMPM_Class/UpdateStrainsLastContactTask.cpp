@@ -60,6 +60,7 @@ UpdateStrainsLastContactTask::UpdateStrainsLastContactTask(const char *name) : M
 void UpdateStrainsLastContactTask::Execute(int taskOption)
 {
 	CommonException *uslErr = NULL;
+	int totalPatches = fmobj->GetTotalNumberOfPatches();
 #ifdef CONST_ARRAYS
 	int ndsArray[MAX_SHAPE_NODES];
 	double fn[MAX_SHAPE_NODES],xDeriv[MAX_SHAPE_NODES],yDeriv[MAX_SHAPE_NODES],zDeriv[MAX_SHAPE_NODES];
@@ -78,57 +79,64 @@ void UpdateStrainsLastContactTask::Execute(int taskOption)
 		for(int i=1;i<=nnodes;i++)
 			nd[i]->RezeroNodeTask6(timestep);
 		
-		// zero ghost nodes on this patch
-		int pn = GetPatchNumber();
-		patches[pn]->RezeroNodeTask6(timestep);
-		
-		try
-		{	short vfld;
-			NodalPoint *ndptr;
-			int i,numnds,matfld,*nds;
+		// zero ghost nodes on each patch and extrapolate its particles
+#pragma omp for
+		for(int pn=0;pn<totalPatches;pn++)
+		{	double threadStart = ThreadTime();
+			long numParticles = 0,numNodes = 0;
+			patches[pn]->RezeroNodeTask6(timestep);
+			
+			try
+			{	short vfld;
+				NodalPoint *ndptr;
+				int i,numnds,matfld,*nds;
 			
-			// loop over non-rigid particles only
-			MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
-			while(mpmptr!=NULL)
-			{	// get shape functions and mat field
-				nds = ndsArray;
-				matfld = GetParticleFunctions(mpmptr,&nds,fn,xDeriv,yDeriv,zDeriv);
-				numnds = nds[0];
+				// loop over non-rigid particles only
+				MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
+				while(mpmptr!=NULL)
+				{	// get shape functions and mat field
+					nds = ndsArray;
+					matfld = GetParticleFunctions(mpmptr,&nds,fn,xDeriv,yDeriv,zDeriv);
+					numnds = nds[0];
+					numParticles++;
+					numNodes += numnds;
 				
-				// Add particle property to each node in the element
-				for(i=1;i<=numnds;i++)
-				{   // get node pointer
-					ndptr = GetNodePointer(pn,nds[i]);
+					// Add particle property to each node in the element
+					for(i=1;i<=numnds;i++)
+					{   // get node pointer
+						ndptr = GetNodePointer(pn,nds[i]);
 					
-					// add mass and momentum (and maybe contact stuff) to this node
-					vfld = mpmptr->vfld[i];
-					ndptr->AddMassMomentumLast(mpmptr,vfld,matfld,fn[i],xDeriv[i],yDeriv[i],zDeriv[i]);
-				}
+						// add mass and momentum (and maybe contact stuff) to this node
+						vfld = mpmptr->vfld[i];
+						ndptr->AddMassMomentumLast(mpmptr,vfld,matfld,fn[i],xDeriv[i],yDeriv[i],zDeriv[i]);
+					}
 				
-				// next material point
-				mpmptr = (MPMBase *)mpmptr->GetNextObject();
+					// next material point
+					mpmptr = (MPMBase *)mpmptr->GetNextObject();
+				}
 			}
-		}
-		catch(CommonException& err)
-		{	if(uslErr==NULL)
-			{
+			catch(CommonException& err)
+			{	if(uslErr==NULL)
+				{
 #pragma omp critical (error)
-				uslErr = new CommonException(err);
+					uslErr = new CommonException(err);
+				}
 			}
-		}
-		catch(std::bad_alloc&)
-		{	if(uslErr==NULL)
-			{
+			catch(std::bad_alloc&)
+			{	if(uslErr==NULL)
+				{
 #pragma omp critical (error)
-				uslErr = new CommonException("Memory error","UpdateStrainsLastContactTask::Execute");
+					uslErr = new CommonException("Memory error","UpdateStrainsLastContactTask::Execute");
+				}
 			}
-		}
-		catch(...)
-		{	if(uslErr==NULL)
-			{
+			catch(...)
+			{	if(uslErr==NULL)
+				{
 #pragma omp critical (error)
-				uslErr = new CommonException("Unexpected error","UpdateStrainsLastContactTask::Execute");
+					uslErr = new CommonException("Unexpected error","UpdateStrainsLastContactTask::Execute");
+				}
 			}
+			TrackThreadWork(threadStart,numParticles,numNodes);
 		}
 	}
 	
@@ -136,11 +144,12 @@ void UpdateStrainsLastContactTask::Execute(int taskOption)
 	if(uslErr!=NULL) throw *uslErr;
 	
 	// reduction of ghost node forces to real nodes
-	int totalPatches = fmobj->GetTotalNumberOfPatches();
+	double serialStart = ThreadTime();
 	if(totalPatches>1)
 	{	for(int pn=0;pn<totalPatches;pn++)
 			patches[pn]->MassAndMomentumReductionLast();
 	}
+	TrackSerialTime(serialStart);
 	
 	// contact and mnomenta BCs
 	UpdateMomentaTask::ContactAndMomentaBCs(UPDATE_STRAINS_LAST_CALL);
@@ -10,18 +10,22 @@
 	The tasks are:
 	--------------
 	* Find vstar on all nodes (needed when update particles)
+	* For order 3 or higher, the particle double loop is done once to assemble
+		a sparse nodal operator for each patch that is applied in each iteration
 ********************************************************************************/
 
 #include "stdafx.h"
 #include "NairnMPM_Class/XPICExtrapolationTask.hpp"
 #include "NairnMPM_Class/NairnMPM.hpp"
 #include "Nodes/NodalPoint.hpp"
+#include "Nodes/CrackVelocityField.hpp"
 #include "Global_Quantities/BodyForce.hpp"
 #include "Exceptions/CommonException.hpp"
 #include "Patches/GridPatch.hpp"
 #include "MPM_Classes/MPMBase.hpp"
 #include "Elements/ElementBase.hpp"
 #include "Materials/MaterialBase.hpp"
+#include "NairnMPM_Class/XPICNodalOperator.hpp"
 
 // class globals
 XPICExtrapolationTask *XPICMechanicsTask=NULL;
@@ -32,6 +36,11 @@ XPICExtrapolationTask::XPICExtrapolationTask(const char *name) : MPMTask(name)
 {
 }
 
+XPICExtrapolationTask::~XPICExtrapolationTask()
+{	for(int pn=0;pn<(int)nodalOperators.size();pn++)
+		delete nodalOperators[pn];
+}
+
 #pragma mark REQUIRED METHODS
 
 // Update particle position, velocity, temp, and conc
@@ -64,17 +73,35 @@ void XPICExtrapolationTask::Execute(int xpicOption)
 			InitializeXPICData(patches[i],xpicOption);
 	}
 	
+	// when more than one iteration, first particle loop assembles nodal operator for each patch
+	bool useOperator = UseXPICNodalOperator(m);
+	if(useOperator)
+	{	while((int)nodalOperators.size()<totalPatches)
+			nodalOperators.push_back(new XPICNodalOperator());
+	}
+	
 	// iterate for k from 2 to XPIC order m (note that loop is skipped for order 1)
 	double vsign = -1.;					// (-1)^k starting at -1 for k=2 to subtract v*
 	for(int k=2;k<=m;k++)
-	{
-#pragma omp parallel private(fn,ndsArray,xDeriv,yDeriv,zDeriv)
-		{
-			// thread for patch pn
-			int pn = GetPatchNumber();
+	{	// scaling for this iteration
+		double scale = (double)(m-k+1)/(double)k;
+#if MM_XPIC == 1
+		double scaleContact = (double)(m-k)/(double)k;
+#else
+		double scaleContact = 1.;
+#endif
+		
+#pragma omp parallel for private(fn,ndsArray,xDeriv,yDeriv,zDeriv)
+		for(int pn=0;pn<totalPatches;pn++)
+		{	// after the first iteration, apply the operator without revisiting the particles
+			if(useOperator && k>2)
+			{	nodalOperators[pn]->Apply(scale,scaleContact);
+				continue;
+			}
 			
 			try
 			{	// Loop over non-rigid particles
+				if(useOperator) nodalOperators[pn]->StartAssembly();
 				MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
 				while(mpmptr!=NULL)
 				{	// get shape functions and mat field
@@ -89,20 +116,21 @@ void XPICExtrapolationTask::Execute(int xpicOption)
 					else
 						elref->GetShapeFunctions(fn,&nds,mpmptr);
 					
-					// Add to each node for this particle
-					double scale = (double)(m-k+1)/(double)k;
-#if MM_XPIC == 1
-					double scaleContact = (double)(m-k)/(double)k;
-#else
-					double scaleContact = 1.;
-#endif
-					
-					// double loop over nodes
-					XPICDoubleLoop(mpmptr,matfld,nds,fn,pn,scale,scaleContact,xDeriv,yDeriv,zDeriv);
+					// double loop over nodes to add to each node or to the operator
+					if(useOperator)
+						XPICOperatorLoop(nodalOperators[pn],mpmptr,matfld,nds,fn,pn);
+					else
+						XPICDoubleLoop(mpmptr,matfld,nds,fn,pn,scale,scaleContact,xDeriv,yDeriv,zDeriv);
 					
 					// next material point
 					mpmptr = (MPMBase *)mpmptr->GetNextObject();
 				}
+				
+				// compress operator and apply for the first iteration
+				if(useOperator)
+				{	nodalOperators[pn]->FinishAssembly();
+					nodalOperators[pn]->Apply(scale,scaleContact);
+				}
 			}
 			catch(CommonException& err)
 			{   if(xpicErr==NULL)
@@ -151,12 +179,9 @@ void XPICExtrapolationTask::Execute(int xpicOption)
 	if(!XPICDoesBackExtrapolation()) return;
 	
 	// Extrapolate back tothe particles
-#pragma omp parallel private(fn,ndsArray)
-	{
-		// thread for patch pn
-		int pn = GetPatchNumber();
-		
-		try
+#pragma omp parallel for private(fn,ndsArray)
+	for(int pn=0;pn<totalPatches;pn++)
+	{	try
 		{	// Loop over non-rigid particles
 			MPMBase *mpmptr = patches[pn]->GetFirstBlockPointer(FIRST_NONRIGID);
 			while(mpmptr!=NULL)
@@ -275,3 +300,33 @@ bool XPICExtrapolationTask::XPICDoesBackExtrapolation(void)
 // empty method
 void XPICExtrapolationTask::XPICBackExtrapolation(MPMBase *mpmptr,int *nds,double *fn,int m) {}
 
+// Use nodal operator if more than one iteration (subclasses whose double loop
+// depends on more than nodal vStarPrev should return false)
+bool XPICExtrapolationTask::UseXPICNodalOperator(int m) { return m>2; }
+
+// Double XPIC loop to add weights to the nodal operator (with same weights as XPICDoubleLoop())
+void XPICExtrapolationTask::XPICOperatorLoop(XPICNodalOperator *nodalOp,MPMBase *mpmptr,int matfld,int *nds,double *fn,int pn)
+{
+	// number of nodes
+	int numnds = nds[0];
+	
+	for(int i=1;i<=numnds;i++)
+	{	// get mass from real node
+		NodalPoint *ndptri = nd[nds[i]];
+		short vfldi = mpmptr->vfld[i];
+		double mass = ndptri->GetMaterialMass(vfldi,matfld);
+		
+		// row for material field on node pointer (which may now be ghost node)
+		ndptri = GetNodePointer(pn,nds[i]);
+		int row = nodalOp->GetRow(ndptri->cvf[vfldi]->GetMaterialVelocityField(matfld));
+		int hint = 0;
+		
+		// loop over nodes again
+		for(int j=1;j<=numnds;j++)
+		{	// read-only real node to get vStarPrev
+			Vector *vStarPrevj = nd[nds[j]]->GetVStarPrev(mpmptr->vfld[j],matfld);
+			nodalOp->AddTerm(row,vStarPrevj,mpmptr->mp*fn[i]*fn[j]/mass,hint);
+		}
+	}
+}
+
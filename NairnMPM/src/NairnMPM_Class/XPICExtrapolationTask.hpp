@@ -18,6 +18,7 @@
 class NodalPoint;
 class GridPatch;
 class MPMBase;
+class XPICNodalOperator;
 
 class XPICExtrapolationTask : public MPMTask
 {
@@ -25,6 +26,7 @@ class XPICExtrapolationTask : public MPMTask
 	
 		// constructor
 		XPICExtrapolationTask(const char *);
+		virtual ~XPICExtrapolationTask();
 	
 		// required methods
 		virtual void Execute(int);
@@ -39,9 +41,11 @@ class XPICExtrapolationTask : public MPMTask
 		virtual void UpdateXStar(NodalPoint *,double,int,int,double);
 		virtual bool XPICDoesBackExtrapolation(void);
 		virtual void XPICBackExtrapolation(MPMBase *,int *,double *,int);
+		virtual bool UseXPICNodalOperator(int);
+		virtual void XPICOperatorLoop(XPICNodalOperator *,MPMBase *,int,int *,double *,int);
 	
 	protected:
-	
+		vector< XPICNodalOperator * > nodalOperators;		// one per patch
 };
 
 extern XPICExtrapolationTask *XPICMechanicsTask;
@@ -0,0 +1,112 @@
+/********************************************************************************
+	XPICNodalOperator.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "NairnMPM_Class/XPICNodalOperator.hpp"
+#include "Nodes/MatVelocityField.hpp"
+#include "Global_Quantities/BodyForce.hpp"
+
+#pragma mark XPICNodalOperator::Constructors and Destructors
+
+XPICNodalOperator::XPICNodalOperator()
+{
+}
+
+#pragma mark XPICNodalOperator::Methods
+
+// clear previous operator (keeps memory)
+void XPICNodalOperator::StartAssembly(void)
+{	rowIndex.clear();
+	targets.clear();
+}
+
+// Find row for target material velocity field (new row if not found)
+int XPICNodalOperator::GetRow(MatVelocityField *target)
+{
+	unordered_map< MatVelocityField *,int >::iterator it = rowIndex.find(target);
+	if(it!=rowIndex.end()) return it->second;
+
+	int row = (int)targets.size();
+	rowIndex[target] = row;
+	targets.push_back(target);
+	if(row<(int)rowTerms.size())
+		rowTerms[row].clear();
+	else
+		rowTerms.push_back(vector< XPICOperatorTerm >());
+	return row;
+}
+
+// Add weight for source vStarPrev to a row (summed with previous weight for same source)
+// Search starts at hint and hint is changed to the next term
+void XPICNodalOperator::AddTerm(int row,Vector *vStarPrev,double weight,int &hint)
+{
+	vector< XPICOperatorTerm > &rterms = rowTerms[row];
+	int numTerms = (int)rterms.size();
+	if(hint>=numTerms) hint = 0;
+	for(int t=hint;t<numTerms;t++)
+	{	if(rterms[t].vStarPrev==vStarPrev)
+		{	rterms[t].weight += weight;
+			hint = t+1;
+			return;
+		}
+	}
+	for(int t=0;t<hint;t++)
+	{	if(rterms[t].vStarPrev==vStarPrev)
+		{	rterms[t].weight += weight;
+			hint = t+1;
+			return;
+		}
+	}
+
+	// new term
+	XPICOperatorTerm term;
+	term.vStarPrev = vStarPrev;
+	term.weight = weight;
+	rterms.push_back(term);
+	hint = numTerms+1;
+}
+
+// Copy rows to compressed row storage
+void XPICNodalOperator::FinishAssembly(void)
+{
+	int numRows = (int)targets.size();
+	rowStart.resize(numRows+1);
+	rowStart[0] = 0;
+	for(int r=0;r<numRows;r++)
+		rowStart[r+1] = rowStart[r]+(int)rowTerms[r].size();
+
+	terms.resize(rowStart[numRows]);
+	for(int r=0;r<numRows;r++)
+		std::copy(rowTerms[r].begin(),rowTerms[r].end(),terms.begin()+rowStart[r]);
+}
+
+// Add scale*(operator times vStarPrev) to vStarNext of each target and
+// when XPIC includes contact, add scaleContact*(operator times deltaVStarPrev) too
+void XPICNodalOperator::Apply(double scale,double scaleContact) const
+{
+#if MM_XPIC == 1
+	bool hasContact = bodyFrc.UsingVstar()==VSTAR_WITH_CONTACT;
+#endif
+
+	// MatVelocityField::AddVStarNext() expects delta v* +2 from v*
+	Vector sums[3];
+	ZeroVector(&sums[1]);
+	int numRows = (int)targets.size();
+	for(int r=0;r<numRows;r++)
+	{	ZeroVector(&sums[0]);
+		ZeroVector(&sums[2]);
+		for(int t=rowStart[r];t<rowStart[r+1];t++)
+		{	const XPICOperatorTerm *term = &terms[t];
+			AddScaledVector(&sums[0],term->vStarPrev,term->weight);
+#if MM_XPIC == 1
+			if(hasContact) AddScaledVector(&sums[2],term->vStarPrev+2,term->weight);
+#endif
+		}
+		targets[r]->AddVStarNext(sums,NULL,NULL,NULL,scale,scaleContact);
+	}
+}
@@ -0,0 +1,59 @@
+/********************************************************************************
+	XPICNodalOperator.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Sparse nodal operator for XPIC extrapolations on one patch. Each row
+	is a material velocity field on a real or ghost node of the patch and
+	each term is the weight (sum over particles of mp Si Sj/mi) applied to
+	vStarPrev of a material velocity field on a real node. It is assembled
+	in one particle loop and then applied for each XPIC iteration without
+	returning to the particles. Rows are stored in compressed form in the
+	order first seen in the patch's particle list. During assembly, the
+	search for a term starts after the previous term found in that row,
+	because neighboring particles add terms in the same order.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _XPICNODALOPERATOR_
+
+#define _XPICNODALOPERATOR_
+
+class MatVelocityField;
+
+// one term in an operator row
+typedef struct {
+	Vector *vStarPrev;
+	double weight;
+} XPICOperatorTerm;
+
+class XPICNodalOperator
+{
+	public:
+
+		// constructors and destructors
+		XPICNodalOperator();
+
+		// methods
+		void StartAssembly(void);
+		int GetRow(MatVelocityField *);
+		void AddTerm(int,Vector *,double,int &);
+		void FinishAssembly(void);
+		void Apply(double,double) const;
+
+	private:
+		// assembly (capacity kept between steps)
+		unordered_map< MatVelocityField *,int > rowIndex;
+		vector< vector< XPICOperatorTerm > > rowTerms;
+
+		// compressed rows
+		vector< MatVelocityField * > targets;
+		vector< int > rowStart;
+		vector< XPICOperatorTerm > terms;
+};
+
+#endif
@@ -457,6 +457,21 @@ int CrackVelocityField::GetNumberMaterials(void) { return 1; }
 // Look for presence of nonrigid poitns (override in CrackVelocityFieldMulti)
 bool CrackVelocityField::HasPointsNonrigid(void) const { return numberPoints>0; }
 
+// bytes used by material velocity fields and other data of this field
+// (subclasses add size of the object)
+size_t CrackVelocityField::MemoryBytes(void) const
+{	size_t bytes = maxMaterialFields*sizeof(MatVelocityField *);
+	for(int i=0;i<maxMaterialFields;i++)
+	{	if(mvf[i]!=NULL) bytes += mvf[i]->MemoryBytes();
+	}
+	if(df!=NULL)
+	{	bytes += sizeof(DispField);
+		if(df->matWeight!=NULL) bytes += numActiveMaterials*sizeof(double);
+	}
+	if(cm!=NULL) bytes += sizeof(CenterMassField);
+	return bytes;
+}
+
 // for debugging
 void CrackVelocityField::Describe(void) const
 {
@@ -141,6 +141,7 @@ class CrackVelocityField
 		virtual int GetFieldNum(void) const;
 		virtual int HasPointsThatSeeCracks(void);
 		virtual int GetNumberNonrigidMaterials(void);
+		virtual size_t MemoryBytes(void) const;
 	
 		// class methods
 		static bool ActiveField(CrackVelocityField *);
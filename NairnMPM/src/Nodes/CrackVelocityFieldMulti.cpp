@@ -1270,6 +1270,11 @@ void CrackVelocityFieldMulti::Describe(void) const
 	}
 }
 
+// bytes used by this field and its material velocity fields
+size_t CrackVelocityFieldMulti::MemoryBytes(void) const
+{	return sizeof(CrackVelocityFieldMulti) + CrackVelocityField::MemoryBytes();
+}
+
 // get first active rigid field or return NULL. Also return number in rigidFieldNum
 // Onluy called when copying rigid filed to field [0]
 MatVelocityField *CrackVelocityFieldMulti::GetRigidMaterialField(int *rigidFieldNum)
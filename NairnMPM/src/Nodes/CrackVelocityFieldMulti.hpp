@@ -88,6 +88,7 @@ class CrackVelocityFieldMulti : public CrackVelocityField
 		virtual int GetNumberMaterials(void);
 		virtual int GetNumberNonrigidMaterials(void);
 		virtual void Describe(void) const;
+		virtual size_t MemoryBytes(void) const;
 
 		// XPIC methods
 		virtual void XPICSupport(int,int,NodalPoint *,double,int,int,double);
@@ -238,4 +238,9 @@ void CrackVelocityFieldSingle::Describe(void) const
 	cout << "#     single material" << endl;
 	mvf[0]->Describe(0);
 }
+
+// bytes used by this field and its material velocity field
+size_t CrackVelocityFieldSingle::MemoryBytes(void) const
+{	return sizeof(CrackVelocityFieldSingle) + CrackVelocityField::MemoryBytes();
+}
 	
@@ -57,6 +57,7 @@ class CrackVelocityFieldSingle : public CrackVelocityField
 #endif
 		virtual int PasteFieldMomenta(Vector *,int);
 		virtual void Describe(void) const;
+		virtual size_t MemoryBytes(void) const;
 	
 		// XPIC
 		virtual void XPICSupport(int,int,NodalPoint *,double,int,int,double);
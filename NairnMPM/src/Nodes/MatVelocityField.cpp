@@ -599,6 +599,16 @@ bool MatVelocityField::IgnoresCracks(void) const
 {	return (flags&IGORE_CRACKS_BIT) != 0 ? true : false;
 }
 
+// bytes used by this field, its vectors, and its contact terms
+size_t MatVelocityField::MemoryBytes(void) const
+{	size_t bytes = sizeof(MatVelocityField) + (pkCopy+1)*sizeof(Vector);
+	if(contactInfo!=NULL)
+	{	bytes += sizeof(ContactTerms);
+		if(contactInfo->terms!=NULL) bytes += mpmgrid.numContactVectors*sizeof(Vector);
+	}
+	return bytes;
+}
+
 #pragma mark CLASS METHODS
 
 // return true if references field is active in this time step
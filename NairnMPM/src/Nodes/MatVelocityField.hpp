@@ -106,6 +106,7 @@ class MatVelocityField
 		bool IsRigidBlockField(void) const;
 		int GetFlags(void) const;
 		bool IgnoresCracks(void) const;
+		size_t MemoryBytes(void) const;
 	
 		// class methods
 		static bool ActiveField(MatVelocityField *);
@@ -24,6 +24,9 @@
 // global point to contact conditions
 vector< MaterialContactNode * > MaterialContactNode::materialContactNodes;
 
+// contact nodes are reused on each time step (see ReserveContactNodes())
+vector< MaterialContactNode * > MaterialContactNode::contactNodePool;
+
 #pragma mark MaterialContactNode: Constructors and Destructors
 
 // Constructors
@@ -54,7 +57,18 @@ MaterialContactNode::~MaterialContactNode()
 	if(lists!=NULL) delete [] lists;
 	
 	// null pointer from node to this contact node
-	theNode->contactData = NULL;
+	if(theNode!=NULL) theNode->contactData = NULL;
+}
+
+// Reuse pooled contact node for a new node
+void MaterialContactNode::ReuseForNode(NodalPoint *nd)
+{
+	theNode = nd;
+	prevNode = NULL;
+	if(lists!=NULL)
+	{	for(int i=0;i<maxCrackFields;i++) lists[i].clear();
+	}
+	theNode->contactData = this;
 }
 
 // Get the node
@@ -119,6 +133,9 @@ bool MaterialContactNode::ContactOnKnownNodes(double dtime,int passType)
 	CommonException *mcErr = NULL;
 	int numNodesPerProc = (int)((double)numContactNodes/(double)(fmobj->GetNumberOfProcessors()));
 	
+	// deterministic mode is serial so interface energy and friction work are summed in node order
+	if(fmobj->deterministicPatches>0) numNodesPerProc = 0;
+	
 	// Do contact on all material contact nodes
 #pragma omp parallel if(numNodesPerProc>1)
 	{
@@ -143,15 +160,50 @@ bool MaterialContactNode::ContactOnKnownNodes(double dtime,int passType)
 	return true;
 }
 
-// delete the contact node (which delink to node), clear vector of pointers
+// delink contact nodes from their nodes and clear vector of pointers
+// The contact nodes stay in the pool for the next time step
 void MaterialContactNode::ReleaseContactNodes(void)
 {
 	long numContactNodes = materialContactNodes.size();
 	if(numContactNodes==0) return;
 	
+#pragma omp parallel for
 	for(long i=0;i<numContactNodes;i++)
-		delete materialContactNodes[i];
+	{	materialContactNodes[i]->theNode->contactData = NULL;
+		materialContactNodes[i]->theNode = NULL;
+	}
 	
 	materialContactNodes.clear();
+}
+
+// Prepare for num contact nodes on this time step, which are then set by SetContactNode()
+// Pool only grows, thus new contact nodes are only needed when step has more than any previous step
+// Call outside parallel loops, but SetContactNode() can then be done in parallel
+// throws std::bad_alloc
+void MaterialContactNode::ReserveContactNodes(int num)
+{
+	while((int)contactNodePool.size()<num)
+		contactNodePool.push_back(new MaterialContactNode(NULL,NULL));
+	materialContactNodes.resize(num);
+}
 
+// Set contact node k (0 based) to pooled node for nodal point nd
+void MaterialContactNode::SetContactNode(int k,NodalPoint *nd)
+{	MaterialContactNode *mcn = contactNodePool[k];
+	mcn->ReuseForNode(nd);
+	materialContactNodes[k] = mcn;
+}
+
+// bytes used by pooled contact nodes (and any particle lists) and the list of contact nodes
+size_t MaterialContactNode::MemoryBytes(void)
+{	size_t bytes = (contactNodePool.capacity()+materialContactNodes.capacity())*sizeof(MaterialContactNode *);
+	for(int k=0;k<(int)contactNodePool.size();k++)
+	{	bytes += sizeof(MaterialContactNode);
+		vector< int > *lists = contactNodePool[k]->lists;
+		if(lists!=NULL)
+		{	for(int i=0;i<maxCrackFields;i++)
+				bytes += sizeof(vector< int >)+lists[i].capacity()*sizeof(int);
+		}
+	}
+	return bytes;
 }
@@ -21,11 +21,13 @@ class MaterialContactNode
 	
 		// variables (changed in MPM time step)
 		static vector< MaterialContactNode * > materialContactNodes;
+		static vector< MaterialContactNode * > contactNodePool;
 	
 		// constructors and destructors
 		MaterialContactNode(NodalPoint *,MaterialContactNode *);
 		virtual ~MaterialContactNode();
 		void LinkToNode(void);
+		void ReuseForNode(NodalPoint *);
 	
 		// common methods
 		void NodalMaterialContact(double,int);
@@ -41,6 +43,9 @@ class MaterialContactNode
 		// class methods
 		static bool ContactOnKnownNodes(double,int);
 		static void ReleaseContactNodes(void);
+		static void ReserveContactNodes(int);
+		static void SetContactNode(int,NodalPoint *);
+		static size_t MemoryBytes(void);
 	
 	protected:
 		NodalPoint *theNode;
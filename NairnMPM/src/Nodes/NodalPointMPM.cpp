@@ -385,14 +385,15 @@ void NodalPoint::AddMassMomentum(MPMBase *mptr,short vfld,int matfld,double shap
 	// add momentum
 	double mp = mptr->mp;
 	double fnmp = shape*mp;
-	Vector wtvel;
-	cvf[vfld]->AddMomentumTask1(matfld,CopyScaleVector(&wtvel,&mptr->vel,fnmp),&mptr->vel,numPts);
+	Vector wtvel,vp = mptr->vel;
+	cvf[vfld]->AddMomentumTask1(matfld,CopyScaleVector(&wtvel,&vp,fnmp),&vp,numPts);
 
 	// crack contact calculations (only if cracks or multimaterial mode, i.e., contact is being done)
 	if(firstCrack!=NULL || fmobj->multiMaterialMode)
 	{	// Extrapolate volume along with displacement and position (if needed)
 		double wtVolume = nonRigid ? shape*mptr->GetVolume(DEFORMED_AREA) : shape*mptr->GetUnscaledVolume();
-		cvf[vfld]->AddVolumeDisplacement(matfld,wtVolume,fnmp,mptr->pos,&mptr->origpos);
+		Vector xorig = mptr->origpos;
+		cvf[vfld]->AddVolumeDisplacement(matfld,wtVolume,fnmp,mptr->pos,&xorig);
 		
 		// material contact calculations (only if multimaterial mode and if needed)
 		if(mpmgrid.volumeGradientIndex>=0)
@@ -435,12 +436,14 @@ void NodalPoint::AddMassMomentumLast(MPMBase *mptr,short vfld,int matfld,double
 	// add momentum
 	double mp = mptr->mp;
 	double fnmp = shape*mp;
-	cvf[vfld]->AddMomentumTask6(matfld,fnmp,&mptr->vel);
+	Vector vp = mptr->vel;
+	cvf[vfld]->AddMomentumTask6(matfld,fnmp,&vp);
 	
 	// crack contact calculations (only if cracks or multimaterial mode, i.e., contact is being done)
 	if(firstCrack!=NULL || fmobj->multiMaterialMode)
 	{	// Extrapolate volume along with displacement and position (if needed) (only nonrigid materials here)
-		cvf[vfld]->AddVolumeDisplacement(matfld,shape*mptr->GetVolume(DEFORMED_AREA),fnmp,mptr->pos,&mptr->origpos);
+		Vector xorig = mptr->origpos;
+		cvf[vfld]->AddVolumeDisplacement(matfld,shape*mptr->GetVolume(DEFORMED_AREA),fnmp,mptr->pos,&xorig);
 
 		// material contact calculations (only if multimaterial mode and needed)
 		if(mpmgrid.volumeGradientIndex>=0)
@@ -1550,6 +1553,16 @@ bool NodalPoint::NeedsParticleListed(short vfld)
 	return cvf[vfld]->GetNumberMaterials()>1;
 }
 
+// bytes used by crack and material velocity fields on this node (not including the node)
+size_t NodalPoint::FieldMemoryBytes(void) const
+{	if(cvf==NULL) return 0;
+	size_t bytes = maxCrackFields*sizeof(CrackVelocityField *);
+	for(int i=0;i<maxCrackFields;i++)
+	{	if(cvf[i]!=NULL) bytes += cvf[i]->MemoryBytes();
+	}
+	return bytes;
+}
+
 // describe velocity field
 void NodalPoint::Describe(bool cvfDetails) const
 {	cout << "#  node=" << num << " pt=(" << x << "," << y << "," << z << ") mass=" << nodalMass << endl;
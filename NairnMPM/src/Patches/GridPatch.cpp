@@ -52,7 +52,7 @@ GridPatch::GridPatch(int xmin,int xmax,int ymin,int ymax,int zmin,int zmax)
 	ghosts = NULL;
 	numGhosts=0;
 	
-	lastToMove = NULL;
+	moving.reserve(MOVING_BUFFER_SIZE);
 }
 
 // Create all ghost nodes
@@ -199,39 +199,51 @@ void GridPatch::DeleteDisp(void)
 }
 
 // prepare particle to be moved to another patch
+// Buffer keeps its capacity so only grows when more particles move than in previous steps
+// Only called by the thread for this patch
 bool GridPatch::AddMovingParticle(MPMBase *mptr,GridPatch *newPatch,MPMBase *prevMptr)
-{	// create data structure
-	MovingData *nextToMove = new MovingData;
-	
-	// fill with data
-	nextToMove->movingMptr = mptr;
-	nextToMove->newPatch = (void *)newPatch;
-	nextToMove->previousMptr = prevMptr;
-	nextToMove->previousMoveData = (void *)lastToMove;
-	
-	// reset last to move and exit
-	lastToMove = nextToMove;
+{	MovingData nextToMove;
+	nextToMove.movingMptr = mptr;
+	nextToMove.newPatch = (void *)newPatch;
+	nextToMove.previousMptr = prevMptr;
+	try
+	{	moving.push_back(nextToMove);
+	}
+	catch(std::bad_alloc&)
+	{	return false;
+	}
 	return true;
 }
 
-// If any scheduled to move, move them now and clear data in the process
-void GridPatch::MoveParticlesToNewPatches(void)
-{	// move if any need to be moved
-	while(lastToMove!=NULL)
-	{	// move it now
-		RemoveParticleAfter(lastToMove->movingMptr,lastToMove->previousMptr);
-		GridPatch *patch = (GridPatch *)lastToMove->newPatch;
-		patch->AddParticle(lastToMove->movingMptr);
-		
-		// find next one and delete old one
-		MovingData *nextToMove = (MovingData *)lastToMove->previousMoveData;
-		delete lastToMove;
-		
-		// on to next one
-		lastToMove = nextToMove;
+// number of particles scheduled to leave this patch
+int GridPatch::NumberOfMovingParticles(void) const { return (int)moving.size(); }
+
+// First move phase removes all leaving particles from this patch
+// Removed in reverse order so previous particles of later ones remain valid
+// Can run in parallel with other patches because only changes this patch's lists
+void GridPatch::RemoveMovingParticles(void)
+{	for(int i=(int)moving.size()-1;i>=0;i--)
+		RemoveParticleAfter(moving[i].movingMptr,moving[i].previousMptr);
+}
+
+// Second move phase adds particles moving to this patch (after all patches finished first phase)
+// Source patches are visited in order and each in reverse order to give the same
+//    particle order as moving them serially
+// Can run in parallel with other patches because only changes this patch's lists
+void GridPatch::AddMovedParticles(int numPatches)
+{	for(int sn=0;sn<numPatches;sn++)
+	{	if(patches[sn]==this) continue;
+		const vector< MovingData > &sourceMoving = patches[sn]->moving;
+		for(int i=(int)sourceMoving.size()-1;i>=0;i--)
+		{	if(sourceMoving[i].newPatch==(void *)this)
+				AddParticle(sourceMoving[i].movingMptr);
+		}
 	}
 }
 
+// done moving, but keep buffer capacity
+void GridPatch::ClearMovingParticles(void) { moving.clear(); }
+
 // add particle to this patch - it is put at the beginning
 void GridPatch::AddParticle(MPMBase *mptr)
 {
@@ -571,3 +583,13 @@ GhostNode **GridPatch::GetGhosts(int *getNum)
 {	*getNum = numGhosts;
 	return ghosts;
 }
+
+// bytes used by ghost nodes (with their velocity fields) and moving particle records of this patch
+size_t GridPatch::MemoryBytes(void) const
+{	size_t bytes = numGhosts*(sizeof(GhostNode *)+sizeof(GhostNode)) + moving.capacity()*sizeof(MovingData);
+	for(int i=0;i<numGhosts;i++)
+	{	NodalPoint *ghost = ghosts[i]->GetGhostNodePointer();
+		if(ghost!=NULL) bytes += sizeof(NodalPoint)+ghost->FieldMemoryBytes();
+	}
+	return bytes;
+}
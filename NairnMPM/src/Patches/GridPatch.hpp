@@ -22,9 +22,11 @@ typedef struct {
 	MPMBase *movingMptr;
 	void *newPatch;
 	MPMBase *previousMptr;
-	void *previousMoveData;
 } MovingData;
 
+// initial room for particles leaving each patch in one step
+#define MOVING_BUFFER_SIZE 256
+
 enum { FIRST_NONRIGID=0,FIRST_RIGID_BLOCK,FIRST_RIGID_CONTACT,FIRST_RIGID_BC };
 
 class GridPatch
@@ -47,7 +49,10 @@ class GridPatch
         void JKTaskReduction(void);
         void DeleteDisp(void);
 		bool AddMovingParticle(MPMBase *,GridPatch *,MPMBase *);
-		void MoveParticlesToNewPatches(void);
+		int NumberOfMovingParticles(void) const;
+		void RemoveMovingParticles(void);
+		void AddMovedParticles(int);
+		void ClearMovingParticles(void);
 		void AddParticle(MPMBase *);
 		void RemoveParticleAfter(MPMBase *,MPMBase *);
 		void XPICSupport(int,int,NodalPoint *,double,int,int,double);
@@ -57,6 +62,7 @@ class GridPatch
 		NodalPoint *GetNodePointer(int);
         NodalPoint *GetNodePointer(int,bool);
 		GhostNode **GetGhosts(int *);
+		size_t MemoryBytes(void) const;
 	
     private:
         int x0,x1,y0,y1,z0,z1;					// element ranges (0-based row, col, rank)
@@ -75,7 +81,7 @@ class GridPatch
 		int fullRank;
         int baseInterior;
         int baseApex;
-		MovingData *lastToMove;
+		vector< MovingData > moving;			// particles leaving this patch (capacity kept between steps)
 };
 
 extern GridPatch **patches;
@@ -18,6 +18,11 @@
 #include "Read_MPM/MpsController.hpp"
 #include "System/ArchiveData.hpp"
 #include "Read_XML/Expression.hpp"
+#include "Read_MPM/ImageVolume.hpp"
+#include "NairnMPM_Class/MeshInfo.hpp"
+#include "Custom_Tasks/DiffusionTask.hpp"
+#include "Global_Quantities/ThermalRamp.hpp"
+#include "Exceptions/CommonException.hpp"
 
 extern char *angleExpr[3];
 extern char rotationAxes[4];
@@ -29,7 +34,11 @@ extern char angleAxes[4];
 short MPMReadHandler::BMPFileInput(char *xName,const Attributes& attrs)
 {
 	// check for common commands
-	if(BMPFileCommonInput(xName,attrs,POINTSBLOCK,fmobj->IsThreeD())) return TRUE;
+	if(BMPFileCommonInput(xName,attrs,POINTSBLOCK,fmobj->IsThreeD()))
+	{	// settings for image volumes
+		if(strcmp(xName,"BMP")==0) VolumeFileInput(attrs);
+		return TRUE;
+	}
 	
 	//-----------------------------------------------------------
     // Intensity properties for MPM only
@@ -56,6 +65,12 @@ short MPMReadHandler::BMPFileInput(char *xName,const Attributes& attrs)
 //-----------------------------------------------------------
 void MPMReadHandler::TranslateBMPFiles(void)
 {
+	// 3D image volumes
+	if(ImageVolume::IsVolumeFile(bmpFileName))
+	{	TranslateVolumeFiles();
+		return;
+	}
+	
 	// file info and data
 	unsigned char **rows,**angleRows = NULL,**angle2Rows = NULL,**angle3Rows = NULL;
 	XYInfoHeader info;
@@ -255,6 +270,287 @@ void MPMReadHandler::TranslateBMPFiles(void)
 		
 }
 
+//-----------------------------------------------------------
+// Read <BMP> attributes used only for 3D image volumes
+// throws SAXException()
+//-----------------------------------------------------------
+void MPMReadHandler::VolumeFileInput(const Attributes& attrs)
+{
+	char *aName,*value;
+	
+	bdepth=-1.e9;		// < -1.e8 means depth was not specified
+	volumeVoxels[0]=volumeVoxels[1]=volumeVoxels[2]=0;
+	volumeHeader=0;
+	volumeRule=VOLUME_MAJORITY;
+	volumeSample=1;
+	double aScaling=ReadUnits(attrs,LENGTH_UNITS);
+	int numAttr=(int)attrs.getLength();
+	for(int i=0;i<numAttr;i++)
+	{	aName=XMLString::transcode(attrs.getLocalName(i));
+		value=XMLString::transcode(attrs.getValue(i));
+		if(strcmp(aName,"depth")==0)
+		{	sscanf(value,"%lf",&bdepth);
+			bdepth*=aScaling;
+		}
+		else if(strcmp(aName,"voxels")==0)
+		{	if(sscanf(value,"%d,%d,%d",&volumeVoxels[0],&volumeVoxels[1],&volumeVoxels[2])!=3)
+				throw SAXException("<BMP> voxels attribute must be three comma separated integers.");
+		}
+		else if(strcmp(aName,"header")==0)
+			sscanf(value,"%ld",&volumeHeader);
+		else if(strcmp(aName,"rule")==0)
+		{	if(strcmp(value,"majority")==0)
+				volumeRule=VOLUME_MAJORITY;
+			else if(strcmp(value,"average")==0)
+				volumeRule=VOLUME_AVERAGE;
+			else
+				throw SAXException("<BMP> rule attribute must be 'majority' or 'average'.");
+		}
+		else if(strcmp(aName,"sample")==0)
+		{	sscanf(value,"%d",&volumeSample);
+			if(volumeSample<1)
+				throw SAXException("<BMP> sample attribute must be a positive integer.");
+		}
+		delete [] aName;
+		delete [] value;
+	}
+}
+
+//-----------------------------------------------------------
+// Translate 3D image volume (raw or TIFF stack) into material points
+// Files are memory mapped and particles are created in parallel
+// throws std::bad_alloc, SAXException()
+//-----------------------------------------------------------
+void MPMReadHandler::TranslateVolumeFiles(void)
+{
+	if(!fmobj->IsThreeD())
+		throw SAXException(XYFileError("Image volumes (raw or TIFF stacks) are only allowed in 3D simulations.",bmpFileName));
+	
+	// open the volume
+	ImageVolume *volume,*angleVolumes[3] = {NULL,NULL,NULL};
+	char *fullPath=archiver->ExpandOutputPath(bmpFileName);
+	try
+	{	volume=ImageVolume::OpenVolume(fullPath,volumeVoxels,volumeHeader);
+	}
+	catch(...)
+	{	delete [] fullPath;
+		throw;
+	}
+	delete [] fullPath;
+	
+	// angle volumes (overrides other angle settings)
+	bool setAngles = false;
+	int numRotations=(int)strlen(rotationAxes);
+	int fileRotations=(int)strlen(angleAxes);
+	try
+	{	if(bmpAngleFileName[0][0]>0)
+		{	setAngles = true;
+			if(numAngles==0)
+				throw SAXException(XYFileError("No mapping of pixels to angles for angle file were provided.",bmpFileName));
+			for(int i=0;i<fileRotations;i++)
+			{	fullPath=archiver->ExpandOutputPath(bmpAngleFileName[i]);
+				try
+				{	angleVolumes[i]=ImageVolume::OpenVolume(fullPath,volumeVoxels,volumeHeader);
+				}
+				catch(...)
+				{	delete [] fullPath;
+					throw;
+				}
+				delete [] fullPath;
+				if(!volume->SameSize(angleVolumes[i]))
+					throw SAXException(XYFileError("The image volume and an angle volume sizes do not match.",bmpFileName));
+				if(i>=numAngles)
+				{	minAngle[i] = minAngle[i-1];
+					minIntensity[i] = minIntensity[i-1];
+					angleScale[i] = angleScale[i-1];
+					numAngles++;
+				}
+			}
+		}
+		else if(numRotations>0)
+		{	for(int i=0;i<numRotations;i++)
+			{	if(!Expression::CreateFunction(angleExpr[i],i+1))
+					throw SAXException("Invalid angle expression was provided in <RotateX(YZ)> command.");
+			}
+		}
+	}
+	catch(...)
+	{	delete volume;
+		for(int i=0;i<3;i++)
+		{	if(angleVolumes[i]!=NULL) delete angleVolumes[i];
+		}
+		throw;
+	}
+	
+	// get final width, height, and depth (depth defaults to cubic voxels)
+	XYInfoHeader info;
+	info.width = volume->Width();
+	info.height = volume->Height();
+	info.knowsCellSize = false;
+	Vector pw;
+	double zlevel = 0.;
+	const char *msg = CommonReadHandler::DecodeBMPWidthAndHeight(info,bwidth,bheight,zlevel,pw,false);
+	if(msg != NULL)
+		throw SAXException(XYFileError("<BMP> command must specify width and/or height as size or pixels per mm.",bmpFileName));
+	if(bdepth<-1.e8)
+		pw.z = pw.x;
+	else if(bdepth<0.)
+		pw.z = -bdepth;
+	else
+		pw.z = bdepth/(double)volume->Depth();
+	bdepth = pw.z*(double)volume->Depth();
+	if(orig.z<-1.e8) orig.z = 0.;
+	volume->SetGeometry(orig,pw,yflipped);
+	for(int i=0;i<fileRotations;i++)
+	{	if(angleVolumes[i]!=NULL) angleVolumes[i]->SetGeometry(orig,pw,yflipped);
+	}
+	
+	// levels in an array
+	vector<BMPLevel *> levels;
+	BMPLevel *nextLevel = firstLevel;
+	while(nextLevel!=NULL)
+	{	levels.push_back(nextLevel);
+		nextLevel = (BMPLevel *)nextLevel->GetNextObject();
+	}
+	int numLevels = (int)levels.size();
+	
+	// find occupied blocks to skip empty regions (not valid for average rule)
+	if(volumeRule==VOLUME_MAJORITY)
+		volume->FindOccupiedBlocks(&levels[0],numLevels);
+	
+	// elements that overlap the volume
+	vector<int> volumeElems;
+	Vector vmin = orig;
+	Vector vmax = MakeVector(orig.x+bwidth,orig.y+bheight,orig.z+bdepth);
+	if(mpmgrid.IsStructuredGrid())
+	{	int emin[3],emax[3];
+		if(mpmgrid.FindElementRangeInBox(&vmin,&vmax,emin,emax))
+		{	int horiz,vert,zpts;
+			mpmgrid.GetGridPoints(&horiz,&vert,&zpts);
+			horiz--;
+			vert--;
+			for(int zrow=emin[2];zrow<=emax[2];zrow++)
+			{	for(int row=emin[1];row<=emax[1];row++)
+				{	for(int col=emin[0];col<=emax[0];col++)
+						volumeElems.push_back(horiz*(zrow*vert+row)+col);
+				}
+			}
+		}
+	}
+	else
+	{	for(int ii=0;ii<nelems;ii++) volumeElems.push_back(ii);
+	}
+	
+	// Length/semiscale is half particle with (as in TranslateBMPFiles())
+	double semiscale=2.*pow((double)fmobj->ptsPerElement,1./3.);
+	
+	// create points in parallel, each into its own slot so final order matches element order
+	int numElems = (int)volumeElems.size();
+	int ptsPerElement = fmobj->ptsPerElement;
+	MPMBase **newMpts = NULL;
+	if(numElems>0)
+	{	newMpts = new (nothrow) MPMBase *[numElems*ptsPerElement];
+		if(newMpts==NULL)
+			throw SAXException(XYFileError("Out of memory creating material points for image volume.",bmpFileName));
+		for(int p=0;p<numElems*ptsPerElement;p++) newMpts[p] = NULL;
+	}
+	CommonException *volErr = NULL;
+	
+#pragma omp parallel
+	{	vector<double> levelWeights(numLevels);
+		Vector mpos[MaxElParticles];
+		VolumeMap map;
+		
+#pragma omp for
+		for(int e=0;e<numElems;e++)
+		{	try
+			{	ElementBase *elem=theElements[volumeElems[e]];
+				
+				// load point coordinates
+				elem->MPMPoints(ptsPerElement,mpos);
+				
+				// particle size within volume of the element
+				Vector del;
+				del.x=elem->GetDeltaX()/semiscale;
+				del.y=elem->GetDeltaY()/semiscale;
+				del.z=elem->GetDeltaZ()/semiscale;
+				
+				for(int k=0;k<ptsPerElement;k++)
+				{	int ptFlag=1<<k;
+					
+					// skip if already filled, not in the volume, or no material near the point
+					if(elem->filled&ptFlag) continue;
+					if(!volume->MapDomain(&mpos[k],&del,map)) continue;
+					if(!volume->HasOccupiedBlocks(map)) continue;
+					
+					// find level and its material ID or none (empty space is not marked as filled)
+					BMPLevel *level = volume->FindLevel(&levels[0],numLevels,map,volumeRule,volumeSample,&levelWeights[0]);
+					if(level==NULL) continue;
+					int matID = level->Material();
+					if(matID<=0) continue;
+					
+					MPMBase *newMpt=new MatPoint3D(volumeElems[e]+1,matID,level->angle);
+					newMpt->SetPosition(&mpos[k]);
+					newMpt->SetOrigin(&mpos[k]);
+					newMpt->SetVelocity(&level->vel);
+					newMpt->SetDimensionlessByPts(ptsPerElement);
+					newMpt->SetConcentration(level->concentration,DiffusionTask::reference);
+					newMpt->SetTemperature(level->temperature,thermal.reference);
+					
+					// is there an angle volume too?
+					if(setAngles)
+					{	double matAngle[3];
+						for(int i=0;i<fileRotations;i++)
+						{	double totalIntensity = angleVolumes[i]->FindAverageValue(map,volumeSample);
+							matAngle[i] = minAngle[i]+(totalIntensity-minIntensity[i])*angleScale[i];
+						}
+						SetMptAnglesFromFunctions(angleAxes,matAngle,&mpos[k],newMpt);
+					}
+					else
+					{	// If had Rotate commands then use them
+						SetMptAnglesFromFunctions(rotationAxes,NULL,&mpos[k],newMpt);
+					}
+					
+					// fill the spot
+					newMpts[e*ptsPerElement+k] = newMpt;
+					elem->filled|=ptFlag;
+				}
+			}
+			catch(...)
+			{	if(volErr==NULL)
+				{
+#pragma omp critical (error)
+					volErr = new CommonException("Unexpected error creating particles from image volume","MPMReadHandler::TranslateVolumeFiles");
+				}
+			}
+		}
+	}
+	
+	// add points in element order
+	int numNew = 0;
+	for(int p=0;p<numElems*ptsPerElement;p++)
+	{	if(newMpts[p]!=NULL) newMpts[numNew++] = newMpts[p];
+	}
+	if(volErr==NULL)
+		mpCtrl->AddMaterialPoints(newMpts,numNew);
+	else
+	{	for(int p=0;p<numNew;p++) delete newMpts[p];
+	}
+	if(newMpts!=NULL) delete [] newMpts;
+	
+	// clean up
+	delete volume;
+	for(int i=0;i<3;i++)
+	{	if(angleVolumes[i]!=NULL) delete angleVolumes[i];
+	}
+	for(int ii=0;ii<numRotations;ii++)
+	{	delete [] angleExpr[ii];
+	}
+	Expression::DeleteFunction(-1);
+	
+	if(volErr!=NULL) throw *volErr;
+}
+
 // set current intensity velocity
 void MPMReadHandler::SetLevelVelocity(double vx,double vy,double vz)
 {
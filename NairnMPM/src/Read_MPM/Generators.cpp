@@ -25,6 +25,7 @@
 #include "Boundary_Conditions/MatPtTractionBC.hpp"
 #include "Global_Quantities/ThermalRamp.hpp"
 #include "Exceptions/StrX.hpp"
+#include "Exceptions/CommonException.hpp"
 #include "Read_XML/ArcController.hpp"
 #include "Read_XML/RectController.hpp"
 #include "Read_XML/OvalController.hpp"
@@ -78,6 +79,8 @@ enum { LINE_SHAPE=0,CIRCLE_SHAPE };		// shape for generating crack segments, Lip
 
 // Function prototypes
 void swap(double&,double&,double&,double&,double&,double&);
+double GridFirstCell(double,int,double);
+void GridAxisEdges(vector< double > &,double,double,int,double,double,double);
 
 // throws std::bad_alloc, SAXException()
 short MPMReadHandler::GenerateInput(char *xName,const Attributes& attrs)
@@ -1219,15 +1222,53 @@ void MPMReadHandler::MPMPts(void)
 		}
 	}
 
-    try
-    {   for(i=1;i<=nelems;i++)
-		{	theElements[i-1]->MPMPoints(fmobj->ptsPerElement,ppos);
-            for(k=0;k<fmobj->ptsPerElement;k++)
+	// elements that might have points in the shape (all elements if shape is unbounded)
+	vector<int> shapeElems;
+	Vector bmin,bmax;
+	theShape->GetBoundingBox(&bmin,&bmax);
+	if(mpmgrid.IsStructuredGrid())
+	{	int emin[3],emax[3],row,zrow,col;
+		if(mpmgrid.FindElementRangeInBox(&bmin,&bmax,emin,emax))
+		{	int horiz,vert,depth;
+			mpmgrid.GetGridPoints(&horiz,&vert,&depth);
+			horiz--;
+			vert--;
+			for(zrow=emin[2];zrow<=emax[2];zrow++)
+			{	for(row=emin[1];row<=emax[1];row++)
+				{	for(col=emin[0];col<=emax[0];col++)
+						shapeElems.push_back(horiz*(zrow*vert+row)+col);
+				}
+			}
+		}
+	}
+	else
+	{	for(i=0;i<nelems;i++) shapeElems.push_back(i);
+	}
+	
+	// create points in parallel, each into its own slot so final order matches element order
+	int numElems = (int)shapeElems.size();
+	int ptsPerElement = fmobj->ptsPerElement;
+	MPMBase **newMpts = NULL;
+	if(MatID>0 && numElems>0)
+	{	newMpts = new (nothrow) MPMBase *[numElems*ptsPerElement];
+		if(newMpts==NULL) throw SAXException("Memory error creating material points in a shape.");
+		for(i=0;i<numElems*ptsPerElement;i++) newMpts[i] = NULL;
+	}
+	const char *ptErr = NULL;
+	CommonException *xErr = NULL;
+	
+#pragma omp parallel for private(ppos,newMpt,k,ptFlag)
+	for(int e=0;e<numElems;e++)
+	{	try
+		{	int iel = shapeElems[e];
+			theElements[iel]->MPMPoints(ptsPerElement,ppos);
+			ptFlag = 0;
+            for(k=0;k<ptsPerElement;k++)
             {   // if particle size is already used, then go to next location
                 // this check is skipped when creating shifted and/or deformed particles
                 if(!isDeformed)
                 {	ptFlag=1<<k;
-                    if(theElements[i-1]->filled&ptFlag) continue;
+                    if(theElements[iel]->filled&ptFlag) continue;
                 }
                 
                 // check if particle is in the shape
@@ -1236,32 +1277,33 @@ void MPMReadHandler::MPMPts(void)
                     // for Hole (MatID<=0), just set the point flag
                 	if(MatID>0)
                     {	if(fmobj->IsThreeD())
-                            newMpt=new MatPoint3D(i,MatID,Angle);
+                            newMpt=new MatPoint3D(iel+1,MatID,Angle);
                         else if(fmobj->IsAxisymmetric())
-                            newMpt=new MatPointAS(i,MatID,Angle,ppos[k].x);
+                            newMpt=new MatPointAS(iel+1,MatID,Angle,ppos[k].x);
                         else
-                            newMpt=new MatPoint2D(i,MatID,Angle,Thick);
+                            newMpt=new MatPoint2D(iel+1,MatID,Angle,Thick);
                         newMpt->SetPosition(&ppos[k]);
                         newMpt->SetOrigin(&ppos[k]);
- 						newMpt->SetDimensionlessByPts(fmobj->ptsPerElement);
+ 						newMpt->SetDimensionlessByPts(ptsPerElement);
  						
 						// velocity
+						Vector pVel = Vel;
 						if(hasVelOrLp)
-						{	fnum=numRotations;
+						{	int vnum=numRotations;
 							if(vel0Expr[0]!=NULL)
-							{	fnum++;
-								Vel.x=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	vnum++;
+								pVel.x=Expression::FunctionValue(vnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 							if(vel0Expr[1]!=NULL)
-							{	fnum++;
-								Vel.y=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	vnum++;
+								pVel.y=Expression::FunctionValue(vnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 							if(vel0Expr[2]!=NULL)
-							{	fnum++;
-								Vel.z=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	vnum++;
+								pVel.z=Expression::FunctionValue(vnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 						}
-                        newMpt->SetVelocity(&Vel);
+                        newMpt->SetVelocity(&pVel);
 						
 						// custom angles
                         SetMptAnglesFromFunctions(rotationAxes,NULL,&ppos[k],newMpt);
@@ -1270,18 +1312,18 @@ void MPMReadHandler::MPMPts(void)
 						if(isDeformed)
 						{	Vector moved;
 							ZeroVector(&moved);
-							fnum = firstTranslate;
+							int tnum = firstTranslate;
 							if(initTranslate[0]!=NULL)
-							{	fnum++;
-								moved.x=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	tnum++;
+								moved.x=Expression::FunctionValue(tnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 							if(initTranslate[1]!=NULL)
-							{	fnum++;
-								moved.y=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	tnum++;
+								moved.y=Expression::FunctionValue(tnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 							if(initTranslate[2]!=NULL)
-							{	fnum++;
-								moved.z=Expression::FunctionValue(fnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
+							{	tnum++;
+								moved.z=Expression::FunctionValue(tnum,ppos[k].x,ppos[k].y,ppos[k].z,0.,0.,0.);
 							}
 							AddVector(&moved,&ppos[k]);
 							newMpt->SetPosition(&moved);
@@ -1289,28 +1331,63 @@ void MPMReadHandler::MPMPts(void)
 							
 							// reset element, but delete if not in the grid
 							int status = ResetElementsTask::ResetElement(newMpt);
-							if(status==LEFT_GRID) continue;
+							if(status==LEFT_GRID)
+							{	delete newMpt;
+								continue;
+							}
 							newMpt->SetElementCrossings(0);		// in case in new element
 							
 							// set deformation gradient
 							newMpt->SetDeformationGradientMatrix(initDeformation);
 						}
 						
-						// add the point
-                        mpCtrl->AddMaterialPoint(newMpt,pConc,pTempSet);
+						// save in this point's slot
+						newMpts[e*ptsPerElement+k] = newMpt;
                     }
                     
                     // mark as filled (note that ptFlag will be zero for deformed particles and therefore
                     // no change occurs)
-                    theElements[i-1]->filled|=ptFlag;
+                    theElements[iel]->filled|=ptFlag;
                 }
             }
         }
-    }
-    catch(const char *msg)
-    {   throw SAXException(msg);
+		catch(const char *msg)
+		{	if(ptErr==NULL)
+			{
+#pragma omp critical (error)
+				ptErr = msg;
+			}
+		}
+		catch(CommonException& err)
+		{	if(xErr==NULL)
+			{
+#pragma omp critical (error)
+				xErr = new CommonException(err);
+			}
+		}
+		catch(...)
+		{	if(xErr==NULL)
+			{
+#pragma omp critical (error)
+				xErr = new CommonException("Unexpected error","MPMReadHandler::MPMPts");
+			}
+		}
     }
 	
+	// add points in element order (or delete them if there was an error)
+	if(newMpts!=NULL)
+	{	for(i=0;i<numElems*ptsPerElement;i++)
+		{	if(newMpts[i]==NULL) continue;
+			if(ptErr==NULL && xErr==NULL)
+				mpCtrl->AddMaterialPoint(newMpts[i],pConc,pTempSet);
+			else
+				delete newMpts[i];
+		}
+		delete [] newMpts;
+	}
+	if(ptErr!=NULL) throw SAXException(ptErr);
+	if(xErr!=NULL) throw *xErr;
+	
 	// remove created functions (angleExpr deleted later)
 	Expression::DeleteFunction(-1);
 	
@@ -1426,6 +1503,13 @@ void MPMReadHandler::grid()
 	if(Nhoriz<1 || Nvert<1 || (Ndepth<1 && is3D))
 		throw SAXException("Number of grid elements in all direction must be >= 1.");
 	
+	// graded elements need number of elements
+	if((cellHoriz>0. && !DbleEqual(Rhoriz,1.)) || (cellVert>0. && !DbleEqual(Rvert,1.))
+	   		|| (cellDepth>0. && is3D && !DbleEqual(Rdepth,1.)))
+		throw SAXException("Grid axis with graded elements (rx, ry, or rz) must set number of elements instead of cellsize.");
+	if(Rhoriz<=0. || Rvert<=0. || (is3D && Rdepth<=0.))
+		throw SAXException("Grid element size ratios (rx, ry, and rz) must be positive.");
+	
 	// save the limits before extra GIMP layer
 	mxmin=Xmin;
 	mxmax=Xmax;
@@ -1434,24 +1518,30 @@ void MPMReadHandler::grid()
 	mzmin=Zmin;
 	mzmax=Zmax;
 	
-	// allow for GIMP
+	// allow for GIMP (extra elements match size of first and last elements)
 	if(ElementBase::useGimp != POINT_GIMP)
-	{	double cell=(Xmax-Xmin)/(double)Nhoriz;
+	{	double cell=GridFirstCell(Xmax-Xmin,Nhoriz,Rhoriz);
 		Nhoriz+=2;
 		Xmin-=cell;
-		Xmax+=cell;
-		cell=(Ymax-Ymin)/(double)Nvert;
+		Xmax+=Rhoriz*cell;
+		cell=GridFirstCell(Ymax-Ymin,Nvert,Rvert);
 		Ymin-=cell;
-		Ymax+=cell;
+		Ymax+=Rvert*cell;
 		Nvert+=2;
 		if(is3D)
-		{	cell=(Zmax-Zmin)/(double)Ndepth;
+		{	cell=GridFirstCell(Zmax-Zmin,Ndepth,Rdepth);
 			Zmin-=cell;
-			Zmax+=cell;
+			Zmax+=Rdepth*cell;
 			Ndepth+=2;
 		}
 	}
 	
+	// node locations along each axis
+	vector< double > xedges,yedges,zedges;
+	GridAxisEdges(xedges,Xmin,Xmax,Nhoriz,Rhoriz,mxmin,mxmax);
+	GridAxisEdges(yedges,Ymin,Ymax,Nvert,Rvert,mymin,mymax);
+	if(is3D) GridAxisEdges(zedges,Zmin,Zmax,Ndepth,Rdepth,mzmin,mzmax);
+	
 	double zparam,gridz = 0.;
 	if(DbleEqual(Rhoriz,1.) && DbleEqual(Rvert,1.) && (!is3D || DbleEqual(Rdepth,1.)))
 	{   // Orthogonal, and all elements are the same size
@@ -1518,12 +1608,11 @@ void MPMReadHandler::grid()
 	if(is3D)
 	{	// create the nodes: vary x first, then y, last z
 		for(k=0;k<=Ndepth;k++)
-		{	zpt=Zmin+(double)k*(Zmax-Zmin)/(double)Ndepth;
+		{	zpt=zedges[k];
 			for(j=0;j<=Nvert;j++)
-			{	ypt=Ymin+(double)j*(Ymax-Ymin)/(double)Nvert;
+			{	ypt=yedges[j];
 				for(i=0;i<=Nhoriz;i++)
-				{	xpt=Xmin+(double)i*(Xmax-Xmin)/(double)Nhoriz;
-					zpt=Zmin+(double)k*(Zmax-Zmin)/(double)Ndepth;
+				{	xpt=xedges[i];
 					node=k*(Nhoriz+1)*(Nvert+1)+j*(Nhoriz+1)+(i+1);
 					nd[curPt] = NodalPoint::Create3DNode(node,xpt,ypt,zpt);
 					curPt++;
@@ -1554,9 +1643,9 @@ void MPMReadHandler::grid()
 	else if(mpm2DElement==FOUR_NODE_ISO)
 	{	// create the nodes vary x first, y second
 		for(j=0;j<=Nvert;j++)
-		{	ypt=Ymin+(double)j*(Ymax-Ymin)/(double)Nvert;
+		{	ypt=yedges[j];
 			for(i=0;i<=Nhoriz;i++)
-			{	xpt=Xmin+(double)i*(Xmax-Xmin)/(double)Nhoriz;
+			{	xpt=xedges[i];
 				node=j*(Nhoriz+1)+(i+1);
 				nd[curPt] = NodalPoint::Create2DNode(node,xpt,ypt);
 				curPt++;
@@ -1610,6 +1699,42 @@ void MPMReadHandler::grid()
 	}
 }
 
+// Size of first of num elements spanning length when element sizes grow geometrically
+//   such that the last element is ratio times the first one
+double GridFirstCell(double length,int num,double ratio)
+{
+	if(DbleEqual(ratio,1.) || num<2) return length/(double)num;
+	double q = pow(ratio,1./(double)(num-1));
+	return length*(q-1.)/(pow(q,(double)num)-1.);
+}
+
+// Fill edges with num+1 node locations from amin to amax along one grid axis
+// If ratio is not 1, elements from gmin to gmax are graded (see GridFirstCell()) and
+//   any elements outside that range are the extra GIMP layer
+void GridAxisEdges(vector< double > &edges,double amin,double amax,int num,double ratio,double gmin,double gmax)
+{
+	edges.resize(num+1);
+	if(DbleEqual(ratio,1.))
+	{	for(int i=0;i<=num;i++)
+			edges[i]=amin+(double)i*(amax-amin)/(double)num;
+		return;
+	}
+	
+	// graded elements
+	int first = amin<gmin ? 1 : 0;
+	int numGraded = amin<gmin ? num-2 : num;
+	double q = numGraded>1 ? pow(ratio,1./(double)(numGraded-1)) : 1.;
+	double cell = GridFirstCell(gmax-gmin,numGraded,ratio);
+	edges[0]=amin;
+	edges[first]=gmin;
+	for(int i=first+1;i<first+numGraded;i++)
+	{	edges[i]=edges[i-1]+cell;
+		cell*=q;
+	}
+	edges[first+numGraded]=gmax;
+	edges[num]=amax;
+}
+
 //-----------------------------------------------------------
 // Make sure axisymmetric has r=0 BCs
 //-----------------------------------------------------------
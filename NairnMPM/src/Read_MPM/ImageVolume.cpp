@@ -0,0 +1,528 @@
+/********************************************************************************
+	ImageVolume.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Read_MPM/ImageVolume.hpp"
+#include "Read_XML/CommonReadHandler.hpp"
+#include "Read_XML/BMPLevel.hpp"
+#ifndef WINDOWS_EXE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define WEIGHT_TOL 1.e-10
+#define OCCUPIED_BLOCK 8
+
+#pragma mark ImageVolume: Constructors and Destructors
+
+// Open and map the volume file
+// throws SAXException()
+ImageVolume::ImageVolume(const char *filePath)
+{
+	fullPath = new char[strlen(filePath)+1];
+	strcpy(fullPath,filePath);
+	data = NULL;
+	dataLength = 0;
+	mapped = false;
+	width = height = depth = 0;
+	rowsPerStrip = stripsPerSlice = 0;
+	orig = MakeVector(0.,0.,0.);
+	pw = MakeVector(1.,1.,1.);
+	flipped = false;
+	blockSize = OCCUPIED_BLOCK;
+	numBlocks[0] = numBlocks[1] = numBlocks[2] = 0;
+	bigEndian = false;
+	MapFile();
+}
+
+// Destructor
+ImageVolume::~ImageVolume()
+{
+	if(data!=NULL)
+	{
+#ifdef WINDOWS_EXE
+		free(data);
+#else
+		if(mapped) munmap(data,(size_t)dataLength);
+#endif
+	}
+	if(fullPath!=NULL) delete [] fullPath;
+}
+
+// Map the file read only (or read it all on Windows)
+// throws SAXException()
+void ImageVolume::MapFile(void)
+{
+#ifdef WINDOWS_EXE
+	FILE *fp = fopen(fullPath,"rb");
+	if(fp==NULL)
+		VolumeError("The image volume file could not be opened.");
+	if(fseek(fp,0L,SEEK_END)==0)
+		dataLength = ftell(fp);
+	rewind(fp);
+	if(dataLength>0)
+	{	data = (unsigned char *)malloc(dataLength);
+		if(data==NULL)
+		{	fclose(fp);
+			VolumeError("Out of memory reading the image volume file.");
+		}
+		if(fread(data,dataLength,1,fp)!=1)
+		{	fclose(fp);
+			VolumeError("The image volume file could not be read.");
+		}
+	}
+	fclose(fp);
+#else
+	int fd = open(fullPath,O_RDONLY);
+	if(fd<0)
+		VolumeError("The image volume file could not be opened.");
+	struct stat fileStat;
+	if(fstat(fd,&fileStat)!=0)
+	{	close(fd);
+		VolumeError("The image volume file size could not be found.");
+	}
+	dataLength = (long)fileStat.st_size;
+	if(dataLength>0)
+	{	void *mapAddr = mmap(NULL,(size_t)dataLength,PROT_READ,MAP_PRIVATE,fd,0);
+		if(mapAddr==MAP_FAILED)
+		{	close(fd);
+			VolumeError("The image volume file could not be memory mapped.");
+		}
+		data = (unsigned char *)mapAddr;
+		mapped = true;
+	}
+	close(fd);
+#endif
+
+	if(data==NULL)
+		VolumeError("The image volume file is empty.");
+}
+
+#pragma mark ImageVolume: Methods
+
+// Raw volume with given voxels and header bytes to skip
+// throws SAXException()
+void ImageVolume::SetRawVolume(int nx,int ny,int nz,long headerBytes)
+{
+	if(nx<1 || ny<1 || nz<1)
+		VolumeError("Raw image volumes must specify voxels in all three directions.");
+	if(headerBytes<0)
+		VolumeError("Raw image volume header length cannot be negative.");
+	width = nx;
+	height = ny;
+	depth = nz;
+	long sliceBytes = (long)width*(long)height;
+	if(dataLength < headerBytes + sliceBytes*(long)depth)
+		VolumeError("The raw image volume file is smaller than its number of voxels.");
+
+	// each slice is one strip
+	rowsPerStrip = height;
+	stripsPerSlice = 1;
+	strips.resize(depth);
+	for(int slice=0;slice<depth;slice++)
+		strips[slice] = data + headerBytes + sliceBytes*(long)slice;
+}
+
+// Find slices and strips in a multi-page TIFF file
+// throws SAXException()
+void ImageVolume::ReadTIFFStack(void)
+{
+	if(dataLength<8)
+		VolumeError("The TIFF file is too short to have a header.");
+	if(data[0]=='I' && data[1]=='I')
+		bigEndian = false;
+	else if(data[0]=='M' && data[1]=='M')
+		bigEndian = true;
+	else
+		VolumeError("The TIFF file does not have a valid byte order.");
+	if(ReadTIFFUnsigned(2,2)!=42)
+		VolumeError("The file is not a TIFF file or is a BigTIFF file (not supported).");
+
+	long ifd = (long)ReadTIFFUnsigned(4,4);
+	while(ifd!=0)
+	{	if(ifd+2>dataLength)
+			VolumeError("The TIFF file has an invalid directory offset.");
+		int numEntries = (int)ReadTIFFUnsigned(ifd,2);
+		if(ifd+6+12*numEntries>dataLength)
+			VolumeError("The TIFF file has an incomplete directory.");
+
+		// read needed tags
+		int pageWidth=0,pageHeight=0,bits=1,compression=1,samples=1,photometric=1;
+		unsigned int pageRowsPerStrip=0xFFFFFFFF;
+		long offsetsPos=0,countsPos=0;
+		int offsetsType=0,countsType=0,numStrips=0,numCounts=0;
+		for(int i=0;i<numEntries;i++)
+		{	long entry = ifd+2+12*i;
+			int tag = (int)ReadTIFFUnsigned(entry,2);
+			int type = (int)ReadTIFFUnsigned(entry+2,2);
+			int count = (int)ReadTIFFUnsigned(entry+4,4);
+
+			// values are in place if they fit in 4 bytes
+			int typeSize = type==3 ? 2 : (type==4 ? 4 : 1);
+			long valuePos = entry+8;
+			if((long)count*typeSize>4) valuePos = (long)ReadTIFFUnsigned(entry+8,4);
+			if(valuePos+(long)count*typeSize>dataLength)
+				VolumeError("The TIFF file has a directory entry outside the file.");
+
+			switch(tag)
+			{	case 256:
+					pageWidth = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 257:
+					pageHeight = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 258:
+					bits = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 259:
+					compression = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 262:
+					photometric = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 273:
+					offsetsPos = valuePos;
+					offsetsType = type;
+					numStrips = count;
+					break;
+				case 277:
+					samples = (int)ReadTIFFValue(valuePos,type,0);
+					break;
+				case 278:
+					pageRowsPerStrip = ReadTIFFValue(valuePos,type,0);
+					break;
+				case 279:
+					countsPos = valuePos;
+					countsType = type;
+					numCounts = count;
+					break;
+				case 322:
+					VolumeError("Tiled TIFF files are not supported for image volumes.");
+					break;
+				default:
+					break;
+			}
+		}
+
+		// check this page
+		if(pageWidth<1 || pageHeight<1)
+			VolumeError("A TIFF page is missing its width or height.");
+		if(bits!=8 || samples!=1 || photometric!=1)
+			VolumeError("TIFF image volumes must be 8 bit gray scale with black as zero.");
+		if(compression!=1)
+			VolumeError("TIFF image volumes must not be compressed.");
+		if(pageRowsPerStrip>(unsigned int)pageHeight) pageRowsPerStrip = pageHeight;
+		int pageStrips = (pageHeight+(int)pageRowsPerStrip-1)/(int)pageRowsPerStrip;
+		if(numStrips!=pageStrips || numCounts!=pageStrips)
+			VolumeError("A TIFF page does not have the expected number of strips.");
+		if(depth==0)
+		{	width = pageWidth;
+			height = pageHeight;
+			rowsPerStrip = (int)pageRowsPerStrip;
+			stripsPerSlice = pageStrips;
+		}
+		else if(pageWidth!=width || pageHeight!=height || (int)pageRowsPerStrip!=rowsPerStrip)
+			VolumeError("All pages in a TIFF image volume must have the same size and strips.");
+
+		// pages cannot take less space than their voxels (and prevents directory loops)
+		if((long)(depth+1)*(long)width*(long)height>dataLength)
+			VolumeError("The TIFF file has more pages than fit in the file.");
+
+		// save strips
+		for(int s=0;s<pageStrips;s++)
+		{	long offset = (long)ReadTIFFValue(offsetsPos,offsetsType,s);
+			long bytes = (long)ReadTIFFValue(countsPos,countsType,s);
+			int rows = rowsPerStrip;
+			if((s+1)*rowsPerStrip>height) rows = height-s*rowsPerStrip;
+			long needed = (long)rows*(long)width;
+			if(bytes<needed || offset+needed>dataLength)
+				VolumeError("A TIFF strip is too short or outside the file.");
+			strips.push_back(data+offset);
+		}
+		depth++;
+
+		// next page
+		ifd = (long)ReadTIFFUnsigned(ifd+2+12*numEntries,4);
+	}
+
+	if(depth==0)
+		VolumeError("The TIFF file has no pages.");
+}
+
+// Set origin, voxel size, and whether rows start at the bottom
+void ImageVolume::SetGeometry(Vector volOrig,Vector voxelSize,bool rowsFlipped)
+{	orig = volOrig;
+	pw = voxelSize;
+	flipped = rowsFlipped;
+}
+
+// Find voxels under particle domain with semi lengths in del (as in CommonReadHandler::MapDomainToImage())
+// Return false if the particle is not in the volume
+bool ImageVolume::MapDomain(Vector *spot,Vector *del,VolumeMap &map) const
+{
+	double pt[3] = {spot->x,spot->y,spot->z};
+	double semi[3] = {del->x,del->y,del->z};
+	double start[3] = {orig.x,orig.y,orig.z};
+	double size[3] = {pw.x,pw.y,pw.z};
+	int num[3] = {width,height,depth};
+
+	for(int ax=0;ax<3;ax++)
+	{	// particle must be in the volume
+		if(pt[ax]<start[ax] || pt[ax]>=start[ax]+size[ax]*(double)num[ax]) return false;
+
+		double vmin = (pt[ax]-semi[ax]-start[ax])/size[ax];
+		double vmax = (pt[ax]+semi[ax]-start[ax])/size[ax];
+		map.v1[ax] = CommonReadHandler::BMPIndex(vmin,num[ax]);
+		map.v2[ax] = CommonReadHandler::BMPIndex(vmax,num[ax]);
+		if(map.v2[ax]==map.v1[ax])
+		{	// a single voxel
+			map.wt1[ax] = map.wt2[ax] = 1.;
+			continue;
+		}
+
+		// fractional weight for first and last voxel (at most 1 when domain extends past the volume)
+		map.wt1[ax] = fmin((double)(map.v1[ax]+1)-vmin,1.);
+		map.wt2[ax] = fmin(vmax-(double)map.v2[ax],1.);
+
+		// ignore excellent alignment
+		if(map.wt1[ax]<WEIGHT_TOL)
+		{	map.v1[ax]++;
+			map.wt1[ax] = 1.;
+		}
+		if(map.wt2[ax]<WEIGHT_TOL && map.v2[ax]>map.v1[ax])
+		{	map.v2[ax]--;
+			map.wt2[ax] = 1.;
+		}
+	}
+	return true;
+}
+
+// Find level for voxels in a domain (as in CommonReadHandler::FindBMPLevel()) using rule
+//    VOLUME_MAJORITY - level with largest voxel weight
+//    VOLUME_AVERAGE - level for the weighted average intensity
+// Levels are in an array and weights must have numLevels elements (so it is thread safe)
+// Sample every sample voxels along each axis (1 to use all voxels)
+// Return NULL if no voxels
+BMPLevel *ImageVolume::FindLevel(BMPLevel **levels,int numLevels,const VolumeMap &map,int rule,int sample,double *weights) const
+{
+	if(rule==VOLUME_AVERAGE)
+	{	double intensity = FindAverageValue(map,sample)+0.5;
+		if(intensity<0.) intensity = 0.;
+		if(intensity>255.) intensity = 255.;
+		return LevelForIntensity(levels,numLevels,(unsigned char)intensity);
+	}
+
+	// clear level weights
+	int lev;
+	for(lev=0;lev<numLevels;lev++) weights[lev] = 0.;
+
+	// add weights
+	double sweight,rweight,weight;
+	for(int slice=map.v1[2];slice<=map.v2[2];slice+=sample)
+	{	sweight = slice==map.v1[2] ? map.wt1[2] : (slice==map.v2[2] ? map.wt2[2] : 1.);
+		for(int row=map.v1[1];row<=map.v2[1];row+=sample)
+		{	rweight = sweight*(row==map.v1[1] ? map.wt1[1] : (row==map.v2[1] ? map.wt2[1] : 1.));
+			const unsigned char *voxels = Row(slice,flipped ? row : height-1-row);
+			for(int col=map.v1[0];col<=map.v2[0];col+=sample)
+			{	weight = rweight*(col==map.v1[0] ? map.wt1[0] : (col==map.v2[0] ? map.wt2[0] : 1.));
+
+				// first level with this intensity
+				for(lev=0;lev<numLevels;lev++)
+				{	if(levels[lev]->Material(voxels[col])>=0)
+					{	weights[lev] += weight;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// find level with maximum weight (same rules as BMPLevel::MaximumWeight())
+	weight = 0.;
+	BMPLevel *maxLevel = NULL;
+	for(lev=0;lev<numLevels;lev++)
+	{	if(weights[lev]>weight)
+		{	if(levels[lev]->Material()!=0 || fabs(weights[lev]-weight)>1.e-10)
+			{	weight = weights[lev];
+				maxLevel = levels[lev];
+			}
+		}
+	}
+	return maxLevel;
+}
+
+// Weighted average voxel value in a domain (as in CommonReadHandler::FindAverageValue())
+double ImageVolume::FindAverageValue(const VolumeMap &map,int sample) const
+{
+	double totalIntensity = 0.;
+	double totalWeight = 0.;
+
+	double sweight,rweight,weight;
+	for(int slice=map.v1[2];slice<=map.v2[2];slice+=sample)
+	{	sweight = slice==map.v1[2] ? map.wt1[2] : (slice==map.v2[2] ? map.wt2[2] : 1.);
+		for(int row=map.v1[1];row<=map.v2[1];row+=sample)
+		{	rweight = sweight*(row==map.v1[1] ? map.wt1[1] : (row==map.v2[1] ? map.wt2[1] : 1.));
+			const unsigned char *voxels = Row(slice,flipped ? row : height-1-row);
+			for(int col=map.v1[0];col<=map.v2[0];col+=sample)
+			{	weight = rweight*(col==map.v1[0] ? map.wt1[0] : (col==map.v2[0] ? map.wt2[0] : 1.));
+				totalIntensity += weight*voxels[col];
+				totalWeight += weight;
+			}
+		}
+	}
+
+	if(totalWeight>0.) totalIntensity /= totalWeight;
+	return totalIntensity;
+}
+
+// Mark blocks of voxels that have any voxel mapped to a material. Particles whose domain
+// covers no such blocks cannot get a material by majority rule and are skipped without
+// looking at their voxels
+void ImageVolume::FindOccupiedBlocks(BMPLevel **levels,int numLevels)
+{
+	// material flag for each intensity
+	unsigned char hasMat[256];
+	for(int i=0;i<256;i++)
+	{	BMPLevel *level = LevelForIntensity(levels,numLevels,(unsigned char)i);
+		hasMat[i] = (level!=NULL && level->Material()>0) ? 1 : 0;
+	}
+
+	numBlocks[0] = (width+blockSize-1)/blockSize;
+	numBlocks[1] = (height+blockSize-1)/blockSize;
+	numBlocks[2] = (depth+blockSize-1)/blockSize;
+	occupied.assign((long)numBlocks[0]*(long)numBlocks[1]*(long)numBlocks[2],0);
+
+	// each block layer is done by one thread
+#pragma omp parallel for
+	for(int bz=0;bz<numBlocks[2];bz++)
+	{	int lastSlice = (bz+1)*blockSize<depth ? (bz+1)*blockSize : depth;
+		for(int slice=bz*blockSize;slice<lastSlice;slice++)
+		{	for(int row=0;row<height;row++)
+			{	const unsigned char *voxels = Row(slice,row);
+				int by = (flipped ? row : height-1-row)/blockSize;
+				unsigned char *blockRow = &occupied[((long)bz*numBlocks[1]+by)*numBlocks[0]];
+				for(int col=0;col<width;col++)
+				{	if(hasMat[voxels[col]]) blockRow[col/blockSize] = 1;
+				}
+			}
+		}
+	}
+}
+
+// true if any block under the domain has material (or blocks were not found)
+bool ImageVolume::HasOccupiedBlocks(const VolumeMap &map) const
+{
+	if(occupied.size()==0) return true;
+	for(int bz=map.v1[2]/blockSize;bz<=map.v2[2]/blockSize;bz++)
+	{	for(int by=map.v1[1]/blockSize;by<=map.v2[1]/blockSize;by++)
+		{	const unsigned char *blockRow = &occupied[((long)bz*numBlocks[1]+by)*numBlocks[0]];
+			for(int bx=map.v1[0]/blockSize;bx<=map.v2[0]/blockSize;bx++)
+			{	if(blockRow[bx]) return true;
+			}
+		}
+	}
+	return false;
+}
+
+#pragma mark ImageVolume: Accessors
+
+int ImageVolume::Width(void) const { return width; }
+int ImageVolume::Height(void) const { return height; }
+int ImageVolume::Depth(void) const { return depth; }
+
+// true if other volume has same voxels
+bool ImageVolume::SameSize(const ImageVolume *other) const
+{	return width==other->width && height==other->height && depth==other->depth;
+}
+
+// pointer to voxels in a row of a slice (row in file order)
+const unsigned char *ImageVolume::Row(int slice,int row) const
+{	return strips[slice*stripsPerSlice+row/rowsPerStrip] + (long)(row%rowsPerStrip)*(long)width;
+}
+
+// read 2 or 4 byte unsigned value in file byte order
+unsigned int ImageVolume::ReadTIFFUnsigned(long pos,int numBytes) const
+{
+	unsigned int value = 0;
+	for(int i=0;i<numBytes;i++)
+	{	unsigned int b = bigEndian ? data[pos+i] : data[pos+numBytes-1-i];
+		value = (value<<8) | b;
+	}
+	return value;
+}
+
+// read element of array of BYTE (1), SHORT (3), or LONG (4) values
+unsigned int ImageVolume::ReadTIFFValue(long pos,int type,int index) const
+{
+	if(type==3)
+		return ReadTIFFUnsigned(pos+2*index,2);
+	else if(type==4)
+		return ReadTIFFUnsigned(pos+4*index,4);
+	return data[pos+index];
+}
+
+// Throw error with the file name after releasing the mapping
+// throws SAXException()
+void ImageVolume::VolumeError(const char *msg)
+{
+	char *error = new char[strlen(msg)+strlen(fullPath)+10];
+	sprintf(error,"%s (file: %s)",msg,fullPath);
+	if(data!=NULL)
+	{
+#ifdef WINDOWS_EXE
+		free(data);
+#else
+		if(mapped) munmap(data,(size_t)dataLength);
+#endif
+		data = NULL;
+	}
+	delete [] fullPath;
+	fullPath = NULL;
+	throw SAXException(error);
+}
+
+#pragma mark ImageVolume: Class Methods
+
+// true if file extension is a volume file type (raw, tif, or tiff)
+bool ImageVolume::IsVolumeFile(const char *fileName)
+{
+	char ext[11];
+	GetFileExtension(fileName,ext,10);
+	return CIstrcmp(ext,"raw")==0 || CIstrcmp(ext,"tif")==0 || CIstrcmp(ext,"tiff")==0;
+}
+
+// Open a volume file (raw files need voxels[] and header length)
+// throws SAXException()
+ImageVolume *ImageVolume::OpenVolume(const char *filePath,int *voxels,long headerBytes)
+{
+	ImageVolume *volume = new ImageVolume(filePath);
+	try
+	{	char ext[11];
+		GetFileExtension(filePath,ext,10);
+		if(CIstrcmp(ext,"raw")==0)
+			volume->SetRawVolume(voxels[0],voxels[1],voxels[2],headerBytes);
+		else
+			volume->ReadTIFFStack();
+	}
+	catch(...)
+	{	delete volume;
+		throw;
+	}
+	return volume;
+}
+
+// first level in array of levels with this intensity or NULL if none
+BMPLevel *ImageVolume::LevelForIntensity(BMPLevel **levels,int numLevels,unsigned char intensity)
+{
+	for(int lev=0;lev<numLevels;lev++)
+	{	if(levels[lev]->Material(intensity)>=0) return levels[lev];
+	}
+	return NULL;
+}
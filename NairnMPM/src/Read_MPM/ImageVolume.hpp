@@ -0,0 +1,95 @@
+/********************************************************************************
+	ImageVolume.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Gray scale 3D image (voxel) volume used by <BMP> in 3D when the file is
+	a raw volume (.raw) or a multi-page TIFF stack (.tif or .tiff). The file
+	is memory mapped and voxels are read in place (it is never loaded). Only
+	8 bit voxels are supported. Raw files are slices of rows of voxels with
+	sizes (and an optional header length) given in the XML command. TIFF
+	stacks must be uncompressed and in strips (one page per slice).
+
+	Rows within each slice start at the top (maximum y) unless the volume is
+	flipped (row 0 at minimum y). Slice 0 is at minimum z.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _IMAGEVOLUME_
+
+#define _IMAGEVOLUME_
+
+class BMPLevel;
+
+// rules to pick material from voxels within a particle domain
+enum { VOLUME_MAJORITY=0,VOLUME_AVERAGE };
+
+// voxel range in a particle domain along x (0), y (1), and z (2)
+typedef struct
+{	int v1[3],v2[3];				// first and last voxel along each axis
+	double wt1[3],wt2[3];			// weights for first and last voxel along each axis
+} VolumeMap;
+
+class ImageVolume
+{
+	public:
+
+		// constructors and destructors
+		ImageVolume(const char *);
+		~ImageVolume();
+
+		// methods
+		void SetRawVolume(int,int,int,long);
+		void ReadTIFFStack(void);
+		void SetGeometry(Vector,Vector,bool);
+		bool MapDomain(Vector *,Vector *,VolumeMap &) const;
+		BMPLevel *FindLevel(BMPLevel **,int,const VolumeMap &,int,int,double *) const;
+		double FindAverageValue(const VolumeMap &,int) const;
+		void FindOccupiedBlocks(BMPLevel **,int);
+		bool HasOccupiedBlocks(const VolumeMap &) const;
+
+		// accessors
+		int Width(void) const;
+		int Height(void) const;
+		int Depth(void) const;
+		bool SameSize(const ImageVolume *) const;
+		const unsigned char *Row(int,int) const;
+
+		// class methods
+		static bool IsVolumeFile(const char *);
+		static ImageVolume *OpenVolume(const char *,int *,long);
+		static BMPLevel *LevelForIntensity(BMPLevel **,int,unsigned char);
+
+	private:
+		char *fullPath;
+		unsigned char *data;
+		long dataLength;
+		bool mapped;
+		int width,height,depth;
+
+		// strips of rows in each slice
+		vector< const unsigned char * > strips;
+		int rowsPerStrip,stripsPerSlice;
+
+		// location in the grid
+		Vector orig,pw;
+		bool flipped;
+
+		// blocks of voxels with at least one voxel that maps to a material
+		int blockSize,numBlocks[3];
+		vector< unsigned char > occupied;
+
+		// TIFF parsing
+		bool bigEndian;
+		unsigned int ReadTIFFUnsigned(long,int) const;
+		unsigned int ReadTIFFValue(long,int,int) const;
+
+		void MapFile(void);
+		void VolumeError(const char *);
+};
+
+#endif
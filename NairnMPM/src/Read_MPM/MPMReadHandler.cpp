@@ -33,6 +33,8 @@
 #include "Read_XML/MaterialController.hpp"
 #include "Read_MPM/CrackController.hpp"
 #include "Read_MPM/MpsController.hpp"
+#include "Read_MPM/ParticleFile.hpp"
+#include "Read_MPM/ImageVolume.hpp"
 #include "Cracks/CrackHeader.hpp"
 #include "Cracks/CrackSegment.hpp"
 #include "Materials/MaterialBase.hpp"
@@ -57,6 +59,11 @@ MPMReadHandler::MPMReadHandler()
 	crackCtrl=new CrackController();
     currentTask=NULL;
 	currentContact=NULL;
+	bdepth=-1.e9;
+	volumeVoxels[0]=volumeVoxels[1]=volumeVoxels[2]=0;
+	volumeHeader=0;
+	volumeRule=VOLUME_MAJORITY;
+	volumeSample=1;
 }
 
 MPMReadHandler::~MPMReadHandler()
@@ -77,6 +84,13 @@ MPMReadHandler::~MPMReadHandler()
 // Return NairnFEA class object
 CommonAnalysis *MPMReadHandler::GetCommonAnalysis(void) { return fmobj; }
 
+// Set material array and then check materials in particle files
+// throws SAXException()
+void MPMReadHandler::FinishUp(void)
+{	CommonReadHandler::FinishUp();
+	ParticleFile::CheckMaterialIDs();
+}
+
 // Custom MPM element start
 // throws std::bad_alloc, SAXException()
 bool MPMReadHandler::myStartElement(char *xName,const Attributes& attrs)
@@ -218,6 +232,21 @@ bool MPMReadHandler::myStartElement(char *xName,const Attributes& attrs)
     	input=DOUBLE_NUM;
         inputPtr=(char *)archiver->GetGlobalTimePtr();
 		gScaling=ReadUnits(attrs,SEC_UNITS);
+		
+		// optional binary columnar file (default is text)
+        numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   aName=XMLString::transcode(attrs.getLocalName(i));
+            if(strcmp(aName,"format")==0)
+			{	value=XMLString::transcode(attrs.getValue(i));
+				if(strcmp(value,"binary")==0)
+					archiver->SetGlobalBinary(true);
+				else if(strcmp(value,"text")!=0)
+                    throw SAXException("GlobalArchiveTime format must be text or binary");
+				delete [] value;
+			}
+			delete [] aName;
+        }
     }
     
     else if(strcmp(xName,"GlobalArchive")==0)
@@ -380,6 +409,52 @@ bool MPMReadHandler::myStartElement(char *xName,const Attributes& attrs)
 		fmobj->skipPostExtrapolation = true;
 	}
 
+	else if(strcmp(xName,"TaskProfile")==0 || strcmp(xName,"MaterialProfile")==0 || strcmp(xName,"MemoryProfile")==0)
+	{	// per-task and per-thread profile, per-material constitutive law costs, or memory use at each archive (default is CSV)
+		ValidateCommand(xName,MPMHEADER,ANY_DIM);
+		int format = CSV_PROFILE;
+        numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   aName=XMLString::transcode(attrs.getLocalName(i));
+            if(strcmp(aName,"format")==0)
+			{	value=XMLString::transcode(attrs.getValue(i));
+				if(strcmp(value,"json")==0 || strcmp(value,"JSON")==0)
+					format = JSON_PROFILE;
+				else if(strcmp(value,"csv")!=0 && strcmp(value,"CSV")!=0)
+                    throw SAXException("TaskProfile, MaterialProfile, and MemoryProfile format must be csv or json");
+				delete [] value;
+			}
+			delete [] aName;
+        }
+		if(strcmp(xName,"TaskProfile")==0)
+			archiver->SetTaskProfile(format);
+		else if(strcmp(xName,"MaterialProfile")==0)
+			archiver->SetMaterialProfile(format);
+		else
+			archiver->SetMemoryProfile(format);
+	}
+
+	else if(strcmp(xName,"Deterministic")==0)
+	{	// fixed patches and reduction order for results independent of number of processors
+		ValidateCommand(xName,MPMHEADER,ANY_DIM);
+		fmobj->deterministicPatches = DEFAULT_DETERMINISTIC_PATCHES;
+        numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   aName=XMLString::transcode(attrs.getLocalName(i));
+            if(strcmp(aName,"patches")==0)
+			{	value=XMLString::transcode(attrs.getValue(i));
+				sscanf(value,"%d",&fmobj->deterministicPatches);
+				delete [] value;
+			}
+			delete [] aName;
+        }
+		if(fmobj->deterministicPatches<1)
+			throw SAXException("<Deterministic> patches must be a positive integer");
+		
+		// random numbers (e.g., in generator or material functions) repeat too
+		srand(DETERMINISTIC_SEED);
+	}
+	
 	else if(strcmp(xName,"TrackParticleSpin")==0 || strcmp(xName,"TrackGradV")==0)
 	{	throw SAXException("<TrackParticleSpin> command requires OSParticulas.");
 	}
@@ -876,6 +951,33 @@ bool MPMReadHandler::myStartElement(char *xName,const Attributes& attrs)
     	block=MATLPTS;
     }
 	
+	// binary particle file
+    else if(strcmp(xName,"PointFile")==0)
+	{	ValidateCommand(xName,POINTSBLOCK,ANY_DIM);
+		char *fileName=NULL;
+    	numAttr=(int)attrs.getLength();
+        for(i=0;i<numAttr;i++)
+        {   aName=XMLString::transcode(attrs.getLocalName(i));
+            if(strcmp(aName,"name")==0)
+			{	if(fileName!=NULL) delete [] fileName;
+				fileName=XMLString::transcode(attrs.getValue(i));
+			}
+            delete [] aName;
+        }
+		if(fileName==NULL)
+			throw SAXException("<PointFile> must specify a file name.");
+		char *fullPath=archiver->ExpandOutputPath(fileName);
+		delete [] fileName;
+		try
+		{	ParticleFile::ReadParticleFile(fullPath,mpCtrl);
+		}
+		catch(...)
+		{	delete [] fullPath;
+			throw;
+		}
+		delete [] fullPath;
+    }
+	
 	// <pt> may be in:
 	//  a. <NodeList> for node in a mesh (which might be 3D crack mesh too)
 	//  b. MATLPTS to define a material point (XML only and subordinate to <mp> defining only point location)
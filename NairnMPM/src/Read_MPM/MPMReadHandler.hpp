@@ -32,11 +32,14 @@ class MPMReadHandler : public CommonReadHandler
 		virtual void myEndElement(char *);
 		virtual void myCharacters(char *,const unsigned int);
 		virtual void TranslateBMPFiles(void);
+		virtual void FinishUp(void);
         
         // My methods
         short GenerateInput(char *,const Attributes&);
         short EndGenerator(char *xName);
 		short BMPFileInput(char *,const Attributes&);
+		void VolumeFileInput(const Attributes&);
+		void TranslateVolumeFiles(void);
  		void SetLevelVelocity(double,double,double);
         void MPMPts(void);						// Generate material points
 		void SetGIMPBorderAsHoles(void);		// implicit block edge GIMP elements from getting particles
@@ -58,6 +61,11 @@ class MPMReadHandler : public CommonReadHandler
     	ParseController *damageICCtrl;
 		ContactLaw *currentContact;
         char *currentTask;
+	
+		// image volume settings for 3D <BMP>
+		double bdepth;
+		int volumeVoxels[3],volumeRule,volumeSample;
+		long volumeHeader;
         
 		void grid(void);
 };
@@ -28,6 +28,20 @@ void MpsController::AddMaterialPoint(MPMBase *newMpt,double conc,double temp)
 	newMpt->SetTemperature(temp,thermal.reference);
 }
 
+// add array of new material points (with concentration and temperature already set)
+void MpsController::AddMaterialPoints(MPMBase **newMpts,int numNew)
+{
+	if(numNew<1) return;
+	for(int p=1;p<numNew;p++)
+		newMpts[p-1]->SetNextObject(newMpts[p]);
+	if(firstObject==NULL)
+		firstObject=newMpts[0];
+	else
+		lastObject->SetNextObject(newMpts[0]);
+	lastObject=newMpts[numNew-1];
+	numObjects+=numNew;
+}
+
 // set position (if "pt") or velocity (if "vel")
 int MpsController::SetPtOrVel(char *xName,Vector *value)
 {
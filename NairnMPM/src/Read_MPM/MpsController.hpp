@@ -23,6 +23,7 @@ class MpsController : public ParseController
 	
 		// methods
 		void AddMaterialPoint(MPMBase *,double,double);
+		void AddMaterialPoints(MPMBase **,int);
 		int SetPtOrVel(char *,Vector *);
 		void SetPtMass(double);
 		int SetMPArray(void);
@@ -0,0 +1,419 @@
+/********************************************************************************
+	ParticleFile.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "Read_MPM/ParticleFile.hpp"
+#include "Read_MPM/MpsController.hpp"
+#include "Read_XML/CommonReadHandler.hpp"
+#include "NairnMPM_Class/NairnMPM.hpp"
+#include "NairnMPM_Class/MeshInfo.hpp"
+#include "NairnMPM_Class/ResetElementsTask.hpp"
+#include "MPM_Classes/MatPoint2D.hpp"
+#include "MPM_Classes/MatPointAS.hpp"
+#include "MPM_Classes/MatPoint3D.hpp"
+#include "Materials/MaterialBase.hpp"
+#include "Custom_Tasks/DiffusionTask.hpp"
+#include "Global_Quantities/ThermalRamp.hpp"
+#include "Exceptions/CommonException.hpp"
+#ifndef WINDOWS_EXE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// files with initial stresses are kept until material densities are known
+static vector<ParticleFile *> stressFiles;
+
+// largest material ID in each file (checked when all materials are defined)
+static vector< pair< string,int > > fileMaterials;
+
+#pragma mark ParticleFile: Constructors and Destructors
+
+// Open and map the file and validate its header
+// throws SAXException()
+ParticleFile::ParticleFile(const char *filePath)
+{
+	fullPath = new char[strlen(filePath)+1];
+	strcpy(fullPath,filePath);
+	data = NULL;
+	dataLength = 0;
+	mapped = false;
+	header = NULL;
+	stressColumn = NULL;
+	firstPoint = 0;
+	numPoints = 0;
+
+#ifdef WINDOWS_EXE
+	// read whole file into memory
+	FILE *fp = fopen(fullPath,"rb");
+	if(fp==NULL)
+		ParticleFileError("The particle file could not be opened.");
+	if(fseek(fp,0L,SEEK_END)==0)
+		dataLength = ftell(fp);
+	rewind(fp);
+	if(dataLength>=(long)sizeof(ParticleFileHeader))
+	{	data = (unsigned char *)malloc(dataLength);
+		if(data==NULL)
+		{	fclose(fp);
+			ParticleFileError("Out of memory reading the particle file.");
+		}
+		if(fread(data,dataLength,1,fp)!=1)
+		{	fclose(fp);
+			ParticleFileError("The particle file could not be read.");
+		}
+	}
+	fclose(fp);
+#else
+	// map the file read only
+	int fd = open(fullPath,O_RDONLY);
+	if(fd<0)
+		ParticleFileError("The particle file could not be opened.");
+	struct stat fileStat;
+	if(fstat(fd,&fileStat)!=0)
+	{	close(fd);
+		ParticleFileError("The particle file size could not be found.");
+	}
+	dataLength = (long)fileStat.st_size;
+	if(dataLength>=(long)sizeof(ParticleFileHeader))
+	{	void *mapAddr = mmap(NULL,(size_t)dataLength,PROT_READ,MAP_PRIVATE,fd,0);
+		if(mapAddr==MAP_FAILED)
+		{	close(fd);
+			ParticleFileError("The particle file could not be memory mapped.");
+		}
+		data = (unsigned char *)mapAddr;
+		mapped = true;
+	}
+	close(fd);
+#endif
+
+	if(data==NULL)
+		ParticleFileError("The particle file is too short to have a header.");
+
+	// validate the header
+	header = (ParticleFileHeader *)data;
+	if(strncmp(header->tag,PF_TAG,8)!=0)
+		ParticleFileError("The particle file does not start with a valid particle file header.");
+	if(header->byteOrder!=1)
+		ParticleFileError("The particle file byte order does not match this computer.");
+	int dim = fmobj->IsThreeD() ? 3 : 2;
+	if(header->dimension!=dim)
+		ParticleFileError("The particle file dimension does not match the analysis.");
+	if((header->columns & PF_POSITION)==0 || (header->columns & PF_MATERIAL)==0)
+		ParticleFileError("The particle file must have position and material columns.");
+	if((header->columns & ~PF_ALLCOLUMNS)!=0)
+		ParticleFileError("The particle file has unknown data columns.");
+	if(header->numPoints<1 || header->numPoints>2147483647LL)
+		ParticleFileError("The particle file number of particles is not valid.");
+	numPoints = (int)header->numPoints;
+
+	// size must match the columns
+	long expected = (long)sizeof(ParticleFileHeader);
+	int flag;
+	for(flag=PF_POSITION;flag<=PF_ORIGIN;flag<<=1)
+	{	if(header->columns & flag)
+			expected += ColumnBytes(flag,dim,numPoints);
+	}
+	if(dataLength!=expected)
+		ParticleFileError("The particle file length does not match the number of particles and columns in its header.");
+}
+
+// Destructor
+ParticleFile::~ParticleFile()
+{
+	if(data!=NULL)
+	{
+#ifdef WINDOWS_EXE
+		free(data);
+#else
+		if(mapped) munmap(data,(size_t)dataLength);
+#endif
+	}
+	if(fullPath!=NULL) delete [] fullPath;
+}
+
+#pragma mark ParticleFile: Methods
+
+// Create particles for the file and add them to the material point controller
+// Return true if the file must be kept to set initial stresses
+// throws SAXException()
+bool ParticleFile::LoadParticles(MpsController *mpsCtrl)
+{
+	int dim = fmobj->IsThreeD() ? 3 : 2;
+
+	// column arrays (NULL if not in the file)
+	const double *px = Column(PF_POSITION,0);
+	const double *py = Column(PF_POSITION,1);
+	const double *pz = dim==3 ? Column(PF_POSITION,2) : NULL;
+	const int *matID = (const int *)Column(PF_MATERIAL,0);
+	const double *anglez = Column(PF_ANGLES,0);
+	const double *angley = dim==3 ? Column(PF_ANGLES,1) : NULL;
+	const double *anglex = dim==3 ? Column(PF_ANGLES,2) : NULL;
+	const double *thick = Column(PF_THICKNESS,0);
+	const double *vx = Column(PF_VELOCITY,0);
+	const double *vy = Column(PF_VELOCITY,1);
+	const double *vz = dim==3 ? Column(PF_VELOCITY,2) : NULL;
+	const double *lpx = Column(PF_SIZE,0);
+	const double *lpy = Column(PF_SIZE,1);
+	const double *lpz = dim==3 ? Column(PF_SIZE,2) : NULL;
+	const double *temp = Column(PF_TEMPERATURE,0);
+	const double *conc = Column(PF_CONCENTRATION,0);
+	const double *pmass = Column(PF_MASS,0);
+	const double *ox = Column(PF_ORIGIN,0);
+	const double *oy = Column(PF_ORIGIN,1);
+	const double *oz = dim==3 ? Column(PF_ORIGIN,2) : NULL;
+	stressColumn = Column(PF_STRESS,0);
+
+	// defaults for missing columns
+	double defThick = mpmgrid.GetDefaultThickness();
+	bool hasDiffusion = fmobj->HasDiffusion();
+	bool isAxisymmetric = fmobj->IsAxisymmetric();
+
+	MPMBase **pts = new (std::nothrow) MPMBase *[numPoints];
+	if(pts==NULL)
+		ParticleFileError("Out of memory creating particles from the particle file.");
+
+	// create particles in parallel (each thread only changes its own particles)
+	int badPoint = numPoints;
+	const char *badMsg = NULL;
+	int maxMatl = 0;
+#pragma omp parallel for reduction(max:maxMatl)
+	for(int p=0;p<numPoints;p++)
+	{	pts[p] = NULL;
+		const char *msg = NULL;
+		try
+		{	int matl = matID[p];
+			if(matl<1)
+				msg = "A particle in the particle file has an invalid material ID.";
+			if(matl>maxMatl) maxMatl = matl;
+			double angle = anglez!=NULL ? anglez[p] : 0.;
+
+			// create the particle
+			MPMBase *newMpt;
+			if(dim==3)
+			{	newMpt = new MatPoint3D(1,matl,angle);
+				if(angley!=NULL)
+				{	newMpt->SetAngley0InDegrees(angley[p]);
+					newMpt->SetAnglex0InDegrees(anglex[p]);
+				}
+			}
+			else if(isAxisymmetric)
+				newMpt = new MatPointAS(1,matl,angle,1.);
+			else
+				newMpt = new MatPoint2D(1,matl,angle,thick!=NULL ? thick[p] : defThick);
+			pts[p] = newMpt;
+
+			// concentration and temperature
+			double pConc = DiffusionTask::reference;
+			if(hasDiffusion && conc!=NULL)
+			{	if(conc[p]<0.)
+					msg = "A particle in the particle file has weight fraction concentration < 0.";
+				pConc = -conc[p];
+			}
+			newMpt->SetConcentration(pConc,DiffusionTask::reference);
+			newMpt->SetTemperature(temp!=NULL ? temp[p] : thermal.reference,thermal.reference);
+
+			// size
+			Vector lp = MakeVector(0.5,0.5,0.5);
+			if(lpx!=NULL)
+			{	lp.x = lpx[p];
+				lp.y = lpy[p];
+				if(dim==3) lp.z = lpz[p];
+			}
+			newMpt->SetDimensionlessSize(&lp);
+
+			// position, origin, and element (axisymmetric thickness is set by the origin)
+			Vector xp = MakeVector(px[p],py[p],dim==3 ? pz[p] : 0.);
+			newMpt->SetPosition(&xp);
+			if(ox!=NULL)
+			{	Vector xo = MakeVector(ox[p],oy[p],dim==3 ? oz[p] : 0.);
+				newMpt->SetOrigin(&xo);
+			}
+			else
+				newMpt->SetOrigin(&xp);
+			int result = ResetElementsTask::ResetElement(newMpt);
+			if(result==LEFT_GRID || result==LEFT_GRID_NAN)
+				msg = "A particle in the particle file is not within the grid.";
+			newMpt->SetElementCrossings(0);
+
+			// velocity and mass
+			if(vx!=NULL)
+			{	Vector vel = MakeVector(vx[p],vy[p],dim==3 ? vz[p] : 0.);
+				newMpt->SetVelocity(&vel);
+			}
+			if(pmass!=NULL && pmass[p]>0.) newMpt->mp = pmass[p];
+		}
+		catch(...)
+		{	msg = "Out of memory creating particles from the particle file.";
+		}
+
+		// keep first error
+		if(msg!=NULL)
+		{
+#pragma omp critical (error)
+			{	if(p<badPoint)
+				{	badPoint = p;
+					badMsg = msg;
+				}
+			}
+		}
+	}
+
+	// on error, delete the particles
+	if(badMsg!=NULL)
+	{	for(int p=0;p<numPoints;p++)
+		{	if(pts[p]!=NULL) delete pts[p];
+		}
+		delete [] pts;
+		ParticleFileError(badMsg);
+	}
+
+	// add to list of material points
+	firstPoint = mpsCtrl->numObjects;
+	mpsCtrl->AddMaterialPoints(pts,numPoints);
+	delete [] pts;
+	fileMaterials.push_back(pair< string,int >(string(fullPath),maxMatl));
+
+	return stressColumn!=NULL;
+}
+
+// pointer to component of a column or NULL if not in the file
+const double *ParticleFile::Column(int column,int component) const
+{
+	if((header->columns & column)==0) return NULL;
+	int dim = header->dimension;
+	long offset = (long)sizeof(ParticleFileHeader);
+	int flag;
+	for(flag=PF_POSITION;flag<column;flag<<=1)
+	{	if(header->columns & flag)
+			offset += ColumnBytes(flag,dim,numPoints);
+	}
+	offset += (long)component*(long)numPoints*(long)sizeof(double);
+	return (const double *)(data+offset);
+}
+
+// create error message with the file name and release the file
+// throws SAXException()
+void ParticleFile::ParticleFileError(const char *msg)
+{
+	char *error = new char[strlen(msg)+strlen(fullPath)+10];
+	sprintf(error,"%s (file: %s)",msg,fullPath);
+	if(data!=NULL)
+	{
+#ifdef WINDOWS_EXE
+		free(data);
+#else
+		if(mapped) munmap(data,(size_t)dataLength);
+#endif
+		data = NULL;
+	}
+	delete [] fullPath;
+	fullPath = NULL;
+	throw SAXException(error);
+}
+
+#pragma mark ParticleFile: Class Methods
+
+// Read particles from file and add to list of material points
+// throws SAXException()
+void ParticleFile::ReadParticleFile(const char *filePath,MpsController *mpsCtrl)
+{
+	ParticleFile *pfile = new ParticleFile(filePath);
+	bool keepFile;
+	try
+	{	keepFile = pfile->LoadParticles(mpsCtrl);
+	}
+	catch(...)
+	{	delete pfile;
+		throw;
+	}
+	if(keepFile)
+		stressFiles.push_back(pfile);
+	else
+		delete pfile;
+}
+
+// Material IDs in the file must be defined materials, but materials are after
+// the particles in the input file so check after all input is read
+// throws SAXException()
+void ParticleFile::CheckMaterialIDs(void)
+{
+	for(int i=0;i<(int)fileMaterials.size();i++)
+	{	if(fileMaterials[i].second<=nmat) continue;
+		const char *msg = "A particle in the particle file has an undefined material ID";
+		char *error = new char[strlen(msg)+fileMaterials[i].first.length()+50];
+		sprintf(error,"%s (%d > %d materials) (file: %s)",msg,fileMaterials[i].second,nmat,
+				fileMaterials[i].first.c_str());
+		fileMaterials.clear();
+		throw SAXException(error);
+	}
+	fileMaterials.clear();
+}
+
+// Set initial stresses from particle files after materials are initialized
+// Must be called before particles are reordered
+// File stress is Cauchy stress, but particles store stress/rho
+// throws CommonException()
+void ParticleFile::SetInitialStresses(void)
+{
+	for(int i=0;i<(int)stressFiles.size();i++)
+	{	ParticleFile *pfile = stressFiles[i];
+		int n = pfile->numPoints;
+		const double *s = pfile->stressColumn;
+		bool threeD = pfile->header->dimension==3;
+
+#pragma omp parallel for
+		for(int j=0;j<n;j++)
+		{	MPMBase *mptr = mpm[pfile->firstPoint+j];
+			const MaterialBase *matRef = theMaterials[mptr->MatID()];
+			if(matRef->IsRigid()) continue;
+			double rho = matRef->GetRho(mptr);
+			Tensor sp;
+			ZeroTensor(&sp);
+			sp.xx = s[j]/rho;
+			sp.yy = s[n+j]/rho;
+			sp.zz = s[2*n+j]/rho;
+			sp.xy = s[3*n+j]/rho;
+			if(threeD)
+			{	sp.xz = s[4*n+j]/rho;
+				sp.yz = s[5*n+j]/rho;
+			}
+			mptr->StoreStressTensor(&sp);
+		}
+
+		delete pfile;
+	}
+	stressFiles.clear();
+}
+
+// number of component arrays in a column
+int ParticleFile::ColumnComponents(int column,int dim)
+{
+	switch(column)
+	{	case PF_POSITION:
+		case PF_VELOCITY:
+		case PF_SIZE:
+		case PF_ORIGIN:
+			return dim;
+		case PF_ANGLES:
+			return dim==3 ? 3 : 1;
+		case PF_STRESS:
+			return dim==3 ? 6 : 4;
+		default:
+			break;
+	}
+	return 1;
+}
+
+// bytes in a column (material ID ints padded to multiple of 8)
+long ParticleFile::ColumnBytes(int column,int dim,long n)
+{
+	if(column==PF_MATERIAL)
+		return 8*((n*(long)sizeof(int)+7)/8);
+	return (long)ColumnComponents(column,dim)*n*(long)sizeof(double);
+}
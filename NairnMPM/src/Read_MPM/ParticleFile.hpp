@@ -0,0 +1,99 @@
+/********************************************************************************
+	ParticleFile.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Binary particle file read by <PointFile> in <MaterialPoints>. The file
+	is memory mapped and converted to particles in parallel. Layout is a
+	64 byte header followed by columns (structure of arrays) in the order
+	of the column flags below. Vector and tensor columns store each component
+	as its own array of numPoints values. All values are doubles except
+	material IDs (int, padded to multiple of 8 bytes) and are in the same
+	units as archive files (these files are written by ExtractMPM -I).
+	The file initializes particles only. There are no strain or history
+	columns, so particles start undeformed with initial material history.
+
+		PF_POSITION		x,y,(z) (required)
+		PF_MATERIAL		1-based material ID (required)
+		PF_ANGLES		z (2D) or z,y,x (3D) in degrees
+		PF_THICKNESS	thickness (2D planar only)
+		PF_VELOCITY		vx,vy,(vz)
+		PF_SIZE			dimensionless size lpx,lpy,(lpz)
+		PF_STRESS		xx,yy,zz,xy (2D) or xx,yy,zz,xy,xz,yz (3D) Cauchy stress
+		PF_TEMPERATURE	temperature
+		PF_CONCENTRATION	weight fraction concentration
+		PF_MASS			particle mass
+		PF_ORIGIN		original position x,y,(z)
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _PARTICLEFILE_
+
+#define _PARTICLEFILE_
+
+class MPMBase;
+class MpsController;
+
+// column flags (must keep this order)
+#define PF_POSITION 0x0001
+#define PF_MATERIAL 0x0002
+#define PF_ANGLES 0x0004
+#define PF_THICKNESS 0x0008
+#define PF_VELOCITY 0x0010
+#define PF_SIZE 0x0020
+#define PF_STRESS 0x0040
+#define PF_TEMPERATURE 0x0080
+#define PF_CONCENTRATION 0x0100
+#define PF_MASS 0x0200
+#define PF_ORIGIN 0x0400
+#define PF_ALLCOLUMNS 0x07FF
+
+#define PF_TAG "NMPMPTS1"
+
+// 64 byte file header
+typedef struct {
+	char tag[8];				// PF_TAG (no terminating zero)
+	int byteOrder;				// 1 in byte order of the writing machine
+	int dimension;				// 2 or 3
+	int columns;				// bits of columns in the file
+	int reserved;
+	long long numPoints;		// number of particles
+	char pad[32];
+} ParticleFileHeader;
+
+class ParticleFile
+{
+	public:
+
+		// constructors and destructors
+		ParticleFile(const char *);
+		~ParticleFile();
+
+		// methods
+		bool LoadParticles(MpsController *);
+
+		// class methods
+		static void ReadParticleFile(const char *,MpsController *);
+		static void CheckMaterialIDs(void);
+		static void SetInitialStresses(void);
+		static int ColumnComponents(int,int);
+		static long ColumnBytes(int,int,long);
+
+	private:
+		char *fullPath;
+		unsigned char *data;
+		long dataLength;
+		bool mapped;
+		ParticleFileHeader *header;
+		const double *stressColumn;
+		int firstPoint,numPoints;
+
+		const double *Column(int,int) const;
+		void ParticleFileError(const char *);
+};
+
+#endif
@@ -17,6 +17,7 @@
 PolyhedronController::PolyhedronController(int block) : ShapeController(block)
 {
 	twoDShape = false;
+	numBins = 0;
 }
 
 // destructor
@@ -192,9 +193,51 @@ bool PolyhedronController::HasAllParameters(void)
 		if(fmax.y > pmax.y) pmax.y=fmax.y;
 		if(fmax.z > pmax.z) pmax.z=fmax.z;
 	}
+	
+	BuildFaceBins();
 	return TRUE;
 }
 
+// Bin faces on a y-z grid by their extents. A face can only contribute to the
+// ray test in ContainsPoint() when the point's (y,z) is within that face's
+// extents, so only faces in the point's bin need to be checked. Extents are
+// padded slightly to allow for round off in the face parameters.
+void PolyhedronController::BuildFaceBins(void)
+{
+	numBins = (int)sqrt((double)faces.size());
+	if(numBins<1) numBins = 1;
+	binSize[0] = (pmax.y-pmin.y)/(double)numBins;
+	binSize[1] = (pmax.z-pmin.z)/(double)numBins;
+	faceBins.clear();
+	faceBins.resize(numBins*numBins);
+	
+	double tolY = 1.e-9*(pmax.y-pmin.y);
+	double tolZ = 1.e-9*(pmax.z-pmin.z);
+	Vector fmin,fmax;
+	for(unsigned i=0;i<faces.size();i++)
+	{	faces[i]->GetExtents(&fmin,&fmax);
+		int jmin = BinIndex(fmin.y-tolY,0);
+		int jmax = BinIndex(fmax.y+tolY,0);
+		int kmin = BinIndex(fmin.z-tolZ,1);
+		int kmax = BinIndex(fmax.z+tolZ,1);
+		for(int k=kmin;k<=kmax;k++)
+		{	for(int j=jmin;j<=jmax;j++)
+				faceBins[k*numBins+j].push_back((int)i);
+		}
+	}
+}
+
+// bin index for y (axis=0) or z (axis=1), clamped to the bin grid
+int PolyhedronController::BinIndex(double value,int axis) const
+{
+	if(binSize[axis]<=0.) return 0;
+	double start = axis==0 ? pmin.y : pmin.z;
+	int index = (int)((value-start)/binSize[axis]);
+	if(index<0) return 0;
+	if(index>=numBins) return numBins-1;
+	return index;
+}
+
 // called read attributes to verify all attributes were there
 bool PolyhedronController::FinishParameter(void) { return style!=NO_FACES; }
 
@@ -214,9 +257,11 @@ bool PolyhedronController::ContainsPoint(Vector& pt)
 	// screen extent first
 	if(pt.x<pmin.x || pt.x>pmax.x || pt.y < pmin.y || pt.y > pmax.y || pt.z < pmin.z || pt.z > pmax.z) return FALSE;
 	
-	for(i=0;i<faces.size();i++)
+	// only faces in this point's y-z bin
+	vector<int> &binFaces = faceBins[BinIndex(pt.z,1)*numBins+BinIndex(pt.y,0)];
+	for(i=0;i<binFaces.size();i++)
 	{	// get parameteric intersection point
-		cross=faces[i]->PointCrossesFace(&pt,&edges);
+		cross=faces[binFaces[i]]->PointCrossesFace(&pt,&edges);
 		if(cross==0) return TRUE;
 		if(cross>0) crossings+=1;
 	}
@@ -224,6 +269,12 @@ bool PolyhedronController::ContainsPoint(Vector& pt)
 	return ((crossings+(edges>>1)) & 0x01);
 }
 
+// extents of all faces
+void PolyhedronController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	*bmin = pmin;
+	*bmax = pmax;
+}
+
 #pragma mark PolyhedronController: accessors
 
 // override for 3D objects
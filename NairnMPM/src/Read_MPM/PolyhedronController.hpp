@@ -36,6 +36,7 @@ class PolyhedronController : public ShapeController
     
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
     
         // accessors
 		virtual bool Is2DShape(void);
@@ -47,6 +48,14 @@ class PolyhedronController : public ShapeController
 		Vector pmin,pmax;
 		char order[9];
 	
+		// faces binned by y-z extents (ray test along x only needs faces in point's bin)
+		int numBins;
+		double binSize[2];
+		vector< vector<int> > faceBins;
+	
+		void BuildFaceBins(void);
+		int BinIndex(double,int) const;
+	
 };
 
 #endif
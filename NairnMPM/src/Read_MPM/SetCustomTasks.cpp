@@ -18,6 +18,7 @@
 #include "Custom_Tasks/CarnotCycle.hpp"
 #include "Custom_Tasks/CustomThermalRamp.hpp"
 #include "Custom_Tasks/PeriodicXPIC.hpp"
+#include "Custom_Tasks/ParticleRefinement.hpp"
 
 // Create custom task
 void MPMReadHandler::ScheduleCustomTask(const Attributes& attrs)
@@ -68,6 +69,11 @@ void MPMReadHandler::ScheduleCustomTask(const Attributes& attrs)
 			{   nextTask=(CustomTask *)(new PeriodicXPIC());
 				if(nextTask==NULL) throw SAXException("Out of memory creating a custom task.");
 			}
+
+			else if(strcmp(value,"ParticleRefinement")==0)
+			{   nextTask=(CustomTask *)(new ParticleRefinement());
+				if(nextTask==NULL) throw SAXException("Out of memory creating a custom task.");
+			}
 			
 			else
 				throw SAXException("Unknown custom task requested for scheduling.");
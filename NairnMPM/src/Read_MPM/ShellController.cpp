@@ -87,6 +87,23 @@ bool ShellController::ContainsPoint(Vector& v)
 	return true;
 }
 
+// only bounded along the axis (radius function can extend beyond the box)
+void ShellController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	ShapeController::GetBoundingBox(bmin,bmax);
+	if(axis==1)
+	{	bmin->x = xmin;
+		bmax->x = xmax;
+	}
+	else if(axis==2)
+	{	bmin->y = ymin;
+		bmax->y = ymax;
+	}
+	else
+	{	bmin->z = zmin;
+		bmax->z = zmax;
+	}
+}
+
 #pragma mark SphereController: accessors
 
 // override for 3D objects
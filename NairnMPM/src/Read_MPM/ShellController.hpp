@@ -28,6 +28,7 @@ class ShellController : public BoxController
     
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
     
 		// accessors
 		virtual bool Is2DShape(void);
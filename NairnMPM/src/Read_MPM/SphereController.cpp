@@ -40,6 +40,16 @@ bool SphereController::ContainsPoint(Vector& pt)
 	return (((pt.x-x0)*(pt.x-x0)/a/a+(pt.y-y0)*(pt.y-y0)/b/b+(pt.z-z0)*(pt.z-z0)/c/c) <= 1.) ? TRUE : FALSE;
 }
 
+// ellipsoid is within its box
+void SphereController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	bmin->x = xmin;
+	bmax->x = xmax;
+	bmin->y = ymin;
+	bmax->y = ymax;
+	bmin->z = zmin;
+	bmax->z = zmax;
+}
+
 #pragma mark SphereController: accessors
 
 // override for 3D objects
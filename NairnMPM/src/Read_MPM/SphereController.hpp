@@ -25,6 +25,7 @@ class SphereController : public ShapeController
     
 		// methods
 		virtual bool ContainsPoint(Vector &);
+		virtual void GetBoundingBox(Vector *,Vector *);
     
         // accessors
 		virtual bool Is2DShape(void);
@@ -115,6 +115,23 @@ bool TorusController::ContainsPoint(Vector& v)
     }
 }
 
+// only bounded along the axis (ring radius can extend beyond the box)
+void TorusController::GetBoundingBox(Vector *bmin,Vector *bmax)
+{	ShapeController::GetBoundingBox(bmin,bmax);
+	if(axis==1)
+	{	bmin->x = xmin;
+		bmax->x = xmax;
+	}
+	else if(axis==2)
+	{	bmin->y = ymin;
+		bmax->y = ymax;
+	}
+	else
+	{	bmin->z = zmin;
+		bmax->z = zmax;
+	}
+}
+
 #pragma mark TorusController: accessors
 
 // override for 3D objects
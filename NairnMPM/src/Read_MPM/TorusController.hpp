@@ -30,6 +30,7 @@ class TorusController : public ShapeController
         
         // methods
         virtual bool ContainsPoint(Vector &);
+        virtual void GetBoundingBox(Vector *,Vector *);
         
         // accessors
         virtual bool Is2DShape(void);
@@ -24,6 +24,10 @@
 #include "Boundary_Conditions/BoundaryCondition.hpp"
 #include "System/UnitsController.hpp"
 #include "Custom_Tasks/DiffusionTask.hpp"
+#include "NairnMPM_Class/MPMTask.hpp"
+#include "Materials/ConstitutiveProfile.hpp"
+#include "System/MemoryProfile.hpp"
+#include "System/ColumnArchive.hpp"
 
 // archiver global
 ArchiveData *archiver;
@@ -41,7 +45,16 @@ ArchiveData::ArchiveData()
 	nextGlobalTime=0.;		// next time to archive global results (sec)
 	
 	globalFile=NULL;		// path to global results file
+	globalBinary=false;		// true for binary columnar global results file
+	globalColumns=NULL;		// binary global results file
 	decohesionFile=NULL;	// path to decohesion file
+	profileFormat=NO_PROFILE;	// task profile archiving
+	profileFile=NULL;		// path to task profile file
+	matProfileFormat=NO_PROFILE;	// constitutive law costs archiving
+	matProfileFile=NULL;	// path to constitutive law costs file
+	memProfileFormat=NO_PROFILE;	// memory use archiving
+	memProfileFile=NULL;	// path to memory use file
+	lastProfileStep=0;		// step of last task profile
 	decohesionModes[0]=0;	// observed decohesion modes
 	threeD=FALSE;			// three D calculations
 	
@@ -232,6 +245,7 @@ bool ArchiveData::BeginArchives(bool isThreeD,int maxMats)
 	
 	// global archiving
 	CreateGlobalFile();
+	CreateProfileFiles();
 	
     // Archive file list headind
     CalcArchiveSize();
@@ -489,52 +503,65 @@ void ArchiveData::CreateGlobalFile(void)
 		if(hasTracers)
 		{	for(int p=0;p<nmpms;p++)
 			{	nextGlobal=firstGlobal;
+				Vector origpos = mpm[p]->origpos;
 				while(nextGlobal!=NULL)
-					nextGlobal = nextGlobal->FindTracerParticle(p,&mpm[p]->origpos);
+					nextGlobal = nextGlobal->FindTracerParticle(p,&origpos);
 			}
 			nextGlobal=firstGlobal;
 			while(nextGlobal!=NULL)
 				nextGlobal = nextGlobal->SetTracerParticle();
 		}
 
-		// get relative path name to the file
-		globalFile = new char[strlen(outputDir)+strlen(archiveRoot)+8];
-		GetFilePath(globalFile,"%s%s.global");
-	
-		// create and open the file
-		if((fp=fopen(globalFile,"w"))==NULL)
-		{	FileError("Global archive file creation failed",globalFile,"ArchiveData::CreateGlobalFile");
-			return;
+		// binary columnar file with a column for each global quantity
+		if(globalBinary)
+		{	globalFile = new char[strlen(outputDir)+strlen(archiveRoot)+12];
+			GetFilePath(globalFile,"%s%s.global.bin");
+			globalColumns = new ColumnArchive(globalFile);
+			nextGlobal=firstGlobal;
+			while(nextGlobal!=NULL)
+				nextGlobal = nextGlobal->AppendColumn(globalColumns);
+			globalColumns->CreateFile();
 		}
+		
+		else
+		{	// get relative path name to the file
+			globalFile = new char[strlen(outputDir)+strlen(archiveRoot)+8];
+			GetFilePath(globalFile,"%s%s.global");
+	
+			// create and open the file
+			if((fp=fopen(globalFile,"w"))==NULL)
+			{	FileError("Global archive file creation failed",globalFile,"ArchiveData::CreateGlobalFile");
+				return;
+			}
 	
-		// write color and count archives
-		strcpy(fline,"#setColor");
-		nextGlobal=firstGlobal;
-		while(nextGlobal!=NULL)
-			nextGlobal = nextGlobal->AppendColor(fline);
-		strcat(fline,"\n");
-		if(fwrite(fline,strlen(fline),1,fp)!=1)
-		{	FileError("Global archive file failed to add colors",globalFile,"ArchiveData::CreateGlobalFile");
-			return;
-		}
+			// write color and count archives
+			strcpy(fline,"#setColor");
+			nextGlobal=firstGlobal;
+			while(nextGlobal!=NULL)
+				nextGlobal = nextGlobal->AppendColor(fline);
+			strcat(fline,"\n");
+			if(fwrite(fline,strlen(fline),1,fp)!=1)
+			{	FileError("Global archive file failed to add colors",globalFile,"ArchiveData::CreateGlobalFile");
+				return;
+			}
 
-		// write name
-		strcpy(fline,"#setName");
-		nextGlobal=firstGlobal;
-		while(nextGlobal!=NULL)
-			nextGlobal = nextGlobal->AppendName(fline);
-		strcat(fline,"\n");
-		if(fwrite(fline,strlen(fline),1,fp)!=1)
-		{	FileError("Global archive file failed to add quantity names",globalFile,"ArchiveData::CreateGlobalFile");
-			return;
-		}
+			// write name
+			strcpy(fline,"#setName");
+			nextGlobal=firstGlobal;
+			while(nextGlobal!=NULL)
+				nextGlobal = nextGlobal->AppendName(fline);
+			strcat(fline,"\n");
+			if(fwrite(fline,strlen(fline),1,fp)!=1)
+			{	FileError("Global archive file failed to add quantity names",globalFile,"ArchiveData::CreateGlobalFile");
+				return;
+			}
 
-		// close the file
-		if(fclose(fp)!=0)
-		{	FileError("Global archive file failed to close",globalFile,"ArchiveData::CreateGlobalFile");
-			return;
+			// close the file
+			if(fclose(fp)!=0)
+			{	FileError("Global archive file failed to close",globalFile,"ArchiveData::CreateGlobalFile");
+				return;
+			}
 		}
-		
 	}
 	
 	// Create Decohsion file
@@ -566,12 +593,63 @@ void ArchiveData::CreateGlobalFile(void)
 	// section in output file
     PrintSection("ARCHIVED GLOBAL RESULTS");
 	if(hasGlobalValues)
-    	cout << "Global data file: " << archiveRoot << ".global" << endl;
+    	cout << "Global data file: " << archiveRoot << (globalBinary ? ".global.bin (binary)" : ".global") << endl;
 	if(hasDecohesion)
 		cout << "Decohesion data file: " << archiveRoot << ".decohn" << endl;
 	cout << endl;
 }
 
+// Create task profile, constitutive law costs, and memory use files (if requested)
+// throws CommonException()
+void ArchiveData::CreateProfileFiles(void)
+{
+	if(profileFormat==NO_PROFILE && matProfileFormat==NO_PROFILE && memProfileFormat==NO_PROFILE) return;
+	
+	if(profileFormat!=NO_PROFILE)
+	{	profileFile = CreateProfileFile(profileFormat,"_Profile",
+							"step,time,steps,task,thread,elapsed_ms,serial_ms,busy_ms,idle_ms,particles,nodes\n");
+		cout << "   (per-task times in ms/step and per-thread busy time, idle time, and work since previous archive)" << endl;
+	}
+	if(matProfileFormat!=NO_PROFILE)
+	{	matProfileFile = CreateProfileFile(matProfileFormat,"_Materials",
+							"step,time,steps,material,name,type,calls,ms_per_step,ns_per_update,solves,bracketed,iterations_per_solve,at_limit,unbracketed\n");
+		cout << "   (per-material strain update times and plastic return counts since previous archive)" << endl;
+	}
+	if(memProfileFormat!=NO_PROFILE)
+	{	memProfileFile = CreateProfileFile(memProfileFormat,"_Memory",
+							"step,time,steps,particles,history,nodes,fields,ghosts,contact,cracks,total,peak_total,peak_step,process_peak\n");
+		cout << "   (bytes in each category and peak total since previous archive)" << endl;
+	}
+	cout << endl;
+}
+
+// Create profile file (root)(name).csv or .json and write heading for CSV
+// JSON files get one object per line
+// throws CommonException()
+char *ArchiveData::CreateProfileFile(int format,const char *name,const char *heading)
+{
+	// get relative path name to the file
+	const char *ext = format==JSON_PROFILE ? ".json" : ".csv";
+	char *newFile = new char[strlen(outputDir)+strlen(archiveRoot)+strlen(name)+strlen(ext)+1];
+	GetFilePath(newFile,"%s%s");
+	strcat(newFile,name);
+	strcat(newFile,ext);
+	
+	// create the file
+	FILE *fp;
+	if((fp=fopen(newFile,"w"))==NULL)
+		FileError("Profile file creation failed",newFile,"ArchiveData::CreateProfileFile");
+	if(format==CSV_PROFILE)
+	{	if(fwrite(heading,strlen(heading),1,fp)!=1)
+			FileError("Profile file failed to add header",newFile,"ArchiveData::CreateProfileFile");
+	}
+	if(fclose(fp)!=0)
+		FileError("Profile file failed to close",newFile,"ArchiveData::CreateProfileFile");
+	
+	cout << "Profile file: " << archiveRoot << name << ext << endl;
+	return newFile;
+}
+
 // Create file in archive folder (outputDir)/(rootName)(fileName)
 // throws std::bad_alloc
 char *ArchiveData::CreateFileInArchiveFolder(char *fileName)
@@ -698,6 +776,10 @@ void ArchiveData::ArchiveResults(double atime)
 	if(firstGlobal!=NULL && globalTime<0.)
 		GlobalArchive(atime);
 	
+	// task profile and constitutive law costs since last archive
+	if(profileFile!=NULL || matProfileFile!=NULL || memProfileFile!=NULL)
+		ArchiveProfiles(atime);
+	
     // get relative path name to the file
 	GetFilePathNum(fname,"%s%s.%d",fmobj->mstep);
     
@@ -856,7 +938,7 @@ void ArchiveData::ArchiveResults(double atime)
 
         // ------- elastic strain (absolute)
         if(mpmOrder[ARCH_Strain]=='Y')
-		{	Tensor *ep=mpm[p]->GetStrainTensor();
+		{	StrainTensor *ep=mpm[p]->GetStrainTensor();
 			*(double *)app=ep->xx;
             app+=sizeof(double);
                 
@@ -1299,6 +1381,22 @@ void ArchiveData::GlobalArchive(double atime)
 	GlobalQuantity *nextGlobal=firstGlobal;
 	while(nextGlobal!=NULL)
 	    nextGlobal=nextGlobal->AppendQuantity(lastArchived);
+	
+	// append one row block to binary file
+	if(globalColumns!=NULL)
+	{	try
+		{	globalColumns->StartBlock(1,fmobj->mstep,UnitsController::Scaling(1000.)*atime);
+			for(int i=0;i<lastArchived.size();i++)
+				globalColumns->WriteColumn(&lastArchived[i]);
+			globalColumns->EndBlock();
+		}
+		catch(CommonException& err)
+		{   // divert to standard output and try to continue
+			cout << "# File error - check disk for amount of free space" << endl;
+			cout << "# " << err.Message() << endl;
+		}
+		return;
+	}
     
 	// time (Legacy units ms)
 	char fline[1000],numStr[100];
@@ -1332,6 +1430,102 @@ void ArchiveData::GlobalArchive(double atime)
 	}
 }
 
+// Append task profile, constitutive law costs, and memory use for steps since the last profile
+// and start new interval
+void ArchiveData::ArchiveProfiles(double atime)
+{
+	int nsteps = fmobj->mstep-lastProfileStep;
+	if(nsteps<=0) return;
+	
+	// time (Legacy units ms)
+	double ptime = UnitsController::Scaling(1000.)*atime;
+	
+	ofstream pfile;
+	try
+	{	// task profile
+		if(profileFile!=NULL)
+		{	pfile.open(profileFile,ios::out | ios::app);
+			if(!pfile.is_open())
+				FileError("File error opening task profile",profileFile,"ArchiveData::ArchiveProfiles");
+			
+			MPMTask *nextMPMTask = firstMPMTask;
+			if(profileFormat==JSON_PROFILE)
+			{	pfile << "{\"step\":" << fmobj->mstep << ",\"time\":" << ptime << ",\"steps\":" << nsteps << ",\"tasks\":[";
+				while(nextMPMTask!=NULL)
+				{	if(nextMPMTask!=firstMPMTask) pfile << ",";
+					nextMPMTask->WriteProfileInterval(pfile,true,fmobj->mstep,ptime,nsteps);
+					nextMPMTask = (MPMTask *)nextMPMTask->GetNextTask();
+				}
+				pfile << "]}" << endl;
+			}
+			else
+			{	while(nextMPMTask!=NULL)
+				{	nextMPMTask->WriteProfileInterval(pfile,false,fmobj->mstep,ptime,nsteps);
+					nextMPMTask = (MPMTask *)nextMPMTask->GetNextTask();
+				}
+			}
+			if(pfile.bad())
+				FileError("File error writing task profile",profileFile,"ArchiveData::ArchiveProfiles");
+			pfile.close();
+			if(pfile.bad())
+				FileError("File error closing task profile",profileFile,"ArchiveData::ArchiveProfiles");
+		}
+		
+		// constitutive law costs
+		if(matProfileFile!=NULL && constitutiveProfile!=NULL)
+		{	pfile.open(matProfileFile,ios::out | ios::app);
+			if(!pfile.is_open())
+				FileError("File error opening constitutive law costs",matProfileFile,"ArchiveData::ArchiveProfiles");
+			if(matProfileFormat==JSON_PROFILE)
+			{	pfile << "{\"step\":" << fmobj->mstep << ",\"time\":" << ptime << ",\"steps\":" << nsteps << ",\"materials\":";
+				constitutiveProfile->WriteProfileInterval(pfile,true,fmobj->mstep,ptime,nsteps);
+				pfile << "}" << endl;
+			}
+			else
+				constitutiveProfile->WriteProfileInterval(pfile,false,fmobj->mstep,ptime,nsteps);
+			if(pfile.bad())
+				FileError("File error writing constitutive law costs",matProfileFile,"ArchiveData::ArchiveProfiles");
+			pfile.close();
+			if(pfile.bad())
+				FileError("File error closing constitutive law costs",matProfileFile,"ArchiveData::ArchiveProfiles");
+		}
+		
+		// memory use
+		if(memProfileFile!=NULL && memoryProfile!=NULL)
+		{	pfile.open(memProfileFile,ios::out | ios::app);
+			if(!pfile.is_open())
+				FileError("File error opening memory use",memProfileFile,"ArchiveData::ArchiveProfiles");
+			if(memProfileFormat==JSON_PROFILE)
+			{	pfile << "{\"step\":" << fmobj->mstep << ",\"time\":" << ptime << ",\"steps\":" << nsteps << ",\"memory\":";
+				memoryProfile->WriteProfileInterval(pfile,true,fmobj->mstep,ptime,nsteps);
+				pfile << "}" << endl;
+			}
+			else
+				memoryProfile->WriteProfileInterval(pfile,false,fmobj->mstep,ptime,nsteps);
+			if(pfile.bad())
+				FileError("File error writing memory use",memProfileFile,"ArchiveData::ArchiveProfiles");
+			pfile.close();
+			if(pfile.bad())
+				FileError("File error closing memory use",memProfileFile,"ArchiveData::ArchiveProfiles");
+		}
+	}
+	catch(CommonException& err)
+	{   // report and try to continue
+		cout << "# " << err.Message() << endl;
+		if(pfile.is_open()) pfile.close();
+	}
+	
+	// start next interval
+	MPMTask *nextMPMTask = firstMPMTask;
+	while(nextMPMTask!=NULL)
+	{	nextMPMTask->ResetProfileInterval();
+		nextMPMTask = (MPMTask *)nextMPMTask->GetNextTask();
+	}
+	if(constitutiveProfile!=NULL) constitutiveProfile->ResetProfileInterval();
+	if(memoryProfile!=NULL) memoryProfile->ResetProfileInterval();
+	lastProfileStep = fmobj->mstep;
+}
+
 // Archive global results if it is time
 void ArchiveData::Decohesion(double atime,MPMBase *mptr,double alpha,double beta,double gamma,
 							 		double GI,double GII1,double GII2,double decohesionCode)
@@ -1628,10 +1822,42 @@ void ArchiveData::ArchiveVTKFile(double atime,vector< int > quantity,vector< int
 }
 
 // Archive the results if it is time
-void ArchiveData::ArchiveHistoryFile(double atime,vector< int > quantity)
+// If historyColumns is not NULL, append block to that binary file instead
+void ArchiveData::ArchiveHistoryFile(double atime,vector< int > quantity,ColumnArchive *historyColumns)
 {
     char fname[300],fline[600],subline[100];
 	
+	if(historyColumns!=NULL)
+	{	// block with a row for each particle
+		historyColumns->StartBlock(nmpms,fmobj->mstep,atime*UnitsController::Scaling(1.e3));
+		
+		// particle numbers
+		vector< int > pnum(nmpms);
+		for(int p=0;p<nmpms;p++) pnum[p] = p+1;
+		historyColumns->WriteColumn(pnum.data());
+		
+		// position
+		vector< double > values(nmpms);
+		int numPos = threeD ? 3 : 2;
+		for(int i=0;i<numPos;i++)
+		{	for(int p=0;p<nmpms;p++)
+				values[p] = i==0 ? mpm[p]->pos.x : (i==1 ? mpm[p]->pos.y : mpm[p]->pos.z);
+			historyColumns->WriteColumn(values.data());
+		}
+		
+		// history data
+		for(unsigned int q=0;q<quantity.size();q++)
+		{
+#pragma omp parallel for
+			for(int p=0;p<nmpms;p++)
+				values[p] = theMaterials[mpm[p]->MatID()]->GetHistory(quantity[q],mpm[p]->GetHistoryPtr(0));
+			historyColumns->WriteColumn(values.data());
+		}
+		
+		historyColumns->EndBlock();
+		return;
+	}
+	
     // get relative path name to the file
     GetFilePathNum(fname,"%s%s_History_%d.txt",fmobj->mstep);
     
@@ -1679,6 +1905,26 @@ void ArchiveData::ArchiveHistoryFile(double atime,vector< int > quantity)
         FileError("File error closing a particle history archive file",fname,"ArchiveData::ArchiveHistoryFile");
 }
 
+// Create binary columnar file for particle history (root)_History.bin with a
+// column for particle number, position, and each history variable
+// throws CommonException()
+ColumnArchive *ArchiveData::CreateHistoryColumns(vector< int > &quantity)
+{
+	char fname[300],colName[50];
+	GetFilePath(fname,"%s%s_History.bin");
+	ColumnArchive *historyColumns = new ColumnArchive(fname);
+	historyColumns->AddColumn("particle",COLUMN_INT32);
+	historyColumns->AddColumn("x",COLUMN_DOUBLE);
+	historyColumns->AddColumn("y",COLUMN_DOUBLE);
+	if(threeD) historyColumns->AddColumn("z",COLUMN_DOUBLE);
+	for(unsigned int q=0;q<quantity.size();q++)
+	{	sprintf(colName,"%d",quantity[q]);
+		historyColumns->AddColumn(colName,COLUMN_DOUBLE);
+	}
+	historyColumns->CreateFile();
+	return historyColumns;
+}
+
 // force archive now, but stay on archiving schedule after that
 void ArchiveData::ForceArchiving(void)
 {	nextArchTime-=archTimes[archBlock];
@@ -1837,6 +2083,17 @@ double ArchiveData::GetLastArchived(int qIndex)
 	return lastArchived[qIndex];
 }
 
+// task profile format (NO_PROFILE, CSV_PROFILE, or JSON_PROFILE)
+void ArchiveData::SetTaskProfile(int format) { profileFormat = format; }
+
+// constitutive law costs format (NO_PROFILE, CSV_PROFILE, or JSON_PROFILE)
+void ArchiveData::SetMaterialProfile(int format) { matProfileFormat = format; }
+int ArchiveData::GetMaterialProfile(void) const { return matProfileFormat; }
+
+// memory use format (NO_PROFILE, CSV_PROFILE, or JSON_PROFILE)
+void ArchiveData::SetMemoryProfile(int format) { memProfileFormat = format; }
+int ArchiveData::GetMemoryProfile(void) const { return memProfileFormat; }
+
 // Propgation Counter
 void ArchiveData::IncrementPropagationCounter(void) { propgationCounter++; }
 void ArchiveData::SetMaxiumPropagations(int maxp)
@@ -1877,6 +2134,9 @@ double *ArchiveData::GetFirstArchTimePtr(void)
 // global time pointer
 double *ArchiveData::GetGlobalTimePtr(void) { return &globalTime; }
 
+// set to write global results to binary columnar file
+void ArchiveData::SetGlobalBinary(bool binary) { globalBinary = binary; }
+
 // for contact forces
 Vector *ArchiveData::GetLastContactForcePtr(void) { return contactForce; }
 
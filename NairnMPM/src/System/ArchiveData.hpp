@@ -17,6 +17,7 @@
 
 class BoundaryCondition;
 class MPMBase;
+class ColumnArchive;
 
 // Archiving both points and cracks
 #define ARCH_ByteOrder 0
@@ -40,6 +41,9 @@ enum { VTK_MASS=0, VTK_VELOCITY, VTK_STRESS, VTK_STRAIN, VTK_DISPLACEMENT, VTK_P
         VTK_EQUIVSTRAIN, VTK_HEATENERGY, VTK_BCFORCES, VTK_VOLUMEGRADIENT, VTK_NUMBERPOINTS,
 		VTK_DEFGRAD };
 
+// Task profile archive formats
+enum { NO_PROFILE=0, CSV_PROFILE, JSON_PROFILE };
+
 #define HEADER_LENGTH 64
 
 class ArchiveData : public CommonArchiveData
@@ -57,7 +61,8 @@ class ArchiveData : public CommonArchiveData
 		bool BeginArchives(bool,int);
 		void ArchiveResults(double);
 		void ArchiveVTKFile(double,vector< int >,vector< int >,vector< char * >,vector< int >,double **,int);
-		void ArchiveHistoryFile(double,vector< int >);
+		void ArchiveHistoryFile(double,vector< int >,ColumnArchive *);
+		ColumnArchive *CreateHistoryColumns(vector< int > &);
 		void FileError(const char *,const char *,const char *);
 		char *CreateFileInArchiveFolder(char *);
 	
@@ -89,8 +94,14 @@ class ArchiveData : public CommonArchiveData
 		double *GetArchTimePtr(void);
 		double *GetFirstArchTimePtr(void);
 		double *GetGlobalTimePtr(void);
+		void SetGlobalBinary(bool);
 		Vector *GetLastContactForcePtr(void);
 		double GetLastArchived(int);
+		void SetTaskProfile(int);
+		void SetMaterialProfile(int);
+		int GetMaterialProfile(void) const;
+		void SetMemoryProfile(int);
+		int GetMemoryProfile(void) const;
 		void Decohesion(double,MPMBase *,double,double,double,double,double,double,double);
 
 	private:
@@ -100,6 +111,8 @@ class ArchiveData : public CommonArchiveData
 		double nextArchTime,nextGlobalTime,globalTime;
 	
 		char *globalFile;
+		bool globalBinary;						// global results in binary columnar file
+		ColumnArchive *globalColumns;			// binary global results file (or NULL)
 		int recSize;							// archive record size
 		int mpmRecSize;							// particle record size
 		int crackRecSize;						// crack particle record size
@@ -116,6 +129,13 @@ class ArchiveData : public CommonArchiveData
 		double logStartTime;
 #endif
 		char *decohesionFile;					// decohesion file
+		int profileFormat;						// task profile format (NO_PROFILE if not archived)
+		char *profileFile;						// task profile file
+		int matProfileFormat;					// constitutive law costs format (NO_PROFILE if not archived)
+		char *matProfileFile;					// constitutive law costs file
+		int memProfileFormat;					// memory use format (NO_PROFILE if not archived)
+		char *memProfileFile;					// memory use file
+		int lastProfileStep;					// step of last task profile
 		int decohesionModes[11];				// initial modes (0 teminated) - softening materials max of 10
 	
 		// methods
@@ -123,6 +143,9 @@ class ArchiveData : public CommonArchiveData
 		void SetArchiveHeader(void);
 		void GlobalArchive(double);
 		void CreateGlobalFile(void);
+		void CreateProfileFiles(void);
+		char *CreateProfileFile(int,const char *,const char *);
+		void ArchiveProfiles(double);
 };
 
 extern ArchiveData *archiver;
@@ -0,0 +1,131 @@
+/********************************************************************************
+	ColumnArchive.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "System/ColumnArchive.hpp"
+#include "System/ArchiveData.hpp"
+#include "Exceptions/CommonException.hpp"
+
+#pragma mark ColumnArchive::Constructors and Destructors
+
+// Create for file at path (file is created in CreateFile())
+ColumnArchive::ColumnArchive(const char *filePath)
+{
+	path = new char[strlen(filePath)+1];
+	strcpy(path,filePath);
+	fp = NULL;
+	blockRows = 0;
+	nextColumn = 0;
+}
+
+// Destructor
+ColumnArchive::~ColumnArchive()
+{	if(fp!=NULL) fclose(fp);
+	delete [] path;
+}
+
+#pragma mark ColumnArchive::Methods
+
+// Add column to the schema (must be before CreateFile())
+void ColumnArchive::AddColumn(const char *name,int type)
+{	names.push_back(string(name));
+	types.push_back(type);
+}
+
+// Create file and write header with the schema
+// throws CommonException()
+void ColumnArchive::CreateFile(void)
+{
+	if((fp=fopen(path,"wb"))==NULL)
+		archiver->FileError("Binary archive file creation failed",path,"ColumnArchive::CreateFile");
+
+	Write(COLUMN_ARCHIVE_MAGIC,8);
+	int header[3] = { 1, COLUMN_ARCHIVE_VERSION, (int)names.size() };
+	Write(header,sizeof(header));
+	for(int i=0;i<(int)names.size();i++)
+	{	int column[2] = { types[i], (int)names[i].length() };
+		Write(column,sizeof(column));
+		Write(names[i].c_str(),names[i].length());
+	}
+
+	if(fclose(fp)!=0)
+	{	fp = NULL;
+		archiver->FileError("Binary archive file failed to close",path,"ColumnArchive::CreateFile");
+	}
+	fp = NULL;
+}
+
+// Append block header, then write all columns, then end the block
+// throws CommonException()
+void ColumnArchive::StartBlock(int numRows,int step,double atime)
+{
+	if((fp=fopen(path,"ab"))==NULL)
+		archiver->FileError("File error opening binary archive",path,"ColumnArchive::StartBlock");
+
+	blockRows = numRows;
+	nextColumn = 0;
+	int rowStep[2] = { numRows, step };
+	Write(rowStep,sizeof(rowStep));
+	Write(&atime,sizeof(double));
+}
+
+// Write next column of integers
+// throws CommonException()
+void ColumnArchive::WriteColumn(const int *values)
+{	CheckColumn(COLUMN_INT32);
+	Write(values,blockRows*sizeof(int));
+}
+
+// Write next column of doubles
+// throws CommonException()
+void ColumnArchive::WriteColumn(const double *values)
+{	CheckColumn(COLUMN_DOUBLE);
+	Write(values,blockRows*sizeof(double));
+}
+
+// Close file after writing all columns
+// throws CommonException()
+void ColumnArchive::EndBlock(void)
+{
+	int written = nextColumn;
+	int closed = fclose(fp);
+	fp = NULL;
+	if(written!=(int)types.size())
+		throw CommonException("Binary archive block did not write all columns","ColumnArchive::EndBlock");
+	if(closed!=0)
+		archiver->FileError("File error closing binary archive",path,"ColumnArchive::EndBlock");
+}
+
+// write bytes to open file
+// throws CommonException()
+void ColumnArchive::Write(const void *bytes,size_t length)
+{
+	if(length==0) return;
+	if(fwrite(bytes,length,1,fp)!=1)
+	{	fclose(fp);
+		fp = NULL;
+		archiver->FileError("File error writing binary archive",path,"ColumnArchive::Write");
+	}
+}
+
+// verify next column has the expected type
+// throws CommonException()
+void ColumnArchive::CheckColumn(int type)
+{
+	if(nextColumn>=(int)types.size() || types[nextColumn]!=type)
+	{	fclose(fp);
+		fp = NULL;
+		throw CommonException("Binary archive column does not match the file schema","ColumnArchive::WriteColumn");
+	}
+	nextColumn++;
+}
+
+#pragma mark ColumnArchive::Accessors
+
+// path to the file
+const char *ColumnArchive::GetPath(void) const { return path; }
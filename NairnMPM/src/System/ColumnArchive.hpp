@@ -0,0 +1,75 @@
+/********************************************************************************
+	ColumnArchive.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Binary, columnar file used for global results and particle history
+	when binary archives are requested. The file has a schema header and
+	then one block is appended at each archive. All values are in the
+	byte order of the computer that wrote the file; readers use the byte
+	order word to detect if bytes need to be reversed.
+
+	Header
+		char[8]		COLUMN_ARCHIVE_MAGIC
+		int32		1 (byte order)
+		int32		COLUMN_ARCHIVE_VERSION
+		int32		number of columns
+		for each column
+			int32	type (COLUMN_INT32 or COLUMN_DOUBLE)
+			int32	name length
+			char[]	name (no terminating zero)
+	Each block
+		int32		number of rows
+		int32		time step number
+		double		time (ms in Legacy units)
+		for each column
+			all rows of that column (int32 or double)
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _COLUMNARCHIVE_
+
+#define _COLUMNARCHIVE_
+
+#define COLUMN_ARCHIVE_MAGIC "NairnCol"
+#define COLUMN_ARCHIVE_VERSION 1
+
+// column types
+enum { COLUMN_INT32=1, COLUMN_DOUBLE };
+
+class ColumnArchive
+{
+	public:
+
+		// constructors and destructors
+		ColumnArchive(const char *);
+		~ColumnArchive();
+
+		// methods
+		void AddColumn(const char *,int);
+		void CreateFile(void);
+		void StartBlock(int,int,double);
+		void WriteColumn(const int *);
+		void WriteColumn(const double *);
+		void EndBlock(void);
+
+		// accessors
+		const char *GetPath(void) const;
+
+	private:
+		char *path;
+		vector< string > names;
+		vector< int > types;
+		FILE *fp;
+		int blockRows;
+		int nextColumn;
+
+		void Write(const void *,size_t);
+		void CheckColumn(int);
+};
+
+#endif
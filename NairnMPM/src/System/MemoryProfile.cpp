@@ -0,0 +1,217 @@
+/********************************************************************************
+	MemoryProfile.cpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+********************************************************************************/
+
+#include "stdafx.h"
+#include "System/MemoryProfile.hpp"
+#include "NairnMPM_Class/NairnMPM.hpp"
+#include "MPM_Classes/MatPoint2D.hpp"
+#include "MPM_Classes/MatPointAS.hpp"
+#include "MPM_Classes/MatPoint3D.hpp"
+#include "MPM_Classes/ParticleArena.hpp"
+#include "Nodes/NodalPoint.hpp"
+#include "Nodes/MaterialContactNode.hpp"
+#include "Patches/GridPatch.hpp"
+#include "Cracks/CrackHeader.hpp"
+#include "Cracks/CrackSegment.hpp"
+#include "Cracks/CrackNode.hpp"
+#ifndef WINDOWS_EXE
+#include <sys/resource.h>
+#endif
+
+// global object for memory accounting
+MemoryProfile *memoryProfile=NULL;
+
+#pragma mark MemoryProfile::Constructors and Destructors
+
+// Create to sample each time step or only at start and end
+MemoryProfile::MemoryProfile(bool sampleSteps)
+{
+	everyStep = sampleSteps;
+	for(int i=0;i<NUM_MEM_CATEGORIES;i++)
+		start[i] = current[i] = peak[i] = 0;
+	peakTotal = intervalPeak = 0;
+	peakStep = intervalPeakStep = 0;
+	numSamples = 0;
+}
+
+#pragma mark MemoryProfile::Methods
+
+// Find bytes in each category at the current step and update peaks
+void MemoryProfile::Sample(int step)
+{
+	// particle objects (size depends on analysis type) and their heap data
+	size_t particleSize;
+	if(fmobj->IsThreeD())
+		particleSize = sizeof(MatPoint3D);
+	else if(fmobj->IsAxisymmetric())
+		particleSize = sizeof(MatPointAS);
+	else
+		particleSize = sizeof(MatPoint2D);
+	size_t particleBytes = 0,dataBytes = 0;
+#pragma omp parallel for reduction(+:particleBytes,dataBytes)
+	for(int p=0;p<nmpms;p++)
+		mpm[p]->AddMemoryBytes(particleBytes,dataBytes);
+	current[MEM_PARTICLES] = nmpms*(sizeof(MPMBase *)+particleSize) + particleBytes;
+
+	// history and domain data in the arena and on the heap
+	if(particleArena!=NULL) dataBytes += particleArena->BytesReserved();
+	current[MEM_HISTORY] = dataBytes;
+
+	// nodes, node list, and active node list
+	current[MEM_NODES] = nnodes*sizeof(NodalPoint) + (nnodes+1)*(sizeof(NodalPoint *)+sizeof(int));
+
+	// crack and material velocity fields on the nodes
+	size_t fieldBytes = 0;
+#pragma omp parallel for reduction(+:fieldBytes)
+	for(int i=1;i<=nnodes;i++)
+		fieldBytes += nd[i]->FieldMemoryBytes();
+	current[MEM_FIELDS] = fieldBytes;
+
+	// ghost nodes and their velocity fields
+	current[MEM_GHOSTS] = 0;
+	if(patches!=NULL)
+	{	int totalPatches = fmobj->GetTotalNumberOfPatches();
+		for(int pn=0;pn<totalPatches;pn++)
+			current[MEM_GHOSTS] += sizeof(GridPatch)+patches[pn]->MemoryBytes();
+	}
+
+	// material and crack contact nodes
+	current[MEM_CONTACT] = MaterialContactNode::MemoryBytes() + CrackNode::MemoryBytes();
+
+	// crack segments
+	current[MEM_CRACKS] = 0;
+	CrackHeader *nextCrack = firstCrack;
+	while(nextCrack!=NULL)
+	{	current[MEM_CRACKS] += sizeof(CrackHeader)+nextCrack->NumberOfSegments()*sizeof(CrackSegment);
+		nextCrack = (CrackHeader *)nextCrack->GetNextObject();
+	}
+
+	// peaks
+	size_t total = Total(current);
+	for(int i=0;i<NUM_MEM_CATEGORIES;i++)
+	{	if(numSamples==0) start[i] = current[i];
+		if(current[i]>peak[i]) peak[i] = current[i];
+	}
+	if(total>peakTotal || numSamples==0)
+	{	peakTotal = total;
+		peakStep = step;
+	}
+	if(total>intervalPeak)
+	{	intervalPeak = total;
+		intervalPeakStep = step;
+	}
+	numSamples++;
+}
+
+// Sample after a time step if sampling every step
+void MemoryProfile::SampleStep(int step)
+{	if(everyStep) Sample(step);
+}
+
+// Write current bytes in each category and peak total since the last interval
+// JSON is one object, CSV is one line
+void MemoryProfile::WriteProfileInterval(ostream &os,bool json,int step,double atime,int nsteps)
+{
+	size_t total = Total(current);
+	size_t processPeak = ProcessPeakBytes();
+	if(json)
+	{	os << "{";
+		for(int i=0;i<NUM_MEM_CATEGORIES;i++)
+			os << "\"" << CategoryLabel(i) << "\":" << current[i] << ",";
+		os << "\"total\":" << total << ",\"peak_total\":" << intervalPeak << ",\"peak_step\":" << intervalPeakStep
+			<< ",\"process_peak\":" << processPeak << "}";
+	}
+	else
+	{	// step,time,steps,particles,history,nodes,fields,ghosts,contact,cracks,total,peak_total,peak_step,process_peak
+		os << step << "," << atime << "," << nsteps;
+		for(int i=0;i<NUM_MEM_CATEGORIES;i++)
+			os << "," << current[i];
+		os << "," << total << "," << intervalPeak << "," << intervalPeakStep << "," << processPeak << endl;
+	}
+}
+
+// start new interval at the current memory use
+void MemoryProfile::ResetProfileInterval(void)
+{	intervalPeak = Total(current);
+	intervalPeakStep = fmobj->mstep;
+}
+
+// Print memory use at start, at end, and peak in MB to standard output
+void MemoryProfile::PrintSummary(void) const
+{
+	if(numSamples==0) return;
+
+	char fline[200];
+	double mb = 1./1048576.;
+	cout << "\nMemory Use (MB, sampled " << (everyStep ? "every step" : "at start and end") << ")" << endl;
+	sprintf(fline,"%-20s %12s %12s %12s","Category","Start","End","Peak");
+	cout << fline << endl;
+	for(int i=0;i<NUM_MEM_CATEGORIES;i++)
+	{	if(peak[i]==0) continue;
+		sprintf(fline,"%-20s %12.3lf %12.3lf %12.3lf",CategoryLabel(i),mb*start[i],mb*current[i],mb*peak[i]);
+		cout << fline << endl;
+	}
+	sprintf(fline,"%-20s %12.3lf %12.3lf %12.3lf (step %d)","total",mb*Total(start),mb*Total(current),mb*peakTotal,peakStep);
+	cout << fline << endl;
+	size_t processPeak = ProcessPeakBytes();
+	if(processPeak>0)
+	{	sprintf(fline,"Process peak resident memory: %.3lf MB",mb*processPeak);
+		cout << fline << endl;
+	}
+}
+
+#pragma mark MemoryProfile::Class Methods
+
+// peak resident memory of this process in bytes (0 if not available)
+size_t MemoryProfile::ProcessPeakBytes(void)
+{
+#ifdef WINDOWS_EXE
+	return 0;
+#else
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF,&usage)!=0) return 0;
+#ifdef __APPLE__
+	// bytes on MacOS
+	return (size_t)usage.ru_maxrss;
+#else
+	// kilobytes on Linux
+	return 1024*(size_t)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// label used in output and archives
+const char *MemoryProfile::CategoryLabel(int category)
+{
+	switch(category)
+	{	case MEM_PARTICLES:
+			return "particles";
+		case MEM_HISTORY:
+			return "history";
+		case MEM_NODES:
+			return "nodes";
+		case MEM_FIELDS:
+			return "fields";
+		case MEM_GHOSTS:
+			return "ghosts";
+		case MEM_CONTACT:
+			return "contact";
+		case MEM_CRACKS:
+			return "cracks";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
+// sum of all categories
+size_t MemoryProfile::Total(const size_t *bytes)
+{	size_t total = 0;
+	for(int i=0;i<NUM_MEM_CATEGORIES;i++) total += bytes[i];
+	return total;
+}
@@ -0,0 +1,61 @@
+/********************************************************************************
+	MemoryProfile.hpp
+	nairn-mpm-fea
+
+	Created by John Nairn on Oct 19, 2026.
+	Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	Accounting of memory used by the main data structures. Each sample
+	adds up bytes allocated for particles, particle history and domain
+	data, nodes, crack and material velocity fields on nodes, ghost nodes
+	in patches, contact nodes, and crack segments (heap overhead is not
+	included). The calculation is sampled at the start and end, or every
+	time step when requested by <MemoryProfile> command, which also
+	writes current values and peak since the previous archive at each
+	archive. A summary is printed at the end of the run.
+
+	Dependencies
+		none
+********************************************************************************/
+
+#ifndef _MEMORYPROFILE_
+
+#define _MEMORYPROFILE_
+
+// memory categories
+enum { MEM_PARTICLES=0, MEM_HISTORY, MEM_NODES, MEM_FIELDS, MEM_GHOSTS, MEM_CONTACT, MEM_CRACKS, NUM_MEM_CATEGORIES };
+
+class MemoryProfile
+{
+	public:
+
+		// constructors and destructors
+		MemoryProfile(bool);
+
+		// methods
+		void Sample(int);
+		void SampleStep(int);
+		void WriteProfileInterval(ostream &,bool,int,double,int);
+		void ResetProfileInterval(void);
+		void PrintSummary(void) const;
+
+		// class methods
+		static size_t ProcessPeakBytes(void);
+		static const char *CategoryLabel(int);
+
+	private:
+		bool everyStep;
+		size_t start[NUM_MEM_CATEGORIES];		// at start of calculation
+		size_t current[NUM_MEM_CATEGORIES];		// most recent sample
+		size_t peak[NUM_MEM_CATEGORIES];		// peak for each category
+		size_t peakTotal,intervalPeak;			// peak total for run and since last archive
+		int peakStep,intervalPeakStep;
+		int numSamples;
+
+		static size_t Total(const size_t *);
+};
+
+// global object for memory accounting (NULL until analysis starts)
+extern MemoryProfile *memoryProfile;
+
+#endif
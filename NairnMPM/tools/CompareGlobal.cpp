@@ -7,6 +7,9 @@
     Copyright (c) 2018 John A. Nairn, All rights reserved.
 	
  	CompareGlobal -o filename (filename)
+ 
+	Files can be text global files or binary columnar files (global
+	or particle history) written by NairnMPM
 *********************************************************************/
 
 #include "CompareGlobal.hpp"
@@ -116,7 +119,8 @@ void Usage(const char *msg)
     cout << "\nUsage:\n"
         "    CompareGlobal -o <OriginalFile> <CompareFile>\n\n"
         "This program compares MPM global results in <CompareFile> numerically\n"
-        "to the MPM global results in <OriginalFile>\n\n"
+        "to the MPM global results in <OriginalFile>. Each file can be a text\n"
+        "global file or a binary columnar file\n\n"
         "  Options:\n"
 		"    -o path            Original file name (required)\n"
 		"		                       (quoted if name has spaces)\n"
@@ -430,11 +434,114 @@ unsigned char *ReadGlobalFile(const char *filename,long &fileLength)
 		fclose(fo);
 		return NULL;
 	}
+	fclose(fo);
+	
+	// convert binary columnar file to text
+	if(fileLength>=8 && memcmp(buffer,COLUMN_ARCHIVE_MAGIC,8)==0)
+	{	unsigned char *text = ConvertColumnFile(buffer,fileLength);
+		free(buffer);
+		if(text==NULL)
+			cerr << "Target file '" << filename << "' is not a valid binary columnar file" << endl;
+		return text;
+	}
 	
 	return buffer;
 	
 }
 
+// Convert binary columnar file to text in the same form as global
+// files with one row for each row in each block, time in the first
+// column, and column names in the #setName line
+unsigned char *ConvertColumnFile(unsigned char *buffer,long &fileLength)
+{
+	unsigned char *bptr = buffer+8;
+	unsigned char *bend = buffer+fileLength;
+	
+	// byte order (1 if same as this computer), version, and number of columns
+	int byteOrder,version,numColumns;
+	if(!ReadColumnBytes(&bptr,bend,&byteOrder,sizeof(int),false)) return NULL;
+	bool swap = byteOrder!=1;
+	if(!ReadColumnBytes(&bptr,bend,&version,sizeof(int),swap)) return NULL;
+	if(!ReadColumnBytes(&bptr,bend,&numColumns,sizeof(int),swap)) return NULL;
+	if(numColumns<0 || numColumns>=MAX_COLUMNS) return NULL;
+	
+	// column names
+	string text = "#setName";
+	vector< int > types;
+	for(int i=0;i<numColumns;i++)
+	{	int type,nameLength;
+		if(!ReadColumnBytes(&bptr,bend,&type,sizeof(int),swap)) return NULL;
+		if(!ReadColumnBytes(&bptr,bend,&nameLength,sizeof(int),swap)) return NULL;
+		if(nameLength<0 || bptr+nameLength>bend) return NULL;
+		text += "\t\"" + string((const char *)bptr,nameLength) + "\"";
+		bptr += nameLength;
+		types.push_back(type);
+	}
+	text += "\n";
+	
+	// each block
+	char numStr[50];
+	while(bptr<bend)
+	{	int numRows,step;
+		double atime;
+		if(!ReadColumnBytes(&bptr,bend,&numRows,sizeof(int),swap)) return NULL;
+		if(!ReadColumnBytes(&bptr,bend,&step,sizeof(int),swap)) return NULL;
+		if(!ReadColumnBytes(&bptr,bend,&atime,sizeof(double),swap)) return NULL;
+		
+		// start of each column
+		vector< unsigned char * > columns;
+		for(int i=0;i<numColumns;i++)
+		{	columns.push_back(bptr);
+			bptr += (long)numRows*(types[i]==COLUMN_INT32 ? sizeof(int) : sizeof(double));
+			if(bptr>bend) return NULL;
+		}
+		
+		// each row
+		for(int r=0;r<numRows;r++)
+		{	sprintf(numStr,"%.17g",atime);
+			text += numStr;
+			for(int i=0;i<numColumns;i++)
+			{	if(types[i]==COLUMN_INT32)
+				{	int ivalue;
+					unsigned char *vptr = columns[i]+r*sizeof(int);
+					ReadColumnBytes(&vptr,bend,&ivalue,sizeof(int),swap);
+					sprintf(numStr,"\t%d",ivalue);
+				}
+				else
+				{	double dvalue;
+					unsigned char *vptr = columns[i]+r*sizeof(double);
+					ReadColumnBytes(&vptr,bend,&dvalue,sizeof(double),swap);
+					sprintf(numStr,"\t%.17g",dvalue);
+				}
+				text += numStr;
+			}
+			text += "\n";
+		}
+	}
+	
+	// copy to buffer
+	fileLength = (long)text.length();
+	unsigned char *textBuffer=(unsigned char *)malloc(fileLength+1);
+	if(textBuffer==NULL)
+	{	cerr << "Out of memory converting binary file" << endl;
+		return NULL;
+	}
+	memcpy(textBuffer,text.c_str(),fileLength+1);
+	return textBuffer;
+}
+
+// Read value with size bytes and advance pointer (reverse bytes if needed)
+// return false if past end of the data
+bool ReadColumnBytes(unsigned char **bptr,unsigned char *bend,void *value,int size,bool swap)
+{
+	if(*bptr+size>bend) return false;
+	unsigned char *vptr = (unsigned char *)value;
+	for(int i=0;i<size;i++)
+		vptr[i] = swap ? (*bptr)[size-1-i] : (*bptr)[i];
+	*bptr += size;
+	return true;
+}
+
 bool DbleEqual(double A, double B)
 {
 	// Check if the numbers are really close -- needed
@@ -14,13 +14,18 @@
 #include <fstream>
 #include <math.h>
 #include <vector>
+#include <string>
 
-#define MAX_FILE_LINE 1000
+#define MAX_FILE_LINE 4000
 #define MAX_COLUMNS 100
 #define NUMBER_STATS 5
 #define MAX_DIFF 1.0e-16
 #define MAX_REL_DIFF 1.0e-7
 
+// binary columnar files (see ColumnArchive.hpp in NairnMPM)
+#define COLUMN_ARCHIVE_MAGIC "NairnCol"
+enum { COLUMN_INT32=1, COLUMN_DOUBLE };
+
 
 using namespace std;
 
@@ -33,5 +38,7 @@ void Usage(const char *);
 void CompareGlobalFiles(const char *,int,int);
 unsigned char *ReadLine(unsigned char *bptr,unsigned char *bend,unsigned char *rline,int *);
 unsigned char *ReadGlobalFile(const char *,long &);
+unsigned char *ConvertColumnFile(unsigned char *,long &);
+bool ReadColumnBytes(unsigned char **,unsigned char *,void *,int,bool);
 bool DbleEqual(double A, double B);
 
@@ -58,10 +58,24 @@ unsigned char *buffer;
 long fileLength,seekOffset,blockSize;
 FILE *fp;
 unsigned char *ap,*apNextBlock;
+bool mappedFile=false;
+int numThreads=0;
 
-// 50 MB chunks
+// 50 MB chunks (when not memory mapped)
 #define MAX_READ_BLOCK 50000000
 
+// particles formatted by each thread before writing in order
+#define PARTICLE_BLOCK 20000
+
+// Each thread extracts its own files and needs its own file and record layout
+// variables. Threads formatting particles in one file copy the layout with copyin.
+#define LAYOUT_VARIABLES mpmOrder,crackOrder,stepNum,threeD,isStructured,archiveTimeMs,recSize, \
+		vectorSize,tensorSize,reverseFromInput,angleOffset,angleYOffset,angleXOffset,posOffset, \
+		stressOffset,strainOffset,crackPosOffset,jIntOffset,kSifOffset,velocityOffset,origPosOffset, \
+		plStrainOffset,tempOffset,concOffset,strainEnergyOffset,plasticEnergyOffset,history1Offset, \
+		history2Offset,history3Offset,history4Offset,workEnergyOffset,heatEnergyOffset,rotStrainOffset
+#pragma omp threadprivate(LAYOUT_VARIABLES,buffer,fileLength,seekOffset,blockSize,fp,ap,apNextBlock,mappedFile)
+
 #pragma mark MAIN AND INPUT PARAMETERS
 
 // main entry point
@@ -320,6 +334,12 @@ int main(int argc, char * const argv[])
 				strcpy(fileExtension,"xyz");
 			}
 			
+			// NairnMPM binary particle file to initialize particles
+			else if(argv[parmInd][optInd]=='I')
+			{	fileFormat='I';
+				strcpy(fileExtension,"mpts");
+			}
+			
 			// 3D file
 			else if(argv[parmInd][optInd]=='3')
 			{	threeD=true;
@@ -345,6 +365,18 @@ int main(int argc, char * const argv[])
 			{	header=true;
 			}
 			
+			// number of threads (must be j, space, number)
+			else if(argv[parmInd][optInd]=='j')
+			{	parm=NextArgument(++parmInd,argv,argc,'j');
+				if(parm==NULL) return BadOptionErr;
+				sscanf(parm,"%d",&numThreads);
+				if(numThreads<=0)
+				{   cerr << "ExtractMPM option 'j' must be a positive integer" << endl;
+					return BadOptionErr;
+				}
+				break;
+			}
+			
 			else
 			{   cerr << "Unknown ExtractMPM option '" << argv[parmInd][optInd] << "' was used\n";
 				return BadOptionErr;
@@ -368,12 +400,33 @@ int main(int argc, char * const argv[])
     char *testPtr=(char *)&test;			// point to first byte
 	thisEndian = *testPtr==1 ? 'i' : 'm' ;
 	
+#ifdef _OPENMP
+	if(numThreads>0) omp_set_num_threads(numThreads);
+#endif
+	
 	// extract the data
 	int fileNum;
-    for(fileNum=parmInd;fileNum<argc;fileNum++)
-	{	int result=ExtractMPMData(argv[fileNum],fileNum-parmInd,argc-parmInd-1);
+	if(outfile!=NULL && argc-parmInd>1)
+	{	// each file has its own output file, so extract files in parallel
+		int result=noErr;
+#pragma omp parallel for schedule(dynamic,1) copyin(mpmOrder,crackOrder,threeD)
+		for(fileNum=parmInd;fileNum<argc;fileNum++)
+		{	int fileResult=ExtractMPMData(argv[fileNum],fileNum-parmInd,argc-parmInd-1);
+			if(fileResult!=noErr)
+			{
+#pragma omp critical (error)
+				{	if(result==noErr) result=fileResult;
+				}
+			}
+		}
 		if(result!=noErr) return result;
 	}
+	else
+	{	for(fileNum=parmInd;fileNum<argc;fileNum++)
+		{	int result=ExtractMPMData(argv[fileNum],fileNum-parmInd,argc-parmInd-1);
+			if(result!=noErr) return result;
+		}
+	}
 	
     // insert code here...
     return noErr;
@@ -397,7 +450,7 @@ void Usage(const char *msg)
 	if(msg!=NULL)
 		cout << "\nERROR: " << msg << endl;
 		
-	cout << "\nExtractMPM\n    version 1.0.0" << endl;
+	cout << "\nExtractMPM\n    version 1.1.0" << endl;
     cout << "\nUsage:\n"
         "    ExtractMPM [-options] <InputFile>\n\n"
         "This program reads the <InputFile>, extracts the desired data as\n"
@@ -429,7 +482,14 @@ void Usage(const char *msg)
         "    -D                 Output as big Endian binary doubles file\n"
         "    -f                 Output as little Endian binary floats file\n"
         "    -F                 Output as big Endian binary floats file\n"
+        "    -I                 Output as NairnMPM binary particle file to initialize\n"
+        "                              particles in <PointFile> (position, velocity,\n"
+        "                              stress, temperature, and concentration only;\n"
+        "                              not a restart because strains and history\n"
+        "                              are not included)\n"
 		"  Other options\n"
+        "    -j num             Number of threads for extracting files and\n"
+        "                              particles (default: all processors)\n"
         "    -H (of -?)         Show this help and exit\n"
 		"\n"
         "See http://osupdocs.forestry.oregonstate.edu/index.php/ExtractMPM for documentation.\n\n"
@@ -458,35 +518,8 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 	}
 	
 	// open the file
-	if((fp=fopen(mpmFile,"r"))==NULL)
-	{	cerr << "Input file '" << mpmFile << "' could not be opened" << endl;
-		return FileAccessErr;
-	}
-	
-	// get file length
-	if(fseek(fp,0L,SEEK_END)!=0)
-	{	cerr << "Input file '" << mpmFile << "' access error (fseek())" << endl;
-		fclose(fp);
-		return FileAccessErr;
-	}
-	fileLength=ftell(fp);
-	rewind(fp);
-	
-	// read first  block of file into buffer
-    blockSize = fileLength>MAX_READ_BLOCK ? MAX_READ_BLOCK : fileLength;
-	buffer=(unsigned char *)malloc(blockSize);
-	if(buffer==NULL)
-	{	cerr << "Out of memory creating file reading buffer" << endl;
-		fclose(fp);
-		return MemoryErr;
-	}
-    
-    // read first block
-	if(fread(buffer,blockSize,1,fp)!=1)
-	{	cerr << "Input file '" << mpmFile << "' access error (not all read)" << endl;
-		fclose(fp);
-		return FileAccessErr;
-	}
+	int openResult=OpenArchiveFile(mpmFile);
+	if(openResult!=noErr) return openResult;
     
     // set up point
     ap=buffer;
@@ -549,8 +582,11 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 		return FileAccessErr;
 	}
     
-    // adjust block end pointer
-    apNextBlock = fileLength>MAX_READ_BLOCK ? ap+MAX_READ_BLOCK-2*recSize : ap+MAX_READ_BLOCK+1;
+    // adjust block end pointer (never reached when the whole file is mapped)
+	if(mappedFile)
+		apNextBlock = buffer+fileLength+1;
+	else
+		apNextBlock = fileLength>MAX_READ_BLOCK ? ap+MAX_READ_BLOCK-2*recSize : ap+MAX_READ_BLOCK+1;
 
 	// output file
 	ofstream fout;
@@ -586,12 +622,16 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 			else
 				sprintf(fname,"%s-%d.%s",outfile,fileIndex,fileExtension);
 		}
-		fout.open(fname);
+		if(fileFormat=='I')
+			fout.open(fname,ios::out | ios::binary);
+		else
+			fout.open(fname);
 		if(!outfile)
 		{	cerr << "Output file '" << fname << "' could not be created" << endl;
 			return FileAccessErr;
 		}
 		
+#pragma omp critical (output)
 		cout << "Writing file '" << fname << "'" << endl;
 	}
 	
@@ -605,8 +645,7 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 			return FileAccessErr;
 		}
 		int vtkResult = VTKLegacy(os,mpmFile);
-        fclose(fp);
-		free(buffer);
+		CloseArchiveFile();
 		return vtkResult;
 	}
 	
@@ -617,11 +656,25 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 			return FileAccessErr;
 		}
 		int xyzResult = XYZExport(os,mpmFile);
-		fclose(fp);
-		free(buffer);
+		CloseArchiveFile();
 		return xyzResult;
 	}
 	
+	// special case for binary particle files
+	else if(fileFormat=='I')
+	{	if(crackDataOnly)
+		{	cerr << "Exports to NairnMPM particle files cannot be for crack data" << endl;
+			return FileAccessErr;
+		}
+		if(outfile==NULL)
+		{	cerr << "Exports to NairnMPM particle files require an output file name" << endl;
+			return FileAccessErr;
+		}
+		int pfResult = ParticleFileExport(os,mpmFile);
+		CloseArchiveFile();
+		return pfResult;
+	}
+	
 	// optional header
 	if(header)
 	{	char *headBuffer=new char[2500];
@@ -728,78 +781,24 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 	int p;
 	short *mptr;
 	BeginMP(os);
-	for(p=0;p<nummpms;p++)
-    {   // read next block when needed
-        if(!GetNextFileBlock(mpmFile)) return FileAccessErr;
-        
-		short matnum=pointMatnum(ap);
-		if(matnum<0) break;
-		
-		// skip if crack data export
-		if(crackDataOnly)
-		{	ap+=recSize;
-			continue;
-		}
-		
-		// if skip is true here, that skip this material
-		if(skipThisPoint(matnum))
-		{	ap+=recSize;
-			continue;
-		}
-		
-		// write position, special for XML which starts the <mp> element
-		if(fileFormat!='X')
-		{	OutputDouble((double *)(ap+posOffset),0,0,reverseFromInput,os,XPOS);
-		    OutputDouble((double *)(ap+posOffset),1,'\t',reverseFromInput,os,YPOS);
-		    if(threeD) OutputDouble((double *)(ap+posOffset),2,'\t',reverseFromInput,os,ZPOS);
-		}
-		else
-		{	// begin mp element (mat, angle, thickness always output)
-			os << "  <mp matl='" << matnum << "'";
-			if(!threeD)
-			{	double *angle=(double *)(ap+angleOffset);
-				double *thickness=(double *)(ap+angleOffset+sizeof(double));
-				if(reverseFromInput)
-				{	Reverse((char *)angle, sizeof(double));
-					Reverse((char *)thickness, sizeof(double));
-				}
-				os << " angle='" << *angle << "' thick='" << *thickness << "'";
-			}
-			if(tempOffset>0 && hasTempQ)
-			{	double *temp=(double *)(ap+tempOffset);
-				if(reverseFromInput) Reverse((char *)temp,sizeof(double));
-				os << " temp='" << *temp << '"';
-			}
-			if(concOffset>0 && hasConcQ)
-			{	double *conc=(double *)(ap+concOffset);
-				if(reverseFromInput) Reverse((char *)conc,sizeof(double));
-				os << " wtconc='" << *conc << '"';
-			}
-			// future: add conc and temp attributes if requested
-			os << ">" << endl;
+	if(mappedFile && !crackDataOnly)
+	{	// all particles are in memory and can be formatted in parallel
+		p=ExtractParticles(os,ap,nummpms);
+		ap+=(long)p*recSize;
+	}
+	else
+	{	for(p=0;p<nummpms;p++)
+		{   // read next block when needed
+			if(!GetNextFileBlock(mpmFile)) return FileAccessErr;
 			
-			// subordinate mp element for position
-			double *xpos=(double *)(ap+posOffset);
-			double *ypos=xpos+1;
-			if(reverseFromInput)
-			{	Reverse((char *)xpos, sizeof(double));
-				Reverse((char *)ypos, sizeof(double));
-			}
-			os << "    <pt x='" << *xpos << "' y='" << *ypos << "'";
-			if(threeD)
-			{	double *zpos=xpos+2;
-				if(reverseFromInput)  Reverse((char *)zpos, sizeof(double));
-			    os << " z='" << *zpos << "'";
-            }
-			os << "/>" << endl;
+			short matnum=pointMatnum(ap);
+			if(matnum<0) break;
+			
+			// output unless crack data export or skipping this material
+			if(!crackDataOnly && !skipThisPoint(matnum))
+				OutputParticle(os,ap,matnum);
+			ap+=recSize;
 		}
-		
-		// write quantities
-		for(i=0;i<(int)quantity.size();i++)
-			OutputQuantity(i,ap,os,matnum,'\t');
-		
-		OutputRecordEnd(os,true);
-		ap+=recSize;
 	}
 	EndMP(os);
 	
@@ -878,11 +877,164 @@ int ExtractMPMData(const char *mpmFile,int fileIndex,int lastIndex)
 		EndCrack(os);
 	}
 	
-	free(buffer);
-    fclose(fp);
+	CloseArchiveFile();
+	return noErr;
+}
+
+// Open archive file and map it into memory (or read first block into buffer if
+// can not map). Sets buffer, fileLength, and mappedFile
+int OpenArchiveFile(const char *mpmFile)
+{
+	if((fp=fopen(mpmFile,"r"))==NULL)
+	{	cerr << "Input file '" << mpmFile << "' could not be opened" << endl;
+		return FileAccessErr;
+	}
+	
+	// get file length
+	if(fseek(fp,0L,SEEK_END)!=0)
+	{	cerr << "Input file '" << mpmFile << "' access error (fseek())" << endl;
+		fclose(fp);
+		return FileAccessErr;
+	}
+	fileLength=ftell(fp);
+	rewind(fp);
+	
+#ifdef USE_MMAP
+	// private mapping because byte reversal changes data in place (copied only if changed)
+	mappedFile=false;
+	if(fileLength>0)
+	{	void *mapped=mmap(NULL,(size_t)fileLength,PROT_READ | PROT_WRITE,MAP_PRIVATE,fileno(fp),0);
+		if(mapped!=MAP_FAILED)
+		{	madvise(mapped,(size_t)fileLength,MADV_SEQUENTIAL);
+			buffer=(unsigned char *)mapped;
+			blockSize=fileLength;
+			mappedFile=true;
+			return noErr;
+		}
+	}
+#endif
+	
+	// read first  block of file into buffer
+    blockSize = fileLength>MAX_READ_BLOCK ? MAX_READ_BLOCK : fileLength;
+	buffer=(unsigned char *)malloc(blockSize);
+	if(buffer==NULL)
+	{	cerr << "Out of memory creating file reading buffer" << endl;
+		fclose(fp);
+		return MemoryErr;
+	}
+    
+    // read first block
+	if(fread(buffer,blockSize,1,fp)!=1)
+	{	cerr << "Input file '" << mpmFile << "' access error (not all read)" << endl;
+		fclose(fp);
+		return FileAccessErr;
+	}
 	return noErr;
 }
 
+// release mapping or buffer and close the file
+void CloseArchiveFile(void)
+{
+#ifdef USE_MMAP
+	if(mappedFile)
+	{	munmap(buffer,(size_t)fileLength);
+		mappedFile=false;
+		fclose(fp);
+		return;
+	}
+#endif
+	free(buffer);
+	fclose(fp);
+}
+
+// Output particles from mapped file starting at firstRecord by formatting blocks of
+// particles in parallel and writing the blocks in order
+// Return number of particle records (crack records start after them)
+int ExtractParticles(ostream &os,unsigned char *firstRecord,int nummpms)
+{
+	// particles end at first record with negative material
+	int numParticles=0;
+	while(numParticles<nummpms && recordMatnum(firstRecord+(long)numParticles*recSize)>=0)
+		numParticles++;
+	
+	int numBlocks=(numParticles+PARTICLE_BLOCK-1)/PARTICLE_BLOCK;
+#pragma omp parallel for ordered schedule(static,1) copyin(LAYOUT_VARIABLES)
+	for(int b=0;b<numBlocks;b++)
+	{	ostringstream block;
+		block.copyfmt(os);
+		int pend = b*PARTICLE_BLOCK+PARTICLE_BLOCK<numParticles ? b*PARTICLE_BLOCK+PARTICLE_BLOCK : numParticles;
+		for(int p=b*PARTICLE_BLOCK;p<pend;p++)
+		{	unsigned char *rp=firstRecord+(long)p*recSize;
+			short matnum=pointMatnum(rp);
+			if(!skipThisPoint(matnum)) OutputParticle(block,rp,matnum);
+		}
+		
+#pragma omp ordered
+		{	string text=block.str();
+			os.write(text.data(),text.size());
+		}
+	}
+	
+	return numParticles;
+}
+
+// Output one particle record at ap for material matnum
+void OutputParticle(ostream &os,unsigned char *ap,short matnum)
+{
+	// write position, special for XML which starts the <mp> element
+	if(fileFormat!='X')
+	{	OutputDouble((double *)(ap+posOffset),0,0,reverseFromInput,os,XPOS);
+	    OutputDouble((double *)(ap+posOffset),1,'\t',reverseFromInput,os,YPOS);
+	    if(threeD) OutputDouble((double *)(ap+posOffset),2,'\t',reverseFromInput,os,ZPOS);
+	}
+	else
+	{	// begin mp element (mat, angle, thickness always output)
+		os << "  <mp matl='" << matnum << "'";
+		if(!threeD)
+		{	double *angle=(double *)(ap+angleOffset);
+			double *thickness=(double *)(ap+angleOffset+sizeof(double));
+			if(reverseFromInput)
+			{	Reverse((char *)angle, sizeof(double));
+				Reverse((char *)thickness, sizeof(double));
+			}
+			os << " angle='" << *angle << "' thick='" << *thickness << "'";
+		}
+		if(tempOffset>0 && hasTempQ)
+		{	double *temp=(double *)(ap+tempOffset);
+			if(reverseFromInput) Reverse((char *)temp,sizeof(double));
+			os << " temp='" << *temp << '"';
+		}
+		if(concOffset>0 && hasConcQ)
+		{	double *conc=(double *)(ap+concOffset);
+			if(reverseFromInput) Reverse((char *)conc,sizeof(double));
+			os << " wtconc='" << *conc << '"';
+		}
+		// future: add conc and temp attributes if requested
+		os << ">" << endl;
+		
+		// subordinate mp element for position
+		double *xpos=(double *)(ap+posOffset);
+		double *ypos=xpos+1;
+		if(reverseFromInput)
+		{	Reverse((char *)xpos, sizeof(double));
+			Reverse((char *)ypos, sizeof(double));
+		}
+		os << "    <pt x='" << *xpos << "' y='" << *ypos << "'";
+		if(threeD)
+		{	double *zpos=xpos+2;
+			if(reverseFromInput)  Reverse((char *)zpos, sizeof(double));
+		    os << " z='" << *zpos << "'";
+		}
+		os << "/>" << endl;
+	}
+	
+	// write quantities
+	for(int i=0;i<(int)quantity.size();i++)
+		OutputQuantity(i,ap,os,matnum,'\t');
+	
+	OutputRecordEnd(os,true);
+}
+
 // called when start MP output - only needed for XML output
 int VTKLegacy(ostream &os,const char *mpmFile)
 {
@@ -1090,6 +1242,118 @@ int XYZExport(ostream &os,const char *mpmFile)
 	return noErr;
 }
 
+// Write NairnMPM binary particle file with archived particle data that can initialize
+// particles in a new calculation. It is not a restart: strains, deformation gradient,
+// plastic strain, and material history are not in the file and start from zero.
+// Data are collected into columns in one pass and written in the order of the
+// particle file column flags
+int ParticleFileExport(ostream &os,const char *mpmFile)
+{
+	int dim = threeD ? 3 : 2;
+	int numTensor = threeD ? 6 : 4;
+	int numAngles = threeD ? 3 : 1;
+	int i;
+	
+	// columns in this archive
+	int columns = PF_POSITION+PF_MATERIAL+PF_ANGLES+PF_MASS+PF_ORIGIN;
+	if(!threeD) columns += PF_THICKNESS;
+	if(velocityOffset>0) columns += PF_VELOCITY;
+	if(stressOffset>0) columns += PF_STRESS;
+	if(tempOffset>0) columns += PF_TEMPERATURE;
+	if(concOffset>0) columns += PF_CONCENTRATION;
+	
+	// collect columns
+	vector< double > pos[3],orig[3],angles[3],vel[3],stress[6];
+	vector< double > thick,mass,temp,conc;
+	vector< int > matID;
+	int nummpms=(int)(fileLength/recSize);
+	int p;
+	for(p=0;p<nummpms;p++)
+	{   // read next block when needed
+		if(!GetNextFileBlock(mpmFile)) return FileAccessErr;
+		
+		short matnum=pointMatnum(ap);
+		if(matnum<0) break;
+		if(skipThisPoint(matnum))
+		{	ap+=recSize;
+			continue;
+		}
+		
+		matID.push_back(matnum);
+		for(i=0;i<dim;i++)
+		{	pos[i].push_back(ArchiveDouble(ap+posOffset+i*sizeof(double)));
+			orig[i].push_back(ArchiveDouble(ap+origPosOffset+i*sizeof(double)));
+			if(velocityOffset>0)
+				vel[i].push_back(ArchiveDouble(ap+velocityOffset+i*sizeof(double)));
+		}
+		for(i=0;i<numAngles;i++)
+			angles[i].push_back(ArchiveDouble(ap+angleOffset+i*sizeof(double)));
+		if(!threeD)
+			thick.push_back(ArchiveDouble(ap+angleOffset+sizeof(double)));
+		if(stressOffset>0)
+		{	for(i=0;i<numTensor;i++)
+				stress[i].push_back(ArchiveDouble(ap+stressOffset+i*sizeof(double)));
+		}
+		if(tempOffset>0)
+			temp.push_back(ArchiveDouble(ap+tempOffset));
+		if(concOffset>0)
+			conc.push_back(ArchiveDouble(ap+concOffset));
+		mass.push_back(ArchiveDouble(ap+sizeof(int)));
+		
+		ap+=recSize;
+	}
+	
+	if(matID.size()==0)
+	{	cerr << "No particles were found to export to the NairnMPM particle file" << endl;
+		return FileAccessErr;
+	}
+	
+	// header
+	ParticleFileHeader header;
+	memset(&header,0,sizeof(ParticleFileHeader));
+	memcpy(header.tag,PF_TAG,8);
+	header.byteOrder = 1;
+	header.dimension = dim;
+	header.columns = columns;
+	header.numPoints = (long long)matID.size();
+	os.write((char *)&header,sizeof(ParticleFileHeader));
+	
+	// columns in required order (material IDs padded to multiple of 8 bytes)
+	for(i=0;i<dim;i++) WriteColumn(os,pos[i]);
+	os.write((char *)&matID[0],matID.size()*sizeof(int));
+	if(matID.size() % 2 != 0)
+	{	int zero = 0;
+		os.write((char *)&zero,sizeof(int));
+	}
+	for(i=0;i<numAngles;i++) WriteColumn(os,angles[i]);
+	if(!threeD) WriteColumn(os,thick);
+	if(velocityOffset>0)
+	{	for(i=0;i<dim;i++) WriteColumn(os,vel[i]);
+	}
+	if(stressOffset>0)
+	{	for(i=0;i<numTensor;i++) WriteColumn(os,stress[i]);
+	}
+	if(tempOffset>0) WriteColumn(os,temp);
+	if(concOffset>0) WriteColumn(os,conc);
+	WriteColumn(os,mass);
+	for(i=0;i<dim;i++) WriteColumn(os,orig[i]);
+	
+	return noErr;
+}
+
+// read double from archive in byte order of this machine (leaving the buffer unchanged)
+double ArchiveDouble(unsigned char *dptr)
+{	double value;
+	memcpy(&value,dptr,sizeof(double));
+	if(reverseFromInput) Reverse((char *)&value,sizeof(double));
+	return value;
+}
+
+// write one column of the particle file
+void WriteColumn(ostream &os,vector< double > &column)
+{	os.write((char *)&column[0],column.size()*sizeof(double));
+}
+
 // If needed, read next block of data from the file
 bool GetNextFileBlock(const char *mpmFile)
 {
@@ -1120,7 +1384,7 @@ bool GetNextFileBlock(const char *mpmFile)
 // When reading VTK file, need several passes through file and restart before each one
 bool RestartFileBlocks(long origOffset,const char *mpmFile)
 {
-    if(fileLength>MAX_READ_BLOCK)
+    if(!mappedFile && fileLength>MAX_READ_BLOCK)
     {   // go back and read first block
         rewind(fp);
         blockSize = MAX_READ_BLOCK;
@@ -1645,6 +1909,14 @@ void OutputQuantity(int i,unsigned char *ap,ostream &os,short matnum,char delim)
 	}
 }
 
+// get material number in record without changing the record
+short recordMatnum(unsigned char *rp)
+{	short matnum;
+	memcpy(&matnum,rp+sizeof(int)+sizeof(double),sizeof(short));
+	if(reverseFromInput) Reverse((char *)&matnum,sizeof(short));
+	return matnum;
+}
+
 // get material number for next material point or crack point
 short pointMatnum(unsigned char *ap)
 {	short *mptr=(short *)(ap+sizeof(int)+sizeof(double));
@@ -12,8 +12,22 @@
 #include <string.h>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <math.h>
 #include <vector>
+#include <string>
+
+// archives are memory mapped when available
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define USE_MMAP
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -47,16 +61,47 @@ enum { ARCH_Velocity=2,ARCH_Stress,ARCH_Strain,ARCH_PlasticStrain,
 // Archiving options for crack segments
 enum { ARCH_JIntegral=2,ARCH_StressIntensity,ARCH_BalanceResults,ARCH_MAXCRACKITEMS };
 
+// NairnMPM binary particle file (must match Read_MPM/ParticleFile.hpp in NairnMPM)
+#define PF_POSITION 0x0001
+#define PF_MATERIAL 0x0002
+#define PF_ANGLES 0x0004
+#define PF_THICKNESS 0x0008
+#define PF_VELOCITY 0x0010
+#define PF_STRESS 0x0040
+#define PF_TEMPERATURE 0x0080
+#define PF_CONCENTRATION 0x0100
+#define PF_MASS 0x0200
+#define PF_ORIGIN 0x0400
+#define PF_TAG "NMPMPTS1"
+
+typedef struct {
+	char tag[8];
+	int byteOrder;
+	int dimension;
+	int columns;
+	int reserved;
+	long long numPoints;
+	char pad[32];
+} ParticleFileHeader;
+
 // prototypes
 char *NextArgument(int,char * const [],int,char);
 void Usage(const char *);
 int ExtractMPMData(const char *,int,int);
+int OpenArchiveFile(const char *);
+void CloseArchiveFile(void);
+int ExtractParticles(ostream &,unsigned char *,int);
+void OutputParticle(ostream &,unsigned char *,short);
 int VTKLegacy(ostream &,const char *);
 int XYZExport(ostream &,const char *);
+int ParticleFileExport(ostream &,const char *);
+double ArchiveDouble(unsigned char *);
+void WriteColumn(ostream &,vector< double > &);
 bool GetNextFileBlock(const char *);
 bool RestartFileBlocks(long,const char *);
 void OutputQuantity(int,unsigned char *,ostream &,short,char);
 short pointMatnum(unsigned char *);
+short recordMatnum(unsigned char *);
 bool skipThisPoint(short);
 void OutputDouble(double *,int,char,bool,ostream &,int);
 void OutputRecordEnd(ostream &,bool);
@@ -0,0 +1,709 @@
+/*********************************************************************
+    MPMBenchmark.cpp
+    Nairn Research Group MPM and FEA Code
+	Run benchmark suite and collect timings
+
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+
+	MPMBenchmark (options) suiteFile
+*********************************************************************/
+
+#include "MPMBenchmark.hpp"
+
+// Global variable settings
+char *mpmExe=NULL;
+char *refExe=NULL;
+char *npList=NULL;
+char *sizeList=NULL;
+char *nameList=NULL;
+char *outFile=NULL;
+char *baseFile=NULL;
+char *scratchDir=NULL;
+double tolerance=10.;
+double accuracy=1.e-4;
+int deterministicPatches=0;
+bool keepRuns=false;
+string suiteFolder;
+
+#pragma mark MAIN AND INPUT PARAMETERS
+
+// main entry point
+int main(int argc, char * const argv[])
+{
+    // Requires one argument after options for file name
+    if(argc<2)
+    {	Usage("Benchmark suite file name is missing");
+        return NoInputFileErr;
+    }
+
+    // Check for options
+	int parmInd;
+	unsigned long opt;
+	char *parm;
+    for(parmInd=1;parmInd<argc && argv[parmInd][0]=='-';parmInd++)
+	{	// each character in the next argument (skipping the '-')
+		unsigned long optNum = strlen(argv[parmInd]);
+		for(opt=1;opt<optNum;opt++)
+		{	// Help request
+			if(argv[parmInd][opt]=='H' || argv[parmInd][opt]=='?')
+			{	Usage(NULL);
+				return noErr;
+			}
+
+			// options with arguments
+			else if(strchr("xnsboedtcaD",argv[parmInd][opt])!=NULL)
+			{	char optChar = argv[parmInd][opt];
+				parm=NextArgument(++parmInd,argv,argc,optChar);
+				if(parm==NULL) return BadOptionErr;
+				switch(optChar)
+				{	case 'x':
+						mpmExe = parm;
+						break;
+					case 'n':
+						npList = parm;
+						break;
+					case 's':
+						sizeList = parm;
+						break;
+					case 'b':
+						baseFile = parm;
+						break;
+					case 'o':
+						outFile = parm;
+						break;
+					case 'e':
+						nameList = parm;
+						break;
+					case 'd':
+						scratchDir = parm;
+						break;
+					case 'c':
+						refExe = parm;
+						break;
+					case 'a':
+						sscanf(parm,"%lf",&accuracy);
+						if(accuracy<=0.)
+						{   cerr << "MPMBenchmark option 'a' must be a positive relative difference" << endl;
+							return BadOptionErr;
+						}
+						break;
+					case 'D':
+						sscanf(parm,"%d",&deterministicPatches);
+						if(deterministicPatches<=0)
+						{   cerr << "MPMBenchmark option 'D' must be a positive number of patches" << endl;
+							return BadOptionErr;
+						}
+						break;
+					default:
+						sscanf(parm,"%lf",&tolerance);
+						if(tolerance<=0.)
+						{   cerr << "MPMBenchmark option 't' must be a positive percentage" << endl;
+							return BadOptionErr;
+						}
+						break;
+				}
+				break;
+			}
+
+			// keep run folders
+			else if(argv[parmInd][opt]=='k')
+				keepRuns = true;
+
+			else
+			{   cerr << "Unknown MPMBenchmark option '" << argv[parmInd][opt] << "' was used\n";
+				return BadOptionErr;
+			}
+		}
+    }
+
+    //  Last parameter must be the suite file name
+    if(parmInd!=argc-1)
+    {	Usage("Benchmark suite file name is missing");
+        return NoInputFileErr;
+    }
+
+	// defaults
+	char exePath[PATH_MAX];
+	if(mpmExe==NULL)
+		mpmExe = (char *)"../input/NairnMPM";
+	if(strchr(mpmExe,'/')!=NULL)
+	{	// runs are in scratch folders so need full path
+		if(realpath(mpmExe,exePath)==NULL)
+		{	cerr << "NairnMPM executable '" << mpmExe << "' was not found" << endl;
+			return FileAccessErr;
+		}
+		mpmExe = exePath;
+	}
+	char refPath[PATH_MAX];
+	if(refExe!=NULL && strchr(refExe,'/')!=NULL)
+	{	if(realpath(refExe,refPath)==NULL)
+		{	cerr << "Reference NairnMPM executable '" << refExe << "' was not found" << endl;
+			return FileAccessErr;
+		}
+		refExe = refPath;
+	}
+	if(npList==NULL) npList = (char *)"1";
+	if(scratchDir==NULL) scratchDir = (char *)"BenchmarkRuns";
+	mkdir(scratchDir,0755);
+
+	// read the suite
+	vector< BenchmarkRun > runs;
+	if(!ReadSuite(argv[parmInd],runs)) return FileAccessErr;
+	if(runs.size()==0)
+	{	cerr << "No benchmarks in the suite file match the selected names and sizes" << endl;
+		return NoInputFileErr;
+	}
+
+	// processor counts
+	vector< int > nps;
+	char *npCopy = new char[strlen(npList)+1];
+	strcpy(npCopy,npList);
+	char *npStr = strtok(npCopy,", ");
+	while(npStr!=NULL)
+	{	int np;
+		if(sscanf(npStr,"%d",&np)!=1 || np<1)
+		{   cerr << "MPMBenchmark option 'n' must be list of positive integers" << endl;
+			return BadOptionErr;
+		}
+		nps.push_back(np);
+		npStr = strtok(NULL,", ");
+	}
+	delete [] npCopy;
+
+	// run each benchmark for each number of processors
+	vector< BenchmarkResult > results;
+	int failed = 0,inaccurate = 0;
+	for(size_t i=0;i<runs.size();i++)
+	{	for(size_t j=0;j<nps.size();j++)
+		{	BenchmarkResult result;
+			cout << runs[i].name << " (" << runs[i].size << ", -np " << nps[j] << "): " << flush;
+			if(RunBenchmark(runs[i],nps[j],mpmExe,"",result))
+			{	char line[200];
+				double msPerStep = 1000.*result.elapsed/(double)result.steps;
+				sprintf(line,"%ld particles, %ld steps, %.4g ms/step, %.4g ns/particle-step",result.particles,
+						result.steps,msPerStep,1.e6*msPerStep/(double)result.particles);
+				cout << line << endl;
+				results.push_back(result);
+
+				// same run with reference executable
+				if(refExe!=NULL)
+				{	BenchmarkResult refResult;
+					cout << "   reference: " << flush;
+					if(RunBenchmark(runs[i],nps[j],refExe,"-ref",refResult))
+					{	if(!CompareAccuracy(result,refResult)) inaccurate++;
+						if(!keepRuns) RemoveRunFolder(refResult.folder);
+					}
+					else
+						failed++;
+				}
+				if(!keepRuns) RemoveRunFolder(result.folder);
+			}
+			else
+				failed++;
+		}
+	}
+
+	// results
+	if(outFile!=NULL)
+	{	if(!WriteResults(outFile,results)) return FileAccessErr;
+	}
+	else
+		WriteResults(NULL,results);
+
+	// baseline
+	int retval = failed>0 ? RunErr : noErr;
+	if(baseFile!=NULL)
+	{	int slower = CompareToBaseline(baseFile,results);
+		if(slower<0) return FileAccessErr;
+		if(slower>0 && retval==noErr) retval = SlowdownErr;
+	}
+
+	// accuracy
+	if(refExe!=NULL)
+	{	cerr << "Compared global results of " << results.size() << " runs to " << refExe << ": " << inaccurate
+				<< " differ by more than " << accuracy << endl;
+		if(inaccurate>0 && retval==noErr) retval = AccuracyErr;
+	}
+
+    return retval;
+}
+
+// grab next argument or quit with error is not found
+char *NextArgument(int parmInd,char * const argv[],int argc,char option)
+{
+	// error if not there
+	if(parmInd>=argc)
+	{   cerr << "MPMBenchmark option '" << option << "' is missing its required argument.\n";
+		return NULL;
+	}
+	return argv[parmInd];
+}
+
+// Explain usage of this program
+void Usage(const char *msg)
+{
+	if(msg!=NULL)
+		cout << "\nERROR: " << msg << endl;
+
+	cout << "\nMPMBenchmark\n    version 1.0.0" << endl;
+    cout << "\nUsage:\n"
+        "    MPMBenchmark [-options] <SuiteFile>\n\n"
+        "This program runs the NairnMPM benchmarks listed in <SuiteFile> and writes\n"
+        "elapsed time per step and time per particle-step for each task and for the\n"
+        "total calculation. Results are CSV or JSON (if output file ends in .json)\n\n"
+        "  Options:\n"
+		"    -x path            Path to NairnMPM (default ../input/NairnMPM)\n"
+		"    -n list            Numbers of processors (e.g. 1,2,4; default 1)\n"
+		"    -s list            Only run these sizes (e.g. small,medium; default all)\n"
+		"    -e list            Only run these benchmarks (default all)\n"
+		"    -o path            Save results to this file (default: standard output)\n"
+		"    -b path            Compare to previous results file and report slowdowns\n"
+		"    -t pct             Slowdown tolerance in percent for -b (default 10)\n"
+		"    -c path            Also run each benchmark with this (reference) NairnMPM and\n"
+		"                           compare global archive results (e.g., float vs. double builds)\n"
+		"    -a diff            Maximum relative difference for -c (default 1e-4)\n"
+		"    -D patches         Run in deterministic mode with this many patches (adds\n"
+		"                           <Deterministic patches=\"patches\"/> to each input file)\n"
+		"    -d path            Scratch folder for the runs (default BenchmarkRuns)\n"
+		"    -k                 Keep each run's input, output, and archives\n"
+        "    -H (or -?)         Show this help and exit\n"
+		"\n"
+		"Exit code is 0 if all runs completed and none are slower than the baseline,\n"
+		"4 if any run failed, 5 if any run was slower than the baseline, or 6 if\n"
+		"any run's global results differ from the reference run by more than -a\n"
+          <<  endl;
+}
+
+#pragma mark SUITE AND INPUT FILES
+
+// Read suite file into list of runs for selected names and sizes
+// Each line is: name size input [entity=value ...]
+bool ReadSuite(const char *suiteFile,vector< BenchmarkRun > &runs)
+{
+	ifstream suite(suiteFile);
+	if(!suite.is_open())
+	{	cerr << "Benchmark suite file '" << suiteFile << "' could not be opened" << endl;
+		return false;
+	}
+
+	// input files are relative to the suite file
+	char fullPath[PATH_MAX];
+	if(realpath(suiteFile,fullPath)==NULL)
+	{	cerr << "Benchmark suite file '" << suiteFile << "' could not be found" << endl;
+		return false;
+	}
+	suiteFolder = fullPath;
+	suiteFolder = suiteFolder.substr(0,suiteFolder.rfind('/')+1);
+
+	string line;
+	int lineNum = 0;
+	while(getline(suite,line))
+	{	lineNum++;
+		istringstream words(line);
+		BenchmarkRun run;
+		if(!(words >> run.name)) continue;
+		if(run.name[0]=='#') continue;
+		if(!(words >> run.size >> run.input))
+		{	cerr << "Line " << lineNum << " of suite file does not have name, size, and input file" << endl;
+			return false;
+		}
+
+		// entity settings
+		string setting;
+		while(words >> setting)
+		{	size_t eq = setting.find('=');
+			if(eq==string::npos || eq==0)
+			{	cerr << "Line " << lineNum << " of suite file has invalid entity setting '" << setting << "'" << endl;
+				return false;
+			}
+			run.entities.push_back(setting.substr(0,eq));
+			run.values.push_back(setting.substr(eq+1));
+		}
+
+		// selected?
+		if(sizeList!=NULL && !InList(sizeList,run.size)) continue;
+		if(nameList!=NULL && !InList(nameList,run.name)) continue;
+		if(run.input[0]!='/') run.input = suiteFolder+run.input;
+		runs.push_back(run);
+	}
+	return true;
+}
+
+// Write input file for the run with new entity values and full path to relative DTD file
+// If -D option was used, add <Deterministic> command to the <MPMHeader> element
+bool WriteRunInput(const BenchmarkRun &run,const char *runInput)
+{
+	ifstream orig(run.input.c_str());
+	if(!orig.is_open())
+	{	cerr << "input file '" << run.input << "' could not be opened" << endl;
+		return false;
+	}
+	string inputFolder = run.input.substr(0,run.input.rfind('/')+1);
+
+	ofstream dest(runInput);
+	if(!dest.is_open())
+	{	cerr << "run input file '" << runInput << "' could not be created" << endl;
+		return false;
+	}
+
+	vector< bool > found(run.entities.size(),false);
+	string line;
+	while(getline(orig,line))
+	{	// relative DTD file
+		size_t sys = line.find("SYSTEM \"");
+		if(sys!=string::npos && line[sys+8]!='/')
+			line.insert(sys+8,inputFolder);
+
+		// entities
+		size_t ent = line.find("<!ENTITY ");
+		while(ent!=string::npos)
+		{	size_t nameStart = ent+9;
+			size_t nameEnd = line.find(' ',nameStart);
+			size_t valueStart = line.find('"',nameStart);
+			size_t valueEnd = valueStart==string::npos ? string::npos : line.find('"',valueStart+1);
+			if(nameEnd==string::npos || valueEnd==string::npos) break;
+			string name = line.substr(nameStart,nameEnd-nameStart);
+			for(size_t i=0;i<run.entities.size();i++)
+			{	if(run.entities[i]==name)
+				{	line.replace(valueStart+1,valueEnd-valueStart-1,run.values[i]);
+					valueEnd = valueStart+1+run.values[i].length();
+					found[i] = true;
+					break;
+				}
+			}
+			ent = line.find("<!ENTITY ",valueEnd);
+		}
+
+		dest << line << "\n";
+
+		// deterministic mode
+		if(deterministicPatches>0 && line.find("<MPMHeader>")!=string::npos)
+			dest << "    <Deterministic patches=\"" << deterministicPatches << "\"/>\n";
+	}
+	dest.close();
+
+	// every setting must be used
+	for(size_t i=0;i<run.entities.size();i++)
+	{	if(!found[i])
+		{	cerr << "entity '" << run.entities[i] << "' not found in input file" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+#pragma mark RUNNING BENCHMARKS
+
+// Run one benchmark with NairnMPM at exe (folder name has suffix) and read times from its output
+// Run folder is removed on success only if not comparing to reference runs
+bool RunBenchmark(const BenchmarkRun &run,int np,const char *exe,const char *suffix,BenchmarkResult &result)
+{
+	result.name = run.name;
+	result.size = run.size;
+	result.np = np;
+	result.particles = 0;
+	result.steps = 0;
+	result.elapsed = 0.;
+	result.cpu = 0.;
+	result.completed = false;
+
+	// folder for this run
+	char runFolder[PATH_MAX],runFile[PATH_MAX+50],cmd[3*PATH_MAX];
+	sprintf(runFolder,"%s/%s-%s-np%d%s",scratchDir,run.name.c_str(),run.size.c_str(),np,suffix);
+	result.folder = runFolder;
+	sprintf(cmd,"rm -rf '%s'",runFolder);
+	system(cmd);
+	if(mkdir(runFolder,0755)!=0)
+	{	cerr << "run folder '" << runFolder << "' could not be created" << endl;
+		return false;
+	}
+
+	// input file and run
+	sprintf(runFile,"%s/Benchmark.fmcmd",runFolder);
+	if(!WriteRunInput(run,runFile)) return false;
+	sprintf(cmd,"cd '%s' && '%s' -np %d Benchmark.fmcmd > Benchmark.mpm 2>&1",runFolder,exe,np);
+	int status = system(cmd);
+
+	// results
+	sprintf(runFile,"%s/Benchmark.mpm",runFolder);
+	bool readOK = ReadRunOutput(runFile,result);
+	if(!readOK || !result.completed || result.steps<=0 || result.particles<=0)
+	{	cerr << "run failed (status " << status << "); see " << runFile << endl;
+		return false;
+	}
+
+	if(!keepRuns && refExe==NULL) RemoveRunFolder(result.folder);
+	return true;
+}
+
+// remove folder used for a run
+void RemoveRunFolder(const string &runFolder)
+{
+	string cmd = "rm -rf '"+runFolder+"'";
+	system(cmd.c_str());
+}
+
+// Read timings from NairnMPM output file
+bool ReadRunOutput(const char *outputFile,BenchmarkResult &result)
+{
+	ifstream output(outputFile);
+	if(!output.is_open()) return false;
+
+	string line;
+	while(getline(output,line))
+	{	const char *cline = line.c_str();
+		if(strncmp(cline,"Number of Material Points: ",27)==0)
+			sscanf(cline+27,"%ld",&result.particles);
+		else if(strncmp(cline,"Calculation Steps: ",19)==0)
+			sscanf(cline+19,"%ld",&result.steps);
+		else if(strncmp(cline,"Elapsed Time: ",14)==0)
+			sscanf(cline+14,"%lf",&result.elapsed);
+		else if(strncmp(cline,"CPU Time: ",10)==0)
+			sscanf(cline+10,"%lf",&result.cpu);
+		else if(strncmp(cline,"Task #",6)==0)
+		{	// Task #n: name: (cpu CPU_ms/step (pct%), )elapsed ms/step (...)
+			size_t nameStart = line.find(": ");
+			size_t nameEnd = nameStart==string::npos ? string::npos : line.find(": ",nameStart+2);
+			size_t msEnd = line.find(" ms/step");
+			if(nameEnd==string::npos || msEnd==string::npos) continue;
+			size_t msStart = line.rfind(' ',msEnd-1);
+			TaskTime task;
+			task.name = line.substr(nameStart+2,nameEnd-nameStart-2);
+			task.msPerStep = strtod(line.substr(msStart+1,msEnd-msStart-1).c_str(),NULL);
+			result.tasks.push_back(task);
+		}
+		else if(line.find("RUN COMPLETED")!=string::npos)
+			result.completed = true;
+	}
+	return true;
+}
+
+#pragma mark RESULTS
+
+// Write results as CSV or JSON (if file name ends in .json) to file or to cout if NULL
+bool WriteResults(const char *resultsFile,const vector< BenchmarkResult > &results)
+{
+	ofstream outfile;
+	if(resultsFile!=NULL)
+	{	outfile.open(resultsFile);
+		if(!outfile.is_open())
+		{	cerr << "results file '" << resultsFile << "' could not be created" << endl;
+			return false;
+		}
+	}
+	ostream &os = resultsFile!=NULL ? outfile : cout;
+	os.precision(6);
+
+	size_t len = resultsFile!=NULL ? strlen(resultsFile) : 0;
+	bool json = len>5 && strcmp(resultsFile+len-5,".json")==0;
+
+	if(json)
+	{	os << "[\n";
+		for(size_t i=0;i<results.size();i++)
+		{	const BenchmarkResult &r = results[i];
+			double msPerStep = 1000.*r.elapsed/(double)r.steps;
+			os << "  {\"benchmark\": " << JSONString(r.name) << ", \"size\": " << JSONString(r.size)
+				<< ", \"np\": " << r.np << ", \"particles\": " << r.particles << ", \"steps\": " << r.steps
+				<< ",\n   \"elapsed_s\": " << r.elapsed << ", \"cpu_s\": " << r.cpu
+				<< ", \"ms_per_step\": " << msPerStep
+				<< ", \"ns_per_particle_step\": " << 1.e6*msPerStep/(double)r.particles
+				<< ",\n   \"tasks\": [";
+			for(size_t j=0;j<r.tasks.size();j++)
+			{	os << (j==0 ? "\n" : ",\n") << "     {\"task\": " << JSONString(r.tasks[j].name)
+					<< ", \"ms_per_step\": " << r.tasks[j].msPerStep
+					<< ", \"ns_per_particle_step\": " << 1.e6*r.tasks[j].msPerStep/(double)r.particles << "}";
+			}
+			os << "]}" << (i+1<results.size() ? ",\n" : "\n");
+		}
+		os << "]" << endl;
+	}
+	else
+	{	// one line per task and one for the total
+		os << "benchmark,size,np,particles,steps,task,ms_per_step,ns_per_particle_step" << endl;
+		for(size_t i=0;i<results.size();i++)
+		{	const BenchmarkResult &r = results[i];
+			double msPerStep = 1000.*r.elapsed/(double)r.steps;
+			os << CSVString(r.name) << "," << CSVString(r.size) << "," << r.np << "," << r.particles << "," << r.steps
+				<< ",Total," << msPerStep << "," << 1.e6*msPerStep/(double)r.particles << endl;
+			for(size_t j=0;j<r.tasks.size();j++)
+			{	os << CSVString(r.name) << "," << CSVString(r.size) << "," << r.np << "," << r.particles << "," << r.steps
+					<< "," << CSVString(r.tasks[j].name) << "," << r.tasks[j].msPerStep << ","
+					<< 1.e6*r.tasks[j].msPerStep/(double)r.particles << endl;
+			}
+		}
+	}
+
+	if(resultsFile!=NULL) outfile.close();
+	return true;
+}
+
+// Compare total time per particle-step to previous CSV results
+// Return number of slower runs or -1 on file error
+int CompareToBaseline(const char *baselineFile,const vector< BenchmarkResult > &results)
+{
+	ifstream base(baselineFile);
+	if(!base.is_open())
+	{	cerr << "baseline file '" << baselineFile << "' could not be opened" << endl;
+		return -1;
+	}
+
+	int slower = 0,compared = 0;
+	string line;
+	while(getline(base,line))
+	{	// only the totals: benchmark,size,np,particles,steps,Total,ms,ns
+		vector< string > cols;
+		istringstream fields(line);
+		string field;
+		while(getline(fields,field,',')) cols.push_back(field);
+		if(cols.size()<8 || cols[5]!="Total") continue;
+
+		int np = atoi(cols[2].c_str());
+		double baseTime = strtod(cols[7].c_str(),NULL);
+		for(size_t i=0;i<results.size();i++)
+		{	const BenchmarkResult &r = results[i];
+			if(r.name!=cols[0] || r.size!=cols[1] || r.np!=np) continue;
+			double newTime = 1.e9*r.elapsed/((double)r.steps*(double)r.particles);
+			double change = 100.*(newTime-baseTime)/baseTime;
+			compared++;
+			if(change>tolerance)
+			{	char msg[200];
+				sprintf(msg,"SLOWER: %s (%s, -np %d) %.4g ns/particle-step vs. %.4g (+%.1f%%)",
+							r.name.c_str(),r.size.c_str(),np,newTime,baseTime,change);
+				cerr << msg << endl;
+				slower++;
+			}
+			break;
+		}
+	}
+
+	cerr << "Compared " << compared << " runs to " << baselineFile << ": " << slower
+			<< " slower by more than " << tolerance << "%" << endl;
+	return slower;
+}
+
+#pragma mark ACCURACY
+
+// Compare global archive of a run to the reference run of the same benchmark
+// Difference in each column is max |value-reference| relative to max |reference| in that column
+// Return false if any column differs by more than accuracy, or if the files do not match
+bool CompareAccuracy(const BenchmarkResult &result,const BenchmarkResult &refResult)
+{
+	string globalFile,refGlobalFile;
+	if(!FindGlobalFile(result.folder,globalFile) || !FindGlobalFile(refResult.folder,refGlobalFile))
+	{	cout << "no global archive to compare" << endl;
+		return true;
+	}
+
+	GlobalResults values,refValues;
+	if(!ReadGlobalResults(globalFile,values) || !ReadGlobalResults(refGlobalFile,refValues))
+	{	cout << "global archive could not be read" << endl;
+		return false;
+	}
+	if(values.rows.size()!=refValues.rows.size() || values.columns!=refValues.columns)
+	{	cout << "MISMATCH: global archives have different rows or columns" << endl;
+		return false;
+	}
+
+	// column with largest difference (time is skipped)
+	double maxDiff = 0.;
+	size_t worst = 0;
+	for(size_t j=1;j<refValues.columns.size();j++)
+	{	double maxRef = 0.,maxError = 0.;
+		for(size_t i=0;i<refValues.rows.size();i++)
+		{	if(refValues.rows[i].size()<=j || values.rows[i].size()<=j) continue;
+			maxRef = fmax(maxRef,fabs(refValues.rows[i][j]));
+			maxError = fmax(maxError,fabs(values.rows[i][j]-refValues.rows[i][j]));
+		}
+		double relDiff = maxRef>0. ? maxError/maxRef : maxError;
+		if(relDiff>=maxDiff)
+		{	maxDiff = relDiff;
+			worst = j;
+		}
+	}
+
+	char line[200];
+	if(worst==0)
+	{	cout << "no global quantities to compare" << endl;
+		return true;
+	}
+	bool accurate = maxDiff<=accuracy;
+	sprintf(line,"%s max relative difference %.3g (%s)",accurate ? "global results within tolerance;" : "INACCURATE:",
+				maxDiff,refValues.columns[worst].c_str());
+	cout << line << endl;
+	return accurate;
+}
+
+// Find global archive file (*.global) in a run folder or its subfolders
+bool FindGlobalFile(const string &runFolder,string &globalFile)
+{
+	string cmd = "find '"+runFolder+"' -name '*.global'";
+	FILE *fp = popen(cmd.c_str(),"r");
+	if(fp==NULL) return false;
+	char path[PATH_MAX];
+	bool found = fgets(path,PATH_MAX,fp)!=NULL;
+	pclose(fp);
+	if(!found) return false;
+	globalFile = path;
+	size_t end = globalFile.find_last_not_of("\r\n");
+	globalFile.erase(end+1);
+	return globalFile.length()>0;
+}
+
+// Read tab-delimited global archive file (column names from #setName line)
+bool ReadGlobalResults(const string &globalFile,GlobalResults &values)
+{
+	ifstream global(globalFile.c_str());
+	if(!global.is_open()) return false;
+
+	string line;
+	while(getline(global,line))
+	{	if(line.length()==0) continue;
+		istringstream fields(line);
+		string field;
+		if(line[0]=='#')
+		{	if(line.compare(0,8,"#setName")!=0) continue;
+			values.columns.clear();
+			values.columns.push_back("Time");
+			getline(fields,field,'\t');
+			while(getline(fields,field,'\t')) values.columns.push_back(field);
+			continue;
+		}
+		vector< double > row;
+		while(getline(fields,field,'\t')) row.push_back(strtod(field.c_str(),NULL));
+		values.rows.push_back(row);
+	}
+	return values.columns.size()>0;
+}
+
+#pragma mark UTILITIES
+
+// true if value is in comma separated list
+bool InList(const char *list,const string &value)
+{
+	string items = string(",")+list+",";
+	return items.find(","+value+",")!=string::npos;
+}
+
+// quoted JSON string
+string JSONString(const string &value)
+{
+	string quoted = "\"";
+	for(size_t i=0;i<value.length();i++)
+	{	if(value[i]=='"' || value[i]=='\\') quoted += '\\';
+		quoted += value[i];
+	}
+	return quoted+"\"";
+}
+
+// quote CSV field if needed
+string CSVString(const string &value)
+{
+	if(value.find_first_of(",\"")==string::npos) return value;
+	string quoted = "\"";
+	for(size_t i=0;i<value.length();i++)
+	{	if(value[i]=='"') quoted += '"';
+		quoted += value[i];
+	}
+	return quoted+"\"";
+}
@@ -0,0 +1,79 @@
+/*********************************************************************
+    MPMBenchmark.hpp
+    Nairn Research Group MPM and FEA Code
+	Run benchmark suite and collect timings
+
+    Created by John Nairn on Oct 19, 2026.
+    Copyright (c) 2026 John A. Nairn, All rights reserved.
+*********************************************************************/
+
+#include <cstdio>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <math.h>
+#include <vector>
+#include <string>
+#include <sys/stat.h>
+#include <limits.h>
+
+#define MAX_FILE_LINE 1000
+
+using namespace std;
+
+// error codes
+enum { noErr=0, NoInputFileErr, BadOptionErr, FileAccessErr, RunErr, SlowdownErr, AccuracyErr };
+
+// one benchmark run in the suite file
+typedef struct
+{	string name;
+	string size;
+	string input;
+	vector< string > entities;
+	vector< string > values;
+} BenchmarkRun;
+
+// time for one task
+typedef struct
+{	string name;
+	double msPerStep;
+} TaskTime;
+
+// results for one run
+typedef struct
+{	string name;
+	string size;
+	int np;
+	long particles;
+	long steps;
+	double elapsed;
+	double cpu;
+	bool completed;
+	vector< TaskTime > tasks;
+	string folder;
+} BenchmarkResult;
+
+// global archive results (time in column 0)
+typedef struct
+{	vector< string > columns;
+	vector< vector< double > > rows;
+} GlobalResults;
+
+// prototypes
+char *NextArgument(int,char * const [],int,char);
+void Usage(const char *);
+bool ReadSuite(const char *,vector< BenchmarkRun > &);
+bool WriteRunInput(const BenchmarkRun &,const char *);
+bool RunBenchmark(const BenchmarkRun &,int,const char *,const char *,BenchmarkResult &);
+bool ReadRunOutput(const char *,BenchmarkResult &);
+bool WriteResults(const char *,const vector< BenchmarkResult > &);
+int CompareToBaseline(const char *,const vector< BenchmarkResult > &);
+bool CompareAccuracy(const BenchmarkResult &,const BenchmarkResult &);
+bool FindGlobalFile(const string &,string &);
+bool ReadGlobalResults(const string &,GlobalResults &);
+void RemoveRunFolder(const string &);
+bool InList(const char *,const string &);
+string JSONString(const string &);
+string CSVString(const string &);